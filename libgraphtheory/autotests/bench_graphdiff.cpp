@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench_graphdiff.h"
+#include "libgraphtheory/graphdocument.h"
+#include "libgraphtheory/nodetype.h"
+#include "libgraphtheory/edgetype.h"
+#include "libgraphtheory/node.h"
+#include "libgraphtheory/edge.h"
+#include "libgraphtheory/graphdiff.h"
+#include "libgraphtheory/kernel/kernel.h"
+#include "libgraphtheory/kernel/kernelexecution.h"
+
+#include <QTest>
+
+using namespace GraphTheory;
+
+namespace
+{
+const int nodeCount = 20000;
+const int edgeCount = 200000;
+
+GraphDocumentPtr createDocument()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("name");
+    document->edgeTypes().first()->addDynamicProperty("weight");
+    BulkUpdateGuard bulkUpdate(document);
+    NodeList nodes;
+    nodes.reserve(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        NodePtr node = Node::create(document);
+        node->setDynamicProperty("name", QString("node%1").arg(i));
+        nodes.append(node);
+    }
+    for (int i = 0; i < edgeCount; ++i) {
+        EdgePtr edge = Edge::create(nodes.at(i % nodeCount), nodes.at((i * 7 + 1) % nodeCount));
+        edge->setDynamicProperty("weight", i);
+    }
+    return document;
+}
+}
+
+void BenchGraphDiff::workingCopyBenchmark()
+{
+    // cloning and destroying the copy happen in the thread of the document for every run
+    GraphDocumentPtr document = createDocument();
+    QBENCHMARK {
+        GraphDiff diff(document);
+    }
+    document->destroy();
+}
+
+void BenchGraphDiff::updateBenchmark()
+{
+    // finding the changes runs on the worker thread
+    GraphDocumentPtr document = createDocument();
+    GraphDiff diff(document);
+    diff.workingCopy()->nodes().first()->setDynamicProperty("name", "changed");
+    QBENCHMARK {
+        diff.update();
+    }
+    QCOMPARE(diff.changedNodes().count(), 1);
+    document->destroy();
+}
+
+void BenchGraphDiff::applyBenchmark()
+{
+    // applying only touches the changed elements
+    GraphDocumentPtr document = createDocument();
+    GraphDiff diff(document);
+    diff.workingCopy()->nodes().first()->setDynamicProperty("name", "changed");
+    diff.update();
+    QBENCHMARK {
+        diff.apply();
+    }
+    QCOMPARE(document->nodes().first()->dynamicProperty("name").toString(), QString("changed"));
+    document->destroy();
+}
+
+void BenchGraphDiff::executeAsyncBenchmark()
+{
+    // total overhead of a script run that changes nothing
+    GraphDocumentPtr document = createDocument();
+    Kernel kernel;
+    QBENCHMARK {
+        KernelExecution *execution = kernel.executeAsync(document, "1;");
+        execution->waitForFinished();
+        delete execution;
+    }
+    document->destroy();
+}
+
+QTEST_MAIN(BenchGraphDiff)
@@ -0,0 +1,41 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH_GRAPHDIFF_H
+#define BENCH_GRAPHDIFF_H
+
+#include <QObject>
+
+/**
+ * Per-run cost of the working copy that asynchronous script executions operate on. The
+ * benchmarks are not run by ctest, start bench_graphdiff manually, e.g., with "-iterations 10".
+ */
+class BenchGraphDiff : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void workingCopyBenchmark();
+    void updateBenchmark();
+    void applyBenchmark();
+    void executeAsyncBenchmark();
+};
+
+#endif
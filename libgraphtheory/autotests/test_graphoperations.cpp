@@ -21,11 +21,18 @@
 #include "test_graphoperations.h"
 #include "libgraphtheory/graphdocument.h"
 #include "libgraphtheory/nodetype.h"
+#include "libgraphtheory/nodetypestyle.h"
 #include "libgraphtheory/edgetype.h"
 #include "libgraphtheory/node.h"
 #include "libgraphtheory/edge.h"
+#include "libgraphtheory/graphsnapshot.h"
+#include "libgraphtheory/graphdiff.h"
+#include "libgraphtheory/models/nodemodel.h"
+#include "libgraphtheory/models/edgemodel.h"
 
 #include <QTest>
+#include <QSignalSpy>
+#include <QSet>
 
 void TestGraphOperations::initTestCase()
 {
@@ -236,6 +243,185 @@ void TestGraphOperations::testNodeIdentifiers()
     document->destroy();
 }
 
+void TestGraphOperations::testNodeLookup()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+
+    QCOMPARE(document->node(nodeA->id()), nodeA);
+    QCOMPARE(document->node(nodeB->id()), nodeB);
+
+    // lookup must follow identifier changes
+    const int oldId = nodeA->id();
+    nodeA->setId(42);
+    QCOMPARE(document->node(42), nodeA);
+    QVERIFY(document->node(oldId).isNull());
+
+    // generated identifiers must skip explicitly set ones
+    NodePtr nodeC = Node::create(document);
+    QVERIFY(nodeC->id() > 42);
+    QCOMPARE(document->node(42), nodeA);
+
+    // removed nodes must not be found anymore
+    nodeB->destroy();
+    QVERIFY(document->node(nodeB->id()).isNull());
+
+    document->destroy();
+}
+
+void TestGraphOperations::testBulkUpdate()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    QSignalSpy nodeAddedSpy(document.data(), SIGNAL(nodeAdded()));
+    QSignalSpy nodesAddedSpy(document.data(), SIGNAL(nodesAdded(int,int)));
+    QSignalSpy edgesAddedSpy(document.data(), SIGNAL(edgesAdded(int,int)));
+    QSignalSpy edgesResetSpy(document.data(), SIGNAL(edgesReset()));
+
+    // creation of elements is reported by one range signal
+    document->beginBulkUpdate();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    Edge::create(nodeA, nodeB);
+    Edge::create(nodeB, nodeC);
+    QCOMPARE(document->nodes().count(), 3);
+    QCOMPARE(nodesAddedSpy.count(), 0);
+    document->endBulkUpdate();
+    QCOMPARE(nodeAddedSpy.count(), 0);
+    QCOMPARE(nodesAddedSpy.count(), 1);
+    QCOMPARE(nodesAddedSpy.at(0).at(0).toInt(), 0);
+    QCOMPARE(nodesAddedSpy.at(0).at(1).toInt(), 2);
+    QCOMPARE(edgesAddedSpy.count(), 1);
+    QCOMPARE(document->node(nodeC->id()), nodeC);
+
+    // removals inside a bulk update are reported as reset
+    document->beginBulkUpdate();
+    foreach (EdgePtr edge, document->edges()) {
+        edge->destroy();
+    }
+    document->endBulkUpdate();
+    QCOMPARE(document->edges().count(), 0);
+    QCOMPARE(edgesResetSpy.count(), 1);
+    QCOMPARE(edgesAddedSpy.count(), 1);
+
+    // models announce appended nodes as inserted rows, the guard finishes the bulk update
+    NodeModel model;
+    model.setDocument(document);
+    QSignalSpy rowsInsertedSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy modelResetSpy(&model, SIGNAL(modelReset()));
+    {
+        BulkUpdateGuard bulkUpdate(document);
+        Node::create(document);
+        Node::create(document);
+        QCOMPARE(model.rowCount(), 3);
+    }
+    QCOMPARE(model.rowCount(), 5);
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(rowsInsertedSpy.at(0).at(1).toInt(), 3);
+    QCOMPARE(rowsInsertedSpy.at(0).at(2).toInt(), 4);
+    QCOMPARE(modelResetSpy.count(), 0);
+    QCOMPARE(nodesAddedSpy.count(), 2);
+
+    document->destroy();
+}
+
+void TestGraphOperations::testRemoval()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    Edge::create(nodeA, nodeB);
+    Edge::create(nodeB, nodeC);
+    EdgePtr edge = Edge::create(nodeC, nodeA);
+    QSignalSpy nodeReplacedSpy(document.data(), SIGNAL(nodeReplaced(int)));
+
+    // last node moves into the slot of the removed node
+    nodeA->destroy();
+    QCOMPARE(document->nodes().count(), 2);
+    QCOMPARE(document->nodes().at(0), nodeC);
+    QCOMPARE(document->nodes().at(1), nodeB);
+    QCOMPARE(nodeReplacedSpy.count(), 1);
+    QCOMPARE(nodeReplacedSpy.at(0).at(0).toInt(), 0);
+    QCOMPARE(document->edges().count(), 1);
+    QVERIFY(!document->edges().contains(edge));
+
+    // removing an already removed node must not change the document
+    document->remove(nodeA);
+    QCOMPARE(document->nodes().count(), 2);
+
+    // batched removal of edges
+    Edge::create(nodeC, nodeB);
+    Edge::create(nodeB, nodeB);
+    QCOMPARE(document->edges().count(), 3);
+    document->remove(document->edges());
+    QCOMPARE(document->edges().count(), 0);
+    QCOMPARE(nodeB->edges().count(), 0);
+    QCOMPARE(nodeC->edges().count(), 0);
+
+    document->destroy();
+}
+
+void TestGraphOperations::testModelRemoval()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("name");
+    document->edgeTypes().first()->addDynamicProperty("weight");
+    const int count = 20000;
+    {
+        BulkUpdateGuard bulkUpdate(document);
+        NodePtr previous = Node::create(document);
+        for (int i = 1; i < count; ++i) {
+            NodePtr node = Node::create(document);
+            Edge::create(previous, node);
+            previous = node;
+        }
+    }
+    NodeModel nodeModel;
+    nodeModel.setDocument(document);
+    EdgeModel edgeModel;
+    edgeModel.setDocument(document);
+
+    // every removal only remaps the element that moves into the freed row, thus removing
+    // many elements with attached models does not take quadratic time
+    for (int i = 0; i < count / 2; ++i) {
+        document->nodes().at(i)->destroy();
+    }
+    QCOMPARE(nodeModel.rowCount(), count / 2);
+    QCOMPARE(edgeModel.rowCount(), document->edges().count());
+
+    // change signals of moved elements are mapped to their new rows
+    QSignalSpy nodeChangedSpy(&nodeModel, SIGNAL(nodeChanged(int)));
+    QSignalSpy edgeChangedSpy(&edgeModel, SIGNAL(edgeChanged(int)));
+    for (int row = 0; row < document->nodes().count(); row += 997) {
+        nodeChangedSpy.clear();
+        document->nodes().at(row)->setDynamicProperty("name", row);
+        QCOMPARE(nodeChangedSpy.count(), 1);
+        QCOMPARE(nodeChangedSpy.at(0).at(0).toInt(), row);
+    }
+    for (int row = 0; row < document->edges().count(); row += 997) {
+        edgeChangedSpy.clear();
+        document->edges().at(row)->setDynamicProperty("weight", row);
+        QCOMPARE(edgeChangedSpy.count(), 1);
+        QCOMPARE(edgeChangedSpy.at(0).at(0).toInt(), row);
+    }
+
+    // type changes during bulk removals only notify rows that still exist
+    {
+        BulkUpdateGuard bulkUpdate(document);
+        for (int i = 0; i < count / 4; ++i) {
+            document->nodes().first()->destroy();
+        }
+        document->nodeTypes().first()->addDynamicProperty("rank");
+        document->edgeTypes().first()->addDynamicProperty("capacity");
+    }
+    QCOMPARE(nodeModel.rowCount(), document->nodes().count());
+    QCOMPARE(edgeModel.rowCount(), document->edges().count());
+
+    document->destroy();
+}
+
 // test if edges between nodes are returned correctly
 void TestGraphOperations::testUnidirectionalEdges()
 {
@@ -357,6 +543,46 @@ void TestGraphOperations::testEdgeDirectionChange()
     document->destroy();
 }
 
+void TestGraphOperations::testEdgeTypeChange()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    EdgeTypePtr typeA = document->edgeTypes().first();
+    typeA->setDirection(EdgeType::Unidirectional);
+    EdgeTypePtr typeB = EdgeType::create(document);
+    typeB->setDirection(EdgeType::Bidirectional);
+
+    NodePtr from = Node::create(document);
+    NodePtr to = Node::create(document);
+    EdgePtr edge = Edge::create(from, to);
+    EdgePtr loop = Edge::create(from, from);
+
+    QCOMPARE(from->edgesView(typeA).count(), 2);
+    QCOMPARE(from->outEdgesView(typeA).count(), 2);
+    QCOMPARE(from->inEdgesView(typeA).count(), 1);
+    QCOMPARE(to->inEdgesView(typeA).count(), 1);
+    QCOMPARE(to->outEdgesView(typeA).count(), 0);
+
+    // changing the type moves the edge to the other type at both end points
+    edge->setType(typeB);
+    QCOMPARE(from->edgesView(typeA).count(), 1);
+    QCOMPARE(from->edgesView(typeB).count(), 1);
+    QCOMPARE(to->edgesView(typeA).count(), 0);
+    QCOMPARE(to->outEdgesView(typeB).count(), 1);
+    QCOMPARE(to->inEdgesView(typeB).count(), 1);
+    QCOMPARE(from->edges().count(), 2);
+    QCOMPARE(from->outEdges().count(), 2);
+
+    loop->setType(typeB);
+    QCOMPARE(from->edgesView(typeA).count(), 0);
+    QCOMPARE(from->edgesView(typeB).count(), 2);
+
+    loop->destroy();
+    QCOMPARE(from->edgesView(typeB).count(), 1);
+    QCOMPARE(from->edges().count(), 1);
+
+    document->destroy();
+}
+
 void TestGraphOperations::testDynamicPropertyRename()
 {
     GraphDocumentPtr document = GraphDocument::create();
@@ -396,4 +622,295 @@ void TestGraphOperations::testDynamicPropertyRename()
     document->destroy();
 }
 
+void TestGraphOperations::testDynamicPropertyTypeChange()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodeTypePtr typeA = document->nodeTypes().first();
+    NodeTypePtr typeB = NodeType::create(document);
+    typeA->addDynamicProperty("shared");
+    typeA->addDynamicProperty("onlyA");
+    typeB->addDynamicProperty("onlyB");
+    typeB->addDynamicProperty("shared");
+
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    nodeA->setDynamicProperty("shared", "a");
+    nodeA->setDynamicProperty("onlyA", "a");
+    nodeB->setDynamicProperty("shared", "b");
+
+    // only values of properties registered at both types are kept
+    nodeA->setType(typeB);
+    QCOMPARE(nodeA->dynamicProperty("shared").toString(), QString("a"));
+    QCOMPARE(nodeA->dynamicProperty("onlyA").isValid(), false);
+    QCOMPARE(nodeA->dynamicProperty("onlyB").isValid(), false);
+    QCOMPARE(nodeB->dynamicProperty("shared").toString(), QString("b"));
+
+    // released rows must not leak values to new nodes
+    NodePtr nodeC = Node::create(document);
+    QCOMPARE(nodeC->dynamicProperty("shared").isValid(), false);
+    QCOMPARE(nodeC->dynamicProperty("onlyA").isValid(), false);
+
+    // unregistered properties are not stored
+    nodeB->setDynamicProperty("unknown", "b");
+    QCOMPARE(nodeB->dynamicProperty("unknown").isValid(), false);
+
+    // values keep their type, also after the column switched its storage
+    typeA->addDynamicProperty("mixed");
+    nodeB->setDynamicProperty("mixed", 1.5);
+    QCOMPARE(nodeB->dynamicProperty("mixed").userType(), int(QMetaType::Double));
+    nodeC->setDynamicProperty("mixed", 2);
+    QCOMPARE(nodeB->dynamicProperty("mixed"), QVariant(1.5));
+    QCOMPARE(nodeC->dynamicProperty("mixed"), QVariant(2));
+    nodeC->setDynamicProperty("mixed", QVariant());
+    QCOMPARE(nodeC->dynamicProperty("mixed").isValid(), false);
+
+    document->destroy();
+}
+
+void TestGraphOperations::testPropertyKeys()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodeTypePtr type = document->nodeTypes().first();
+    type->addDynamicProperty("a");
+    type->addDynamicProperty("b");
+    NodePtr node = Node::create(document);
+
+    // keys are interned
+    const PropertyKey keyA("a");
+    const PropertyKey keyB("b");
+    QVERIFY(keyA == PropertyKey("a"));
+    QVERIFY(keyA != keyB);
+    QCOMPARE(keyB.name(), QString("b"));
+    QVERIFY(!PropertyKey().isValid());
+
+    node->setDynamicProperty(keyB, "value");
+    QCOMPARE(node->dynamicProperty("b").toString(), QString("value"));
+    QCOMPARE(node->dynamicProperty(keyB).toString(), QString("value"));
+    QCOMPARE(type->dynamicPropertyIndex(keyB), 1);
+
+    // keys follow removal and renaming of properties
+    type->removeDynamicProperty("a");
+    QCOMPARE(type->dynamicPropertyIndex(keyA), -1);
+    QCOMPARE(type->dynamicPropertyIndex(keyB), 0);
+    QCOMPARE(node->dynamicProperty(keyB).toString(), QString("value"));
+    type->renameDynamicProperty("b", "c");
+    QVERIFY(!node->dynamicProperty(keyB).isValid());
+    QCOMPARE(node->dynamicProperty(PropertyKey("c")).toString(), QString("value"));
+
+    document->destroy();
+}
+
+void TestGraphOperations::testSnapshot()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    EdgeTypePtr typeA = document->edgeTypes().first();
+    typeA->setDirection(EdgeType::Unidirectional);
+    typeA->addDynamicProperty("weight");
+    EdgeTypePtr typeB = EdgeType::create(document);
+    typeB->setDirection(EdgeType::Bidirectional);
+
+    QMap<int, NodePtr> nodes;
+    for (int i = 0; i < 3; ++i) {
+        nodes.insert(i, Node::create(document));
+    }
+    EdgePtr edge01 = Edge::create(nodes[0], nodes[1]);
+    edge01->setDynamicProperty("weight", 2.5);
+    EdgePtr edge02 = Edge::create(nodes[0], nodes[2]);
+    EdgePtr edge12 = Edge::create(nodes[1], nodes[2]);
+    edge12->setType(typeB);
+
+    GraphSnapshot snapshot(document, QStringList() << "weight");
+    QCOMPARE(snapshot.nodeCount(), 3);
+    QCOMPARE(snapshot.edgeCount(), 3);
+    QCOMPARE(snapshot.nodeIndex(nodes[2]), 2);
+    QCOMPARE(snapshot.edgeTypeCount(), 2);
+
+    // unidirectional edges are contained once, bidirectional edges at both nodes
+    QCOMPARE(snapshot.offsets(), QVector<int>() << 0 << 2 << 3 << 4);
+    QCOMPARE(snapshot.targets(), QVector<int>() << 1 << 2 << 2 << 1);
+    const int b = snapshot.edgeTypeIndex(typeB);
+    QCOMPARE(snapshot.offsets(b), QVector<int>() << 0 << 0 << 1 << 2);
+    QCOMPARE(snapshot.targets(b), QVector<int>() << 2 << 1);
+    QCOMPARE(snapshot.edge(snapshot.edges(b).first()), edge12);
+
+    // weights, missing values are NaN
+    const QVector<qreal> &weights = snapshot.weights(snapshot.weightIndex("weight"));
+    QCOMPARE(weights.at(0), 2.5);
+    QVERIFY(qIsNaN(weights.at(1)));
+
+    // snapshot is not affected by changes of the document
+    nodes[1]->destroy();
+    QCOMPARE(snapshot.nodeCount(), 3);
+    QCOMPARE(snapshot.edgeCount(), 3);
+
+    document->destroy();
+}
+
+void TestGraphOperations::testTypeChangeDispatch()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodeTypePtr typeA = document->nodeTypes().first();
+    NodeTypePtr typeB = NodeType::create(document);
+    typeA->addDynamicProperty("a");
+    typeB->addDynamicProperty("b");
+    NodePtr node = Node::create(document);
+    Node::create(document);
+    Node::create(document)->setType(typeB);
+    Node::create(document);
+
+    NodeModel model;
+    model.setDocument(document);
+    QSignalSpy dataSpy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+
+    // a style change of the type is announced once per range of rows of its nodes
+    typeA->style()->setColor(Qt::red);
+    QCOMPARE(dataSpy.count(), 2);
+    QCOMPARE(dataSpy.at(0).at(0).value<QModelIndex>().row(), 0);
+    QCOMPARE(dataSpy.at(0).at(1).value<QModelIndex>().row(), 1);
+    QVERIFY(dataSpy.at(0).at(2).value<QVector<int>>().contains(NodeModel::TypeColorRole));
+    QCOMPARE(dataSpy.at(1).at(0).value<QModelIndex>().row(), 3);
+    QCOMPARE(dataSpy.at(1).at(1).value<QModelIndex>().row(), 3);
+    QCOMPARE(model.data(model.index(0), NodeModel::TypeColorRole).value<QColor>(), QColor(Qt::red));
+
+    // a property rename only affects the rows of nodes of the renamed type
+    dataSpy.clear();
+    typeB->renameDynamicProperty("b", "c");
+    QCOMPARE(dataSpy.count(), 1);
+    QCOMPARE(dataSpy.at(0).at(0).value<QModelIndex>().row(), 2);
+    QCOMPARE(dataSpy.at(0).at(1).value<QModelIndex>().row(), 2);
+    QVERIFY(dataSpy.at(0).at(2).value<QVector<int>>().contains(NodeModel::PropertiesRole));
+
+    // nodes that change their type are announced individually
+    dataSpy.clear();
+    node->setType(typeB);
+    QCOMPARE(dataSpy.count(), 1);
+    QCOMPARE(dataSpy.at(0).at(0).value<QModelIndex>().row(), 0);
+    dataSpy.clear();
+    typeB->style()->setColor(Qt::blue);
+    QCOMPARE(dataSpy.count(), 2);
+    QCOMPARE(dataSpy.at(0).at(0).value<QModelIndex>().row(), 0);
+    QCOMPARE(dataSpy.at(0).at(1).value<QModelIndex>().row(), 0);
+    QCOMPARE(dataSpy.at(1).at(0).value<QModelIndex>().row(), 2);
+
+    document->destroy();
+}
+
+void TestGraphOperations::testDocumentDiff()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("name");
+    document->edgeTypes().first()->addDynamicProperty("weight");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    nodeA->setDynamicProperty("name", "a");
+    EdgePtr edgeAB = Edge::create(nodeA, nodeB);
+    edgeAB->setDynamicProperty("weight", 3);
+    Edge::create(nodeB, nodeC);
+
+    // an independent copy is equal to the document
+    GraphDocumentPtr copy = document->clone();
+    QVERIFY(GraphDiff(document, copy).isEmpty());
+
+    // nodes are matched by identifier, edges by end points and type
+    copy->node(nodeA->id())->setDynamicProperty("name", "changed");
+    copy->node(nodeC->id())->destroy();
+    NodePtr nodeD = Node::create(copy);
+    Edge::create(copy->node(nodeA->id()), nodeD);
+    copy->edges().first()->setDynamicProperty("weight", 4);
+
+    GraphDiff diff(document, copy);
+    QCOMPARE(diff.document(), document);
+    QCOMPARE(diff.workingCopy(), copy);
+    QCOMPARE(diff.changedNodes(), NodeList() << copy->node(nodeA->id()));
+    QCOMPARE(diff.insertedNodes(), NodeList() << nodeD);
+    QCOMPARE(diff.removedNodes(), NodeList() << nodeC);
+    QCOMPARE(diff.insertedEdges().count(), 1);
+    QCOMPARE(diff.insertedEdges().first()->to(), nodeD);
+    QCOMPARE(diff.removedEdges().count(), 1);
+    QCOMPARE(diff.removedEdges().first()->to(), nodeC);
+    QCOMPARE(diff.changedEdges(), EdgeList() << copy->edges().first());
+
+    // the comparison is repeated by update(), the compared document is not owned
+    copy->node(nodeA->id())->setDynamicProperty("name", "a");
+    diff.update();
+    QVERIFY(diff.changedNodes().isEmpty());
+    QCOMPARE(diff.insertedNodes(), NodeList() << nodeD);
+
+    copy->destroy();
+    document->destroy();
+}
+
+void TestGraphOperations::testCloneAndDiff()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("name");
+    document->nodeTypes().first()->addDynamicProperty("obsolete");
+    document->edgeTypes().first()->addDynamicProperty("weight");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    nodeA->setDynamicProperty("name", "a");
+    nodeB->setDynamicProperty("obsolete", "b");
+    EdgePtr edgeAB = Edge::create(nodeA, nodeB);
+    edgeAB->setDynamicProperty("weight", 3);
+    EdgePtr parallelAB = Edge::create(nodeA, nodeB);
+    parallelAB->setDynamicProperty("weight", 5);
+    Edge::create(nodeB, nodeC);
+
+    // working copy contains equal elements with equal values at the same positions
+    GraphDiff diff(document);
+    GraphDocumentPtr copy = diff.workingCopy();
+    QCOMPARE(copy->nodes().count(), 3);
+    QCOMPARE(copy->edges().count(), 3);
+    QCOMPARE(copy->nodes().at(0)->id(), nodeA->id());
+    QCOMPARE(copy->nodes().at(0)->dynamicProperty("name").toString(), QString("a"));
+    QCOMPARE(copy->edges().at(0)->dynamicProperty("weight").toInt(), 3);
+    QCOMPARE(copy->nodes().at(1)->edges().count(), 3);
+    diff.update();
+    QVERIFY(diff.isEmpty());
+
+    // modifications of the working copy do not affect the original document
+    const NodePtr copyA = copy->nodes().at(0);
+    copyA->setDynamicProperty("name", "changed");
+    copy->nodes().at(2)->destroy();
+    copy->edges().at(1)->setDynamicProperty("weight", 7);
+    copy->nodeTypes().first()->removeDynamicProperty("obsolete");
+    NodePtr nodeD = Node::create(copy);
+    Edge::create(copyA, nodeD);
+    QCOMPARE(nodeA->dynamicProperty("name").toString(), QString("a"));
+    QCOMPARE(parallelAB->dynamicProperty("weight").toInt(), 5);
+    QCOMPARE(document->edges().count(), 3);
+
+    diff.update();
+    QVERIFY(!diff.isEmpty());
+    QCOMPARE(diff.changedNodes(), NodeList() << copyA);
+    QCOMPARE(diff.insertedNodes(), NodeList() << nodeD);
+    QCOMPARE(diff.removedNodes(), NodeList() << nodeC);
+    QCOMPARE(diff.insertedEdges().count(), 1);
+    QCOMPARE(diff.removedEdges().count(), 1);
+    QCOMPARE(diff.changedEdges(), EdgeList() << copy->edges().at(1));
+
+    // a node created concurrently in the document takes the identifier of the inserted node
+    NodePtr nodeE = Node::create(document);
+    QCOMPARE(nodeE->id(), nodeD->id());
+
+    diff.apply();
+    QCOMPARE(nodeA->dynamicProperty("name").toString(), QString("changed"));
+    QVERIFY(!nodeC->isValid());
+    QCOMPARE(edgeAB->dynamicProperty("weight").toInt(), 3);
+    QCOMPARE(parallelAB->dynamicProperty("weight").toInt(), 7);
+    QVERIFY(!document->nodeTypes().first()->dynamicProperties().contains("obsolete"));
+    QCOMPARE(document->nodes().count(), 4);
+    QCOMPARE(document->edges().count(), 3);
+    QCOMPARE(document->node(nodeE->id()), nodeE);
+    QSet<int> ids;
+    foreach (const NodePtr &node, document->nodes()) {
+        ids.insert(node->id());
+    }
+    QCOMPARE(ids.count(), 4);
+
+    document->destroy();
+}
+
 QTEST_MAIN(TestGraphOperations)
@@ -47,11 +47,22 @@ private Q_SLOTS:
     void testNodeDynamicProperties();
     void testEdgeDynamicProperties();
     void testNodeIdentifiers();
+    void testNodeLookup();
+    void testBulkUpdate();
+    void testRemoval();
+    void testModelRemoval();
     void testUnidirectionalEdges();
     void testBidirectionalEdges();
     void testEdgesOfDifferentType();
     void testEdgeDirectionChange();
+    void testEdgeTypeChange();
     void testDynamicPropertyRename();
+    void testDynamicPropertyTypeChange();
+    void testPropertyKeys();
+    void testSnapshot();
+    void testTypeChangeDispatch();
+    void testDocumentDiff();
+    void testCloneAndDiff();
 };
 
 #endif
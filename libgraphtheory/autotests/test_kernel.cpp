@@ -20,6 +20,7 @@
 
 #include "test_kernel.h"
 #include "libgraphtheory/kernel/kernel.h"
+#include "libgraphtheory/kernel/kernelexecution.h"
 #include "libgraphtheory/graphdocument.h"
 #include "libgraphtheory/nodetype.h"
 #include "libgraphtheory/edgetype.h"
@@ -27,6 +28,7 @@
 #include "libgraphtheory/edge.h"
 
 #include <QTest>
+#include <QtNumeric>
 
 void TestKernel::initTestCase()
 {
@@ -686,8 +688,540 @@ void TestKernel::distance()
     result = kernel.execute(document, script);
     QCOMPARE(result.toInteger(), qreal(2));
 
+    script = "Document.nodes()[0].distance(\"dist\", Document.nodes(), true)[2].path.length;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toInteger(), qreal(3));
+
+    script = "Document.nodes()[0].distance(\"dist\", Document.nodes(), true)[2].path[1].id;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toInteger(), qreal(nodeB->id()));
+
+    // wrappers of removed nodes and other values are rejected as targets
+    script = "var node = Document.createNode(0, 0); Document.remove(node);"
+             "Document.nodes()[0].distance(\"dist\", [Document.nodes()[1], node]);";
+    result = kernel.execute(document, script);
+    QVERIFY(result.isError());
+    QVERIFY(result.toString().contains("target 1"));
+    script = "Document.nodes()[0].distance(\"dist\", [5]);";
+    result = kernel.execute(document, script);
+    QVERIFY(result.isError());
+    QCOMPARE(document->nodes().count(), 3);
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::bulkAccess()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("value");
+    document->edgeTypes().first()->addDynamicProperty("weight");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    nodeA->setX(10);
+    nodeA->setY(20);
+    nodeB->setDynamicProperty("value", 5);
+    Edge::create(nodeC, nodeA)->setDynamicProperty("weight", 3);
+
+    Kernel kernel;
+    QString script;
+    QScriptValue result;
+
+    script = "var positions = Document.nodePositions(); positions.length + \",\" + positions[0] + \",\" + positions[1];";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toString(), QString("6,10,20"));
+
+    script = "var values = Document.nodeProperty(\"value\"); isNaN(values[0]) + \",\" + values[1];";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toString(), QString("true,5"));
+
+    script = "Document.edgeEndpoints().join(\",\") + \",\" + Document.edgeProperty(\"weight\")[0];";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toString(), QString("2,0,3"));
+
+    // write access
+    script = "Document.setNodePositions([1, 2, 3, 4, 5, 6]);"
+             "Document.setNodeProperty(\"value\", [0.5, 0.25, 0.25]);";
+    kernel.execute(document, script);
+    QCOMPARE(nodeC->x(), qreal(5));
+    QCOMPARE(nodeC->y(), qreal(6));
+    QCOMPARE(nodeA->dynamicProperty("value").toReal(), qreal(0.5));
+    QCOMPARE(nodeB->dynamicProperty("value").toReal(), qreal(0.25));
+
+    // properties that are not declared by the node type are rejected
+    script = "Document.setNodeProperty(\"rank\", [1, 2, 3]);";
+    kernel.execute(document, script);
+    QVERIFY(!document->nodeTypes().first()->dynamicProperties().contains("rank"));
+    QVERIFY(!nodeA->dynamicProperty("rank").isValid());
+
+    // arrays of wrong length are rejected
+    script = "Document.setNodePositions([1, 2]);";
+    kernel.execute(document, script);
+    QCOMPARE(nodeA->x(), qreal(1));
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::distanceMatrix()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->edgeTypes().first()->addDynamicProperty("dist");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    EdgePtr edgeAB = Edge::create(nodeA, nodeB);
+    EdgePtr edgeBC = Edge::create(nodeB, nodeC);
+    edgeAB->setDynamicProperty("dist", 1);
+    edgeBC->setDynamicProperty("dist", 1);
+
+    Kernel kernel;
+    QString script;
+    QScriptValue result;
+
+    script = "Document.distanceMatrix(\"dist\").distance(0, 2);";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toNumber(), qreal(2));
+    script = "Document.distanceMatrix(\"dist\").distance(2, 0);";
+    result = kernel.execute(document, script);
+    QVERIFY(qIsInf(result.toNumber()));
+    script = "Document.distanceMatrix(\"dist\").size;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toInteger(), qreal(3));
+
+    // cached matrix must follow changes of lengths and structure
+    edgeBC->setDynamicProperty("dist", 2);
+    script = "Document.distanceMatrix(\"dist\").distance(0, 2);";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toNumber(), qreal(3));
+    Edge::create(nodeC, nodeA)->setDynamicProperty("dist", 1);
+    script = "Document.distanceMatrix(\"dist\").distance(2, 1);";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toNumber(), qreal(2));
+
+    // blocked Floyd-Warshall for negative lengths must agree with single-source distances
+    GraphDocumentPtr chainDocument = GraphDocument::create();
+    chainDocument->edgeTypes().first()->addDynamicProperty("dist");
+    NodeList nodes;
+    for (int i = 0; i < 150; ++i) {
+        nodes.append(Node::create(chainDocument));
+    }
+    for (int i = 0; i < nodes.length(); ++i) {
+        if (i + 1 < nodes.length()) {
+            Edge::create(nodes.at(i), nodes.at(i + 1))->setDynamicProperty("dist", -1);
+        }
+        if (i + 7 < nodes.length()) {
+            Edge::create(nodes.at(i), nodes.at(i + 7))->setDynamicProperty("dist", -(i % 9));
+        }
+    }
+    script = "var matrix = Document.distanceMatrix(\"dist\");"
+             "var nodes = Document.nodes();"
+             "var mismatches = 0;"
+             "for (var i = 0; i < nodes.length; i += 13) {"
+             "    var distances = nodes[i].distance(\"dist\", nodes);"
+             "    for (var j = 0; j < nodes.length; ++j) {"
+             "        if (isFinite(matrix.distance(i, j)) != (distances[j] < 1e300)"
+             "            || (isFinite(matrix.distance(i, j)) && matrix.distance(i, j) != distances[j])) {"
+             "            ++mismatches;"
+             "        }"
+             "    }"
+             "}"
+             "mismatches;";
+    result = kernel.execute(chainDocument, script);
+    QCOMPARE(result.toInteger(), qreal(0));
+
+    // graphs whose matrix would not fit into memory are rejected before allocating it
+    GraphDocumentPtr largeDocument = GraphDocument::create();
+    {
+        BulkUpdateGuard bulkUpdate(largeDocument);
+        for (int i = 0; i <= 10000; ++i) {
+            Node::create(largeDocument);
+        }
+    }
+    script = "Document.distanceMatrix(\"dist\") === undefined;";
+    result = kernel.execute(largeDocument, script);
+    QVERIFY(result.toBool());
+
+    // cleanup
+    document->destroy();
+    chainDocument->destroy();
+    largeDocument->destroy();
+}
+
+void TestKernel::algorithms()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->edgeTypes().first()->addDynamicProperty("w");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    NodePtr nodeD = Node::create(document);
+    Edge::create(nodeA, nodeB)->setDynamicProperty("w", 1);
+    Edge::create(nodeB, nodeC)->setDynamicProperty("w", 1);
+    Edge::create(nodeA, nodeC)->setDynamicProperty("w", 5);
+    Edge::create(nodeC, nodeD)->setDynamicProperty("w", 1);
+
+    Kernel kernel;
+    QString script;
+    QScriptValue result;
+    const QString path = QString("%1,%2,%3,%4").arg(nodeA->id()).arg(nodeB->id()).arg(nodeC->id()).arg(nodeD->id());
+
+    // shortest paths
+    script = QString("Algorithms.dijkstra(%1, %2, \"w\").join(\",\");").arg(nodeA->id()).arg(nodeD->id());
+    QCOMPARE(kernel.execute(document, script).toString(), path);
+    script = QString("Algorithms.bellmanFord(%1, %2, \"w\").join(\",\");").arg(nodeA->id()).arg(nodeD->id());
+    QCOMPARE(kernel.execute(document, script).toString(), path);
+    script = QString("Algorithms.aStar(%1, %2, \"w\").join(\",\");").arg(nodeA->id()).arg(nodeD->id());
+    QCOMPARE(kernel.execute(document, script).toString(), path);
+    script = QString("Algorithms.dijkstra(%1, %2).length;").arg(nodeD->id()).arg(nodeA->id());
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(0));
+
+    // traversals and orders
+    script = QString("Algorithms.bfs(%1).length;").arg(nodeB->id());
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(3));
+    script = QString("Algorithms.dfs(%1).join(\",\");").arg(nodeA->id());
+    QCOMPARE(kernel.execute(document, script).toString().split(',').first().toInt(), nodeA->id());
+    script = "Algorithms.topologicalSort().join(\",\");";
+    QCOMPARE(kernel.execute(document, script).toString(), path);
+
+    // components
+    script = "Algorithms.connectedComponents().length;";
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(1));
+    script = "Algorithms.stronglyConnectedComponents().length;";
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(4));
+    script = "Algorithms.articulationPoints().join(\",\");";
+    QCOMPARE(kernel.execute(document, script).toString().toInt(), nodeC->id());
+    script = "Algorithms.bridges().length;";
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(1));
+
+    // spanning trees, flows and matchings
+    script = "Algorithms.kruskal(\"w\").length;";
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(3));
+    script = QString("Algorithms.prim(%1, \"w\").length;").arg(nodeD->id());
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(3));
+    script = QString("Algorithms.maxFlow(%1, %2, \"w\");").arg(nodeA->id()).arg(nodeC->id());
+    QCOMPARE(kernel.execute(document, script).toNumber(), qreal(6));
+    script = QString("Algorithms.minCut(%1, %2, \"w\").length;").arg(nodeA->id()).arg(nodeD->id());
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(1));
+    script = "Algorithms.bipartiteMatching().length;";
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(0));
+
+    // closing the cycle
+    Edge::create(nodeD, nodeA);
+    script = "Algorithms.topologicalSort().length;";
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(0));
+    script = "Algorithms.stronglyConnectedComponents().length;";
+    QCOMPARE(kernel.execute(document, script).toInteger(), qreal(1));
+
+    // edges without weight value have weight 0
+    Edge::create(nodeA, nodeD);
+    script = QString("Algorithms.dijkstra(%1, %2, \"w\").join(\",\");").arg(nodeA->id()).arg(nodeD->id());
+    QCOMPARE(kernel.execute(document, script).toString(), QString("%1,%2").arg(nodeA->id()).arg(nodeD->id()));
+
+    // matching on a path
+    GraphDocumentPtr pathDocument = GraphDocument::create();
+    NodePtr previous = Node::create(pathDocument);
+    for (int i = 0; i < 3; ++i) {
+        NodePtr next = Node::create(pathDocument);
+        Edge::create(previous, next);
+        previous = next;
+    }
+    script = "Algorithms.bipartiteMatching().length;";
+    QCOMPARE(kernel.execute(pathDocument, script).toInteger(), qreal(2));
+
+    // cleanup
+    document->destroy();
+    pathDocument->destroy();
+}
+
+void TestKernel::wrapperReuse()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("value");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    Edge::create(nodeA, nodeB);
+
+    Kernel kernel;
+    QString script;
+    QScriptValue result;
+
+    // changes done outside of scripts are visible to reused wrappers
+    nodeA->setDynamicProperty("value", 1);
+    script = "Document.nodes()[0].value = 2;";
+    kernel.execute(document, script);
+    QCOMPARE(nodeA->dynamicProperty("value").toInt(), 2);
+    nodeA->setDynamicProperty("value", 3);
+    script = "Document.nodes()[0].value;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toString().toInt(), 3);
+
+    // wrappers of removed nodes are released
+    script = "Document.remove(Document.nodes()[1]); Document.nodes().length;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toInteger(), qreal(1));
+    script = "Document.nodes()[0].edges().length;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toInteger(), qreal(0));
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::wrapperRelease()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    QWeakPointer<Edge> edge = Edge::create(nodeA, nodeB).toWeakRef();
+    QWeakPointer<Node> node = nodeB.toWeakRef();
+    nodeB.reset();
+
+    Kernel kernel;
+    QString script;
+    QScriptValue result;
+
+    // removed elements are freed right away, not after the run
+    script = "Document.remove(Document.nodes()[1]);";
+    kernel.execute(document, script);
+    QVERIFY(node.isNull());
+    QVERIFY(edge.isNull());
+
+    // script references to removed elements are invalidated but stay safe to use
+    script = "var n = Document.createNode(0, 0); Document.remove(n); Document.remove(n); n.id;";
+    result = kernel.execute(document, script);
+    QVERIFY(result.toString().contains("Error"));
+    QCOMPARE(document->nodes().count(), 1);
+
+    // build and delete cycles do not accumulate elements
+    script = "for (var i = 0; i < 100; ++i) {"
+             "    var a = Document.createNode(0, 0);"
+             "    var b = Document.createNode(0, 0);"
+             "    Document.createEdge(a, b);"
+             "    Document.remove(a);"
+             "    Document.remove(b);"
+             "}"
+             "Document.nodes().length + Document.edges().length;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toInteger(), qreal(1));
+
+    // wrappers kept between runs are released when their elements are removed outside of
+    // scripts, by single removals as well as by bulk updates
+    NodePtr nodeC = Node::create(document);
+    NodePtr nodeD = Node::create(document);
+    script = "Document.nodes()[1].id + Document.nodes()[2].id;";
+    kernel.execute(document, script);
+    node = nodeC.toWeakRef();
+    nodeC->destroy();
+    nodeC.reset();
+    QVERIFY(node.isNull());
+    node = nodeD.toWeakRef();
+    {
+        BulkUpdateGuard bulkUpdate(document);
+        nodeD->destroy();
+        nodeD.reset();
+    }
+    QVERIFY(node.isNull());
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::libraryScripts()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    Kernel kernel;
+    QScriptValue result;
+    KernelExecution *execution;
+
+    QVERIFY(!kernel.addLibrary("broken", "function broken( {"));
+    QVERIFY(kernel.addLibrary("counter", "var counter = 0; function count() { return ++counter; }"));
+    QCOMPARE(kernel.libraries(), QStringList() << "counter");
+
+    // libraries are only evaluated once per engine, script variables do not persist
+    result = kernel.execute(document, "var local = 1; count();");
+    QCOMPARE(result.toInteger(), qreal(1));
+    result = kernel.execute(document, "count() + (typeof local == 'undefined' ? 0 : 10);");
+    QCOMPARE(result.toInteger(), qreal(2));
+
+    // engines of asynchronous executions are reused as well
+    execution = kernel.executeAsync(document, "var local = 1; count();");
+    execution->waitForFinished();
+    QCOMPARE(execution->result(), QString("1"));
+    delete execution;
+    execution = kernel.executeAsync(document, "count() + (typeof local == 'undefined' ? 0 : 10);");
+    execution->waitForFinished();
+    QCOMPARE(execution->result(), QString("2"));
+    delete execution;
+
+    // errors of scripts do not discard the engine
+    execution = kernel.executeAsync(document, "count(); undefinedFunction();");
+    execution->waitForFinished();
+    QVERIFY(execution->hasError());
+    delete execution;
+    execution = kernel.executeAsync(document, "count();");
+    execution->waitForFinished();
+    QCOMPARE(execution->result(), QString("4"));
+    delete execution;
+
+    // changed libraries are evaluated by fresh engines
+    kernel.removeLibrary("counter");
+    QVERIFY(kernel.libraries().isEmpty());
+    result = kernel.execute(document, "typeof count;");
+    QCOMPARE(result.toString(), QString("undefined"));
+    execution = kernel.executeAsync(document, "typeof count;");
+    execution->waitForFinished();
+    QCOMPARE(execution->result(), QString("undefined"));
+    delete execution;
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::messageBatching()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    Kernel kernel;
+    int batches = 0;
+    int batchedMessages = 0;
+    Kernel::MessageList lastBatch;
+    connect(&kernel, &Kernel::messagesBatched, [&](const Kernel::MessageList &batch) {
+        ++batches;
+        batchedMessages += batch.count();
+        lastBatch = batch;
+    });
+    const QString script = "for (var i = 0; i < 1000; ++i) { Console.log(i); }";
+    kernel.execute(document, script);
+
+    // every message is delivered once in a batch and all batches are delivered after execution
+    QVERIFY(batchedMessages > 1000);
+    QVERIFY(batches >= 1);
+    QVERIFY(batches < 1000);
+
+    // messages of asynchronous executions are batched by the execution, in order and
+    // followed by the status messages
+    batches = 0;
+    batchedMessages = 0;
+    KernelExecution *execution = kernel.executeAsync(document, script);
+    execution->waitForFinished();
+    QVERIFY(batchedMessages > 1000);
+    QVERIFY(batches >= 1);
+    QVERIFY(batches < 1000);
+    QCOMPARE(lastBatch.first().second, QString("0"));
+    QCOMPARE(lastBatch.at(999).second, QString("999"));
+    delete execution;
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::profiling()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    Node::create(document);
+    Node::create(document);
+
+    Kernel kernel;
+    QVERIFY(!kernel.isProfilingEnabled());
+    kernel.setProfilingEnabled(true);
+    kernel.execute(document, "for (var i = 0; i < 3; ++i) { Document.nodes(); }");
+
+    const KernelProfile profile = kernel.profile();
+    QVERIFY(profile.totalTime() > 0);
+    QVERIFY(profile.nativeTime() <= profile.totalTime());
+    bool found = false;
+    foreach (const KernelProfile::Entry &entry, profile.entries()) {
+        if (entry.function == "DocumentWrapper.nodes") {
+            QCOMPARE(entry.calls, 3);
+            found = true;
+        }
+    }
+    QVERIFY(found);
+    QVERIFY(profile.summary().contains("DocumentWrapper.nodes"));
+
+    // asynchronous executions are profiled by their own engine
+    KernelExecution *execution = kernel.executeAsync(document, "Document.nodes(); Document.nodes();");
+    execution->waitForFinished();
+    QVERIFY(execution->isProfiled());
+    found = false;
+    foreach (const KernelProfile::Entry &entry, kernel.profile().entries()) {
+        if (entry.function == "DocumentWrapper.nodes") {
+            QCOMPARE(entry.calls, 2);
+            found = true;
+        }
+    }
+    QVERIFY(found);
+    delete execution;
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::asyncExecution()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("value");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    Edge::create(nodeA, nodeB);
+
+    Kernel kernel;
+    QString script;
+    KernelExecution *execution;
+
+    // changes are applied after the execution finished
+    script = "var node = Document.createNode(0, 0); Document.nodes()[0].value = 5; Console.progress(50); Document.nodes().length;";
+    execution = kernel.executeAsync(document, script);
+    execution->waitForFinished();
+    QVERIFY(execution->isFinished());
+    QVERIFY(!execution->hasError());
+    QCOMPARE(execution->result(), QString("3"));
+    QCOMPARE(document->nodes().count(), 3);
+    QCOMPARE(nodeA->dynamicProperty("value").toInt(), 5);
+    QCOMPARE(document->edges().count(), 1);
+    delete execution;
+
+    // changes of canceled executions are discarded
+    script = "Document.remove(Document.nodes()[0]); while (true) {}";
+    execution = kernel.executeAsync(document, script);
+    execution->cancel();
+    execution->waitForFinished();
+    QVERIFY(execution->isCanceled());
+    QCOMPARE(document->nodes().count(), 3);
+    delete execution;
+
+    // wrappers are kept per document between executions, unregistered script properties
+    // only exist at the wrapper
+    GraphDocumentPtr otherDocument = GraphDocument::create();
+    Node::create(otherDocument);
+    script = "Document.nodes()[0].marker = 7;";
+    kernel.execute(otherDocument, script);
+    execution = kernel.executeAsync(document, script);
+    execution->waitForFinished();
+    delete execution;
+    script = "Document.nodes()[0].marker;";
+    execution = kernel.executeAsync(otherDocument, script);
+    execution->waitForFinished();
+    QCOMPARE(execution->result(), QString("7"));
+    delete execution;
+    execution = kernel.executeAsync(document, script);
+    execution->waitForFinished();
+    QCOMPARE(execution->result(), QString("7"));
+    delete execution;
+
+    // wrappers of nodes removed by the script are released after the changes are applied
+    QWeakPointer<Node> removedNode = nodeA.toWeakRef();
+    nodeA.reset();
+    script = "Document.remove(Document.nodes()[0]);";
+    execution = kernel.executeAsync(document, script);
+    execution->waitForFinished();
+    delete execution;
+    QVERIFY(removedNode.isNull());
+
     // cleanup
     document->destroy();
+    otherDocument->destroy();
 }
 
 QTEST_MAIN(TestKernel)
@@ -79,6 +79,24 @@ private Q_SLOTS:
     void deleteEdge();
     /** test Node::distance function **/
     void distance();
+    /** test bulk accessors of the document **/
+    void bulkAccess();
+    /** test Document.distanceMatrix function **/
+    void distanceMatrix();
+    /** test native graph algorithms **/
+    void algorithms();
+    /** test that wrappers are kept and updated between script runs **/
+    void wrapperReuse();
+    /** test that wrappers of removed elements are released during script runs **/
+    void wrapperRelease();
+    /** test batched delivery of messages **/
+    void messageBatching();
+    /** test library scripts that are kept between executions **/
+    void libraryScripts();
+    /** test profiling of script executions **/
+    void profiling();
+    /** test asynchronous execution and its cancellation **/
+    void asyncExecution();
 };
 
 #endif
@@ -40,6 +40,7 @@ void TestKernelScriptApi::xmlValidity()
     QVERIFY(schema.load(QUrl::fromLocalFile("kernelapi/kernelapi.xsd")));
 
     QXmlSchemaValidator validator(schema);
+    QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/algorithms.xml")));
     QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/console.xml")));
     QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/document.xml")));
     QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/node.xml")));
@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "distancematrix_p.h"
+#include "graphsnapshot.h"
+#include "shortestpaths_p.h"
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QtMath>
+#include <functional>
+#include <limits>
+
+using namespace GraphTheory;
+
+namespace {
+const qreal infinity = std::numeric_limits<qreal>::infinity();
+
+// edge length of the square blocks of Floyd-Warshall, 64x64 distances fit into the L1 cache
+const int blockSize = 64;
+
+class Task : public QRunnable
+{
+public:
+    explicit Task(const std::function<void()> &function)
+        : m_function(function)
+    {
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        m_function();
+    }
+
+private:
+    std::function<void()> m_function;
+};
+
+/**
+ * Call @p function for all indices from 0 to @p count-1 on the threads of @p pool and return
+ * when all calls are finished.
+ */
+void parallelFor(QThreadPool &pool, int count, const std::function<void(int)> &function)
+{
+    if (count == 1) {
+        function(0);
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        pool.start(new Task([&function, i]() {
+            function(i);
+        }));
+    }
+    pool.waitForDone();
+}
+
+/**
+ * Relax all distances in block (@p rowBlock, @p columnBlock) over the intermediate nodes of
+ * block @p pivotBlock, for the @p n x @p n matrix @p distances.
+ */
+void relaxBlock(qreal *distances, int n, int rowBlock, int columnBlock, int pivotBlock)
+{
+    const int rowEnd = qMin(n, (rowBlock + 1) * blockSize);
+    const int columnBegin = columnBlock * blockSize;
+    const int columnEnd = qMin(n, columnBegin + blockSize);
+    const int pivotEnd = qMin(n, (pivotBlock + 1) * blockSize);
+    for (int k = pivotBlock * blockSize; k < pivotEnd; ++k) {
+        const qreal *rowK = distances + qint64(k) * n;
+        for (int i = rowBlock * blockSize; i < rowEnd; ++i) {
+            qreal *rowI = distances + qint64(i) * n;
+            const qreal distanceIK = rowI[k];
+            if (distanceIK == infinity) {
+                continue;
+            }
+            // branch-free inner loop over contiguous memory, which compilers vectorize
+            for (int j = columnBegin; j < columnEnd; ++j) {
+                const qreal candidate = distanceIK + rowK[j];
+                rowI[j] = candidate < rowI[j] ? candidate : rowI[j];
+            }
+        }
+    }
+}
+}
+
+const int DistanceMatrix::maximumSize;
+
+DistanceMatrix::DistanceMatrix()
+    : m_size(0)
+    , m_negativeCycle(false)
+{
+}
+
+DistanceMatrix::DistanceMatrix(const GraphSnapshot &graph, const QVector<qreal> &weights)
+    : m_size(graph.nodeCount())
+    , m_negativeCycle(false)
+    , m_offsets(graph.offsets())
+    , m_targets(graph.targets())
+    , m_edges(graph.edges())
+    , m_weights(weights)
+{
+    Q_ASSERT(weights.size() == graph.edgeCount());
+    Q_ASSERT(m_size <= maximumSize);
+
+    // repeated Dijkstra needs O(n*m*log(n)) steps and Floyd-Warshall O(n^3)
+    const qreal n = m_size;
+    if (!ShortestPaths::hasNegativeWeight(weights) && m_targets.size() * qLn(n + 1) / qLn(2) < n * n) {
+        computeDijkstra(graph);
+    } else {
+        computeFloydWarshall();
+    }
+}
+
+int DistanceMatrix::size() const
+{
+    return m_size;
+}
+
+bool DistanceMatrix::hasNegativeCycle() const
+{
+    return m_negativeCycle;
+}
+
+qreal DistanceMatrix::distance(int from, int to) const
+{
+    return m_distances.constData()[qint64(from) * m_size + to];
+}
+
+bool DistanceMatrix::isValidFor(const GraphSnapshot &graph, const QVector<qreal> &weights) const
+{
+    return graph.nodeCount() == m_size
+        && graph.offsets() == m_offsets
+        && graph.targets() == m_targets
+        && graph.edges() == m_edges
+        && weights == m_weights;
+}
+
+void DistanceMatrix::computeDijkstra(const GraphSnapshot &graph)
+{
+    m_distances.resize(m_size * m_size); // fits into int for at most maximumSize nodes
+    qreal *distances = m_distances.data();
+    const int threads = qMax(1, QThread::idealThreadCount());
+    const int chunk = (m_size + threads - 1) / threads;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    parallelFor(pool, qMin(threads, m_size), [&](int task) {
+        const int end = qMin(m_size, (task + 1) * chunk);
+        for (int source = task * chunk; source < end; ++source) {
+            const ShortestPaths paths(graph, m_weights, source);
+            qreal *row = distances + qint64(source) * m_size;
+            for (int target = 0; target < m_size; ++target) {
+                row[target] = paths.distance(target);
+            }
+        }
+    });
+}
+
+void DistanceMatrix::computeFloydWarshall()
+{
+    const int n = m_size;
+    m_distances.fill(infinity, n * n);
+    qreal *distances = m_distances.data();
+    for (int i = 0; i < n; ++i) {
+        qreal *row = distances + qint64(i) * n;
+        row[i] = 0;
+        for (int a = m_offsets.at(i); a < m_offsets.at(i + 1); ++a) {
+            qreal &entry = row[m_targets.at(a)];
+            entry = qMin(entry, m_weights.at(m_edges.at(a)));
+        }
+    }
+
+    const int blocks = (n + blockSize - 1) / blockSize;
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+    for (int pivot = 0; pivot < blocks; ++pivot) {
+        // the pivot block only depends on itself
+        relaxBlock(distances, n, pivot, pivot, pivot);
+        if (blocks == 1) {
+            break;
+        }
+
+        // blocks in pivot row and column depend on the pivot block and themselves
+        parallelFor(pool, blocks, [=](int block) {
+            if (block != pivot) {
+                relaxBlock(distances, n, pivot, block, pivot);
+                relaxBlock(distances, n, block, pivot, pivot);
+            }
+        });
+
+        // all other blocks depend on the pivot row and column, each task updates one block row
+        parallelFor(pool, blocks, [=](int rowBlock) {
+            if (rowBlock == pivot) {
+                return;
+            }
+            for (int columnBlock = 0; columnBlock < blocks; ++columnBlock) {
+                if (columnBlock != pivot) {
+                    relaxBlock(distances, n, rowBlock, columnBlock, pivot);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (distances[qint64(i) * n + i] < 0) {
+            m_negativeCycle = true;
+            break;
+        }
+    }
+}
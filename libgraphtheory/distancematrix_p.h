@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DISTANCEMATRIX_P_H
+#define DISTANCEMATRIX_P_H
+
+#include <QVector>
+
+namespace GraphTheory
+{
+class GraphSnapshot;
+
+/**
+ * \class DistanceMatrix
+ *
+ * All-pairs shortest path distances of a GraphSnapshot, stored row by row in one contiguous
+ * buffer. Sparse graphs without negative weights are computed by Dijkstra's algorithm from
+ * every node, all other graphs by a cache-blocked Floyd-Warshall algorithm. Both run on all
+ * available cores.
+ *
+ * The matrix remembers the structure and weights it was computed for, such that a cached
+ * matrix can be validated against a new snapshot in linear time.
+ */
+class DistanceMatrix
+{
+public:
+    /**
+     * Largest supported number of nodes. The matrix of this size needs 800 MB, callers must
+     * reject larger graphs before computing a matrix.
+     */
+    static const int maximumSize = 10000;
+
+    /**
+     * Creates an empty matrix.
+     */
+    DistanceMatrix();
+
+    /**
+     * Compute all distances of @p graph with edge weights @p weights given by edge index.
+     * The graph must not have more than maximumSize nodes.
+     */
+    DistanceMatrix(const GraphSnapshot &graph, const QVector<qreal> &weights);
+
+    /**
+     * @return number of rows and columns, which is the number of nodes
+     */
+    int size() const;
+
+    /**
+     * @return true if the graph contains a cycle of negative weight, in which case the
+     * distances are meaningless
+     */
+    bool hasNegativeCycle() const;
+
+    /**
+     * @return distance from node index @p from to node index @p to, infinity if not reachable
+     */
+    qreal distance(int from, int to) const;
+
+    /**
+     * @return true if the matrix was computed for the same structure and weights as given by
+     * @p graph and @p weights
+     */
+    bool isValidFor(const GraphSnapshot &graph, const QVector<qreal> &weights) const;
+
+private:
+    void computeDijkstra(const GraphSnapshot &graph);
+    void computeFloydWarshall();
+
+    int m_size;
+    bool m_negativeCycle;
+    QVector<qreal> m_distances;
+
+    // input of the computation
+    QVector<int> m_offsets;
+    QVector<int> m_targets;
+    QVector<int> m_edges;
+    QVector<qreal> m_weights;
+};
+}
+
+#endif
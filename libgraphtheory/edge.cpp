@@ -20,6 +20,8 @@
 
 #include "edge.h"
 #include "edgetypestyle.h"
+#include "propertytable_p.h"
+#include "elementpool_p.h"
 #include "logging_p.h"
 #include <QVariant>
 
@@ -28,10 +30,15 @@ using namespace GraphTheory;
 // initialize number of edge objects
 uint Edge::objectCounter = 0;
 
+// memory pool for edge objects
+Q_GLOBAL_STATIC_WITH_ARGS(ElementPool, edgePool, (sizeof(Edge)))
+
 class GraphTheory::EdgePrivate {
 public:
     EdgePrivate()
         : m_valid(false)
+        , m_documentIndex(-1)
+        , m_propertyRow(-1)
     {
     }
 
@@ -39,13 +46,36 @@ public:
     {
     }
 
+    static void * operator new(std::size_t size);
+    static void operator delete(void *pointer, std::size_t size);
+
     EdgePtr q;
     NodePtr m_from;
     NodePtr m_to;
     EdgeTypePtr m_type;
     bool m_valid;
+    int m_documentIndex;
+    int m_propertyRow; // row of the values in the property table of the type
 };
 
+Q_GLOBAL_STATIC_WITH_ARGS(ElementPool, edgePrivatePool, (sizeof(EdgePrivate)))
+
+void * EdgePrivate::operator new(std::size_t size)
+{
+    if (edgePrivatePool.isDestroyed()) {
+        return ::operator new(size);
+    }
+    return edgePrivatePool->allocate(size);
+}
+
+void EdgePrivate::operator delete(void *pointer, std::size_t size)
+{
+    // after the pool is destroyed at shutdown, its memory is released by the system
+    if (!edgePrivatePool.isDestroyed()) {
+        edgePrivatePool->deallocate(pointer, size);
+    }
+}
+
 Edge::Edge()
     : QObject()
     , d(new EdgePrivate)
@@ -55,9 +85,28 @@ Edge::Edge()
 
 Edge::~Edge()
 {
+    if (d->m_type) {
+        d->m_type->propertyTable()->removeRow(d->m_propertyRow);
+    }
     --Edge::objectCounter;
 }
 
+void * Edge::operator new(std::size_t size)
+{
+    if (edgePool.isDestroyed()) {
+        return ::operator new(size);
+    }
+    return edgePool->allocate(size);
+}
+
+void Edge::operator delete(void *pointer, std::size_t size)
+{
+    // after the pool is destroyed at shutdown, its memory is released by the system
+    if (!edgePool.isDestroyed()) {
+        edgePool->deallocate(pointer, size);
+    }
+}
+
 EdgePtr Edge::create(NodePtr from, NodePtr to)
 {
     Q_ASSERT(from);
@@ -78,6 +127,24 @@ EdgePtr Edge::create(NodePtr from, NodePtr to)
     return pi;
 }
 
+EdgePtr Edge::clone(NodePtr from, NodePtr to, EdgeTypePtr type) const
+{
+    EdgePtr pi(new Edge);
+    pi->setQpointer(pi);
+    pi->d->m_from = from;
+    pi->d->m_to = to;
+    // values are located at the same row of the copied property table
+    pi->d->m_type = type;
+    pi->d->m_propertyRow = d->m_propertyRow;
+
+    to->insert(pi->d->q);
+    from->insert(pi->d->q);
+    to->document()->insert(pi->d->q);
+    pi->d->m_valid = true;
+
+    return pi;
+}
+
 EdgePtr Edge::self() const
 {
     return d->q;
@@ -121,39 +188,62 @@ void Edge::setType(EdgeTypePtr type)
     if (d->m_type == type) {
         return;
     }
-    if (d->m_type) {
-        d->m_type->disconnect(this);
-        d->m_type->style()->disconnect(this);
-    }
+    EdgeTypePtr previousType = d->m_type;
     d->m_type = type;
-    connect(type.data(), &EdgeType::dynamicPropertyAboutToBeAdded,
-        this, &Edge::dynamicPropertyAboutToBeAdded);
-    connect(type.data(), &EdgeType::dynamicPropertyAdded,
-        this, &Edge::dynamicPropertyAdded);
-    connect(type.data(), &EdgeType::dynamicPropertiesAboutToBeRemoved,
-        this, &Edge::dynamicPropertiesAboutToBeRemoved);
-    connect(type.data(), &EdgeType::dynamicPropertyRemoved,
-        this, &Edge::dynamicPropertyRemoved);
-    connect(type.data(), &EdgeType::dynamicPropertyRemoved,
-        this, &Edge::updateDynamicProperty);
-    connect(type.data(), &EdgeType::directionChanged,
-        this, &Edge::directionChanged);
-    connect(type.data(), &EdgeType::dynamicPropertyRenamed,
-        this, &Edge::renameDynamicProperty);
-    connect(type->style(), &EdgeTypeStyle::changed,
-        this, &Edge::styleChanged);
+
+    // allocate row in property table of the new type and keep values of properties that are
+    // registered at both types
+    const int previousRow = d->m_propertyRow;
+    d->m_propertyRow = type->propertyTable()->insertRow();
+    if (previousType) {
+        const QStringList previousProperties = previousType->dynamicProperties();
+        const QStringList properties = type->dynamicProperties();
+        for (int i = 0; i < previousProperties.length(); ++i) {
+            const int column = properties.indexOf(previousProperties.at(i));
+            if (column >= 0) {
+                type->propertyTable()->setValue(column, d->m_propertyRow,
+                    previousType->propertyTable()->value(i, previousRow));
+            }
+        }
+        previousType->propertyTable()->removeRow(previousRow);
+
+        // move edge to the new type at its end points
+        d->m_from->updateEdgeType(d->q, previousType);
+        d->m_to->updateEdgeType(d->q, previousType);
+    }
 
     emit typeChanged(type);
-    emit styleChanged();
 }
 
 QVariant Edge::dynamicProperty(const QString &property) const
 {
-    return Edge::property(("_graph_" + property).toLatin1());
+    if (!d->m_type) {
+        return QVariant();
+    }
+    const int column = d->m_type->dynamicProperties().indexOf(property);
+    if (column < 0) {
+        return QVariant();
+    }
+    return d->m_type->propertyTable()->value(column, d->m_propertyRow);
+}
+
+QVariant Edge::dynamicProperty(const PropertyKey &key) const
+{
+    if (!d->m_type) {
+        return QVariant();
+    }
+    const int column = d->m_type->dynamicPropertyIndex(key);
+    if (column < 0) {
+        return QVariant();
+    }
+    return d->m_type->propertyTable()->value(column, d->m_propertyRow);
 }
 
 QStringList Edge::dynamicProperties() const
 {
+    if (!d->m_type) {
+        return QStringList();
+    }
     return d->m_type->dynamicProperties();
 }
 
@@ -161,28 +251,43 @@ void Edge::setDynamicProperty(const QString &property, const QVariant &value)
 {
     if (!d->m_type) {
         qCWarning(GRAPHTHEORY_GENERAL) << "No type registered, aborting to set property.";
+        return;
     }
-    if (value.isValid() && !d->m_type->dynamicProperties().contains(property)) {
-        qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+    const int column = d->m_type->dynamicProperties().indexOf(property);
+    if (column < 0) {
+        if (value.isValid()) {
+            qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+        }
+        return;
     }
-    setProperty(("_graph_" + property).toLatin1(), value);
-    emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(property));
+    d->m_type->propertyTable()->setValue(column, d->m_propertyRow, value);
+    emit dynamicPropertyChanged(column);
 }
 
-void Edge::updateDynamicProperty(const QString &property)
+void Edge::setDynamicProperty(const PropertyKey &key, const QVariant &value)
 {
-    // remove property if not registered at type
-    if (!d->m_type->dynamicProperties().contains(property)) {
-        setDynamicProperty(property, QVariant::Invalid);
+    if (!d->m_type) {
+        qCWarning(GRAPHTHEORY_GENERAL) << "No type registered, aborting to set property.";
+        return;
     }
-
-    emit dynamicPropertiesChanged();
+    const int column = d->m_type->dynamicPropertyIndex(key);
+    if (column < 0) {
+        if (value.isValid()) {
+            qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+        }
+        return;
+    }
+    d->m_type->propertyTable()->setValue(column, d->m_propertyRow, value);
+    emit dynamicPropertyChanged(column);
 }
 
 void Edge::renameDynamicProperty(const QString &oldProperty, const QString &newProperty)
 {
-    setDynamicProperty(newProperty, dynamicProperty(oldProperty));
-    setDynamicProperty(oldProperty, QVariant::Invalid);
+    // the renamed property keeps its column in the property table, thus the value is preserved
+    Q_UNUSED(oldProperty);
+    if (!d->m_type) {
+        return;
+    }
     emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(newProperty));
 }
 
@@ -190,3 +295,18 @@ void Edge::setQpointer(EdgePtr q)
 {
     d->q = q;
 }
+
+int Edge::documentIndex() const
+{
+    return d->m_documentIndex;
+}
+
+void Edge::setDocumentIndex(int index)
+{
+    d->m_documentIndex = index;
+}
+
+int Edge::propertyRow() const
+{
+    return d->m_propertyRow;
+}
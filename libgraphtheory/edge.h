@@ -23,11 +23,13 @@
 
 #include "graphtheory_export.h"
 #include "typenames.h"
+#include "propertykey.h"
 #include "edgetype.h"
 #include "node.h"
 
 #include <QObject>
 #include <QSharedPointer>
+#include <cstddef>
 
 namespace GraphTheory
 {
@@ -40,7 +42,7 @@ class EdgePrivate;
 class GRAPHTHEORY_EXPORT Edge : public QObject
 {
     Q_OBJECT
-    Q_PROPERTY(QStringList dynamicProperties READ dynamicProperties NOTIFY dynamicPropertiesChanged)
+    Q_PROPERTY(QStringList dynamicProperties READ dynamicProperties)
 
 public:
     /**
@@ -56,6 +58,13 @@ public:
     /** Destroys the edge */
     virtual ~Edge();
 
+    /**
+     * Edges are allocated from a shared pool, such that large numbers of edges are stored
+     * contiguously and without per-object allocation overhead.
+     */
+    static void * operator new(std::size_t size);
+    static void operator delete(void *pointer, std::size_t size);
+
     /**
      * @return shared pointer to object
      */
@@ -105,6 +114,13 @@ public:
      */
     QVariant dynamicProperty(const QString &property) const;
 
+    /**
+     * Fast variant of dynamicProperty() for properties identified by @p key.
+     *
+     * @return return value of dynamic property, value is QVariant::Invalid if it is not set
+     */
+    QVariant dynamicProperty(const PropertyKey &key) const;
+
     /**
      * @return list of dynamic properties registered at edge type
      */
@@ -112,8 +128,8 @@ public:
 
     /**
      * Set dynamic property with identifier @c property. If @c value is
-     * QVariant::Invalid, the dynamic property is unset. Internally, this
-     * method use the QObject::setProperty mechanism but prefixes properties to avoid name clashes.
+     * QVariant::Invalid, the dynamic property is unset. The property must be registered at
+     * the edge type; values are stored in the property table of the type.
      *
      * @param property is the identifier for the new property
      * @param value is the value of this property
@@ -121,7 +137,17 @@ public:
     void setDynamicProperty(const QString &property, const QVariant &value);
 
     /**
-     * Rename dynamic property from identifier @c oldProperty to @c newProperty.
+     * Fast variant of setDynamicProperty() for properties identified by @p key. The property
+     * must be registered at the edge type.
+     *
+     * @param key is the key of the property
+     * @param value is the value of this property
+     */
+    void setDynamicProperty(const PropertyKey &key, const QVariant &value);
+
+    /**
+     * Rename dynamic property from identifier @c oldProperty to @c newProperty. The rename must
+     * already be performed at the edge type, the value of the property is preserved.
      *
      * @param oldProperty the former value of the property
      * @param newProperty the new value of the property
@@ -140,22 +166,12 @@ public:
 
 Q_SIGNALS:
     void typeChanged(EdgeTypePtr type);
-    void directionChanged(EdgeType::Direction direction);
-    void dynamicPropertyAboutToBeAdded(const QString&, int);
-    void dynamicPropertyAdded();
-    void dynamicPropertiesAboutToBeRemoved(int, int);
-    void dynamicPropertyRemoved();
-    void dynamicPropertyChanged(int index);
-    /** list of dynamic properties changed **/
-    void dynamicPropertiesChanged();
     /**
-     * signal is emitted whenever a style property changed. Use typeChanged() to get informed
-     * about a change of the style object.
+     * signal is emitted whenever the value of the dynamic property in column @p index of the
+     * property table changed. Changes of the property list, the direction or the style are only
+     * signaled by the edge type, which notifies its subscribers once for all of its edges.
      **/
-    void styleChanged();
-
-private Q_SLOTS:
-    void updateDynamicProperty(const QString &property);
+    void dynamicPropertyChanged(int index);
 
 protected:
     Edge();
@@ -164,7 +180,25 @@ private:
     Q_DISABLE_COPY(Edge)
     const QScopedPointer<EdgePrivate> d;
     void setQpointer(EdgePtr q);
+    /**
+     * Create copy of this edge of type @p type between @p from and @p to and insert it into
+     * the nodes and their document. The property table of @p type must be a copy of the table
+     * of the type of this edge.
+     */
+    EdgePtr clone(NodePtr from, NodePtr to, EdgeTypePtr type) const;
+    /**
+     * Position of the edge in the list of the document or -1 if the edge is not
+     * contained in the document. Only maintained by GraphDocument.
+     */
+    int documentIndex() const;
+    void setDocumentIndex(int index);
+    /**
+     * @return row of the values of this edge in the property table of its type
+     */
+    int propertyRow() const;
     static uint objectCounter;
+    friend class GraphDocument;
+    friend class GraphDiffPrivate;
 };
 }
 
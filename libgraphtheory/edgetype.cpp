@@ -21,6 +21,7 @@
 #include "edgetype.h"
 #include "edgetypestyle.h"
 #include "graphdocument.h"
+#include "propertytable_p.h"
 #include <QDebug>
 
 using namespace GraphTheory;
@@ -45,10 +46,24 @@ public:
         m_style->deleteLater();
     }
 
+    void updatePropertyKeys()
+    {
+        m_propertyKeys.fill(-1);
+        for (int i = 0; i < m_dynamicProperties.length(); ++i) {
+            const int id = PropertyKey(m_dynamicProperties.at(i)).id();
+            while (m_propertyKeys.length() <= id) {
+                m_propertyKeys.append(-1);
+            }
+            m_propertyKeys[id] = i;
+        }
+    }
+
     EdgeTypePtr q;
     GraphDocumentPtr m_document;
     int m_id;
     QStringList m_dynamicProperties;
+    PropertyTable m_propertyTable; // values of dynamic properties of all elements
+    QVector<int> m_propertyKeys; // index of dynamic property by property key identifier
     EdgeTypeStyle *m_style;
     EdgeType::Direction m_direction;
     QString m_name;
@@ -142,13 +157,23 @@ QStringList EdgeType::dynamicProperties() const
     return d->m_dynamicProperties;
 }
 
+int EdgeType::dynamicPropertyIndex(const PropertyKey &key) const
+{
+    if (!key.isValid() || key.id() >= d->m_propertyKeys.length()) {
+        return -1;
+    }
+    return d->m_propertyKeys.at(key.id());
+}
+
 void EdgeType::addDynamicProperty(const QString& property)
 {
     if (d->m_dynamicProperties.contains(property)) {
         return;
     }
     emit dynamicPropertyAboutToBeAdded(property, d->m_dynamicProperties.count());
+    d->m_propertyTable.insertColumn(d->m_dynamicProperties.count());
     d->m_dynamicProperties.append(property);
+    d->updatePropertyKeys();
     emit dynamicPropertyAdded();
 }
 
@@ -159,7 +184,9 @@ void EdgeType::removeDynamicProperty(const QString& property)
     }
     int index = d->m_dynamicProperties.indexOf(property);
     emit dynamicPropertiesAboutToBeRemoved(index, index);
-    d->m_dynamicProperties.removeOne(property);
+    d->m_propertyTable.removeColumn(index);
+    d->m_dynamicProperties.removeAt(index);
+    d->updatePropertyKeys();
     emit dynamicPropertyRemoved(property);
 }
 
@@ -173,6 +200,7 @@ void EdgeType::renameDynamicProperty(const QString& oldProperty, const QString&
     }
     int index = d->m_dynamicProperties.indexOf(oldProperty);
     d->m_dynamicProperties[index] = newProperty;
+    d->updatePropertyKeys();
     emit dynamicPropertyRenamed(oldProperty, newProperty);
     emit dynamicPropertyChanged(index);
 }
@@ -195,3 +223,8 @@ void EdgeType::setQpointer(EdgeTypePtr q)
 {
     d->q = q;
 }
+
+PropertyTable * EdgeType::propertyTable() const
+{
+    return &d->m_propertyTable;
+}
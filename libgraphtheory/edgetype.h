@@ -23,6 +23,7 @@
 
 #include "graphtheory_export.h"
 #include "typenames.h"
+#include "propertykey.h"
 
 #include <QObject>
 #include <QSharedPointer>
@@ -32,6 +33,7 @@ namespace GraphTheory
 
 class EdgeTypePrivate;
 class EdgeTypeStyle;
+class PropertyTable;
 
 /**
  * \class Edge
@@ -91,6 +93,14 @@ public:
      */
     QStringList dynamicProperties() const;
 
+    /**
+     * Look up the position of the dynamic property with key @p key in dynamicProperties()
+     * without comparing strings.
+     *
+     * @return index of the property or -1 if the property is not registered at this type
+     */
+    int dynamicPropertyIndex(const PropertyKey &key) const;
+
     /**
      * Add dynamic property @c property to list of dynamic properties.
      * Signal dynamicPropertyAdded(@c property) is emitted afterwards
@@ -173,7 +183,14 @@ private:
     Q_DISABLE_COPY(EdgeType)
     const QScopedPointer<EdgeTypePrivate> d;
     void setQpointer(EdgeTypePtr q);
+    /**
+     * @return storage of the dynamic property values of all edges of this type
+     */
+    PropertyTable * propertyTable() const;
     static uint objectCounter;
+    friend class Edge;
+    friend class GraphDocument;
+    friend class GraphDiffPrivate;
 };
 }
 
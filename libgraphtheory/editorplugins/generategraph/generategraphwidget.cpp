@@ -187,6 +187,8 @@ void GenerateGraphWidget::generateGraph()
 {
     setGraphIdentifier(ui->identifier->text());
 
+    // notify views only once about all created elements
+    BulkUpdateGuard bulkUpdate(m_document);
     switch (m_graphGenerator) {
     case MeshGraph:
         generateMesh(ui->meshRows->value(), ui->meshColumns->value());
@@ -221,6 +223,7 @@ void GenerateGraphWidget::generateGraph()
     default:
         break;
     }
+    bulkUpdate.release();
 
     close();
     deleteLater();
@@ -22,12 +22,16 @@
 #include "typenames.h"
 #include "graphdocument.h"
 #include "edge.h"
+#include "graphsnapshot.h"
+#include "propertykey.h"
 #include "modifiers/topology.h"
 
 #include <KLocalizedString>
-#include <QMap>
 #include <QPair>
 #include <QDebug>
+#include <QVector>
+#include <QtNumeric>
+#include <limits>
 
 using namespace GraphTheory;
 
@@ -72,16 +76,21 @@ void TransformEdgesWidget::transform()
 
 void TransformEdgesWidget::makeComplete()
 {
+    // notify views only once about all removed and created edges
+    BulkUpdateGuard bulkUpdate(m_document);
+
     //TODO only default edge type considered
     foreach(EdgePtr e, m_document->edges()) {
         e->destroy();
     }
 
-    for (int i = 0; i < m_document->nodes().size() - 1; ++i) {
-        for (int j = i + 1; j < m_document->nodes().size(); ++j) {
-            Edge::create(m_document->nodes().at(i), m_document->nodes().at(j));
-            if (m_document->edgeTypes().first()->direction() == EdgeType::Unidirectional) {
-                Edge::create(m_document->nodes().at(j), m_document->nodes().at(i));
+    const NodeList nodes = m_document->nodes();
+    const bool unidirectional = m_document->edgeTypes().first()->direction() == EdgeType::Unidirectional;
+    for (int i = 0; i < nodes.size() - 1; ++i) {
+        for (int j = i + 1; j < nodes.size(); ++j) {
+            Edge::create(nodes.at(i), nodes.at(j));
+            if (unidirectional) {
+                Edge::create(nodes.at(j), nodes.at(i));
             }
         }
     }
@@ -90,9 +99,7 @@ void TransformEdgesWidget::makeComplete()
 void TransformEdgesWidget::removeAllEdges()
 {
     //TODO only default edge type considered
-    foreach(EdgePtr e, m_document->edges()) {
-        e->destroy();
-    }
+    m_document->remove(m_document->edges());
 }
 
 void TransformEdgesWidget::reverseAllEdges()
@@ -116,109 +123,92 @@ void TransformEdgesWidget::reverseAllEdges()
 
 qreal TransformEdgesWidget::makeSpanningTree()
 {
-    NodeList nodes = m_document->nodes();
-    int n = nodes.size();
+    const GraphSnapshot graph(m_document, QStringList() << "value");
+    const int n = graph.nodeCount();
+    if (n == 0) {
+        return 0;
+    }
+    const QVector<int> &offsets = graph.offsets();
+    const QVector<int> &targets = graph.targets();
+    const QVector<int> &edges = graph.edges();
+    const QVector<qreal> &weights = graph.weights(0);
 
     // the resulting spanning tree (MST)
     QList< QPair<int, int> > MST;
+    QVector<qreal> MSTWeights;
 
     /*
      * distance[i] denotes the distance between node i and the minimum spanning
      * tree; initially this distance is infinity. Note that if i is already element
      * in MST distance[i] is only a temporary variable and its value is undefined.
      */
-    QMap<int, qreal> distance;
-    for (int i = 0; i < nodes.size(); i++) {
-        distance[i] = std::numeric_limits<unsigned int>::max();
-    }
+    QVector<qreal> distance(n, std::numeric_limits<qreal>::infinity());
 
     /*
      * Indicator variable that is true if node is in tree, false otherwise.
      * Initially all nodes are marked to be not in MST.
      */
-    QMap<int, bool> inTree;
-    for (int i = 0; i < nodes.size(); i++) {
-        inTree[i] = false;
-    }
-
-    /* weight[i][j] denotes distance between nodes i and j. If no
-     * path is present between i and j in the previous tree the weight
-     * must be set to 0.
-     */
-    QMap< QPair<int, int>, qreal> weight;
-
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (i == j)   weight[QPair<int, int>(i, j)] = 0;
-
-            EdgeList out;
-            out = nodes[i]->edges();
-
-            for (int k = 0; k < out.size(); k++) {
-                if (out[k]->to() == nodes[j]) {
-                    if (!out[k]->property("value").toString().isEmpty())
-                        weight[QPair<int, int>(i, j)] = out[k]->property("value").toDouble();
-                    else
-                        weight[QPair<int, int>(i, j)] = 1;
-
-                }
-            }
-        }
-    }
+    QVector<bool> inTree(n, false);
 
     /*
      * successor[i] denotes the index of the node, to which i must be
      * linked to in order to get distance distance[i]
      */
-    QMap< int, int> successor;
+    QVector<int> successor(n, -1);
+
+    // update distances to all neighbors of node; edges without weight have weight 1
+    auto updateDistances = [&](int node) {
+        for (int k = offsets.at(node); k < offsets.at(node + 1); ++k) {
+            const int target = targets.at(k);
+            const qreal weight = qIsNaN(weights.at(edges.at(k))) ? 1 : weights.at(edges.at(k));
+            if (!inTree.at(target) && distance.at(target) > weight) {
+                distance[target] = weight;
+                successor[target] = node;
+            }
+        }
+    };
 
     // start with first graph node
     inTree[0] = true;
-
-    // update distances
-    for (int i = 0; i < n; ++i) {
-        if ((weight[QPair<int, int>(0, i)] != 0) && (distance[i] > weight[QPair<int, int>(0, i)])) {
-            distance[i] = weight[QPair<int, int>(0, i)] ;
-            successor[i] = 0;
-        }
-    }
+    updateDistances(0);
 
     qreal total = 0;
     for (int treeSize = 1; treeSize < n; treeSize++) {
         // Find node with the smallest distance to the tree
         int min = -1;
         for (int i = 0; i < n; ++i) {
-            if (inTree[i] == false) {
-                if ((min == -1) || (distance[min] > distance[i])) {
+            if (!inTree.at(i) && successor.at(i) != -1) {
+                if ((min == -1) || (distance.at(min) > distance.at(i))) {
                     min = i;
                 }
             }
         }
+        if (min == -1) { // remaining nodes are not reachable
+            break;
+        }
 
         // add node to tree
-        MST << QPair<int, int>(successor[min], min);
-        inTree[min] = 1;
-        total += distance[min];
-
-        // update distances
-        for (int i = 0; i < n; ++i) {
-            if ((weight[QPair<int, int>(min, i)]  != 0) && (distance[i] > weight[QPair<int, int>(min, i)])) {
-                distance[i] = weight[QPair<int, int>(min, i)];
-                successor[i] = min;
-            }
-        }
+        MST << QPair<int, int>(successor.at(min), min);
+        MSTWeights << distance.at(min);
+        inTree[min] = true;
+        total += distance.at(min);
+        updateDistances(min);
     }
 
     removeAllEdges();
 
     // refill with MST edges
+    const PropertyKey valueKey("value");
     for (int i = 0; i < MST.size(); i++) {
-        EdgePtr edge = Edge::create(nodes[MST[i].first], nodes[MST[i].second]);
+        EdgePtr edge = Edge::create(graph.node(MST[i].first), graph.node(MST[i].second));
 
-        if (weight[QPair<int, int>(MST[i].first, MST[i].second)] != 1) {
+        if (MSTWeights.at(i) != 1) {
+            if (!edge->type()->dynamicProperties().contains("value")) {
+                edge->type()->addDynamicProperty("value");
+            }
             QString value;
-            value.setNum(weight[QPair<int, int>(MST[i].first, MST[i].second)]);
-            edge->setDynamicProperty("value", value);
+            value.setNum(MSTWeights.at(i));
+            edge->setDynamicProperty(valueKey, value);
         }
     }
 
@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "elementpool_p.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+#include <new>
+
+using namespace GraphTheory;
+
+namespace
+{
+// slab sizes grow from 64 up to 65536 slots
+const int minimalSlabSize = 64;
+const int maximalSlabSize = 65536;
+
+std::size_t slotSize(std::size_t objectSize)
+{
+    const std::size_t alignment = alignof(std::max_align_t);
+    const std::size_t size = qMax(objectSize, sizeof(void*));
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// all existing pools, such that unused memory can be released at once
+struct PoolRegistry {
+    QMutex mutex;
+    QVector<ElementPool*> pools;
+};
+Q_GLOBAL_STATIC(PoolRegistry, poolRegistry)
+}
+
+ElementPool::ElementPool(std::size_t objectSize)
+    : m_slotSize(slotSize(objectSize))
+    , m_nextSlabSize(minimalSlabSize)
+    , m_freeSlots(nullptr)
+    , m_allocated(0)
+{
+    PoolRegistry *registry = poolRegistry();
+    QMutexLocker locker(&registry->mutex);
+    registry->pools.append(this);
+}
+
+ElementPool::~ElementPool()
+{
+    if (!poolRegistry.isDestroyed()) {
+        PoolRegistry *registry = poolRegistry();
+        QMutexLocker locker(&registry->mutex);
+        registry->pools.removeOne(this);
+    }
+    if (m_allocated > 0) {
+        return;
+    }
+    foreach (const Slab &slab, m_slabs) {
+        ::operator delete(slab.begin);
+    }
+}
+
+void * ElementPool::allocate(std::size_t size)
+{
+    if (slotSize(size) != m_slotSize) {
+        return ::operator new(size);
+    }
+    QMutexLocker locker(&m_mutex);
+    if (!m_freeSlots) {
+        allocateSlab();
+    }
+    FreeSlot *slot = m_freeSlots;
+    m_freeSlots = slot->next;
+    ++m_slabs[slabIndex(slot)].allocated;
+    ++m_allocated;
+    return slot;
+}
+
+void ElementPool::deallocate(void *pointer, std::size_t size)
+{
+    if (!pointer) {
+        return;
+    }
+    if (slotSize(size) != m_slotSize) {
+        ::operator delete(pointer);
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    FreeSlot *slot = static_cast<FreeSlot*>(pointer);
+    slot->next = m_freeSlots;
+    m_freeSlots = slot;
+    --m_slabs[slabIndex(slot)].allocated;
+    --m_allocated;
+}
+
+void ElementPool::releaseUnusedSlabs()
+{
+    QMutexLocker locker(&m_mutex);
+    const bool hasUnusedSlab = std::any_of(m_slabs.constBegin(), m_slabs.constEnd(),
+        [](const Slab &slab) { return slab.allocated == 0; });
+    if (!hasUnusedSlab) {
+        return;
+    }
+
+    // unlink the slots of unused slabs from the free list before releasing the slabs
+    FreeSlot **link = &m_freeSlots;
+    while (*link) {
+        if (m_slabs.at(slabIndex(*link)).allocated == 0) {
+            *link = (*link)->next;
+        } else {
+            link = &(*link)->next;
+        }
+    }
+    for (int i = m_slabs.size() - 1; i >= 0; --i) {
+        if (m_slabs.at(i).allocated == 0) {
+            ::operator delete(m_slabs.at(i).begin);
+            m_slabs.remove(i);
+        }
+    }
+    if (m_slabs.isEmpty()) {
+        m_nextSlabSize = minimalSlabSize;
+    }
+}
+
+void ElementPool::releaseAllUnusedSlabs()
+{
+    if (poolRegistry.isDestroyed()) {
+        return;
+    }
+    PoolRegistry *registry = poolRegistry();
+    QMutexLocker locker(&registry->mutex);
+    foreach (ElementPool *pool, registry->pools) {
+        pool->releaseUnusedSlabs();
+    }
+}
+
+void ElementPool::allocateSlab()
+{
+    const int count = m_nextSlabSize;
+    m_nextSlabSize = qMin(2 * m_nextSlabSize, maximalSlabSize);
+    char *begin = static_cast<char*>(::operator new(count * m_slotSize));
+    Slab slab = { begin, begin + count * m_slotSize, 0 };
+    auto position = std::upper_bound(m_slabs.begin(), m_slabs.end(), begin,
+        [](const char *value, const Slab &other) { return value < other.begin; });
+    m_slabs.insert(position, slab);
+
+    // chain slots in address order, such that consecutive allocations are contiguous
+    for (int i = count - 1; i >= 0; --i) {
+        FreeSlot *slot = reinterpret_cast<FreeSlot*>(begin + i * m_slotSize);
+        slot->next = m_freeSlots;
+        m_freeSlots = slot;
+    }
+}
+
+int ElementPool::slabIndex(const void *pointer) const
+{
+    // the slab with the largest start address not above the pointer contains it
+    const char *address = static_cast<const char*>(pointer);
+    auto position = std::upper_bound(m_slabs.constBegin(), m_slabs.constEnd(), address,
+        [](const char *value, const Slab &other) { return value < other.begin; });
+    Q_ASSERT(position != m_slabs.constBegin());
+    Q_ASSERT(address < (position - 1)->end);
+    return int(position - m_slabs.constBegin()) - 1;
+}
@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ELEMENTPOOL_P_H
+#define ELEMENTPOOL_P_H
+
+#include <QMutex>
+#include <QVector>
+#include <cstddef>
+
+namespace GraphTheory
+{
+
+/**
+ * \class ElementPool
+ *
+ * Slab allocator for objects of one fixed size. Memory is requested in slabs of growing size,
+ * such that elements that are created one after another are laid out contiguously, and freed
+ * slots are reused before a new slab is requested. Requests of a different size are passed
+ * to the global allocator. Allocation and deallocation are thread-safe.
+ *
+ * Slabs are kept after their objects are freed, such that creating and removing elements
+ * does not repeatedly request memory. Slabs without any allocated object are returned to the
+ * system by releaseUnusedSlabs(), which GraphDocument calls whenever a document is destroyed.
+ */
+class ElementPool
+{
+public:
+    explicit ElementPool(std::size_t objectSize);
+
+    /**
+     * Release all slabs if no object is allocated any more. Otherwise the slabs are leaked
+     * intentionally, since the remaining objects may still be destroyed later on.
+     */
+    ~ElementPool();
+
+    /**
+     * @return memory for one object of size @p size
+     */
+    void * allocate(std::size_t size);
+
+    /**
+     * Return memory at @p pointer of an object of size @p size to the pool.
+     */
+    void deallocate(void *pointer, std::size_t size);
+
+    /**
+     * Return all slabs of this pool that contain no allocated object to the system.
+     */
+    void releaseUnusedSlabs();
+
+    /**
+     * Call releaseUnusedSlabs() on all existing pools.
+     */
+    static void releaseAllUnusedSlabs();
+
+private:
+    Q_DISABLE_COPY(ElementPool)
+    struct FreeSlot {
+        FreeSlot *next;
+    };
+    struct Slab {
+        char *begin;
+        char *end;
+        int allocated; // number of slots in use
+    };
+    void allocateSlab();
+    /** @return index of the slab containing @p pointer **/
+    int slabIndex(const void *pointer) const;
+
+    const std::size_t m_slotSize;
+    int m_nextSlabSize;
+    FreeSlot *m_freeSlots;
+    QVector<Slab> m_slabs; // ordered by address
+    int m_allocated;
+    QMutex m_mutex;
+};
+}
+
+#endif
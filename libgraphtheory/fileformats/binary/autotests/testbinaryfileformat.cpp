@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testbinaryfileformat.h"
+#include "../binaryfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+#include "edgetypestyle.h"
+#include "nodetypestyle.h"
+#include <QtTest>
+
+using namespace GraphTheory;
+
+TestBinaryFileFormat::TestBinaryFileFormat()
+{
+}
+
+// test serialization and import of edge and node types
+void TestBinaryFileFormat::documentTypesTest()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->setId(1);
+    document->nodeTypes().first()->setName("testName");
+    document->nodeTypes().first()->style()->setColor(QColor("#ff0000"));
+    document->nodeTypes().first()->style()->setVisible(false);
+    document->nodeTypes().first()->style()->setPropertyNamesVisible(true);
+    document->nodeTypes().first()->addDynamicProperty("label");
+    document->edgeTypes().first()->setId(1);
+    document->edgeTypes().first()->setName("testName");
+    document->edgeTypes().first()->style()->setColor(QColor("#ff0000"));
+    document->edgeTypes().first()->setDirection(EdgeType::Bidirectional);
+    EdgeTypePtr edgeType = EdgeType::create(document);
+    edgeType->setId(2);
+    edgeType->setDirection(EdgeType::Unidirectional);
+    edgeType->addDynamicProperty("weight");
+
+    BinaryFileFormat serializer(this, QList<QVariant>());
+    serializer.setFile(QUrl::fromLocalFile("test.bgraph"));
+    serializer.writeFile(document);
+    QVERIFY(serializer.hasError() == false);
+
+    BinaryFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.bgraph"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    QVERIFY(importer.isGraphDocument());
+    GraphDocumentPtr importDocument = importer.graphDocument();
+
+    QCOMPARE(importDocument->nodeTypes().count(), 1);
+    NodeTypePtr nodeType = importDocument->nodeTypes().first();
+    QCOMPARE(nodeType->id(), 1);
+    QCOMPARE(nodeType->name(), QString("testName"));
+    QCOMPARE(nodeType->style()->isVisible(), false);
+    QCOMPARE(nodeType->style()->isPropertyNamesVisible(), true);
+    QCOMPARE(nodeType->style()->color().name(), QString("#ff0000"));
+    QCOMPARE(nodeType->dynamicProperties(), QStringList() << "label");
+
+    QCOMPARE(importDocument->edgeTypes().count(), 2);
+    QCOMPARE(importDocument->edgeTypes().at(0)->id(), 1);
+    QCOMPARE(importDocument->edgeTypes().at(0)->name(), QString("testName"));
+    QCOMPARE(importDocument->edgeTypes().at(0)->direction(), EdgeType::Bidirectional);
+    QCOMPARE(importDocument->edgeTypes().at(1)->id(), 2);
+    QCOMPARE(importDocument->edgeTypes().at(1)->direction(), EdgeType::Unidirectional);
+    QCOMPARE(importDocument->edgeTypes().at(1)->dynamicProperties(), QStringList() << "weight");
+
+    document->destroy();
+    importDocument->destroy();
+}
+
+// test if nodes, edges, and their properties are re-imported correctly
+void TestBinaryFileFormat::nodeAndEdgeTest()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("label");
+    document->edgeTypes().first()->addDynamicProperty("label");
+    NodeTypePtr secondType = NodeType::create(document);
+    secondType->addDynamicProperty("value");
+
+    NodePtr previous;
+    for (int i = 0; i < 1000; ++i) {
+        NodePtr node = Node::create(document);
+        node->setId(i + 10);
+        node->setX(i);
+        node->setY(-0.5 * i);
+        if (i % 3 == 0) {
+            node->setType(secondType);
+            node->setDynamicProperty("value", i);
+        } else {
+            node->setDynamicProperty("label", QString::fromUtf8("n\xc3\xa4de %1").arg(i));
+        }
+        if (previous) {
+            Edge::create(previous, node)->setDynamicProperty("label", QString::number(i));
+        }
+        previous = node;
+    }
+
+    BinaryFileFormat serializer(this, QList<QVariant>());
+    serializer.setFile(QUrl::fromLocalFile("test.bgraph"));
+    serializer.writeFile(document);
+    QVERIFY(serializer.hasError() == false);
+
+    BinaryFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.bgraph"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr importDocument = importer.graphDocument();
+
+    const NodeList nodes = document->nodes();
+    const NodeList importNodes = importDocument->nodes();
+    QCOMPARE(importNodes.count(), nodes.count());
+    for (int i = 0; i < nodes.count(); ++i) {
+        QCOMPARE(importNodes.at(i)->id(), nodes.at(i)->id());
+        QCOMPARE(importNodes.at(i)->x(), nodes.at(i)->x());
+        QCOMPARE(importNodes.at(i)->y(), nodes.at(i)->y());
+        QCOMPARE(importNodes.at(i)->type()->dynamicProperties(), nodes.at(i)->type()->dynamicProperties());
+        foreach (const QString &property, nodes.at(i)->dynamicProperties()) {
+            QCOMPARE(importNodes.at(i)->dynamicProperty(property).toString(), nodes.at(i)->dynamicProperty(property).toString());
+        }
+    }
+    const EdgeList edges = document->edges();
+    const EdgeList importEdges = importDocument->edges();
+    QCOMPARE(importEdges.count(), edges.count());
+    for (int i = 0; i < edges.count(); ++i) {
+        QCOMPARE(importEdges.at(i)->from()->id(), edges.at(i)->from()->id());
+        QCOMPARE(importEdges.at(i)->to()->id(), edges.at(i)->to()->id());
+        QCOMPARE(importEdges.at(i)->dynamicProperty("label").toString(), edges.at(i)->dynamicProperty("label").toString());
+    }
+
+    document->destroy();
+    importDocument->destroy();
+}
+
+// test that truncated and foreign files are rejected
+void TestBinaryFileFormat::corruptedFileTest()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    Edge::create(Node::create(document), Node::create(document));
+    BinaryFileFormat serializer(this, QList<QVariant>());
+    serializer.setFile(QUrl::fromLocalFile("test.bgraph"));
+    serializer.writeFile(document);
+    QVERIFY(serializer.hasError() == false);
+    document->destroy();
+
+    QFile file("test.bgraph");
+    QVERIFY(file.resize(file.size() - 4));
+    BinaryFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.bgraph"));
+    importer.readFile();
+    QVERIFY(importer.hasError());
+
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("{ \"FormatVersion\": 1 }");
+    file.close();
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::CouldNotRecognizeFileFormat);
+}
+
+QTEST_MAIN(TestBinaryFileFormat);
@@ -0,0 +1,519 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "binaryfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "graphdocument.h"
+#include "graphsnapshot.h"
+#include "node.h"
+#include "edge.h"
+#include "edgetypestyle.h"
+#include "nodetypestyle.h"
+#include "propertykey.h"
+#include "logging_p.h"
+#include <KLocalizedString>
+#include <KPluginFactory>
+#include <QColor>
+#include <QFile>
+#include <QHash>
+#include <QUrl>
+#include <QVector>
+#include <cstring>
+
+using namespace GraphTheory;
+
+K_PLUGIN_FACTORY_WITH_JSON( FilePluginFactory,
+                            "binaryfileformat.json",
+                            registerPlugin<BinaryFileFormat>();)
+
+namespace
+{
+const char magic[4] = { 'R', 'G', 'B', 'F' };
+const quint32 formatVersion = 1;
+const quint32 byteOrderMark = 0x01020304;
+
+/**
+ * Writer for values and arrays in native byte order.
+ */
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(QFile *file)
+        : m_file(file)
+        , m_ok(true)
+    {
+    }
+
+    void writeRaw(const char *data, qint64 size)
+    {
+        if (size > 0 && m_file->write(data, size) != size) {
+            m_ok = false;
+        }
+    }
+
+    template<typename T>
+    void write(T value)
+    {
+        writeRaw(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void writeArray(const QVector<T> &values)
+    {
+        writeRaw(reinterpret_cast<const char *>(values.constData()), qint64(values.size()) * sizeof(T));
+    }
+
+    void writeString(const QString &string)
+    {
+        const QByteArray data = string.toUtf8();
+        write<quint32>(data.size());
+        writeRaw(data.constData(), data.size());
+    }
+
+    /**
+     * Write property column with @p values.
+     */
+    void writeColumn(const QStringList &values)
+    {
+        QVector<quint32> offsets;
+        offsets.reserve(values.size() + 1);
+        offsets.append(0);
+        QByteArray data;
+        foreach (const QString &value, values) {
+            data.append(value.toUtf8());
+            offsets.append(data.size());
+        }
+        writeArray(offsets);
+        writeRaw(data.constData(), data.size());
+    }
+
+    bool isOk() const
+    {
+        return m_ok;
+    }
+
+private:
+    QFile *m_file;
+    bool m_ok;
+};
+
+/**
+ * Bounds checked reader of a memory block. Values are copied out of the block, such that it
+ * does not need to be aligned.
+ */
+class BinaryReader
+{
+public:
+    BinaryReader(const uchar *data, qint64 size)
+        : m_data(data)
+        , m_end(data + size)
+        , m_ok(true)
+    {
+    }
+
+    const uchar * readRaw(qint64 size)
+    {
+        if (!m_ok || size < 0 || size > m_end - m_data) {
+            m_ok = false;
+            return nullptr;
+        }
+        const uchar *data = m_data;
+        m_data += size;
+        return data;
+    }
+
+    template<typename T>
+    T read()
+    {
+        T value = T();
+        if (const uchar *data = readRaw(sizeof(T))) {
+            std::memcpy(&value, data, sizeof(T));
+        }
+        return value;
+    }
+
+    template<typename T>
+    QVector<T> readArray(quint32 count)
+    {
+        QVector<T> values;
+        if (const uchar *data = readRaw(qint64(count) * sizeof(T))) {
+            values.resize(count);
+            std::memcpy(values.data(), data, qint64(count) * sizeof(T));
+        }
+        return values;
+    }
+
+    QString readString()
+    {
+        const quint32 size = read<quint32>();
+        const uchar *data = readRaw(size);
+        if (!data) {
+            return QString();
+        }
+        return QString::fromUtf8(reinterpret_cast<const char *>(data), size);
+    }
+
+    /**
+     * Read property column with @p count values.
+     */
+    QStringList readColumn(int count)
+    {
+        const QVector<quint32> offsets = readArray<quint32>(count + 1);
+        if (!m_ok || offsets.first() != 0) {
+            m_ok = false;
+            return QStringList();
+        }
+        const char *data = reinterpret_cast<const char *>(readRaw(offsets.last()));
+        if (!data) {
+            return QStringList();
+        }
+        QStringList values;
+        values.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            if (offsets.at(i) > offsets.at(i + 1)) {
+                m_ok = false;
+                return QStringList();
+            }
+            values.append(QString::fromUtf8(data + offsets.at(i), offsets.at(i + 1) - offsets.at(i)));
+        }
+        return values;
+    }
+
+    void setError()
+    {
+        m_ok = false;
+    }
+
+    bool isOk() const
+    {
+        return m_ok;
+    }
+
+private:
+    const uchar *m_data;
+    const uchar *m_end;
+    bool m_ok;
+};
+}
+
+BinaryFileFormat::BinaryFileFormat(QObject* parent, const QList< QVariant >&)
+    : FileFormatInterface("rocs_binaryfileformat", parent)
+{
+}
+
+BinaryFileFormat::~BinaryFileFormat()
+{
+}
+
+const QStringList BinaryFileFormat::extensions() const
+{
+    return QStringList()
+           << i18n("Rocs Binary Format (%1)", QString("*.bgraph"));
+}
+
+void BinaryFileFormat::readFile()
+{
+    QFile fileHandle(file().toLocalFile());
+    if (!fileHandle.open(QFile::ReadOnly)) {
+        setError(CouldNotOpenFile, i18n("Could not open file \"%1\" in read mode: %2", file().toLocalFile(), fileHandle.errorString()));
+        return;
+    }
+
+    // map the file if possible, otherwise read it at once
+    QByteArray content;
+    const uchar *data = fileHandle.map(0, fileHandle.size());
+    if (!data) {
+        content = fileHandle.readAll();
+        data = reinterpret_cast<const uchar *>(content.constData());
+    }
+    BinaryReader reader(data, fileHandle.size());
+
+    // check header
+    const uchar *fileMagic = reader.readRaw(sizeof(magic));
+    if (!fileMagic || std::memcmp(fileMagic, magic, sizeof(magic)) != 0) {
+        setError(CouldNotRecognizeFileFormat, i18n("File \"%1\" is not a binary graph file.", file().toLocalFile()));
+        return;
+    }
+    const quint32 version = reader.read<quint32>();
+    if (version == 0 || version > formatVersion) {
+        setError(NotSupportedOperation, i18n("File format version %1 is not supported.", version));
+        return;
+    }
+    if (reader.read<quint32>() != byteOrderMark) {
+        setError(NotSupportedOperation, i18n("File was written on a machine with different byte order."));
+        return;
+    }
+
+    // cleanup default
+    GraphDocumentPtr document = GraphDocument::create();
+    document->remove(document->nodeTypes().first());
+    document->remove(document->edgeTypes().first());
+
+    // import node types
+    QVector<NodeTypePtr> nodeTypes;
+    QVector<QStringList> nodeTypeProperties;
+    const quint32 nodeTypeCount = reader.read<quint32>();
+    for (quint32 index = 0; index < nodeTypeCount && reader.isOk(); ++index) {
+        NodeTypePtr type = NodeType::create(document);
+        type->setId(reader.read<qint32>());
+        type->setName(reader.readString());
+        type->style()->setColor(QColor::fromRgba(reader.read<quint32>()));
+        type->style()->setVisible(reader.read<quint8>());
+        type->style()->setPropertyNamesVisible(reader.read<quint8>());
+        QStringList properties;
+        const quint32 propertyCount = reader.read<quint32>();
+        for (quint32 pIndex = 0; pIndex < propertyCount && reader.isOk(); ++pIndex) {
+            properties.append(reader.readString());
+            type->addDynamicProperty(properties.last());
+        }
+        nodeTypes.append(type);
+        nodeTypeProperties.append(properties);
+    }
+
+    // import edge types
+    QVector<EdgeTypePtr> edgeTypes;
+    QVector<QStringList> edgeTypeProperties;
+    const quint32 edgeTypeCount = reader.read<quint32>();
+    for (quint32 index = 0; index < edgeTypeCount && reader.isOk(); ++index) {
+        EdgeTypePtr type = EdgeType::create(document);
+        type->setId(reader.read<qint32>());
+        type->setName(reader.readString());
+        type->style()->setColor(QColor::fromRgba(reader.read<quint32>()));
+        type->style()->setVisible(reader.read<quint8>());
+        type->style()->setPropertyNamesVisible(reader.read<quint8>());
+        QStringList properties;
+        const quint32 propertyCount = reader.read<quint32>();
+        for (quint32 pIndex = 0; pIndex < propertyCount && reader.isOk(); ++pIndex) {
+            properties.append(reader.readString());
+            type->addDynamicProperty(properties.last());
+        }
+        type->setDirection(reader.read<quint8>() == 0 ? EdgeType::Unidirectional : EdgeType::Bidirectional);
+        edgeTypes.append(type);
+        edgeTypeProperties.append(properties);
+    }
+
+    // read element columns and validate all references before creating any element
+    const quint32 nodeCount = reader.read<quint32>();
+    const QVector<qint32> nodeIds = reader.readArray<qint32>(nodeCount);
+    const QVector<quint32> nodeTypeIndices = reader.readArray<quint32>(nodeCount);
+    const QVector<double> nodeX = reader.readArray<double>(nodeCount);
+    const QVector<double> nodeY = reader.readArray<double>(nodeCount);
+    const QVector<quint32> nodeColors = reader.readArray<quint32>(nodeCount);
+    const quint32 edgeCount = reader.read<quint32>();
+    const QVector<quint32> edgeFrom = reader.readArray<quint32>(edgeCount);
+    const QVector<quint32> edgeTo = reader.readArray<quint32>(edgeCount);
+    const QVector<quint32> edgeTypeIndices = reader.readArray<quint32>(edgeCount);
+    for (int i = 0; i < nodeTypeIndices.size(); ++i) {
+        if (nodeTypeIndices.at(i) >= nodeTypeCount) {
+            reader.setError();
+        }
+    }
+    for (int i = 0; i < edgeTypeIndices.size(); ++i) {
+        if (edgeFrom.at(i) >= nodeCount || edgeTo.at(i) >= nodeCount || edgeTypeIndices.at(i) >= edgeTypeCount) {
+            reader.setError();
+        }
+    }
+    if (!reader.isOk()) {
+        document->destroy();
+        setError(EncodingProblem, i18n("File \"%1\" is corrupted.", file().toLocalFile()));
+        return;
+    }
+
+    // create elements
+    BulkUpdateGuard bulkUpdate(document);
+    QVector<NodePtr> nodes(nodeCount);
+    for (quint32 i = 0; i < nodeCount; ++i) {
+        NodePtr node = Node::create(document);
+        node->setType(nodeTypes.at(nodeTypeIndices.at(i)));
+        node->setId(nodeIds.at(i));
+        node->setX(nodeX.at(i));
+        node->setY(nodeY.at(i));
+        node->setColor(QColor::fromRgba(nodeColors.at(i)));
+        nodes[i] = node;
+    }
+    QVector<EdgePtr> edges(edgeCount);
+    for (quint32 i = 0; i < edgeCount; ++i) {
+        EdgePtr edge = Edge::create(nodes.at(edgeFrom.at(i)), nodes.at(edgeTo.at(i)));
+        edge->setType(edgeTypes.at(edgeTypeIndices.at(i)));
+        edges[i] = edge;
+    }
+
+    // set dynamic properties, empty values are skipped
+    for (quint32 type = 0; type < nodeTypeCount && reader.isOk(); ++type) {
+        QVector<NodePtr> typeNodes;
+        for (quint32 i = 0; i < nodeCount; ++i) {
+            if (nodeTypeIndices.at(i) == type) {
+                typeNodes.append(nodes.at(i));
+            }
+        }
+        foreach (const QString &property, nodeTypeProperties.at(type)) {
+            const PropertyKey key(property);
+            const QStringList values = reader.readColumn(typeNodes.size());
+            for (int i = 0; i < values.size(); ++i) {
+                if (!values.at(i).isEmpty()) {
+                    typeNodes.at(i)->setDynamicProperty(key, values.at(i));
+                }
+            }
+        }
+    }
+    for (quint32 type = 0; type < edgeTypeCount && reader.isOk(); ++type) {
+        QVector<EdgePtr> typeEdges;
+        for (quint32 i = 0; i < edgeCount; ++i) {
+            if (edgeTypeIndices.at(i) == type) {
+                typeEdges.append(edges.at(i));
+            }
+        }
+        foreach (const QString &property, edgeTypeProperties.at(type)) {
+            const PropertyKey key(property);
+            const QStringList values = reader.readColumn(typeEdges.size());
+            for (int i = 0; i < values.size(); ++i) {
+                if (!values.at(i).isEmpty()) {
+                    typeEdges.at(i)->setDynamicProperty(key, values.at(i));
+                }
+            }
+        }
+    }
+    bulkUpdate.release();
+
+    if (!reader.isOk()) {
+        document->destroy();
+        setError(EncodingProblem, i18n("File \"%1\" is corrupted.", file().toLocalFile()));
+        return;
+    }
+
+    setGraphDocument(document);
+    setError(None);
+}
+
+void BinaryFileFormat::writeFile(GraphDocumentPtr document)
+{
+    QFile fileHandle(file().toLocalFile());
+    if (!fileHandle.open(QFile::WriteOnly)) {
+        setError(FileIsReadOnly, i18n("Could not open file \"%1\" in write mode: %2", file().fileName(), fileHandle.errorString()));
+        return;
+    }
+    BinaryWriter writer(&fileHandle);
+    const GraphSnapshot graph(document);
+
+    // header
+    writer.writeRaw(magic, sizeof(magic));
+    writer.write<quint32>(formatVersion);
+    writer.write<quint32>(byteOrderMark);
+
+    // node types
+    const QList<NodeTypePtr> nodeTypes = document->nodeTypes();
+    QHash<NodeType*, quint32> nodeTypeIndices;
+    writer.write<quint32>(nodeTypes.size());
+    foreach (const NodeTypePtr &type, nodeTypes) {
+        nodeTypeIndices.insert(type.data(), nodeTypeIndices.size());
+        writer.write<qint32>(type->id());
+        writer.writeString(type->name());
+        writer.write<quint32>(type->style()->color().rgba());
+        writer.write<quint8>(type->style()->isVisible());
+        writer.write<quint8>(type->style()->isPropertyNamesVisible());
+        writer.write<quint32>(type->dynamicProperties().size());
+        foreach (const QString &property, type->dynamicProperties()) {
+            writer.writeString(property);
+        }
+    }
+
+    // edge types
+    const QList<EdgeTypePtr> edgeTypes = document->edgeTypes();
+    QHash<EdgeType*, quint32> edgeTypeIndices;
+    writer.write<quint32>(edgeTypes.size());
+    foreach (const EdgeTypePtr &type, edgeTypes) {
+        edgeTypeIndices.insert(type.data(), edgeTypeIndices.size());
+        writer.write<qint32>(type->id());
+        writer.writeString(type->name());
+        writer.write<quint32>(type->style()->color().rgba());
+        writer.write<quint8>(type->style()->isVisible());
+        writer.write<quint8>(type->style()->isPropertyNamesVisible());
+        writer.write<quint32>(type->dynamicProperties().size());
+        foreach (const QString &property, type->dynamicProperties()) {
+            writer.writeString(property);
+        }
+        writer.write<quint8>(type->direction() == EdgeType::Unidirectional ? 0 : 1);
+    }
+
+    // node columns
+    const int nodeCount = graph.nodeCount();
+    QVector<quint32> nodeTypeColumn(nodeCount);
+    QVector<double> xColumn(nodeCount);
+    QVector<double> yColumn(nodeCount);
+    QVector<quint32> colorColumn(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        const NodePtr node = graph.node(i);
+        nodeTypeColumn[i] = nodeTypeIndices.value(node->type().data());
+        xColumn[i] = node->x();
+        yColumn[i] = node->y();
+        colorColumn[i] = node->color().rgba();
+    }
+    writer.write<quint32>(nodeCount);
+    writer.writeArray(graph.nodeIds());
+    writer.writeArray(nodeTypeColumn);
+    writer.writeArray(xColumn);
+    writer.writeArray(yColumn);
+    writer.writeArray(colorColumn);
+
+    // edge columns, node indices are non-negative and thus written unchanged
+    const int edgeCount = graph.edgeCount();
+    QVector<quint32> edgeTypeColumn(edgeCount);
+    for (int i = 0; i < edgeCount; ++i) {
+        edgeTypeColumn[i] = edgeTypeIndices.value(graph.edge(i)->type().data());
+    }
+    writer.write<quint32>(edgeCount);
+    writer.writeArray(graph.edgeSources());
+    writer.writeArray(graph.edgeTargets());
+    writer.writeArray(edgeTypeColumn);
+
+    // property columns
+    for (int type = 0; type < nodeTypes.size(); ++type) {
+        foreach (const QString &property, nodeTypes.at(type)->dynamicProperties()) {
+            const PropertyKey key(property);
+            QStringList values;
+            for (int i = 0; i < nodeCount; ++i) {
+                if (nodeTypeColumn.at(i) == quint32(type)) {
+                    values.append(graph.node(i)->dynamicProperty(key).toString());
+                }
+            }
+            writer.writeColumn(values);
+        }
+    }
+    for (int type = 0; type < edgeTypes.size(); ++type) {
+        foreach (const QString &property, edgeTypes.at(type)->dynamicProperties()) {
+            const PropertyKey key(property);
+            QStringList values;
+            for (int i = 0; i < edgeCount; ++i) {
+                if (edgeTypeColumn.at(i) == quint32(type)) {
+                    values.append(graph.edge(i)->dynamicProperty(key).toString());
+                }
+            }
+            writer.writeColumn(values);
+        }
+    }
+
+    if (!writer.isOk() || !fileHandle.flush()) {
+        setError(Unknown, i18n("Error on serializing file format to file."));
+        return;
+    }
+    setError(None);
+}
+
+#include "binaryfileformat.moc"
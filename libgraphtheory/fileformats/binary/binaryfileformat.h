@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINARYFILEFORMAT_H
+#define BINARYFILEFORMAT_H
+
+#include "fileformats/fileformatinterface.h"
+
+namespace GraphTheory
+{
+
+/** \brief compact binary graph file format
+ *
+ * The format stores all element data as columns, such that loading a file is mostly copying
+ * arrays out of the memory mapped file. It is intended for fast saving and re-opening of large
+ * documents; for interchange the text based formats should be preferred.
+ *
+ * Layout (version 1), all values in the byte order of the writing machine:
+ *  - header: magic "RGBF", quint32 format version, quint32 byte order mark 0x01020304
+ *  - node types: quint32 count, for each type qint32 id, string name, quint32 color (ARGB),
+ *    quint8 visible, quint8 property names visible, quint32 property count, string names
+ *  - edge types: as node types, followed by quint8 direction for each type
+ *  - nodes: quint32 count n, qint32 ids[n], quint32 type indices[n], double x[n], double y[n],
+ *    quint32 colors[n]
+ *  - edges: quint32 count m, quint32 start node indices[m], quint32 end node indices[m],
+ *    quint32 type indices[m]
+ *  - property columns: for each node type and each of its properties, followed by the same for
+ *    edge types, the values of all elements of that type in element order as
+ *    quint32 offsets[k+1] into the following UTF-8 data of offsets[k] bytes
+ *
+ * Strings are stored as quint32 length followed by UTF-8 data. Dynamic property values are
+ * stored by their string representation, like in the Rocs graph format.
+ */
+class BinaryFileFormat : public FileFormatInterface
+{
+    Q_OBJECT
+public:
+    explicit BinaryFileFormat(QObject *parent, const QList< QVariant >&);
+    ~BinaryFileFormat();
+
+    /**
+     * File extensions that are common for this file type.
+     */
+    const QStringList extensions() const Q_DECL_OVERRIDE;
+
+    /**
+     * Writes given graph document to formerly specified file \see setFile().
+     * \param graph is graphDocument to be serialized
+     */
+    void writeFile(GraphDocumentPtr graph) Q_DECL_OVERRIDE;
+
+    /**
+     * Open given file and imports it into internal format.
+     * \param file is url of a local file
+     */
+    void readFile() Q_DECL_OVERRIDE;
+};
+}
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testcsvfileformat.h"
+#include "../csvfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+#include "edgetype.h"
+#include <QFile>
+#include <QtTest>
+
+using namespace GraphTheory;
+
+namespace
+{
+void writeTestFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(content);
+}
+}
+
+TestCsvFileFormat::TestCsvFileFormat()
+{
+}
+
+void TestCsvFileFormat::parseTest()
+{
+    writeTestFile("test.csv",
+        "\xEF\xBB\xBF" "Source,Target,Weight,Label\r\n"
+        "a,b,1.5,first\r\n"
+        "\r\n"
+        "b,\"c,d\",,\"say \"\"hello\"\"\"\r\n"
+        "\"c,d\",a,3,");
+
+    CsvFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.csv"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    QVERIFY(importer.isGraphDocument());
+    GraphDocumentPtr document = importer.graphDocument();
+
+    QCOMPARE(document->edgeTypes().first()->dynamicProperties(), QStringList() << "Weight" << "Label");
+    QCOMPARE(document->nodes().count(), 3);
+    QCOMPARE(document->nodes().at(0)->dynamicProperty("name").toString(), QString("a"));
+    QCOMPARE(document->nodes().at(1)->dynamicProperty("name").toString(), QString("b"));
+    QCOMPARE(document->nodes().at(2)->dynamicProperty("name").toString(), QString("c,d"));
+
+    QCOMPARE(document->edges().count(), 3);
+    EdgePtr edge = document->edges().at(0);
+    QCOMPARE(edge->dynamicProperty("Weight").type(), QVariant::Double);
+    QCOMPARE(edge->dynamicProperty("Weight").toReal(), 1.5);
+    QCOMPARE(edge->dynamicProperty("Label").type(), QVariant::String);
+    QCOMPARE(edge->dynamicProperty("Label").toString(), QString("first"));
+    edge = document->edges().at(1);
+    QCOMPARE(edge->to(), document->nodes().at(2));
+    QVERIFY(!edge->dynamicProperty("Weight").isValid());
+    QCOMPARE(edge->dynamicProperty("Label").toString(), QString("say \"hello\""));
+    edge = document->edges().at(2);
+    QCOMPARE(edge->from(), document->nodes().at(2));
+    QCOMPARE(edge->to(), document->nodes().at(0));
+}
+
+void TestCsvFileFormat::columnNamesTest()
+{
+    writeTestFile("test.csv",
+        "id;to;from\n"
+        "1;x;y\n");
+
+    CsvFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.csv"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr document = importer.graphDocument();
+    QCOMPARE(document->edgeTypes().first()->dynamicProperties(), QStringList() << "id");
+    QCOMPARE(document->edges().count(), 1);
+    EdgePtr edge = document->edges().first();
+    QCOMPARE(edge->from()->dynamicProperty("name").toString(), QString("y"));
+    QCOMPARE(edge->to()->dynamicProperty("name").toString(), QString("x"));
+    QCOMPARE(edge->dynamicProperty("id").toString(), QString("1"));
+}
+
+void TestCsvFileFormat::lineBreakTest()
+{
+    writeTestFile("test.csv",
+        "source,target,\"edge\r\nlabel\"\r\n"
+        "a,b,\"first\nline\"\r\n"
+        "\"multi\nline\",c,\"\"\"\n\"\"\"\r\n");
+
+    CsvFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.csv"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr document = importer.graphDocument();
+    QCOMPARE(document->edgeTypes().first()->dynamicProperties(), QStringList() << "edge\r\nlabel");
+    QCOMPARE(document->nodes().count(), 4);
+    QCOMPARE(document->nodes().at(2)->dynamicProperty("name").toString(), QString("multi\nline"));
+    QCOMPARE(document->edges().count(), 2);
+    QCOMPARE(document->edges().at(0)->dynamicProperty("edge\r\nlabel").toString(), QString("first\nline"));
+    QCOMPARE(document->edges().at(1)->dynamicProperty("edge\r\nlabel").toString(), QString("\"\n\""));
+
+    // line breaks in quoted fields at the boundaries of the chunks that are parsed in parallel
+    const int edges = 100000;
+    QByteArray content("source,target,text,number\n");
+    for (int i = 0; i < edges; ++i) {
+        content += "a,b,\"" + QByteArray(20, '\n') + QByteArray::number(i) + "\"," + QByteArray::number(i) + '\n';
+    }
+    writeTestFile("test.csv", content);
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    document = importer.graphDocument();
+    QCOMPARE(document->edges().count(), edges);
+    for (int i = 0; i < edges; i += 997) {
+        const EdgePtr edge = document->edges().at(i);
+        QCOMPARE(edge->dynamicProperty("text").toString(), QString(20, '\n') + QString::number(i));
+        QCOMPARE(edge->dynamicProperty("number").toInt(), i);
+    }
+    QCOMPARE(document->edges().first()->dynamicProperty("text").type(), QVariant::String);
+    QCOMPARE(document->edges().first()->dynamicProperty("number").type(), QVariant::Double);
+}
+
+void TestCsvFileFormat::parseErrorTest()
+{
+    CsvFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.csv"));
+
+    writeTestFile("test.csv", "source,target\na,b\nb,c,d\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+    QVERIFY(importer.errorString().contains("line 3"));
+
+    writeTestFile("test.csv", "source,target\n\"a,b\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+
+    writeTestFile("test.csv", "source\na\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+
+    writeTestFile("test.csv", "");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::NoGraphFound);
+}
+
+void TestCsvFileFormat::largeFileTest()
+{
+    // several megabytes to have the file parsed in multiple chunks
+    const int nodes = 1000;
+    const int edges = 200000;
+    QByteArray content("source\ttarget\tweight\n");
+    for (int i = 0; i < edges; ++i) {
+        content += "node" + QByteArray::number(i % nodes) + "\tnode" + QByteArray::number((7 * i + 1) % nodes)
+            + '\t' + QByteArray::number(i) + '\n';
+    }
+    content += "a\tb\n";
+    writeTestFile("test.csv", content);
+
+    CsvFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.csv"));
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+    QVERIFY(importer.errorString().contains(QString("line %1").arg(edges + 2)));
+
+    content.chop(4);
+    writeTestFile("test.csv", content);
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr document = importer.graphDocument();
+    QCOMPARE(document->nodes().count(), nodes);
+    QCOMPARE(document->edges().count(), edges);
+    EdgePtr edge = document->edges().last();
+    QCOMPARE(edge->from()->dynamicProperty("name").toString(), QString("node%1").arg((edges - 1) % nodes));
+    QCOMPARE(edge->dynamicProperty("weight").toString(), QString::number(edges - 1));
+}
+
+QTEST_MAIN(TestCsvFileFormat);
@@ -0,0 +1,411 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "csvfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "fileformats/textreader_p.h"
+#include "modifiers/topology.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+#include "nodetype.h"
+#include "edgetype.h"
+#include "propertykey.h"
+#include "logging_p.h"
+#include <KLocalizedString>
+#include <KPluginFactory>
+#include <QFile>
+#include <QHash>
+#include <QUrl>
+#include <QVector>
+#include <QtNumeric>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace GraphTheory;
+
+K_PLUGIN_FACTORY_WITH_JSON( FilePluginFactory,
+                            "csvfileformat.json",
+                            registerPlugin<CsvFileFormat>();)
+
+namespace
+{
+/**
+ * Fields of all rows of one chunk of the file, stored row by row.
+ */
+struct CsvChunk
+{
+    CsvChunk()
+        : error(0)
+    {
+    }
+
+    QVector<QString> fields;
+    QVector<qreal> numbers; // value of each field, NaN if the field is not a number
+    QVector<bool> textColumns; // columns that contain non-empty fields that are not numbers
+    const char *error; // begin of the first line that could not be parsed
+};
+
+/**
+ * @return the number in [@p first, @p last), surrounded by optional blanks, or NaN if the
+ *         range does not contain exactly one number
+ */
+qreal parseNumber(const char *first, const char *last)
+{
+    const char *position = TextChunk::skipBlanks(first, last);
+    qreal value;
+    if (!TextChunk::parseReal(position, last, value) || TextChunk::skipBlanks(position, last) != last) {
+        return std::numeric_limits<qreal>::quiet_NaN();
+    }
+    return value;
+}
+
+/**
+ * @return end of the record that begins at @p position, i.e., the first line break that is not
+ *         enclosed in quotes, or @p end if there is none
+ */
+const char * findRecordEnd(const char *position, const char *end)
+{
+    forever {
+        const char *newline = static_cast<const char *>(std::memchr(position, '\n', size_t(end - position)));
+        if (!newline) {
+            return end;
+        }
+        const char *quote = static_cast<const char *>(std::memchr(position, '"', size_t(newline - position)));
+        if (!quote) {
+            return newline;
+        }
+        // an escaped quote "" closes and reopens the quoted range, thus needs no special handling
+        const char *closingQuote = static_cast<const char *>(std::memchr(quote + 1, '"', size_t(end - quote - 1)));
+        if (!closingQuote) {
+            return end;
+        }
+        position = closingQuote + 1;
+    }
+}
+
+/**
+ * Read the record at @p position and advance @p position to the begin of the next record. The
+ * record range [@p recordBegin, @p recordEnd) does not contain the line terminator.
+ */
+void readRecord(const char *&position, const char *end, const char *&recordBegin, const char *&recordEnd)
+{
+    recordBegin = position;
+    recordEnd = findRecordEnd(position, end);
+    position = recordEnd == end ? end : recordEnd + 1;
+    if (recordEnd > recordBegin && *(recordEnd - 1) == '\r') {
+        --recordEnd;
+    }
+}
+
+/**
+ * Split [@p begin, @p end) into chunks of complete records. Line boundaries of TextChunk::split()
+ * that are inside of quoted fields are moved behind the end of the record.
+ */
+QVector<TextChunk> splitRecords(const char *begin, const char *end)
+{
+    const QVector<TextChunk> lineChunks = TextChunk::split(begin, end);
+    QVector<TextChunk> chunks;
+    chunks.reserve(lineChunks.size());
+    const char *chunkBegin = begin;
+    for (int i = 1; i < lineChunks.size(); ++i) {
+        const char *boundary = lineChunks.at(i).begin();
+        if (boundary <= chunkBegin) {
+            continue;
+        }
+        // chunks begin outside of quotes, thus an odd number of quotes means the boundary is inside
+        if (std::count(chunkBegin, boundary, '"') % 2 != 0) {
+            const char *closingQuote = static_cast<const char *>(std::memchr(boundary, '"', size_t(end - boundary)));
+            const char *recordBegin;
+            const char *recordEnd;
+            boundary = closingQuote ? closingQuote + 1 : end;
+            readRecord(boundary, end, recordBegin, recordEnd);
+        }
+        if (boundary == end) {
+            break;
+        }
+        chunks.append(TextChunk(chunkBegin, boundary));
+        chunkBegin = boundary;
+    }
+    chunks.append(TextChunk(chunkBegin, end));
+    return chunks;
+}
+
+/**
+ * Parse the field at @p position and advance @p position to the delimiter behind the field. If
+ * @p number is given, it is set to the numeric value of the field, or NaN if it is no number.
+ */
+bool parseField(const char *&position, const char *end, char delimiter, QString &value, qreal *number)
+{
+    if (position == end || *position != '"') {
+        const char *next = static_cast<const char *>(std::memchr(position, delimiter, size_t(end - position)));
+        next = next ? next : end;
+        value = QString::fromUtf8(position, int(next - position));
+        if (number) {
+            *number = parseNumber(position, next);
+        }
+        position = next;
+        return true;
+    }
+
+    QByteArray field;
+    const char *current = position + 1;
+    forever {
+        const char *quote = static_cast<const char *>(std::memchr(current, '"', size_t(end - current)));
+        if (!quote) {
+            return false;
+        }
+        field.append(current, int(quote - current));
+        current = quote + 1;
+        if (current == end || *current != '"') {
+            break;
+        }
+        field.append('"'); // escaped quote
+        ++current;
+    }
+    if (current != end && *current != delimiter) {
+        return false;
+    }
+    value = QString::fromUtf8(field);
+    if (number) {
+        *number = parseNumber(field.constData(), field.constData() + field.size());
+    }
+    position = current;
+    return true;
+}
+
+/**
+ * Append all fields of the record [@p position, @p end) to @p fields and, if given, their
+ * numeric values to @p numbers.
+ *
+ * @return number of fields of the record, or -1 if the record could not be parsed
+ */
+int parseLine(const char *position, const char *end, char delimiter, QVector<QString> &fields, QVector<qreal> *numbers = 0)
+{
+    int count = 0;
+    forever {
+        QString value;
+        qreal number;
+        if (!parseField(position, end, delimiter, value, numbers ? &number : 0)) {
+            return -1;
+        }
+        fields.append(value);
+        if (numbers) {
+            numbers->append(number);
+        }
+        ++count;
+        if (position == end) {
+            return count;
+        }
+        ++position; // skip delimiter
+    }
+}
+
+void parseChunk(const TextChunk &chunk, char delimiter, int columns, CsvChunk &result)
+{
+    result.textColumns.fill(false, columns);
+    const char *position = chunk.begin();
+    const char *record;
+    const char *recordEnd;
+    while (position < chunk.end()) {
+        readRecord(position, chunk.end(), record, recordEnd);
+        if (record == recordEnd) {
+            continue;
+        }
+        if (parseLine(record, recordEnd, delimiter, result.fields, &result.numbers) != columns) {
+            result.error = record;
+            return;
+        }
+        for (int i = result.fields.size() - columns; i < result.fields.size(); ++i) {
+            if (qIsNaN(result.numbers.at(i)) && !result.fields.at(i).isEmpty()) {
+                result.textColumns[i % columns] = true;
+            }
+        }
+    }
+}
+
+/**
+ * @return the most frequent of the delimiters ',', ';' and tab in the line [@p begin, @p end)
+ */
+char detectDelimiter(const char *begin, const char *end)
+{
+    const char delimiters[] = { ',', ';', '\t' };
+    char delimiter = ',';
+    qint64 maximum = 0;
+    for (char candidate : delimiters) {
+        const qint64 count = std::count(begin, end, candidate);
+        if (count > maximum) {
+            delimiter = candidate;
+            maximum = count;
+        }
+    }
+    return delimiter;
+}
+}
+
+CsvFileFormat::CsvFileFormat(QObject* parent, const QList< QVariant >&)
+    : FileFormatInterface("rocs_csvfileformat", parent)
+{
+}
+
+CsvFileFormat::~CsvFileFormat()
+{
+}
+
+const QStringList CsvFileFormat::extensions() const
+{
+    return QStringList()
+           << i18n("Comma Separated Values (%1)", QString("*.csv"));
+}
+
+FileFormatInterface::PluginType CsvFileFormat::pluginCapability() const
+{
+    return FileFormatInterface::ImportOnly;
+}
+
+void CsvFileFormat::writeFile(GraphDocumentPtr document)
+{
+    Q_UNUSED(document);
+    qCWarning(GRAPHTHEORY_FILEFORMAT) << "This plugin cannot export documents.";
+    setError(NotSupportedOperation);
+}
+
+void CsvFileFormat::readFile()
+{
+    QFile fileHandle(file().toLocalFile());
+    if (!fileHandle.open(QFile::ReadOnly)) {
+        setError(CouldNotOpenFile, i18n("Could not open file \"%1\" in read mode: %2", file().toLocalFile(), fileHandle.errorString()));
+        return;
+    }
+    const TextFile content(&fileHandle);
+
+    // read header, skipping the byte order mark that is written by some spreadsheet applications
+    const char *headerBegin = content.begin();
+    if (content.end() - headerBegin >= 3 && std::memcmp(headerBegin, "\xEF\xBB\xBF", 3) == 0) {
+        headerBegin += 3;
+    }
+    if (headerBegin == content.end()) {
+        setError(NoGraphFound, i18n("File \"%1\" does not contain a header line.", file().toLocalFile()));
+        return;
+    }
+    const char *bodyBegin = headerBegin;
+    const char *headerEnd;
+    readRecord(bodyBegin, content.end(), headerBegin, headerEnd);
+    QVector<QString> names;
+    const char delimiter = detectDelimiter(headerBegin, headerEnd);
+    const int columns = parseLine(headerBegin, headerEnd, delimiter, names);
+    if (columns < 2) {
+        setError(EncodingProblem, i18n("Could not parse file \"%1\": the header must name at least two columns.", file().toLocalFile()));
+        return;
+    }
+    int sourceColumn = -1;
+    int targetColumn = -1;
+    for (int i = 0; i < columns; ++i) {
+        names[i] = names.at(i).trimmed();
+        const QString name = names.at(i).toLower();
+        if (name == QLatin1String("source") || name == QLatin1String("from")) {
+            sourceColumn = i;
+        } else if (name == QLatin1String("target") || name == QLatin1String("to")) {
+            targetColumn = i;
+        }
+    }
+    if (sourceColumn < 0) {
+        sourceColumn = targetColumn == 0 ? 1 : 0;
+    }
+    if (targetColumn < 0) {
+        targetColumn = sourceColumn == 0 ? 1 : 0;
+    }
+
+    // parse chunks of the file in parallel, the document is only modified afterwards
+    const QVector<TextChunk> chunks = splitRecords(bodyBegin, content.end());
+    QVector<CsvChunk> results(chunks.size());
+    TextChunk::parallelFor(chunks.size(), [&chunks, &results, delimiter, columns](int index) {
+        parseChunk(chunks.at(index), delimiter, columns, results[index]);
+    });
+    foreach (const CsvChunk &result, results) {
+        if (result.error) {
+            setError(EncodingProblem, i18n("Could not parse file \"%1\": line %2 does not have %3 fields.", file().toLocalFile(), TextChunk::lineNumber(content.begin(), result.error), columns));
+            return;
+        }
+    }
+
+    GraphDocumentPtr document = GraphDocument::create();
+    const PropertyKey nameKey(QStringLiteral("name"));
+    document->nodeTypes().first()->addDynamicProperty(nameKey.name());
+    QVector<PropertyKey> keys(columns);
+    for (int i = 0; i < columns; ++i) {
+        if (i != sourceColumn && i != targetColumn && !names.at(i).isEmpty()) {
+            document->edgeTypes().first()->addDynamicProperty(names.at(i));
+            keys[i] = PropertyKey(names.at(i));
+        }
+    }
+
+    // columns whose non-empty fields are all numbers are imported as numbers, others as text
+    QVector<bool> numericColumns(columns, true);
+    foreach (const CsvChunk &result, results) {
+        for (int i = 0; i < columns; ++i) {
+            numericColumns[i] = numericColumns.at(i) && !result.textColumns.at(i);
+        }
+    }
+
+    // create nodes in order of their first occurrence
+    QHash<QString, NodePtr> nodes;
+    auto node = [&document, &nodes, &nameKey](const QString &name) {
+        NodePtr &entry = nodes[name];
+        if (!entry) {
+            entry = Node::create(document);
+            entry->setDynamicProperty(nameKey, name);
+        }
+        return entry;
+    };
+    BulkUpdateGuard bulkUpdate(document);
+    foreach (const CsvChunk &result, results) {
+        for (int row = 0; row < result.fields.size(); row += columns) {
+            const QString *fields = result.fields.constData() + row;
+            const qreal *numbers = result.numbers.constData() + row;
+            EdgePtr edge = Edge::create(node(fields[sourceColumn]), node(fields[targetColumn]));
+            for (int i = 0; i < columns; ++i) {
+                if (!keys.at(i).isValid() || fields[i].isEmpty()) {
+                    continue;
+                }
+                if (numericColumns.at(i)) {
+                    edge->setDynamicProperty(keys.at(i), numbers[i]);
+                } else {
+                    edge->setDynamicProperty(keys.at(i), fields[i]);
+                }
+            }
+        }
+    }
+    bulkUpdate.release();
+
+    // force directed alignment does not scale to large graphs, e.g., exported edge tables
+    const int maxAlignedNodes = 10000;
+    Topology layouter;
+    if (document->nodes().count() > maxAlignedNodes) {
+        layouter.applyCircleAlignment(document->nodes(), 300);
+    } else {
+        layouter.directedGraphDefaultTopology(document);
+    }
+    setGraphDocument(document);
+    setError(None);
+}
+
+#include "csvfileformat.moc"
@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CSVFILEFORMAT_H
+#define CSVFILEFORMAT_H
+
+#include "fileformats/fileformatinterface.h"
+
+namespace GraphTheory
+{
+
+/** \brief import plugin for edge tables in CSV format
+ *
+ * Edge tables are exported by spreadsheets, databases and most graph tools. Large files are
+ * parsed in parallel chunks directly from the memory mapped file.
+ *
+ * Format Specification:
+ *  - The first line is a header that names the columns. Fields are separated by ',', ';' or tab,
+ *    whichever occurs most often in the header.
+ *  - Each further line describes one directed edge. Start and end node are given by the columns
+ *    named "source" and "target" (or "from" and "to", in any case), otherwise by the first two
+ *    columns. Nodes are identified by these values, which are imported as node property "name".
+ *  - All other columns are imported as edge properties named by the header. Columns whose
+ *    non-empty fields are all decimal numbers are imported as numbers, others as text.
+ *  - Fields may be enclosed in double quotes, a quote inside such a field is written as "".
+ *    Quoted fields may contain line breaks.
+ *  - Each line must have as many fields as the header. Empty lines are ignored.
+ */
+class CsvFileFormat : public FileFormatInterface
+{
+    Q_OBJECT
+public:
+    explicit CsvFileFormat(QObject *parent, const QList< QVariant >&);
+    ~CsvFileFormat();
+
+    /**
+     * File extensions that are common for this file type.
+     */
+    const QStringList extensions() const Q_DECL_OVERRIDE;
+
+    /**
+     * CSV files can only be imported.
+     */
+    FileFormatInterface::PluginType pluginCapability() const Q_DECL_OVERRIDE;
+
+    /**
+     * Not supported, CSV files cannot be written.
+     */
+    void writeFile(GraphDocumentPtr graph) Q_DECL_OVERRIDE;
+
+    /**
+     * Open given file and imports it into internal format.
+     * \param file is url of a local file
+     */
+    void readFile() Q_DECL_OVERRIDE;
+};
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*
+    This file is part of Rocs.
+    Copyright 2026  agent <agent@local>
+
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of
+    the License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchdotfileformat.h"
+#include "../dotfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+#include "nodetype.h"
+#include "edgetype.h"
+#include <QtTest>
+#include <QUrl>
+#include <QTextStream>
+
+using namespace GraphTheory;
+
+namespace
+{
+const int nodeCount = 20000;
+const int edgeCount = 200000;
+}
+
+void DotFileFormatBenchmark::writeBenchmark()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("name");
+    document->edgeTypes().first()->addDynamicProperty("weight");
+    document->beginBulkUpdate();
+    NodeList nodes;
+    nodes.reserve(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        NodePtr node = Node::create(document);
+        node->setDynamicProperty("name", QString("node%1").arg(i));
+        nodes.append(node);
+    }
+    for (int i = 0; i < edgeCount; ++i) {
+        EdgePtr edge = Edge::create(nodes.at(i % nodeCount), nodes.at((i * 7 + 1) % nodeCount));
+        edge->setDynamicProperty("weight", i);
+    }
+    document->endBulkUpdate();
+
+    QTemporaryFile testFile;
+    testFile.open();
+    DotFileFormat dotFormat(this, QList<QVariant>());
+    dotFormat.setFile(QUrl::fromLocalFile(testFile.fileName()));
+    QBENCHMARK {
+        dotFormat.writeFile(document);
+    }
+    QVERIFY(!dotFormat.hasError());
+    document->destroy();
+}
+
+void DotFileFormatBenchmark::readBenchmark()
+{
+    QTemporaryFile testFile;
+    testFile.open();
+    QTextStream out(&testFile);
+    out << "digraph dependencies {\n";
+    for (int i = 0; i < edgeCount; ++i) {
+        out << "  \"module" << i % nodeCount << "\" -> \"module" << (i * 7 + 1) % nodeCount
+            << "\" [weight=\"" << i << "\"];\n";
+    }
+    out << "}\n";
+    out.flush();
+
+    DotFileFormat dotFormat(this, QList<QVariant>());
+    dotFormat.setFile(QUrl::fromLocalFile(testFile.fileName()));
+    QBENCHMARK {
+        dotFormat.readFile();
+    }
+    QVERIFY(!dotFormat.hasError());
+    QCOMPARE(dotFormat.graphDocument()->nodes().count(), nodeCount);
+    QCOMPARE(dotFormat.graphDocument()->edges().count(), edgeCount);
+}
+
+QTEST_MAIN(DotFileFormatBenchmark)
@@ -0,0 +1,37 @@
+/*
+    This file is part of Rocs.
+    Copyright 2026  agent <agent@local>
+
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of
+    the License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BENCHDOTFILEFORMAT_H
+#define BENCHDOTFILEFORMAT_H
+
+#include <QObject>
+
+/**
+ * Throughput of the export and import of large documents. The benchmarks are not run by ctest,
+ * start BenchDotFileFormat manually, e.g., with "-iterations 10".
+ */
+class DotFileFormatBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeBenchmark();
+    void readBenchmark();
+};
+
+#endif
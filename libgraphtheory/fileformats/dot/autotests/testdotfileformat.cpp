@@ -24,6 +24,8 @@
 #include "graphdocument.h"
 #include "node.h"
 #include "edge.h"
+#include "nodetype.h"
+#include "edgetype.h"
 #include "logging_p.h"
 #include <string>
 #include <QtTest>
@@ -82,6 +84,69 @@ void DotFileFormatTest::parseSubgraphs()
     QVERIFY(DotParser::parse(subgraph, document));
 }
 
+void DotFileFormatTest::parseEscapedQuotes()
+{
+    const std::string input = "digraph G { \"a \\\"quoted\\\" name\" -> b [label=\"x;}\"] }";
+    GraphDocumentPtr document = GraphDocument::create();
+    QVERIFY(DotParser::parse(input, document));
+    QCOMPARE(document->nodes().count(), 2);
+    QCOMPARE(document->edges().count(), 1);
+    QCOMPARE(document->nodes().first()->dynamicProperty("name").toString(), QString("a \"quoted\" name"));
+    QCOMPARE(document->edges().first()->dynamicProperty("label").toString(), QString("x;}"));
+}
+
+void DotFileFormatTest::parseErrorRecovery()
+{
+    const QByteArray input = "digraph G {\n"
+                             "  a -> b;\n"
+                             "  c -> -> d;\n"
+                             "  e -> f;\n"
+                             "}\n";
+    GraphDocumentPtr document = GraphDocument::create();
+    QStringList messages;
+    QVERIFY(DotParser::parse(input.constData(), input.constData() + input.size(), document, &messages));
+    QCOMPARE(messages.count(), 1);
+    QVERIFY2(messages.first().startsWith("line 3, column 3:"), messages.first().toUtf8().constData());
+    QCOMPARE(document->nodes().count(), 4);
+    QCOMPARE(document->edges().count(), 2);
+
+    // elements of statements that are only partially parsed are removed again, elements of
+    // alternatives that the parser backtracked from are not duplicated
+    const QByteArray partial = "digraph G {\n"
+                               "  a -> ;\n"
+                               "  b -> c -> ;\n"
+                               "  subgraph { d -> e }\n"
+                               "  f [x=1] [y=2];\n"
+                               "}\n";
+    document = GraphDocument::create();
+    messages.clear();
+    QVERIFY(DotParser::parse(partial.constData(), partial.constData() + partial.size(), document, &messages));
+    QCOMPARE(messages.count(), 2);
+    QCOMPARE(document->nodes().count(), 3);
+    QCOMPARE(document->edges().count(), 1);
+    QCOMPARE(document->nodes().last()->dynamicProperty("y").toString(), QString("2"));
+
+    // input after the end of the graph is an error
+    const QByteArray trailing = "digraph G {\n"
+                                "  a -> b;\n"
+                                "}\n"
+                                "}\n";
+    document = GraphDocument::create();
+    messages.clear();
+    QVERIFY(!DotParser::parse(trailing.constData(), trailing.constData() + trailing.size(), document, &messages));
+    QCOMPARE(messages.count(), 1);
+    QVERIFY2(messages.first().startsWith("line 4, column 1:"), messages.first().toUtf8().constData());
+
+    // unterminated graph cannot be recovered, the error refers to the end of the last statement
+    const QByteArray truncated = "digraph G {\n"
+                                 "  a -> b;\n";
+    document = GraphDocument::create();
+    messages.clear();
+    QVERIFY(!DotParser::parse(truncated.constData(), truncated.constData() + truncated.size(), document, &messages));
+    QCOMPARE(messages.count(), 1);
+    QVERIFY2(messages.first().startsWith("line 2, column 10:"), messages.first().toUtf8().constData());
+}
+
 void DotFileFormatTest::parseFileER()
 {
     // create importer plugin
@@ -722,4 +787,38 @@ void DotFileFormatTest::writeAndParseTest()
     QCOMPARE(document->edges().count(), 1);
 }
 
+void DotFileFormatTest::writeFormatTest()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("name");
+    document->nodeTypes().first()->addDynamicProperty("weight");
+    document->edgeTypes().first()->addDynamicProperty("weight");
+
+    NodePtr from = Node::create(document);
+    from->setDynamicProperty("name", "a");
+    from->setDynamicProperty("weight", 3);
+    NodePtr to = Node::create(document);
+    to->setDynamicProperty("name", QString::fromUtf8("\xc3\xa4\xe2\x82\xac"));
+    Edge::create(from, to)->setDynamicProperty("weight", 2.5);
+    Edge::create(to, from);
+
+    QTemporaryFile testFile;
+    testFile.open();
+    DotFileFormat dotFormat(this, QList<QVariant>());
+    dotFormat.setFile(QUrl::fromLocalFile(testFile.fileName()));
+    dotFormat.writeFile(document);
+    QVERIFY(!dotFormat.hasError());
+
+    const QString expected = QString("digraph {\n"
+        "%1 [ label=\"a\" ,  name = \"a\" ,  weight = \"3\" ];\n"
+        "%2 [ label=\"%3\" ,  name = \"%3\" ,  weight = \"\" ];\n"
+        " %1 -> %2 [ weight = \"2.5\" ];\n"
+        " %2 -> %1 [ weight = \"\" ];\n"
+        "}\n")
+        .arg(from->id())
+        .arg(to->id())
+        .arg(to->dynamicProperty("name").toString());
+    QCOMPARE(QString::fromUtf8(testFile.readAll()), expected);
+}
+
 QTEST_MAIN(DotFileFormatTest)
@@ -40,6 +40,8 @@ private slots:
     void init();
     void simpleGraphParsing();
     void parseSubgraphs();
+    void parseEscapedQuotes();
+    void parseErrorRecovery();
 
     // parsing tests for undirected example graphs
     void parseFileER();
@@ -106,6 +108,7 @@ private slots:
 
     // parsing of exported files
     void writeAndParseTest();
+    void writeFormatTest();
 };
 
 #endif
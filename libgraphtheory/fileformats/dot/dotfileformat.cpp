@@ -20,22 +20,22 @@
 
 #include "dotfileformat.h"
 #include "fileformats/fileformatinterface.h"
+#include "fileformats/textwriter_p.h"
 #include "modifiers/topology.h"
 #include "graphdocument.h"
 #include "node.h"
 #include "edge.h"
+#include "nodetype.h"
+#include "edgetype.h"
 #include <KLocalizedString>
 #include <KPluginFactory>
 #include <QFile>
-#include <QTextStream>
 #include <QUrl>
 #include <QHash>
 #include <QVector>
 #include "dotgrammarhelper.h"
 #include "dotgrammar.h"
 
-extern DotParser::DotGraphParsingHelper* phelper;
-
 using namespace GraphTheory;
 
 K_PLUGIN_FACTORY_WITH_JSON( FilePluginFactory,
@@ -62,100 +62,124 @@ void DotFileFormat::readFile()
     GraphDocumentPtr document = GraphDocument::create();
     setGraphDocument(document);
 
-    QList < QPair<QString, QString> > edges;
     QFile fileHandle(file().toLocalFile());
     if (!fileHandle.open(QFile::ReadOnly)) {
         setError(CouldNotOpenFile, i18n("Could not open file \"%1\" in read mode: %2", file().toLocalFile(), fileHandle.errorString()));
         return;
     }
-    QString content = fileHandle.readAll();
-    if (!DotParser::parse(content.toStdString(), document)) {
-        setError(EncodingProblem, i18n("Could not parse file \"%1\".", file().toLocalFile()));
+
+    // parse the UTF-8 encoded file content in place; map the file if possible, otherwise read it at once
+    QByteArray content;
+    qint64 size = fileHandle.size();
+    const char *data = reinterpret_cast<const char *>(fileHandle.map(0, size));
+    if (!data) {
+        content = fileHandle.readAll();
+        data = content.constData();
+        size = content.size();
+    }
+    QStringList messages;
+    BulkUpdateGuard bulkUpdate(document);
+    const bool parsed = DotParser::parse(data, data + size, document, &messages);
+    bulkUpdate.release();
+    if (!parsed) {
+        setError(EncodingProblem, i18n("Could not parse file \"%1\": %2", file().toLocalFile(), messages.last()));
         return;
     }
+
+    // force directed alignment does not scale to large graphs, e.g., generated dependency graphs
+    const int maxAlignedNodes = 10000;
     Topology layouter;
-    layouter.directedGraphDefaultTopology(document);
-     setError(None);
+    if (document->nodes().count() > maxAlignedNodes) {
+        layouter.applyCircleAlignment(document->nodes(), 300);
+    } else {
+        layouter.directedGraphDefaultTopology(document);
+    }
+
+    if (!messages.isEmpty()) {
+        // keep the document with all parsed statements, but report the first skipped statement
+        setError(EncodingProblem, i18n("Could not parse file \"%1\": %2", file().toLocalFile(), messages.first()));
+        return;
+    }
+    setError(None);
 }
 
 void DotFileFormat::writeFile(GraphDocumentPtr document)
 {
     // prepare file handle for output
     QFile fileHandle(file().toLocalFile());
-    QVariantList subgraphs;
     if (!fileHandle.open(QFile::WriteOnly | QFile::Text)) {
         setError(FileIsReadOnly, i18n("Cannot open file %1 to write document. Error: %2", file().fileName(), fileHandle.errorString()));
         return;
     }
-    QTextStream out(&fileHandle);
-
-    out << "digraph {\n";
+    TextWriter out(&fileHandle);
 
-    // create fast access list of already processed nodes: serialize each node only once
-    QHash<int, bool> processedData;
-
-    // process all data elements
-    foreach(NodePtr node, document->nodes()) {
-        out << processNode(node);
+    // resolve dynamic properties once per type instead of once per element
+    const PropertyKey name(QStringLiteral("name"));
+    QHash<NodeType*, PropertyList> nodeProperties;
+    foreach (const NodeTypePtr &type, document->nodeTypes()) {
+        nodeProperties.insert(type.data(), PropertyList(type->dynamicProperties()));
+    }
+    QHash<EdgeType*, PropertyList> edgeProperties;
+    foreach (const EdgeTypePtr &type, document->edgeTypes()) {
+        edgeProperties.insert(type.data(), PropertyList(type->dynamicProperties()));
     }
 
-    // process all edges
-    for (auto const edge : document->edges()) {
-        out << processEdge(edge);
+    out << "digraph {\n";
+    for (auto const &node : document->nodes()) {
+        writeNode(out, node, nodeProperties[node->type().data()], name);
+    }
+    for (auto const &edge : document->edges()) {
+        writeEdge(out, edge, edgeProperties[edge->type().data()]);
     }
     out << "}\n";
+
+    if (!out.flush()) {
+        setError(Unknown, i18n("Could not write document to file %1. Error: %2", file().fileName(), fileHandle.errorString()));
+        return;
+    }
     setError(None);
-    return;
 }
 
-QString DotFileFormat::processEdge(EdgePtr edge) const
+void DotFileFormat::writeEdge(TextWriter &out, const EdgePtr &edge, const PropertyList &properties) const
 {
-    QString edgeStr;
-    edgeStr.append(QString(" %1 -> %2 ")
-                .arg(edge->from()->id())
-                .arg(edge->to()->id()));
+    out << ' ' << edge->from()->id() << " -> " << edge->to()->id() << ' ';
 
     // process properties if present
     bool firstProperty = true;
-    if (!edge->property("name").toString().isEmpty()) {
+    const QVariant label = edge->property("name");
+    if (label.isValid() && !label.toString().isEmpty()) {
         firstProperty = false;
-        edgeStr.append("[");
-        edgeStr.append(QString(" label = \"%2\" ").arg(edge->property("name").toString()));
-    }
-    foreach(const QByteArray& property, edge->dynamicPropertyNames()) {
-        if (firstProperty == true) {
-                firstProperty = false;
-                edgeStr.append("[");
-            } else {
-                edgeStr.append(", ");
-        }
-        edgeStr.append(QString(" %1 = \"%2\" ").arg(QString(property)).arg(edge->property(property).toString()));
+        out << "[ label = \"" << label << "\" ";
+    }
+    for (int i = 0; i < properties.size(); ++i) {
+        out << (firstProperty ? "[" : ", ");
+        firstProperty = false;
+        out << ' ' << properties.name(i) << " = \"" << edge->dynamicProperty(properties.key(i)) << "\" ";
     }
     if (!firstProperty) { // at least one property was inserted
-        edgeStr.append("]");
+        out << ']';
     }
-    return edgeStr.append(";\n");
+    out << ";\n";
 }
 
-QString DotFileFormat::processNode(NodePtr node) const
+void DotFileFormat::writeNode(TextWriter &out, const NodePtr &node, const PropertyList &properties, const PropertyKey &name) const
 {
-    QString nodeStr;
-
     // use identifier for unique identification, store name as argument "label"
-    nodeStr = QString("%1").arg(node->id());
-    nodeStr.append(" [ ");
-    if (!node->dynamicProperty("name").toString().isEmpty()) {
-        nodeStr.append(QString("label=\"%1\" ").arg(node->dynamicProperty("name").toString()));
+    out << node->id() << " [ ";
+    bool firstProperty = true;
+    const QVariant label = node->dynamicProperty(name);
+    if (label.isValid() && !label.toString().isEmpty()) {
+        firstProperty = false;
+        out << "label=\"" << label << "\" ";
     }
-
-    foreach(const QByteArray& property, node->dynamicPropertyNames()) {
-        nodeStr.append(", ");
-        nodeStr.append(QString(" %1 = \"%2\" ").arg(QString(property)).arg(node->property(property).toString()));
+    for (int i = 0; i < properties.size(); ++i) {
+        if (!firstProperty) {
+            out << ", ";
+        }
+        firstProperty = false;
+        out << ' ' << properties.name(i) << " = \"" << node->dynamicProperty(properties.key(i)) << "\" ";
     }
-
-    // at least one property was inserted
-    nodeStr.append("]");
-    return nodeStr.append(";\n");
+    out << "];\n";
 }
 
 #include "dotfileformat.moc"
@@ -26,6 +26,9 @@
 
 namespace GraphTheory
 {
+class PropertyKey;
+class PropertyList;
+class TextWriter;
 
 class DotFileFormat : public FileFormatInterface
 {
@@ -52,8 +55,8 @@ public:
     void readFile() Q_DECL_OVERRIDE;
 
 private:
-    QString processNode(NodePtr node) const;
-    QString processEdge(EdgePtr edge) const;
+    void writeNode(TextWriter &out, const NodePtr &node, const PropertyList &properties, const PropertyKey &name) const;
+    void writeEdge(TextWriter &out, const EdgePtr &edge, const PropertyList &properties) const;
 
 };
 }
@@ -21,14 +21,19 @@
 #include "typenames.h"
 #include "graphdocument.h"
 #include "node.h"
+#include "edgetype.h"
 #include "logging_p.h"
 
+#include <QByteArray>
+#include <algorithm>
+
 #include <boost/spirit/include/qi.hpp>
 #include <boost/spirit/include/qi_int.hpp>
 #include <boost/spirit/include/qi_real.hpp>
 #include <boost/spirit/include/qi_string.hpp>
 #include <boost/spirit/repository/include/qi_distinct.hpp>
 #include <boost/spirit/repository/include/qi_confix.hpp>
+#include <boost/spirit/include/phoenix_bind.hpp>
 #include <boost/spirit/include/phoenix_core.hpp>
 #include <boost/spirit/include/phoenix_operator.hpp>
 #include <boost/spirit/include/phoenix_stl.hpp>
@@ -155,111 +160,191 @@ using boost::spirit::qi::_1;
 using boost::spirit::qi::_val;
 using boost::spirit::qi::char_;
 using boost::spirit::qi::eol;
+using boost::spirit::qi::eps;
 using boost::spirit::qi::int_;
 using boost::spirit::qi::lexeme;
 using boost::spirit::qi::phrase_parse;
+using boost::spirit::qi::raw;
 using boost::spirit::qi::rule;
 using boost::spirit::qi::standard::space_type;
 using boost::spirit::repository::qi::confix;
 
 typedef BOOST_TYPEOF(SKIPPER) skipper_type;
 
-DotGraphParsingHelper* phelper = 0;
+// The parser works directly on the UTF-8 encoded input. Identifiers are not copied while parsing,
+// but passed as ranges of the input to the semantic actions.
+typedef const char * Iterator;
+typedef boost::iterator_range<Iterator> Token;
+
+void setStrict();
+void setUndirected(DotGraphParsingHelper *helper);
+void setDirected(DotGraphParsingHelper *helper);
+void setGraphId(const Token &token);
+void attributeId(DotGraphParsingHelper *helper, const Token &token);
+void subGraphId(DotGraphParsingHelper *helper, const Token &token);
+void valid(DotGraphParsingHelper *helper, const Token &token);
+void insertAttributeIntoAttributeList(DotGraphParsingHelper *helper);
+void createAttributeList(DotGraphParsingHelper *helper);
+void removeAttributeList(DotGraphParsingHelper *helper);
+void createSubGraph(DotGraphParsingHelper *helper);
+void leaveSubGraph(DotGraphParsingHelper *helper);
+void createNode(DotGraphParsingHelper *helper, const Token &token);
+void setGraphAttributes(DotGraphParsingHelper *helper);
+void setNodeAttributes(DotGraphParsingHelper *helper);
+void applyAttributeList(DotGraphParsingHelper *helper);
+void checkEdgeOperator(DotGraphParsingHelper *helper, const Token &token);
+void edgebound(DotGraphParsingHelper *helper, const Token &token);
+void createEdge(DotGraphParsingHelper *helper);
+void beginStatement(DotGraphParsingHelper *helper);
+void commitStatement(DotGraphParsingHelper *helper);
+void rollbackStatement(DotGraphParsingHelper *helper);
+void statementParsed(DotGraphParsingHelper *helper, const Token &token);
+void skipStatement(DotGraphParsingHelper *helper, const Token &token);
 
 template <typename Iterator, typename Skipper = space_type>
 struct DotGrammar : boost::spirit::qi::grammar<Iterator, Skipper> {
 
-    DotGrammar() : DotGrammar::base_type(graph) {
+    explicit DotGrammar(DotGraphParsingHelper &helper) : DotGrammar::base_type(graph) {
+        DotGraphParsingHelper * const h = &helper;
 
         graph = -distinct::keyword["strict"][&setStrict]
-                >> (distinct::keyword["graph"][&setUndirected] | distinct::keyword["digraph"][&setDirected])
+                >> (distinct::keyword["graph"][phx::bind(&setUndirected, h)] | distinct::keyword["digraph"][phx::bind(&setDirected, h)])
                 >> -ID[&setGraphId]
                 >> '{'
                 >> stmt_list
                 >> '}';
 
-        stmt_list = stmt >> -char_(';') >> -stmt_list;
-
-        stmt = (    (ID[&attributeId] >> '=' >> ID[&valid])[&applyAttributeList]
-                    | attr_stmt
-                    | edge_stmt
-                    | node_stmt
+        // statements are parsed iteratively, such that the stack depth does not depend on the
+        // number of statements; a statement that cannot be parsed is skipped
+        stmt_list = *statement;
+
+        // the parser backtracks when an alternative fails after its first elements were parsed;
+        // the elements created by semantic actions of the failed alternative are removed again
+        begin_stmt = eps[phx::bind(&beginStatement, h)];
+        commit_stmt = eps[phx::bind(&commitStatement, h)];
+        rollback_stmt = eps[phx::bind(&rollbackStatement, h)] >> !eps;
+
+        // a statement only counts as parsed if it ends where a new statement may begin, otherwise
+        // "a -> ;" would be read as node statement "a" followed by an erroneous statement "-> ;"
+        statement = (begin_stmt >> raw[stmt >> !(edgeop | char_("=[],:")) >> -char_(';')][phx::bind(&statementParsed, h, _1)] >> commit_stmt)
+                    | rollback_stmt
+                    | skipped_stmt;
+
+        stmt = (    (begin_stmt >> (ID[phx::bind(&attributeId, h, _1)] >> '=' >> ID[phx::bind(&valid, h, _1)])[phx::bind(&applyAttributeList, h)] >> commit_stmt)
+                    | rollback_stmt
+                    | (begin_stmt >> attr_stmt >> commit_stmt)
+                    | rollback_stmt
+                    | (begin_stmt >> edge_stmt >> commit_stmt)
+                    | rollback_stmt
+                    | (begin_stmt >> node_stmt >> commit_stmt)
+                    | rollback_stmt
                     | subgraph
                 );
 
-        attr_stmt = ( (distinct::keyword["graph"][phx::ref(phelper->attributed)="graph"] >> attr_list[&applyAttributeList])[&setGraphAttributes]
-                    | (distinct::keyword["node"][phx::ref(phelper->attributed)="node"] >> attr_list[&applyAttributeList])
-                    | (distinct::keyword["edge"][phx::ref(phelper->attributed)="edge"] >> attr_list[&applyAttributeList])
+        // skip input up to the end of the statement, but never the end of the enclosing graph
+        skipped_stmt = raw[lexeme[(+(char_ - char_("};\n")) >> -char_(";\n")) | char_(";\n")]][phx::bind(&skipStatement, h, _1)];
+
+        attr_stmt = ( (distinct::keyword["graph"][phx::ref(helper.attributed)="graph"] >> attr_list[phx::bind(&applyAttributeList, h)])[phx::bind(&setGraphAttributes, h)]
+                    | (distinct::keyword["node"][phx::ref(helper.attributed)="node"] >> attr_list[phx::bind(&applyAttributeList, h)])
+                    | (distinct::keyword["edge"][phx::ref(helper.attributed)="edge"] >> attr_list[phx::bind(&applyAttributeList, h)])
                     );
 
-        attr_list = '[' >> -a_list >>']';
+        attr_list = +('[' >> -a_list >> ']');
 
-        a_list = (ID[&attributeId] >> -('=' >> ID[&valid]))[&insertAttributeIntoAttributeList]
+        a_list = (ID[phx::bind(&attributeId, h, _1)] >> -('=' >> ID[phx::bind(&valid, h, _1)]))[phx::bind(&insertAttributeIntoAttributeList, h)]
                  >> -char_(',') >> -a_list;
 
         edge_stmt = (
-                        (node_id[&edgebound] | subgraph) >> edgeRHS >> -(attr_list[phx::ref(phelper->attributed)="edge"])
-                    )[&createAttributeList][&applyAttributeList][&createEdge][&removeAttributeList];
+                        (node_id[phx::bind(&edgebound, h, _1)] | subgraph) >> edgeRHS >> -(attr_list[phx::ref(helper.attributed)="edge"])
+                    )[phx::bind(&createAttributeList, h)][phx::bind(&applyAttributeList, h)][phx::bind(&createEdge, h)][phx::bind(&removeAttributeList, h)];
 
-        edgeRHS = edgeop[&checkEdgeOperator] >> (node_id[&edgebound] | subgraph) >> -edgeRHS;
+        edgeRHS = +(edgeop[phx::bind(&checkEdgeOperator, h, _1)] >> (node_id[phx::bind(&edgebound, h, _1)] | subgraph));
 
         node_stmt  = (
-                         node_id[&createNode] >> -attr_list
-                     )[phx::ref(phelper->attributed)="node"][&createAttributeList][&applyAttributeList][&setNodeAttributes][&removeAttributeList];
+                         node_id[phx::bind(&createNode, h, _1)] >> -attr_list
+                     )[phx::ref(helper.attributed)="node"][phx::bind(&createAttributeList, h)][phx::bind(&applyAttributeList, h)][phx::bind(&setNodeAttributes, h)][phx::bind(&removeAttributeList, h)];
 
-        node_id = ID >> -port;
+        node_id = ID[_val = _1] >> -port;
 
         port = (':' >> ID >> -(':' >> compass_pt))
                | (':' >> compass_pt);
 
-        subgraph = -(distinct::keyword["subgraph"] >> -ID[&subGraphId])
-                   >> char_('{')[&createSubGraph][&createAttributeList]
+        subgraph = -(distinct::keyword["subgraph"] >> -ID[phx::bind(&subGraphId, h, _1)])
+                   >> char_('{')[phx::bind(&createSubGraph, h)][phx::bind(&createAttributeList, h)]
                    >> stmt_list
-                   >> char_('}')[&leaveSubGraph][&removeAttributeList];
+                   >> char_('}')[phx::bind(&leaveSubGraph, h)][phx::bind(&removeAttributeList, h)];
 
         compass_pt  = (distinct::keyword["n"] | distinct::keyword["ne"] | distinct::keyword["e"]
                     | distinct::keyword["se"] | distinct::keyword["s"] | distinct::keyword["sw"]
                     | distinct::keyword["w"] | distinct::keyword["nw"]);
 
-        edgeop = string("->") | string("--");
+        edgeop = raw[string("->") | string("--")];
 
-        ID = lexeme[
+        ID = raw[lexeme[
                 // parse alpha-numeric sequence that is not a keyword
                 ( !(distinct::keyword["graph"] | distinct::keyword["edge"] | distinct::keyword["node"])
                     >> char_("a-zA-Z0-9") >> *char_("a-zA-Z0-9_")
                 )
                 // parse number
                 | (-char_('-') >> ('.' >> +digit) | (+digit >> -('.' >> *digit)))
-                // parse anything that is in quotation marks
-                | ('"' >>  *(char_ - '"') >>  '"')
+                // parse anything that is in quotation marks, quotation marks may be escaped
+                | ('"' >> *(('\\' >> char_) | (char_ - '"')) >> '"')
                 // parse XML attribute sequence
                 | ('<' >>  *(char_ - '>')  >>  '>') //TODO xml parser does not parse interlaced tags
-             ];
+             ]];
     }
 
     rule<Iterator,                Skipper> graph;
-    rule<Iterator, std::string(), Skipper> ID;
+    rule<Iterator, Token(),       Skipper> ID;
     rule<Iterator,                Skipper> stmt_list;
+    rule<Iterator,                Skipper> statement;
+    rule<Iterator,                Skipper> begin_stmt;
+    rule<Iterator,                Skipper> commit_stmt;
+    rule<Iterator,                Skipper> rollback_stmt;
     rule<Iterator,                Skipper> stmt;
+    rule<Iterator,                Skipper> skipped_stmt;
     rule<Iterator,                Skipper> attr_stmt;
     rule<Iterator,                Skipper> attr_list;
     rule<Iterator,                Skipper> a_list;
     rule<Iterator,                Skipper> edge_stmt;
-    rule<Iterator, std::string(), Skipper> edgeop;
+    rule<Iterator, Token(),       Skipper> edgeop;
     rule<Iterator,                Skipper> edgeRHS;
     rule<Iterator,                Skipper> node_stmt;
-    rule<Iterator, std::string(), Skipper> node_id;
-    rule<Iterator, std::string(), Skipper> port;
+    rule<Iterator, Token(),       Skipper> node_id;
+    rule<Iterator,                Skipper> port;
     rule<Iterator,                Skipper> subgraph;
-    rule<Iterator, std::string(), Skipper> compass_pt;
+    rule<Iterator,                Skipper> compass_pt;
 };
 
-void leaveSubGraph()
+/**
+ * \return identifier given by \p token without quotation marks; unless quotation marks have to be
+ * unescaped, the returned array references the input
+ */
+QByteArray identifier(const Token &token)
 {
-    if (!phelper) {
-        return;
+    Iterator first = token.begin();
+    Iterator last = token.end();
+    if (last - first >= 2 && *first == '"' && *(last - 1) == '"') {
+        ++first;
+        --last;
+        if (std::find(first, last, '\\') != last) {
+            QByteArray id;
+            id.reserve(int(last - first));
+            for (Iterator c = first; c != last; ++c) {
+                if (*c == '\\' && c + 1 != last && *(c + 1) == '"') {
+                    ++c;
+                }
+                id.append(*c);
+            }
+            return id;
+        }
     }
-    phelper->leaveSubGraph();
+    return QByteArray::fromRawData(first, int(last - first));
+}
+
+void leaveSubGraph(DotGraphParsingHelper *helper)
+{
+    helper->leaveSubGraph();
 }
 
 void setStrict()
@@ -267,161 +352,96 @@ void setStrict()
     qCCritical(GRAPHTHEORY_FILEFORMAT) << "Graphviz \"strict\" keyword is not implemented.";
 }
 
-void setUndirected()
+void setUndirected(DotGraphParsingHelper *helper)
 {
-    phelper->document->edgeTypes().first()->setDirection(EdgeType::Bidirectional);
+    helper->document->edgeTypes().first()->setDirection(EdgeType::Bidirectional);
 }
 
-void setDirected()
+void setDirected(DotGraphParsingHelper *helper)
 {
-    phelper->document->edgeTypes().first()->setDirection(EdgeType::Unidirectional);
+    helper->document->edgeTypes().first()->setDirection(EdgeType::Unidirectional);
 }
 
-void setGraphId(const std::string& str)
+void setGraphId(const Token &token)
 {
-    QString name = QString::fromStdString(str);
+    QString name = QString::fromUtf8(identifier(token));
     qCCritical(GRAPHTHEORY_FILEFORMAT) << "Graph ID not supported, _not_ setting: " << name;
     //TODO not implemented
 }
 
-void attributeId(const std::string& str)
+void attributeId(DotGraphParsingHelper *helper, const Token &token)
 {
-    if (!phelper) {
-        return;
-    }
-    // remove quotation marks
-    QString id = QString::fromStdString(str);
-    if (id.endsWith('"')) {
-        id.remove(id.length()-1, 1);
-    }
-    if (id.startsWith('"')) {
-        id.remove(0, 1);
-    }
-    phelper->attributeId = id;
-    phelper->valid.clear();
+    helper->attributeId = QString::fromUtf8(identifier(token));
+    helper->valid.clear();
 }
 
-void subGraphId(const std::string& str)
+void subGraphId(DotGraphParsingHelper *helper, const Token &token)
 {
-    if (!phelper) {
-        return;
-    }
-    // remove quotation marks
-    QString id = QString::fromStdString(str);
-    if (id.endsWith('"')) {
-        id.remove(id.length()-1, 1);
-    }
-    if (id.startsWith('"')) {
-        id.remove(0, 1);
-    }
-    phelper->setSubGraphId(id);
+    helper->setSubGraphId(QString::fromUtf8(identifier(token)));
 }
 
-void valid(const std::string& str)
+void valid(DotGraphParsingHelper *helper, const Token &token)
 {
-    if (!phelper) {
-        return;
-    }
-    // remove quotation marks
-    QString id = QString::fromStdString(str);
-    if (id.endsWith('"')) {
-        id.remove(id.length()-1, 1);
-    }
-    if (id.startsWith('"')) {
-        id.remove(0, 1);
-    }
-    phelper->valid = id;
+    helper->valid = QString::fromUtf8(identifier(token));
 }
 
-void insertAttributeIntoAttributeList()
+void insertAttributeIntoAttributeList(DotGraphParsingHelper *helper)
 {
-    if (!phelper) {
-        return;
-    }
-    phelper->unprocessedAttributes.insert(phelper->attributeId, phelper->valid);
+    helper->unprocessedAttributes.insert(helper->attributeId, helper->valid);
 }
 
-void createAttributeList()
+void createAttributeList(DotGraphParsingHelper *helper)
 {
-    if (!phelper) {
-        return;
-    }
-    phelper->graphAttributeStack.push_back(phelper->graphAttributes);
-    phelper->nodeAttributeStack.push_back(phelper->nodeAttributes);
-    phelper->edgeAttributeStack.push_back(phelper->edgeAttributes);
+    helper->graphAttributeStack.push_back(helper->graphAttributes);
+    helper->nodeAttributeStack.push_back(helper->nodeAttributes);
+    helper->edgeAttributeStack.push_back(helper->edgeAttributes);
 }
 
-void removeAttributeList()
+void removeAttributeList(DotGraphParsingHelper *helper)
 {
-    if (!phelper) {
-        return;
-    }
-    phelper->graphAttributes = phelper->graphAttributeStack.back();
-    phelper->graphAttributeStack.pop_back();
-    phelper->nodeAttributes = phelper->nodeAttributeStack.back();
-    phelper->nodeAttributeStack.pop_back();
-    phelper->edgeAttributes = phelper->edgeAttributeStack.back();
-    phelper->edgeAttributeStack.pop_back();
+    helper->graphAttributes = helper->graphAttributeStack.back();
+    helper->graphAttributeStack.pop_back();
+    helper->nodeAttributes = helper->nodeAttributeStack.back();
+    helper->nodeAttributeStack.pop_back();
+    helper->edgeAttributes = helper->edgeAttributeStack.back();
+    helper->edgeAttributeStack.pop_back();
 }
 
-void createNode(const std::string& str)
+void createNode(DotGraphParsingHelper *helper, const Token &token)
 {
-    QString label = QString::fromStdString(str);
-    if (!phelper || label.length() == 0) {
+    const QByteArray label = identifier(token);
+    if (label.isEmpty()) {
         return;
     }
-    // remove quotation marks
-    if (label.endsWith('"')) {
-        label.remove(label.length()-1, 1);
-    }
-    if (label.startsWith('"')) {
-        label.remove(0, 1);
-    }
-    if (!phelper->nodeMap.contains(label)) {
-        phelper->createNode(label);
-    }
+    helper->createNode(label);
 }
 
-void createSubGraph()
+void createSubGraph(DotGraphParsingHelper *helper)
 {
-    if (!phelper) {
-        return;
-    }
-    phelper->createSubGraph();
+    helper->createSubGraph();
 }
 
-void setGraphAttributes()
+void setGraphAttributes(DotGraphParsingHelper *helper)
 {
-    if (!phelper) {
-        return;
-    }
-    phelper->setDocumentAttributes();
+    helper->setDocumentAttributes();
 }
 
-void setNodeAttributes()
+void setNodeAttributes(DotGraphParsingHelper *helper)
 {
-    if (!phelper) {
-        return;
-    }
-    phelper->setNodeAttributes();
+    helper->setNodeAttributes();
 }
 
-void applyAttributeList()
+void applyAttributeList(DotGraphParsingHelper *helper)
 {
-    if (!phelper) {
-        return;
-    }
-    phelper->applyAttributedList();
+    helper->applyAttributedList();
 }
 
-void checkEdgeOperator(const std::string& str)
+void checkEdgeOperator(DotGraphParsingHelper *helper, const Token &token)
 {
-    if (!phelper) {
-        return;
-    }
-
-    if (((phelper->document->edgeTypes().first()->direction() == EdgeType::Unidirectional) && (str.compare("->") == 0)) ||
-            ((phelper->document->edgeTypes().first()->direction() == EdgeType::Bidirectional) && (str.compare("--") == 0)))
+    const bool directed = token.size() == 2 && *token.begin() == '-' && *(token.begin() + 1) == '>';
+    const EdgeType::Direction direction = helper->document->edgeTypes().first()->direction();
+    if ((direction == EdgeType::Unidirectional && directed)
+        || (direction == EdgeType::Bidirectional && !directed))
     {
         return;
     }
@@ -429,28 +449,39 @@ void checkEdgeOperator(const std::string& str)
     qCCritical(GRAPHTHEORY_FILEFORMAT) << "Error: incoherent edge direction relation" << endl;
 }
 
-void edgebound(const std::string& str)
+void edgebound(DotGraphParsingHelper *helper, const Token &token)
 {
-    if (!phelper) {
-        return;
-    }
-    // remove quotation marks
-    QString id = QString::fromStdString(str);
-    if (id.endsWith('"')) {
-        id.remove(id.length()-1, 1);
-    }
-    if (id.startsWith('"')) {
-        id.remove(0, 1);
-    }
-    phelper->addEdgeBound(id);
+    helper->addEdgeBound(identifier(token));
 }
 
-void createEdge()
+void createEdge(DotGraphParsingHelper *helper)
 {
-    if (!phelper) {
-        return;
-    }
-    phelper->createEdge();
+    helper->createEdge();
+}
+
+void beginStatement(DotGraphParsingHelper *helper)
+{
+    helper->beginStatement();
+}
+
+void commitStatement(DotGraphParsingHelper *helper)
+{
+    helper->commitStatement();
+}
+
+void rollbackStatement(DotGraphParsingHelper *helper)
+{
+    helper->rollbackStatement();
+}
+
+void statementParsed(DotGraphParsingHelper *helper, const Token &token)
+{
+    helper->parsedEnd = token.end();
+}
+
+void skipStatement(DotGraphParsingHelper *helper, const Token &token)
+{
+    helper->skipStatement(token.begin(), token.end());
 }
 
 bool parseIntegers(const std::string& str, std::vector<int>& v)
@@ -468,24 +499,40 @@ bool parseIntegers(const std::string& str, std::vector<int>& v)
 
 bool parse(const std::string& str, GraphDocumentPtr document)
 {
-    delete phelper;
-    phelper = new DotGraphParsingHelper;
-    phelper->document = document;
+    return parse(str.data(), str.data() + str.size(), document);
+}
+
+bool parse(const char *begin, const char *end, GraphDocumentPtr document, QStringList *messages)
+{
+    DotGraphParsingHelper helper;
+    helper.document = document;
+    helper.input = begin;
 
-    std::string input(str);
-    std::string::iterator iter = input.begin();
-    DotGrammar<std::string::iterator, skipper_type> r;
+    Iterator iter = begin;
+    DotGrammar<Iterator, skipper_type> r(helper);
 
-    if (phrase_parse(iter, input.end(), r, SKIPPER)) {
+    bool parsed = phrase_parse(iter, end, r, SKIPPER);
+    if (helper.skippedStatements > helper.messages.size()) {
+        helper.messages.append(QString("%1 statements skipped in total").arg(helper.skippedStatements));
+    }
+    if (parsed && iter != end) {
+        // trailing white space and comments are consumed by the parser, anything else is an error
+        helper.messages.append(QString("%1: unexpected input after end of graph").arg(helper.location(iter)));
+        parsed = false;
+    } else if (parsed) {
         qCDebug(GRAPHTHEORY_FILEFORMAT) << "Complete dot file was parsed successfully.";
-        return true;
     } else {
-        qCWarning(GRAPHTHEORY_FILEFORMAT) << "Dot file parsing failed. Unable to parse:";
-        qCDebug(GRAPHTHEORY_FILEFORMAT) << "///// FILE CONTENT BEGIN /////";
-        qCDebug(GRAPHTHEORY_FILEFORMAT) << QString::fromStdString(std::string(iter, input.end()));
-        qCDebug(GRAPHTHEORY_FILEFORMAT) << "///// FILE CONTENT END /////";
+        // a failed parse does not advance the iterator, report the end of the last statement
+        const char *position = std::max(iter, helper.parsedEnd);
+        helper.messages.append(QString("%1: unable to parse graph").arg(helper.location(position)));
+    }
+    foreach (const QString &message, helper.messages) {
+        qCWarning(GRAPHTHEORY_FILEFORMAT) << "Dot file parsing:" << message;
+    }
+    if (messages) {
+        *messages = helper.messages;
     }
-    return false;
+    return parsed;
 }
 
 }
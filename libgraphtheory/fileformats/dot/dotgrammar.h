@@ -20,6 +20,7 @@
 #define DOTGRAMMAR_H
 
 #include "typenames.h"
+#include <QStringList>
 #include <string>
 #include <vector>
 
@@ -33,28 +34,17 @@ namespace DotParser {
     */
     bool parse(const std::string& str, GraphTheory::GraphDocumentPtr document);
 
-    bool parseIntegers(const std::string& str, std::vector<int>& v);
+    /**
+    * Parse the UTF-8 encoded DOT input in the range [\p begin, \p end) into \p document.
+    * Statements that cannot be parsed are skipped up to the next ';' or line break. For each
+    * skipped statement and for a fatal error, a message with the line and column of the input
+    * position is appended to \p messages, if given.
+    * \return true if the graph was parsed, possibly skipping erroneous statements
+    */
+    bool parse(const char *begin, const char *end, GraphTheory::GraphDocumentPtr document,
+               QStringList *messages = 0);
 
-    void setStrict();
-    void setUndirected();
-    void setDirected();
-    void setGraphId(const std::string &str);
-    void attributeId(const std::string &str);
-    void subGraphId(const std::string &str);
-    void valid(const std::string &str);
-    void insertAttributeIntoAttributeList();
-    void createAttributeList();
-    void removeAttributeList();
-    void createSubGraph();
-    void leaveSubGraph();
-    void createNode(const std::string &str);
-    void setGraphAttributes();
-    void setSubGraphAttributes(char const* first, char const* last);
-    void setNodeAttributes();
-    void applyAttributeList();
-    void checkEdgeOperator(const std::string &str);
-    void edgebound(const std::string &str);
-    void createEdge();
+    bool parseIntegers(const std::string& str, std::vector<int>& v);
 }
 
 #endif
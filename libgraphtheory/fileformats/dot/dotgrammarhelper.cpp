@@ -24,12 +24,12 @@
 #include "graphdocument.h"
 #include "node.h"
 #include "edge.h"
+#include "nodetype.h"
+#include "edgetype.h"
 #include "logging_p.h"
 
 #include <QFile>
 
-extern DotParser::DotGraphParsingHelper* phelper;
-
 using namespace GraphTheory;
 
 namespace DotParser
@@ -49,7 +49,15 @@ DotGraphParsingHelper::DotGraphParsingHelper():
     edgebounds(),
     currentNode(),
     currentEdge(),
-    nodeMap()
+    nodeMap(),
+    nameKey(QStringLiteral("name")),
+    input(0),
+    parsedEnd(0),
+    locationCursor(0),
+    lineBegin(0),
+    line(1),
+    messages(),
+    skippedStatements(0)
 {
 }
 
@@ -86,14 +94,15 @@ void DotGraphParsingHelper::setNodeAttributes()
     AttributesMap::ConstIterator iter;
     iter = nodeAttributes.constBegin();
     for (; iter != nodeAttributes.constEnd(); ++iter) {
-        if (!currentNode->dynamicProperties().contains(iter.key())) {
-            currentNode->type()->addDynamicProperty(iter.key());
-        }
         QString key = iter.key(); // do not overwrite labels
         if (key == "name") {
             key = "dot_name";
         }
-        currentNode->setDynamicProperty(key, iter.value());
+        const PropertyKey property(key);
+        if (currentNode->type()->dynamicPropertyIndex(property) < 0) {
+            currentNode->type()->addDynamicProperty(key);
+        }
+        currentNode->setDynamicProperty(property, iter.value());
     }
 }
 
@@ -105,10 +114,11 @@ void DotGraphParsingHelper::setEdgeAttributes()
     AttributesMap::ConstIterator iter;
     iter = edgeAttributes.constBegin();
     for (; iter != edgeAttributes.constEnd(); ++iter) {
-        if (!currentEdge->dynamicProperties().contains(iter.key())) {
+        const PropertyKey property(iter.key());
+        if (currentEdge->type()->dynamicPropertyIndex(property) < 0) {
             currentEdge->type()->addDynamicProperty(iter.key());
         }
-        currentEdge->setDynamicProperty(iter.key(), iter.value());
+        currentEdge->setDynamicProperty(property, iter.value());
     }
 }
 
@@ -146,20 +156,37 @@ void DotGraphParsingHelper::applyAttributedList()
     unprocessedAttributes.clear();
 }
 
-void DotGraphParsingHelper::createNode(const QString &name)
+void DotGraphParsingHelper::createNode(const QByteArray &name)
 {
-    edgebounds.clear(); //TODO explain meaning of this
-
-    if (nodeMap.contains(name)) {
-        qCCritical(GRAPHTHEORY_FILEFORMAT) << "Omitting data element, identifying label is already used: "<< name;
+    // repeated node statements refer to the already created node
+    const auto existing = nodeMap.constFind(name);
+    if (existing != nodeMap.constEnd()) {
+        currentNode = existing.value();
         return;
     }
     currentNode = GraphTheory::Node::create(document);
-    if (!currentNode->type()->dynamicProperties().contains("name")) {
+    if (currentNode->type()->dynamicPropertyIndex(nameKey) < 0) {
         currentNode->type()->addDynamicProperty("name");
     }
-    currentNode->setDynamicProperty("name", name);
-    nodeMap.insert(name, currentNode);
+    currentNode->setDynamicProperty(nameKey, QString::fromUtf8(name));
+    nodeMap.insert(QByteArray(name.constData(), name.size()), currentNode);
+}
+
+NodePtr DotGraphParsingHelper::node(const QByteArray &name)
+{
+    const auto existing = nodeMap.constFind(name);
+    if (existing != nodeMap.constEnd()) {
+        return existing.value();
+    }
+    NodePtr node = Node::create(document);
+    if (node->type()->dynamicPropertyIndex(nameKey) < 0) {
+        node->type()->addDynamicProperty("name");
+    }
+    node->setDynamicProperty(nameKey, QString::fromUtf8(name));
+    nodeMap.insert(QByteArray(name.constData(), name.size()), node);
+    currentNode = node;
+    setNodeAttributes();
+    return node;
 }
 
 void DotGraphParsingHelper::createSubGraph()
@@ -180,50 +207,103 @@ void DotGraphParsingHelper::leaveSubGraph()
 
 void DotGraphParsingHelper::createEdge()
 {
-    QString fromId, toId;
-
     if (edgebounds.isEmpty()) {
         return;
     }
-    fromId = edgebounds.first();
-    edgebounds.removeFirst();
-    while (!edgebounds.isEmpty()) {
-        toId = edgebounds.first();
-        edgebounds.removeFirst();
-
-        // if necessary create from id
-        if (!nodeMap.contains(fromId)) {
-            NodePtr from = Node::create(document);
-            from->setDynamicProperty("name", fromId);
-            if (from->dynamicProperties().contains("name")) {
-                from->type()->addDynamicProperty("name");
-            }
-            nodeMap.insert(fromId, from);
-            currentNode = from;
-            setNodeAttributes();
-        }
-        NodePtr from = nodeMap[fromId];
-
-        // if necessary create to node
-        if (!nodeMap.contains(toId)) {
-            NodePtr to = Node::create(document);
-            if (to->dynamicProperties().contains("name")) {
-                to->type()->addDynamicProperty("name");
-            }
-            to->setDynamicProperty("name", toId);
-            nodeMap.insert(toId, to);
-            currentNode = to;
-            setNodeAttributes();
-        }
-        NodePtr to = nodeMap[toId];
-
+    NodePtr from = node(edgebounds.first());
+    for (int i = 1; i < edgebounds.size(); ++i) {
+        NodePtr to = node(edgebounds.at(i));
         currentEdge = Edge::create(from, to);
-//         qCDebug(GRAPHTHEORY_FILEFORMAT) << "Creating new edge: " << from->identifier() << " -> " << to->identifier();
         setEdgeAttributes();
+        from = to;
+    }
+    edgebounds.clear();
+}
+
+void DotGraphParsingHelper::beginStatement()
+{
+    StatementMark mark;
+    mark.nodeCount = document->nodes().count();
+    mark.edgeCount = document->edges().count();
+    mark.edgeboundCount = edgebounds.count();
+    mark.attributeStackSize = graphAttributeStack.count();
+    mark.attributed = attributed;
+    mark.unprocessedAttributes = unprocessedAttributes;
+    mark.graphAttributes = graphAttributes;
+    mark.nodeAttributes = nodeAttributes;
+    mark.edgeAttributes = edgeAttributes;
+    statementMarks.append(mark);
+}
+
+void DotGraphParsingHelper::commitStatement()
+{
+    // changes are kept, they are covered by the marks of enclosing statements
+    statementMarks.removeLast();
+}
+
+void DotGraphParsingHelper::rollbackStatement()
+{
+    const StatementMark mark = statementMarks.takeLast();
+
+    // elements are appended to the document, thus all elements after the mark were created
+    // by the statement; they are removed from the end to keep the order of the others
+    const EdgeList edges = document->edges();
+    for (int i = edges.count() - 1; i >= mark.edgeCount; --i) {
+        edges.at(i)->destroy();
+    }
+    const NodeList nodes = document->nodes();
+    for (int i = nodes.count() - 1; i >= mark.nodeCount; --i) {
+        nodeMap.remove(nodes.at(i)->dynamicProperty(nameKey).toString().toUtf8());
+        nodes.at(i)->destroy();
+    }
+    currentNode.reset();
+    currentEdge.reset();
 
-        fromId = toId;
+    while (edgebounds.count() > mark.edgeboundCount) {
+        edgebounds.removeLast();
+    }
+    while (graphAttributeStack.count() > mark.attributeStackSize) {
+        graphAttributeStack.removeLast();
+        nodeAttributeStack.removeLast();
+        edgeAttributeStack.removeLast();
     }
+    attributed = mark.attributed;
+    unprocessedAttributes = mark.unprocessedAttributes;
+    graphAttributes = mark.graphAttributes;
+    nodeAttributes = mark.nodeAttributes;
+    edgeAttributes = mark.edgeAttributes;
+}
+
+void DotGraphParsingHelper::skipStatement(const char *first, const char *last)
+{
+    // at most this many skipped statements are reported individually
+    static const int maxMessages = 100;
+
     edgebounds.clear();
+    unprocessedAttributes.clear();
+    ++skippedStatements;
+    parsedEnd = last;
+    if (messages.size() < maxMessages) {
+        const QString statement = QString::fromUtf8(first, int(last - first)).trimmed();
+        messages.append(QString("%1: skipped statement \"%2\"").arg(location(first), statement));
+    }
+}
+
+QString DotGraphParsingHelper::location(const char *position)
+{
+    // positions are requested in increasing order, thus only scan input after the last one
+    if (!locationCursor || position < locationCursor) {
+        locationCursor = input;
+        lineBegin = input;
+        line = 1;
+    }
+    for (; locationCursor < position; ++locationCursor) {
+        if (*locationCursor == '\n') {
+            ++line;
+            lineBegin = locationCursor + 1;
+        }
+    }
+    return QString("line %1, column %2").arg(line).arg(int(position - lineBegin) + 1);
 }
 
 }
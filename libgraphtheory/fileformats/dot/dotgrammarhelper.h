@@ -22,9 +22,11 @@
 #define DOT_GRAMMARHELPER_H
 
 #include "typenames.h"
+#include "propertykey.h"
 #include <QStringList>
 #include <QObject>
 #include <QMap>
+#include <QHash>
 
 namespace DotParser
 {
@@ -37,7 +39,12 @@ struct DotGraphParsingHelper {
     /**
      * Creates new data element and registers the identifier in data map.
      */
-    void createNode(const QString &name);
+    void createNode(const QByteArray &name);
+
+    /**
+     * \return node registered for identifier \p name; the node is created if necessary
+     */
+    GraphTheory::NodePtr node(const QByteArray &name);
 
     /**
      * Creates new sub data structure and enters it. All future created data elements are  add to
@@ -63,11 +70,40 @@ struct DotGraphParsingHelper {
     void applyAttributedList();
 
     void createEdge();
-    void addEdgeBound(QString bound) {
+    void addEdgeBound(const QByteArray &bound) {
         edgebounds.append(bound);
     }
     void setObjectAttributes(QObject *graphElement, const DotParser::DotGraphParsingHelper::AttributesMap &attributes);
 
+    /**
+     * Marks the begin of an attempt to parse a statement or one of its alternatives. Every
+     * call is followed by exactly one call of commitStatement() or rollbackStatement().
+     */
+    void beginStatement();
+
+    /**
+     * Keeps all changes since the corresponding call of beginStatement().
+     */
+    void commitStatement();
+
+    /**
+     * Removes the nodes and edges created since the corresponding call of beginStatement() and
+     * restores the attribute state, such that backtracking of the parser leaves no traces.
+     * Attributes already set at previously existing elements are not restored.
+     */
+    void rollbackStatement();
+
+    /**
+     * Records that the statement in input range [\p first, \p last) could not be parsed and
+     * was skipped, and discards partially parsed state of the statement.
+     */
+    void skipStatement(const char *first, const char *last);
+
+    /**
+     * \return "line L, column C" description of input position \p position
+     */
+    QString location(const char *position);
+
     QString attributeId;
     QString valid;
     std::string attributed; //FIXME change to enum
@@ -80,12 +116,34 @@ struct DotGraphParsingHelper {
     QList< AttributesMap > nodeAttributeStack;
     QList< AttributesMap > edgeAttributeStack;
 
-    QStringList edgebounds;
+    QList<QByteArray> edgebounds;
+
+    struct StatementMark {
+        int nodeCount;
+        int edgeCount;
+        int edgeboundCount;
+        int attributeStackSize;
+        std::string attributed;
+        AttributesMap unprocessedAttributes;
+        AttributesMap graphAttributes;
+        AttributesMap nodeAttributes;
+        AttributesMap edgeAttributes;
+    };
+    QList<StatementMark> statementMarks; // one mark per statement attempt that is in progress
 
     GraphTheory::GraphDocumentPtr document;
     GraphTheory::NodePtr currentNode;
     GraphTheory::EdgePtr currentEdge;
-    QMap<QString, GraphTheory::NodePtr> nodeMap; // for mapping node element ids
+    QHash<QByteArray, GraphTheory::NodePtr> nodeMap; // for mapping node element ids
+
+    const GraphTheory::PropertyKey nameKey;
+    const char *input; // begin of parsed input
+    const char *parsedEnd; // end of the last parsed statement
+    const char *locationCursor; // last position for which the line was computed
+    const char *lineBegin;
+    int line;
+    QStringList messages;
+    int skippedStatements;
 };
 }
 
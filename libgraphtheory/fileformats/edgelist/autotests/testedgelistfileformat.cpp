@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testedgelistfileformat.h"
+#include "../edgelistfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+#include <QFile>
+#include <QtTest>
+
+using namespace GraphTheory;
+
+namespace
+{
+void writeTestFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(content);
+}
+}
+
+TestEdgeListFileFormat::TestEdgeListFileFormat()
+{
+}
+
+void TestEdgeListFileFormat::parseTest()
+{
+    writeTestFile("test.edges",
+        "# Directed graph\n"
+        "% FromNodeId\tToNodeId\n"
+        "\n"
+        "1\t2\n"
+        "  2 3 0.5\r\n"
+        "3 1 2e1 1438041600\n"
+        "7 2");
+
+    EdgeListFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.edges"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    QVERIFY(importer.isGraphDocument());
+    GraphDocumentPtr document = importer.graphDocument();
+
+    QCOMPARE(document->nodes().count(), 4);
+    QCOMPARE(document->nodes().at(0)->id(), 1);
+    QCOMPARE(document->nodes().at(1)->id(), 2);
+    QCOMPARE(document->nodes().at(2)->id(), 3);
+    QCOMPARE(document->nodes().at(3)->id(), 7);
+
+    QCOMPARE(document->edges().count(), 4);
+    EdgePtr edge = document->edges().at(1);
+    QCOMPARE(edge->from()->id(), 2);
+    QCOMPARE(edge->to()->id(), 3);
+    QCOMPARE(edge->dynamicProperty("weight").toReal(), 0.5);
+    QCOMPARE(document->edges().at(2)->dynamicProperty("weight").toReal(), 20.0);
+    QVERIFY(!document->edges().at(0)->dynamicProperty("weight").isValid());
+    QCOMPARE(document->edges().at(3)->from()->id(), 7);
+}
+
+void TestEdgeListFileFormat::parseErrorTest()
+{
+    EdgeListFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.edges"));
+
+    writeTestFile("test.edges", "1 2\n# comment\n2 x\n3 4\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+    QVERIFY(importer.errorString().contains("line 3"));
+
+    writeTestFile("test.edges", "1 2\n-1 2\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+
+    writeTestFile("test.edges", "1 2\n3 4weight\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+}
+
+void TestEdgeListFileFormat::largeFileTest()
+{
+    // several megabytes to have the file parsed in multiple chunks
+    const int nodes = 1000;
+    const int edges = 400000;
+    QByteArray content;
+    for (int i = 0; i < edges; ++i) {
+        content += QByteArray::number(i % nodes) + '\t' + QByteArray::number((7 * i + 1) % nodes) + '\n';
+    }
+    content += "1 2 x\n";
+    writeTestFile("test.edges", content);
+
+    EdgeListFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.edges"));
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+    QVERIFY(importer.errorString().contains(QString("line %1").arg(edges + 1)));
+
+    content.chop(6);
+    writeTestFile("test.edges", content);
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr document = importer.graphDocument();
+    QCOMPARE(document->nodes().count(), nodes);
+    QCOMPARE(document->edges().count(), edges);
+    EdgePtr edge = document->edges().last();
+    QCOMPARE(edge->from()->id(), (edges - 1) % nodes);
+    QCOMPARE(edge->to()->id(), (7 * (edges - 1) + 1) % nodes);
+}
+
+QTEST_MAIN(TestEdgeListFileFormat);
@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "edgelistfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "fileformats/textreader_p.h"
+#include "modifiers/topology.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+#include "edgetype.h"
+#include "propertykey.h"
+#include "logging_p.h"
+#include <KLocalizedString>
+#include <KPluginFactory>
+#include <QFile>
+#include <QHash>
+#include <QUrl>
+#include <QVector>
+#include <QtNumeric>
+#include <limits>
+
+using namespace GraphTheory;
+
+K_PLUGIN_FACTORY_WITH_JSON( FilePluginFactory,
+                            "edgelistfileformat.json",
+                            registerPlugin<EdgeListFileFormat>();)
+
+namespace
+{
+/**
+ * Edges of one chunk of the file, with NaN weights for edges without weight.
+ */
+struct EdgeListChunk
+{
+    EdgeListChunk()
+        : weighted(false)
+        , error(0)
+    {
+    }
+
+    QVector<int> sources;
+    QVector<int> targets;
+    QVector<qreal> weights;
+    bool weighted;
+    const char *error; // begin of the first line that could not be parsed
+};
+
+bool parseIdentifier(const char *&position, const char *end, int &identifier)
+{
+    qint64 value;
+    if (!TextChunk::parseInteger(position, end, value) || value < 0 || value > std::numeric_limits<int>::max()) {
+        return false;
+    }
+    identifier = int(value);
+    return true;
+}
+
+/**
+ * Skip blanks behind a value. The value must be followed by blanks or the end of the line.
+ */
+bool skipSeparator(const char *&position, const char *end)
+{
+    const char *next = TextChunk::skipBlanks(position, end);
+    if (next == position && position != end) {
+        return false;
+    }
+    position = next;
+    return true;
+}
+
+void parseChunk(TextChunk chunk, EdgeListChunk &result)
+{
+    const qreal noWeight = std::numeric_limits<qreal>::quiet_NaN();
+    const char *line;
+    const char *lineEnd;
+    while (chunk.readLine(line, lineEnd)) {
+        const char *position = TextChunk::skipBlanks(line, lineEnd);
+        if (position == lineEnd || *position == '#' || *position == '%') {
+            continue;
+        }
+        int from;
+        int to;
+        qreal weight = noWeight;
+        if (!parseIdentifier(position, lineEnd, from) || !skipSeparator(position, lineEnd)
+            || !parseIdentifier(position, lineEnd, to) || !skipSeparator(position, lineEnd))
+        {
+            result.error = line;
+            return;
+        }
+        if (position != lineEnd) {
+            if (!TextChunk::parseReal(position, lineEnd, weight) || !skipSeparator(position, lineEnd)) {
+                result.error = line;
+                return;
+            }
+            result.weighted = true;
+        }
+        result.sources.append(from);
+        result.targets.append(to);
+        result.weights.append(weight);
+    }
+}
+}
+
+EdgeListFileFormat::EdgeListFileFormat(QObject* parent, const QList< QVariant >&)
+    : FileFormatInterface("rocs_edgelistfileformat", parent)
+{
+}
+
+EdgeListFileFormat::~EdgeListFileFormat()
+{
+}
+
+const QStringList EdgeListFileFormat::extensions() const
+{
+    return QStringList()
+           << i18n("Edge List (%1)", QString("*.edges *.edgelist"));
+}
+
+FileFormatInterface::PluginType EdgeListFileFormat::pluginCapability() const
+{
+    return FileFormatInterface::ImportOnly;
+}
+
+void EdgeListFileFormat::writeFile(GraphDocumentPtr document)
+{
+    Q_UNUSED(document);
+    qCWarning(GRAPHTHEORY_FILEFORMAT) << "This plugin cannot export documents.";
+    setError(NotSupportedOperation);
+}
+
+void EdgeListFileFormat::readFile()
+{
+    QFile fileHandle(file().toLocalFile());
+    if (!fileHandle.open(QFile::ReadOnly)) {
+        setError(CouldNotOpenFile, i18n("Could not open file \"%1\" in read mode: %2", file().toLocalFile(), fileHandle.errorString()));
+        return;
+    }
+    const TextFile content(&fileHandle);
+
+    // parse chunks of the file in parallel, the document is only modified afterwards
+    const QVector<TextChunk> chunks = TextChunk::split(content.begin(), content.end());
+    QVector<EdgeListChunk> results(chunks.size());
+    TextChunk::parallelFor(chunks.size(), [&chunks, &results](int index) {
+        parseChunk(chunks.at(index), results[index]);
+    });
+    bool weighted = false;
+    foreach (const EdgeListChunk &result, results) {
+        if (result.error) {
+            setError(EncodingProblem, i18n("Could not parse file \"%1\": invalid edge in line %2.", file().toLocalFile(), TextChunk::lineNumber(content.begin(), result.error)));
+            return;
+        }
+        weighted = weighted || result.weighted;
+    }
+
+    GraphDocumentPtr document = GraphDocument::create();
+    const PropertyKey weightKey(QStringLiteral("weight"));
+    if (weighted) {
+        document->edgeTypes().first()->addDynamicProperty("weight");
+    }
+
+    // create nodes in order of their first occurrence
+    QHash<int, NodePtr> nodes;
+    auto node = [&document, &nodes](int identifier) {
+        NodePtr &entry = nodes[identifier];
+        if (!entry) {
+            entry = Node::create(document);
+            entry->setId(identifier);
+        }
+        return entry;
+    };
+    BulkUpdateGuard bulkUpdate(document);
+    foreach (const EdgeListChunk &result, results) {
+        for (int i = 0; i < result.sources.size(); ++i) {
+            EdgePtr edge = Edge::create(node(result.sources.at(i)), node(result.targets.at(i)));
+            if (!qIsNaN(result.weights.at(i))) {
+                edge->setDynamicProperty(weightKey, result.weights.at(i));
+            }
+        }
+    }
+    bulkUpdate.release();
+
+    // force directed alignment does not scale to large graphs, e.g., SNAP data sets
+    const int maxAlignedNodes = 10000;
+    Topology layouter;
+    if (document->nodes().count() > maxAlignedNodes) {
+        layouter.applyCircleAlignment(document->nodes(), 300);
+    } else {
+        layouter.directedGraphDefaultTopology(document);
+    }
+    setGraphDocument(document);
+    setError(None);
+}
+
+#include "edgelistfileformat.moc"
@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EDGELISTFILEFORMAT_H
+#define EDGELISTFILEFORMAT_H
+
+#include "fileformats/fileformatinterface.h"
+
+namespace GraphTheory
+{
+
+/** \brief import plugin for plain edge lists
+ *
+ * Edge lists are the common output of graph data pipelines and the format of the SNAP data sets.
+ * Large files are parsed in parallel chunks directly from the memory mapped file.
+ *
+ * Format Specification:
+ *  - Each line describes one directed edge by the integer identifiers of its start and end node,
+ *    separated by spaces or tabs. An optional third column is imported as property "weight",
+ *    further columns are ignored.
+ *  - Nodes are created for all identifiers that appear in the list, with the identifier as
+ *    node id. Identifiers must be non-negative 32 bit integers.
+ *  - Empty lines and lines starting with '#' or '%' are ignored.
+ */
+class EdgeListFileFormat : public FileFormatInterface
+{
+    Q_OBJECT
+public:
+    explicit EdgeListFileFormat(QObject *parent, const QList< QVariant >&);
+    ~EdgeListFileFormat();
+
+    /**
+     * File extensions that are common for this file type.
+     */
+    const QStringList extensions() const Q_DECL_OVERRIDE;
+
+    /**
+     * Edge lists can only be imported.
+     */
+    FileFormatInterface::PluginType pluginCapability() const Q_DECL_OVERRIDE;
+
+    /**
+     * Not supported, edge lists cannot be written.
+     */
+    void writeFile(GraphDocumentPtr graph) Q_DECL_OVERRIDE;
+
+    /**
+     * Open given file and imports it into internal format.
+     * \param file is url of a local file
+     */
+    void readFile() Q_DECL_OVERRIDE;
+};
+}
+
+#endif
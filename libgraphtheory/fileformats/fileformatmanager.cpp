@@ -31,6 +31,7 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QMessageBox>
+#include <QRegularExpression>
 
 using namespace GraphTheory;
 
@@ -138,8 +139,11 @@ void FileFormatManager::loadBackends()
         exit(1);
     }
 
-    // load static plugins
-    d->defaultGraphFilePlugin = backendByExtension("graph2");
+    // prefer the binary format for fast saving and loading of documents
+    d->defaultGraphFilePlugin = backendByExtension("bgraph");
+    if (!d->defaultGraphFilePlugin) {
+        d->defaultGraphFilePlugin = backendByExtension("graph2");
+    }
 }
 
 FileFormatInterface * FileFormatManager::backendByExtension(const QString &ext)
@@ -149,9 +153,15 @@ FileFormatInterface * FileFormatManager::backendByExtension(const QString &ext)
         qCWarning(GRAPHTHEORY_FILEFORMAT) << "File does not contain extension, falling back to default file format";
         return defaultBackend();
     }
+    // extensions are given as patterns "*.ext" inside of translated descriptions, only complete
+    // patterns match, such that e.g. "graph" does not select a plugin for "*.graph2"
+    static const QRegularExpression pattern(QStringLiteral("\\*\\.([^\\s;,()*]+)"));
     foreach(FileFormatInterface * p,  d->backends) {
-        if (p->extensions().join(";").contains(suffix, Qt::CaseInsensitive)) {
-            return p;
+        QRegularExpressionMatchIterator iter = pattern.globalMatch(p->extensions().join(";"));
+        while (iter.hasNext()) {
+            if (iter.next().captured(1).compare(suffix, Qt::CaseInsensitive) == 0) {
+                return p;
+            }
         }
     }
     return nullptr;
@@ -24,8 +24,11 @@
 #include "graphdocument.h"
 #include "node.h"
 #include "edge.h"
+#include "nodetype.h"
+#include "edgetype.h"
 #include <QTest>
 #include <QUrl>
+#include <QTemporaryFile>
 
 using namespace GraphTheory;
 
@@ -68,4 +71,42 @@ void TestGmlFileFormat::serializeTest()
     QVERIFY(serializer.hasError() == false);
 }
 
+void TestGmlFileFormat::serializeFormatTest()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("name");
+    document->edgeTypes().first()->addDynamicProperty("label");
+
+    NodePtr from = Node::create(document);
+    from->setDynamicProperty("name", "a");
+    from->setX(10.5);
+    from->setY(-20);
+    NodePtr to = Node::create(document);
+    to->setDynamicProperty("name", "b");
+    to->setX(0.125);
+    to->setY(1234567);
+    Edge::create(from, to)->setDynamicProperty("label", "test value");
+
+    QTemporaryFile testFile;
+    testFile.open();
+    GmlFileFormat serializer(this, QList<QVariant>());
+    serializer.setFile(QUrl::fromLocalFile(testFile.fileName()));
+    serializer.writeFile(document);
+    QVERIFY(serializer.hasError() == false);
+
+    const QByteArray expected = "id \"graph\" \n"
+        "node [\n id \"a\" \n  x 10.5 \n  y -20 \n"
+        "name a\n"
+        "]\n"
+        "node [\n id \"b\" \n  x 0.125 \n  y 1.23457e+06 \n"
+        "name b\n"
+        "]\n"
+        "edge [\n"
+        "source \"a\"\n target \"b\"\n"
+        "label test value\n"
+        "]\n"
+        "]\n";
+    QCOMPARE(testFile.readAll(), expected);
+}
+
 QTEST_MAIN(TestGmlFileFormat)
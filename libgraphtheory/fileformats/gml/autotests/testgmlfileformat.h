@@ -28,6 +28,7 @@ class TestGmlFileFormat : public QObject
 private slots:
     void parseTest();
     void serializeTest();
+    void serializeFormatTest();
 };
 
 #endif
@@ -22,14 +22,17 @@
 #include "gmlgrammarhelper.h"
 #include "gmlgrammar.h"
 #include "fileformats/fileformatinterface.h"
+#include "fileformats/textwriter_p.h"
 #include "modifiers/topology.h"
 #include "graphdocument.h"
 #include "node.h"
 #include "edge.h"
+#include "nodetype.h"
+#include "edgetype.h"
 #include <KLocalizedString>
 #include <KPluginFactory>
 #include <QFile>
-#include <QTextStream>
+#include <QHash>
 #include <QUrl>
 #include <QVector>
 
@@ -69,7 +72,10 @@ void GmlFileFormat::readFile()
         return;
     }
     QString content = fileHandle.readAll();
-    if (!GmlParser::parse(content, document)) { //TODO change interface and pass graph structure
+    BulkUpdateGuard bulkUpdate(document);
+    const bool parsed = GmlParser::parse(content, document);
+    bulkUpdate.release();
+    if (!parsed) { //TODO change interface and pass graph structure
         setError(EncodingProblem, i18n("Could not parse file \"%1\".", file().toLocalFile()));
         document->destroy();
         return;
@@ -83,66 +89,66 @@ void GmlFileFormat::readFile()
 void GmlFileFormat::writeFile(GraphDocumentPtr document)
 {
     QFile fileHandle(file().toLocalFile());
-    QVariantList subgraphs;
     if (!fileHandle.open(QFile::WriteOnly | QFile::Text)) {
         setError(FileIsReadOnly, i18n("Cannot open file %1 to write document. Error: %2", file().fileName(), fileHandle.errorString()));
         return;
-    } else {
-        QTextStream out(&fileHandle);
+    }
+    TextWriter out(&fileHandle);
+
+    // resolve dynamic properties once per type instead of once per element
+    const PropertyKey name(QStringLiteral("name"));
+    QHash<NodeType*, PropertyList> nodeProperties;
+    foreach (const NodeTypePtr &type, document->nodeTypes()) {
+        nodeProperties.insert(type.data(), PropertyList(type->dynamicProperties()));
+    }
+    QHash<EdgeType*, PropertyList> edgeProperties;
+    foreach (const EdgeTypePtr &type, document->edgeTypes()) {
+        edgeProperties.insert(type.data(), PropertyList(type->dynamicProperties()));
+    }
+
 //FIXME uncommented following directed() check since this is moved to subclass
 //need to add toggle
 //             out << QString("graph [\n directed %1 \n").arg(g->directed()?"1":"0");
-        out << QString("id \"%1\" \n").arg("graph"); //TODO support export of name
-
-        foreach(NodePtr n, document->nodes()) {
-            out << QString("node [\n id \"%1\" \n").arg(n->dynamicProperty("name").toString());
-//                 foreach (QByteArray p, n->dynamicPropertyNames()){
-//                    out << p << " " << n->property(p).toString() << "\n";
-//                  }
-            out << processNode(n);
-            out << "]\n";
-
-        }
-        for (auto const edge : document->edges()) {
-            out << "edge [\n";
-//                  foreach (QByteArray p, e->dynamicPropertyNames()){
-//                    out << p << " " << e->property(p).toString() << "\n";
-//                  }
-            out << processEdge(edge);
-
-            out << "]\n";
-        }
-        out << "]\n";
+    out << "id \"graph\" \n"; //TODO support export of name
+
+    for (auto const &node : document->nodes()) {
+        writeNode(out, node, nodeProperties[node->type().data()], name);
+    }
+    for (auto const &edge : document->edges()) {
+        writeEdge(out, edge, edgeProperties[edge->type().data()], name);
+    }
+    out << "]\n";
+
+    if (!out.flush()) {
+        setError(Unknown, i18n("Could not write document to file %1. Error: %2", file().fileName(), fileHandle.errorString()));
+        return;
     }
     setError(None);
-    return;
 }
 
-
-QString GmlFileFormat::processEdge(EdgePtr e) const
+void GmlFileFormat::writeEdge(TextWriter &out, const EdgePtr &edge, const PropertyList &properties, const PropertyKey &name) const
 {
-    QString edge;
-    edge.append(QString("source \"%1\"\n target \"%2\"\n").arg(e->from()->dynamicProperty("name").toString(), e->to()->dynamicProperty("name").toString()));
+    out << "edge [\n";
+    out << "source \"" << edge->from()->dynamicProperty(name) << "\"\n";
+    out << " target \"" << edge->to()->dynamicProperty(name) << "\"\n";
 //     edge.append (QString(" color \"%1\"\n").arg(e->color())); //Problem with comments (both starts by '#')
 
-    foreach(const QString &property, e->dynamicProperties()) {
-        edge.append(QString("%1 %2\n").arg(property).arg(e->dynamicProperty(property).toString()));
+    for (int i = 0; i < properties.size(); ++i) {
+        out << properties.name(i) << ' ' << edge->dynamicProperty(properties.key(i)) << '\n';
     }
-
-    return edge;
+    out << "]\n";
 }
 
-QString GmlFileFormat::processNode(NodePtr n) const
+void GmlFileFormat::writeNode(TextWriter &out, const NodePtr &node, const PropertyList &properties, const PropertyKey &name) const
 {
-    QString node;
-    node.append(QString("  x %1 \n  y %2 \n").arg(n->x()).arg(n->y()));
+    out << "node [\n id \"" << node->dynamicProperty(name) << "\" \n";
+    out << "  x " << node->x() << " \n  y " << node->y() << " \n";
 //       node.append (QString(" color \"%1\"\n").arg(n->color())); //Problem with comments (both starts by '#')
 
-    foreach(const QString &property, n->dynamicProperties()) {
-        node.append(QString("%1 %2\n").arg(property).arg(n->dynamicProperty(property).toString()));
+    for (int i = 0; i < properties.size(); ++i) {
+        out << properties.name(i) << ' ' << node->dynamicProperty(properties.key(i)) << '\n';
     }
-
-    return node;
+    out << "]\n";
 }
 
 #include "gmlfileformat.moc"
@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testmatrixmarketfileformat.h"
+#include "../matrixmarketfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+#include "edgetype.h"
+#include <QFile>
+#include <QtTest>
+
+using namespace GraphTheory;
+
+namespace
+{
+void writeTestFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(content);
+}
+}
+
+TestMatrixMarketFileFormat::TestMatrixMarketFileFormat()
+{
+}
+
+void TestMatrixMarketFileFormat::parseTest()
+{
+    writeTestFile("test.mtx",
+        "%%MatrixMarket matrix coordinate real general\n"
+        "% comment\n"
+        "%\n"
+        "3 4 3\n"
+        "1 2 0.5\n"
+        "3 4 -1e-3\r\n"
+        "2 2 7\n");
+
+    MatrixMarketFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.mtx"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    QVERIFY(importer.isGraphDocument());
+    GraphDocumentPtr document = importer.graphDocument();
+
+    QCOMPARE(document->edgeTypes().first()->direction(), EdgeType::Unidirectional);
+    QCOMPARE(document->nodes().count(), 4);
+    QCOMPARE(document->nodes().at(0)->id(), 1);
+    QCOMPARE(document->nodes().at(3)->id(), 4);
+    QCOMPARE(document->edges().count(), 3);
+    EdgePtr edge = document->edges().at(1);
+    QCOMPARE(edge->from()->id(), 3);
+    QCOMPARE(edge->to()->id(), 4);
+    QCOMPARE(edge->dynamicProperty("weight").toReal(), -1e-3);
+    QCOMPARE(document->edges().at(2)->from(), document->edges().at(2)->to());
+}
+
+void TestMatrixMarketFileFormat::symmetricTest()
+{
+    writeTestFile("test.mtx",
+        "%%MatrixMarket matrix coordinate pattern symmetric\n"
+        "3 3 2\n"
+        "2 1\n"
+        "3 1\n");
+
+    MatrixMarketFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.mtx"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr document = importer.graphDocument();
+    QCOMPARE(document->edgeTypes().first()->direction(), EdgeType::Bidirectional);
+    QVERIFY(document->edgeTypes().first()->dynamicProperties().isEmpty());
+    QCOMPARE(document->nodes().count(), 3);
+    QCOMPARE(document->edges().count(), 2);
+
+    // the mirrored entries of skew-symmetric matrices have the negated value
+    writeTestFile("test.mtx",
+        "%%MatrixMarket matrix coordinate real skew-symmetric\n"
+        "3 3 2\n"
+        "2 1 1.5\n"
+        "3 2 -2\n");
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    document = importer.graphDocument();
+    QCOMPARE(document->edgeTypes().first()->direction(), EdgeType::Unidirectional);
+    QCOMPARE(document->edges().count(), 4);
+    EdgePtr edge = document->edges().at(0);
+    QCOMPARE(edge->from()->id(), 2);
+    QCOMPARE(edge->to()->id(), 1);
+    QCOMPARE(edge->dynamicProperty("weight").toReal(), 1.5);
+    edge = document->edges().at(1);
+    QCOMPARE(edge->from()->id(), 1);
+    QCOMPARE(edge->to()->id(), 2);
+    QCOMPARE(edge->dynamicProperty("weight").toReal(), -1.5);
+    QCOMPARE(document->edges().at(3)->dynamicProperty("weight").toReal(), 2.0);
+}
+
+void TestMatrixMarketFileFormat::unsupportedTypeTest()
+{
+    MatrixMarketFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.mtx"));
+
+    writeTestFile("test.mtx", "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::NotSupportedOperation);
+
+    writeTestFile("test.mtx", "%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 0\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::NotSupportedOperation);
+
+    writeTestFile("test.mtx", "1 2 3\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::CouldNotRecognizeFileFormat);
+}
+
+void TestMatrixMarketFileFormat::parseErrorTest()
+{
+    MatrixMarketFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.mtx"));
+
+    writeTestFile("test.mtx", "%%MatrixMarket matrix coordinate integer general\n2 2 2\n1 1 1\n2 3 1\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+    QVERIFY(importer.errorString().contains("line 4"));
+
+    writeTestFile("test.mtx", "%%MatrixMarket matrix coordinate integer general\n2 2 3\n1 1 1\n2 2 1\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+
+    writeTestFile("test.mtx", "%%MatrixMarket matrix coordinate integer general\n% no size line\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+
+    // the size line must not declare more nodes than the file can plausibly describe
+    writeTestFile("test.mtx", "%%MatrixMarket matrix coordinate pattern general\n2000000000 1 0\n");
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+    QVERIFY(importer.errorString().contains("exceeds the file size"));
+}
+
+void TestMatrixMarketFileFormat::largeFileTest()
+{
+    // several megabytes to have the file parsed in multiple chunks
+    const int nodes = 1000;
+    const int edges = 300000;
+    QByteArray content("%%MatrixMarket matrix coordinate real general\n");
+    content += QByteArray::number(nodes) + ' ' + QByteArray::number(nodes) + ' ' + QByteArray::number(edges) + '\n';
+    for (int i = 0; i < edges; ++i) {
+        content += QByteArray::number(i % nodes + 1) + ' ' + QByteArray::number((7 * i + 1) % nodes + 1)
+            + ' ' + QByteArray::number(i) + ".5\n";
+    }
+    const QByteArray valid = content;
+    content += "1 1001 1\n";
+    writeTestFile("test.mtx", content);
+
+    MatrixMarketFileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("test.mtx"));
+    importer.readFile();
+    QCOMPARE(importer.error(), FileFormatInterface::EncodingProblem);
+    QVERIFY(importer.errorString().contains(QString("line %1").arg(edges + 3)));
+
+    writeTestFile("test.mtx", valid);
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr document = importer.graphDocument();
+    QCOMPARE(document->nodes().count(), nodes);
+    QCOMPARE(document->edges().count(), edges);
+    EdgePtr edge = document->edges().last();
+    QCOMPARE(edge->from()->id(), (edges - 1) % nodes + 1);
+    QCOMPARE(edge->to()->id(), (7 * (edges - 1) + 1) % nodes + 1);
+    QCOMPARE(edge->dynamicProperty("weight").toReal(), edges - 0.5);
+}
+
+QTEST_MAIN(TestMatrixMarketFileFormat);
@@ -0,0 +1,266 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "matrixmarketfileformat.h"
+#include "fileformats/fileformatinterface.h"
+#include "fileformats/textreader_p.h"
+#include "modifiers/topology.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+#include "edgetype.h"
+#include "propertykey.h"
+#include "logging_p.h"
+#include <KLocalizedString>
+#include <KPluginFactory>
+#include <QFile>
+#include <QUrl>
+#include <QVector>
+#include <limits>
+
+using namespace GraphTheory;
+
+K_PLUGIN_FACTORY_WITH_JSON( FilePluginFactory,
+                            "matrixmarketfileformat.json",
+                            registerPlugin<MatrixMarketFileFormat>();)
+
+namespace
+{
+/**
+ * Entries of one chunk of the file.
+ */
+struct MatrixMarketChunk
+{
+    MatrixMarketChunk()
+        : error(0)
+    {
+    }
+
+    QVector<int> rows;
+    QVector<int> columns;
+    QVector<qreal> values;
+    const char *error; // begin of the first line that could not be parsed
+};
+
+/**
+ * Parse the integer at @p position, which must be in [@p minimum, @p maximum], and skip blanks
+ * behind it. The integer must be followed by blanks or the end of the line.
+ */
+bool parseIndex(const char *&position, const char *end, qint64 minimum, qint64 maximum, int &index)
+{
+    qint64 value;
+    if (!TextChunk::parseInteger(position, end, value) || value < minimum || value > maximum) {
+        return false;
+    }
+    const char *next = TextChunk::skipBlanks(position, end);
+    if (next == position && position != end) {
+        return false;
+    }
+    index = int(value);
+    position = next;
+    return true;
+}
+
+void parseChunk(TextChunk chunk, int rowCount, int columnCount, bool hasValues, MatrixMarketChunk &result)
+{
+    const char *line;
+    const char *lineEnd;
+    while (chunk.readLine(line, lineEnd)) {
+        const char *position = TextChunk::skipBlanks(line, lineEnd);
+        if (position == lineEnd || *position == '%') {
+            continue;
+        }
+        int row;
+        int column;
+        qreal value = 0;
+        if (!parseIndex(position, lineEnd, 1, rowCount, row)
+            || !parseIndex(position, lineEnd, 1, columnCount, column)
+            || (hasValues && !TextChunk::parseReal(position, lineEnd, value))
+            || (position != lineEnd && *position != ' ' && *position != '\t'))
+        {
+            result.error = line;
+            return;
+        }
+        result.rows.append(row);
+        result.columns.append(column);
+        if (hasValues) {
+            result.values.append(value);
+        }
+    }
+}
+}
+
+MatrixMarketFileFormat::MatrixMarketFileFormat(QObject* parent, const QList< QVariant >&)
+    : FileFormatInterface("rocs_matrixmarketfileformat", parent)
+{
+}
+
+MatrixMarketFileFormat::~MatrixMarketFileFormat()
+{
+}
+
+const QStringList MatrixMarketFileFormat::extensions() const
+{
+    return QStringList()
+           << i18n("Matrix Market (%1)", QString("*.mtx"));
+}
+
+FileFormatInterface::PluginType MatrixMarketFileFormat::pluginCapability() const
+{
+    return FileFormatInterface::ImportOnly;
+}
+
+void MatrixMarketFileFormat::writeFile(GraphDocumentPtr document)
+{
+    Q_UNUSED(document);
+    qCWarning(GRAPHTHEORY_FILEFORMAT) << "This plugin cannot export documents.";
+    setError(NotSupportedOperation);
+}
+
+void MatrixMarketFileFormat::readFile()
+{
+    QFile fileHandle(file().toLocalFile());
+    if (!fileHandle.open(QFile::ReadOnly)) {
+        setError(CouldNotOpenFile, i18n("Could not open file \"%1\" in read mode: %2", file().toLocalFile(), fileHandle.errorString()));
+        return;
+    }
+    const TextFile content(&fileHandle);
+    TextChunk header(content.begin(), content.end());
+    const char *line;
+    const char *lineEnd;
+
+    // banner: %%MatrixMarket object format field symmetry
+    QList<QByteArray> banner;
+    if (header.readLine(line, lineEnd)) {
+        banner = QByteArray(line, int(lineEnd - line)).toLower().simplified().split(' ');
+    }
+    if (banner.size() != 5 || banner.at(0) != "%%matrixmarket" || banner.at(1) != "matrix") {
+        setError(CouldNotRecognizeFileFormat, i18n("File \"%1\" is not a Matrix Market file.", file().toLocalFile()));
+        return;
+    }
+    const QByteArray &format = banner.at(2);
+    const QByteArray &field = banner.at(3);
+    const QByteArray &symmetry = banner.at(4);
+    if (format != "coordinate"
+        || (field != "real" && field != "integer" && field != "pattern")
+        || (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric" && symmetry != "hermitian"))
+    {
+        setError(NotSupportedOperation, i18n("Matrix Market files of type \"%1 %2 %3\" are not supported.", QString(format), QString(field), QString(symmetry)));
+        return;
+    }
+    const bool hasValues = field != "pattern";
+
+    // size line behind comments: rows columns entries
+    while (header.readLine(line, lineEnd)) {
+        line = TextChunk::skipBlanks(line, lineEnd);
+        if (line != lineEnd && *line != '%') {
+            break;
+        }
+    }
+    int rowCount;
+    int columnCount;
+    int entryCount;
+    const int maximum = std::numeric_limits<int>::max();
+    if (line == lineEnd
+        || !parseIndex(line, lineEnd, 0, maximum, rowCount)
+        || !parseIndex(line, lineEnd, 0, maximum, columnCount)
+        || !parseIndex(line, lineEnd, 0, maximum, entryCount))
+    {
+        setError(EncodingProblem, i18n("Could not parse file \"%1\": invalid size line.", file().toLocalFile()));
+        return;
+    }
+
+    // one node is created per row and column; the header is not trusted, such that a small file
+    // cannot allocate an arbitrarily large document, a file must have at least as many bytes as nodes
+    const int nodeCount = qMax(rowCount, columnCount);
+    if (nodeCount > content.end() - content.begin()) {
+        setError(EncodingProblem, i18n("Could not parse file \"%1\": the size line declares %2 rows and columns, which exceeds the file size.", file().toLocalFile(), nodeCount));
+        return;
+    }
+
+    // parse chunks of the file in parallel, the document is only modified afterwards
+    const QVector<TextChunk> chunks = TextChunk::split(header.position(), content.end());
+    QVector<MatrixMarketChunk> results(chunks.size());
+    TextChunk::parallelFor(chunks.size(), [&chunks, &results, rowCount, columnCount, hasValues](int index) {
+        parseChunk(chunks.at(index), rowCount, columnCount, hasValues, results[index]);
+    });
+    int entries = 0;
+    foreach (const MatrixMarketChunk &result, results) {
+        if (result.error) {
+            setError(EncodingProblem, i18n("Could not parse file \"%1\": invalid entry in line %2.", file().toLocalFile(), TextChunk::lineNumber(content.begin(), result.error)));
+            return;
+        }
+        entries += result.rows.size();
+    }
+    if (entries != entryCount) {
+        setError(EncodingProblem, i18n("Could not parse file \"%1\": expected %2 entries, but found %3.", file().toLocalFile(), entryCount, entries));
+        return;
+    }
+
+    GraphDocumentPtr document = GraphDocument::create();
+    EdgeTypePtr edgeType = document->edgeTypes().first();
+    // skew-symmetric matrices have distinct values for both directions, thus need two edges
+    const bool skewSymmetric = symmetry == "skew-symmetric";
+    const bool directed = symmetry == "general" || skewSymmetric;
+    edgeType->setDirection(directed ? EdgeType::Unidirectional : EdgeType::Bidirectional);
+    const PropertyKey weightKey(QStringLiteral("weight"));
+    if (hasValues) {
+        edgeType->addDynamicProperty(weightKey.name());
+    }
+
+    BulkUpdateGuard bulkUpdate(document);
+    QVector<NodePtr> nodes(nodeCount);
+    for (int i = 0; i < nodes.size(); ++i) {
+        nodes[i] = Node::create(document);
+        nodes[i]->setId(i + 1);
+    }
+    foreach (const MatrixMarketChunk &result, results) {
+        for (int i = 0; i < result.rows.size(); ++i) {
+            const NodePtr from = nodes.at(result.rows.at(i) - 1);
+            const NodePtr to = nodes.at(result.columns.at(i) - 1);
+            EdgePtr edge = Edge::create(from, to);
+            if (hasValues) {
+                edge->setDynamicProperty(weightKey, result.values.at(i));
+            }
+            if (skewSymmetric && from != to) {
+                edge = Edge::create(to, from);
+                if (hasValues) {
+                    edge->setDynamicProperty(weightKey, -result.values.at(i));
+                }
+            }
+        }
+    }
+    bulkUpdate.release();
+
+    // force directed alignment does not scale to large graphs, e.g., sparse matrix collections
+    const int maxAlignedNodes = 10000;
+    Topology layouter;
+    if (document->nodes().count() > maxAlignedNodes) {
+        layouter.applyCircleAlignment(document->nodes(), 300);
+    } else if (directed) {
+        layouter.directedGraphDefaultTopology(document);
+    } else {
+        layouter.undirectedGraphDefaultTopology(document);
+    }
+    setGraphDocument(document);
+    setError(None);
+}
+
+#include "matrixmarketfileformat.moc"
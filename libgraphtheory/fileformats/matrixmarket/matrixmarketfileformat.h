@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATRIXMARKETFILEFORMAT_H
+#define MATRIXMARKETFILEFORMAT_H
+
+#include "fileformats/fileformatinterface.h"
+
+namespace GraphTheory
+{
+
+/** \brief import plugin for sparse matrices in Matrix Market format
+ *
+ * Matrix Market files are the exchange format of the SuiteSparse Matrix Collection, which provides
+ * many large real world graphs. The entries of a file are parsed in parallel chunks directly
+ * from the memory mapped file.
+ *
+ * Format Specification:
+ *  - The file starts with the banner "%%MatrixMarket matrix coordinate <field> <symmetry>" with
+ *    field "real", "integer" or "pattern" and symmetry "general", "symmetric",
+ *    "skew-symmetric" or "hermitian". Dense ("array") and complex matrices are not supported.
+ *  - The banner is followed by comment lines starting with '%' and the size line
+ *    "<rows> <columns> <entries>".
+ *  - Each entry line "<row> <column> [<value>]" describes an edge from node <row> to node
+ *    <column>. The value is imported as property "weight", pattern matrices have no values.
+ *  - One node is created for each row and column of the matrix, with ids starting at 1. Files
+ *    that declare more rows or columns than they have bytes are rejected.
+ *  - Edges of symmetric and hermitian matrices are bidirectional, the file only lists one
+ *    triangle of those. For each entry of a skew-symmetric matrix, an additional edge in
+ *    reverse direction with the negated value is created.
+ */
+class MatrixMarketFileFormat : public FileFormatInterface
+{
+    Q_OBJECT
+public:
+    explicit MatrixMarketFileFormat(QObject *parent, const QList< QVariant >&);
+    ~MatrixMarketFileFormat();
+
+    /**
+     * File extensions that are common for this file type.
+     */
+    const QStringList extensions() const Q_DECL_OVERRIDE;
+
+    /**
+     * Matrix Market files can only be imported.
+     */
+    FileFormatInterface::PluginType pluginCapability() const Q_DECL_OVERRIDE;
+
+    /**
+     * Not supported, Matrix Market files cannot be written.
+     */
+    void writeFile(GraphDocumentPtr graph) Q_DECL_OVERRIDE;
+
+    /**
+     * Open given file and imports it into internal format.
+     * \param file is url of a local file
+     */
+    void readFile() Q_DECL_OVERRIDE;
+};
+}
+
+#endif
@@ -84,6 +84,7 @@ void Rocs1FileFormat::readFile()
     QTextStream in(&fileHandle);
     in.setCodec("UTF-8");
 
+    BulkUpdateGuard bulkUpdate(document);
     while (!in.atEnd()) {
         QString str = in.readLine().simplified();
 
@@ -252,6 +253,7 @@ void Rocs1FileFormat::readFile()
 //             }
 //         }
     }
+    bulkUpdate.release();
     setGraphDocument(document);
     setError(None);
 }
@@ -27,6 +27,9 @@
 #include "edgetypestyle.h"
 #include "nodetypestyle.h"
 #include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 using namespace GraphTheory;
 
@@ -155,4 +158,131 @@ void TestRocs2FileFormat::parseVersion1Format()
     QVERIFY2(importer.hasError() == false, importer.errorString().toStdString().c_str());
 }
 
+// test import of elements in arbitrary order, unknown values, and escape sequences
+void TestRocs2FileFormat::streamingImport()
+{
+    QFile file("streaming.graph2");
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("{\n"
+               "  \"Edges\": [ { \"From\": 1, \"To\": 2, \"Type\": 1,\n"
+               "      \"Properties\": [ { \"Name\": \"label\", \"Value\": \"a \\\"quoted\\\" \\u00e4 \\ud83d\\ude00 value\" } ] } ],\n"
+               "  \"EdgeTypes\": [ { \"Id\": 1, \"Direction\": \"Unidirectional\", \"Properties\": [ \"label\" ] } ],\n"
+               "  \"FormatVersion\": 1,\n"
+               "  \"Unknown\": { \"nested\": [ 1, { \"a\": null, \"b\": [ true, false ] } ] },\n"
+               "  \"NodeTypes\": [ { \"Id\": 1, \"Properties\": [] } ],\n"
+               "  \"Nodes\": [ { \"Id\": 1, \"Type\": 1, \"X\": -1.5e1 }, { \"Id\": 2, \"Type\": 1 } ]\n"
+               "}\n");
+    file.close();
+
+    Rocs2FileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("streaming.graph2"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr document = importer.graphDocument();
+
+    QCOMPARE(document->nodeTypes().count(), 1);
+    QCOMPARE(document->edgeTypes().count(), 1);
+    QCOMPARE(document->nodes().count(), 2);
+    QCOMPARE(document->node(1)->x(), qreal(-15));
+    QCOMPARE(document->edges().count(), 1);
+    EdgePtr edge = document->edges().first();
+    QVERIFY(edge->from() == document->node(1));
+    QVERIFY(edge->to() == document->node(2));
+    QCOMPARE(edge->type()->direction(), EdgeType::Unidirectional);
+    QCOMPARE(edge->dynamicProperty("label").toString(), QString::fromUtf8("a \"quoted\" \xc3\xa4 \xf0\x9f\x98\x80 value"));
+    document->destroy();
+}
+
+// test export and import of documents that span several read buffers
+void TestRocs2FileFormat::largeDocumentTest()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("label");
+    NodePtr previous;
+    for (int i = 0; i < 2000; ++i) {
+        NodePtr node = Node::create(document);
+        node->setDynamicProperty("label", QString("node %1").arg(i));
+        if (previous) {
+            Edge::create(previous, node);
+        }
+        previous = node;
+    }
+
+    Rocs2FileFormat serializer(this, QList<QVariant>());
+    serializer.setFile(QUrl::fromLocalFile("large.graph2"));
+    serializer.writeFile(document);
+    QVERIFY(serializer.hasError() == false);
+
+    Rocs2FileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("large.graph2"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr importDocument = importer.graphDocument();
+    QCOMPARE(importDocument->nodes().count(), 2000);
+    QCOMPARE(importDocument->edges().count(), 1999);
+    QCOMPARE(importDocument->nodes().last()->dynamicProperty("label").toString(), QString("node 1999"));
+    const EdgeList edges = document->edges();
+    const EdgeList importEdges = importDocument->edges();
+    for (int i = 0; i < importEdges.count(); ++i) {
+        QCOMPARE(importEdges.at(i)->to()->id(), edges.at(i)->to()->id());
+    }
+
+    document->destroy();
+    importDocument->destroy();
+}
+
+// test import of large files written by older versions, which list the edges before the nodes
+void TestRocs2FileFormat::legacyKeyOrderTest()
+{
+    QJsonObject typeJson;
+    typeJson.insert("Id", 1);
+    typeJson.insert("Properties", QJsonArray() << QString("label"));
+    QJsonArray nodesJson;
+    QJsonArray edgesJson;
+    for (int i = 0; i < 2000; ++i) {
+        QJsonObject nodeJson;
+        nodeJson.insert("Id", i);
+        nodeJson.insert("Type", 1);
+        nodesJson.append(nodeJson);
+        if (i > 0) {
+            QJsonObject propertyJson;
+            propertyJson.insert("Name", QString("label"));
+            propertyJson.insert("Value", QString("edge %1").arg(i));
+            QJsonObject edgeJson;
+            edgeJson.insert("From", i - 1);
+            edgeJson.insert("To", i);
+            edgeJson.insert("Type", 1);
+            edgeJson.insert("Properties", QJsonArray() << propertyJson);
+            edgesJson.append(edgeJson);
+        }
+    }
+    // keys are written in alphabetical order, as done by older versions
+    QJsonObject documentJson;
+    documentJson.insert("FormatVersion", 1);
+    documentJson.insert("NodeTypes", QJsonArray() << typeJson);
+    documentJson.insert("EdgeTypes", QJsonArray() << typeJson);
+    documentJson.insert("Nodes", nodesJson);
+    documentJson.insert("Edges", edgesJson);
+    QFile file("legacy.graph2");
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(QJsonDocument(documentJson).toJson());
+    file.close();
+    QVERIFY(file.size() > 64 * 1024); // edges span several read buffers
+
+    Rocs2FileFormat importer(this, QList<QVariant>());
+    importer.setFile(QUrl::fromLocalFile("legacy.graph2"));
+    importer.readFile();
+    QVERIFY(importer.hasError() == false);
+    GraphDocumentPtr document = importer.graphDocument();
+    QCOMPARE(document->nodes().count(), 2000);
+    QCOMPARE(document->edges().count(), 1999);
+    const EdgeList edges = document->edges();
+    for (int i = 0; i < edges.count(); ++i) {
+        QCOMPARE(edges.at(i)->from()->id(), i);
+        QCOMPARE(edges.at(i)->to()->id(), i + 1);
+    }
+    QCOMPARE(edges.last()->dynamicProperty("label").toString(), QString("edge 1999"));
+    document->destroy();
+}
+
 QTEST_MAIN(TestRocs2FileFormat);
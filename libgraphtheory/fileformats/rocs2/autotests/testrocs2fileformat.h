@@ -33,6 +33,9 @@ private slots:
     void documentTypesTest();
     void nodeAndEdgeTest();
     void parseVersion1Format();
+    void streamingImport();
+    void largeDocumentTest();
+    void legacyKeyOrderTest();
 };
 
 #endif
@@ -0,0 +1,484 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "jsonstreamreader.h"
+
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonObject>
+
+using namespace GraphTheory;
+
+namespace
+{
+// size of the chunks in which the device is read
+const int chunkSize = 64 * 1024;
+}
+
+JsonStreamReader::JsonStreamReader(QIODevice *device)
+    : m_device(device)
+    , m_position(0)
+    , m_line(1)
+    , m_token(NoToken)
+    , m_expectation(ExpectValue)
+    , m_number(0)
+    , m_bool(false)
+{
+    Q_ASSERT(device);
+}
+
+bool JsonStreamReader::fill()
+{
+    m_buffer = m_device->read(chunkSize);
+    m_position = 0;
+    return !m_buffer.isEmpty();
+}
+
+int JsonStreamReader::getChar()
+{
+    if (m_position >= m_buffer.size() && !fill()) {
+        return -1;
+    }
+    return static_cast<unsigned char>(m_buffer.at(m_position++));
+}
+
+int JsonStreamReader::getNonSpaceChar()
+{
+    forever {
+        const int c = getChar();
+        switch (c) {
+        case '\n':
+            ++m_line;
+            break;
+        case ' ':
+        case '\t':
+        case '\r':
+            break;
+        default:
+            return c;
+        }
+    }
+}
+
+JsonStreamReader::TokenType JsonStreamReader::setError(const QString &message)
+{
+    m_error = QString("line %1: %2").arg(m_line).arg(message);
+    m_token = Invalid;
+    return m_token;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readNext()
+{
+    if (m_token == Invalid || m_token == EndDocument) {
+        return m_token;
+    }
+
+    forever {
+        const int c = getNonSpaceChar();
+        switch (m_expectation) {
+        case ExpectEndOfDocument:
+            if (c == -1) {
+                m_token = EndDocument;
+                return m_token;
+            }
+            return setError("unexpected content after end of document");
+        case ExpectSeparatorOrEnd:
+            if (c == ',') {
+                m_expectation = (m_containers.last() == '{') ? ExpectName : ExpectValue;
+                continue;
+            }
+            break;
+        case ExpectName:
+        case ExpectNameOrEnd:
+            if (c == '"') {
+                if (!readString()) {
+                    return m_token;
+                }
+                if (getNonSpaceChar() != ':') {
+                    return setError("expected ':' after name");
+                }
+                m_expectation = ExpectValue;
+                m_token = Name;
+                return m_token;
+            }
+            if (m_expectation == ExpectName) {
+                return setError("expected name");
+            }
+            break;
+        case ExpectValueOrEnd:
+            if (c != ']') {
+                return readValue(c);
+            }
+            break;
+        case ExpectValue:
+            return readValue(c);
+        }
+
+        // only the end of the current container is valid at this point
+        if (c == -1) {
+            return setError("unexpected end of document");
+        }
+        const char open = m_containers.last();
+        if ((c == '}' && open == '{') || (c == ']' && open == '[')) {
+            m_containers.removeLast();
+            finishValue();
+            m_token = (c == '}') ? EndObject : EndArray;
+            return m_token;
+        }
+        return setError(QString("unexpected character '%1'").arg(QChar(c)));
+    }
+}
+
+JsonStreamReader::TokenType JsonStreamReader::readValue(int c)
+{
+    switch (c) {
+    case '{':
+        m_containers.append('{');
+        m_expectation = ExpectNameOrEnd;
+        m_token = StartObject;
+        return m_token;
+    case '[':
+        m_containers.append('[');
+        m_expectation = ExpectValueOrEnd;
+        m_token = StartArray;
+        return m_token;
+    case '"':
+        if (!readString()) {
+            return m_token;
+        }
+        m_token = String;
+        break;
+    case 't':
+        if (!readLiteral("rue")) {
+            return m_token;
+        }
+        m_bool = true;
+        m_token = Bool;
+        break;
+    case 'f':
+        if (!readLiteral("alse")) {
+            return m_token;
+        }
+        m_bool = false;
+        m_token = Bool;
+        break;
+    case 'n':
+        if (!readLiteral("ull")) {
+            return m_token;
+        }
+        m_token = Null;
+        break;
+    case -1:
+        return setError("unexpected end of document");
+    default:
+        if (c != '-' && (c < '0' || c > '9')) {
+            return setError(QString("unexpected character '%1'").arg(QChar(c)));
+        }
+        if (!readNumber(c)) {
+            return m_token;
+        }
+        m_token = Number;
+        break;
+    }
+    finishValue();
+    return m_token;
+}
+
+bool JsonStreamReader::readString()
+{
+    m_text.clear();
+    forever {
+        if (m_position >= m_buffer.size() && !fill()) {
+            setError("unterminated string");
+            return false;
+        }
+
+        // copy everything up to the next quote or escape character at once
+        const char *data = m_buffer.constData();
+        const int size = m_buffer.size();
+        int end = m_position;
+        while (end < size && data[end] != '"' && data[end] != '\\') {
+            ++end;
+        }
+        m_text.append(data + m_position, end - m_position);
+        m_position = end;
+        if (end == size) {
+            continue;
+        }
+        const char stop = data[end];
+        ++m_position;
+        if (stop == '"') {
+            return true;
+        }
+
+        const int escaped = getChar();
+        switch (escaped) {
+        case '"':
+        case '\\':
+        case '/':
+            m_text.append(char(escaped));
+            break;
+        case 'b':
+            m_text.append('\b');
+            break;
+        case 'f':
+            m_text.append('\f');
+            break;
+        case 'n':
+            m_text.append('\n');
+            break;
+        case 'r':
+            m_text.append('\r');
+            break;
+        case 't':
+            m_text.append('\t');
+            break;
+        case 'u': {
+            uint code;
+            if (!readHex(code)) {
+                return false;
+            }
+            if (code >= 0xD800 && code < 0xDC00) {
+                // high surrogate, must be followed by low surrogate
+                uint low;
+                if (getChar() != '\\' || getChar() != 'u' || !readHex(low) || low < 0xDC00 || low > 0xDFFF) {
+                    setError("invalid surrogate pair");
+                    return false;
+                }
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            appendUtf8(code);
+            break;
+        }
+        default:
+            setError("invalid escape sequence");
+            return false;
+        }
+    }
+}
+
+bool JsonStreamReader::readHex(uint &code)
+{
+    code = 0;
+    for (int i = 0; i < 4; ++i) {
+        const int c = getChar();
+        code <<= 4;
+        if (c >= '0' && c <= '9') {
+            code += c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            code += c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            code += c - 'A' + 10;
+        } else {
+            setError("invalid unicode escape sequence");
+            return false;
+        }
+    }
+    return true;
+}
+
+void JsonStreamReader::appendUtf8(uint code)
+{
+    if (code < 0x80) {
+        m_text.append(char(code));
+    } else if (code < 0x800) {
+        m_text.append(char(0xC0 | (code >> 6)));
+        m_text.append(char(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        m_text.append(char(0xE0 | (code >> 12)));
+        m_text.append(char(0x80 | ((code >> 6) & 0x3F)));
+        m_text.append(char(0x80 | (code & 0x3F)));
+    } else {
+        m_text.append(char(0xF0 | (code >> 18)));
+        m_text.append(char(0x80 | ((code >> 12) & 0x3F)));
+        m_text.append(char(0x80 | ((code >> 6) & 0x3F)));
+        m_text.append(char(0x80 | (code & 0x3F)));
+    }
+}
+
+bool JsonStreamReader::readNumber(int c)
+{
+    m_text.clear();
+    m_text.append(char(c));
+    forever {
+        if (m_position >= m_buffer.size() && !fill()) {
+            break;
+        }
+        const char next = m_buffer.at(m_position);
+        if ((next < '0' || next > '9') && next != '.' && next != 'e' && next != 'E'
+            && next != '+' && next != '-')
+        {
+            break;
+        }
+        m_text.append(next);
+        ++m_position;
+    }
+    bool ok;
+    m_number = m_text.toDouble(&ok);
+    if (!ok) {
+        setError(QString("invalid number '%1'").arg(QString::fromLatin1(m_text)));
+        return false;
+    }
+    return true;
+}
+
+bool JsonStreamReader::readLiteral(const char *literal)
+{
+    for (const char *c = literal; *c; ++c) {
+        if (getChar() != *c) {
+            setError("invalid literal");
+            return false;
+        }
+    }
+    return true;
+}
+
+void JsonStreamReader::finishValue()
+{
+    m_expectation = m_containers.isEmpty() ? ExpectEndOfDocument : ExpectSeparatorOrEnd;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::tokenType() const
+{
+    return m_token;
+}
+
+QString JsonStreamReader::name() const
+{
+    return QString::fromUtf8(m_text);
+}
+
+QString JsonStreamReader::stringValue() const
+{
+    return QString::fromUtf8(m_text);
+}
+
+double JsonStreamReader::numberValue() const
+{
+    return m_number;
+}
+
+bool JsonStreamReader::boolValue() const
+{
+    return m_bool;
+}
+
+QJsonValue JsonStreamReader::value()
+{
+    switch (m_token) {
+    case StartObject: {
+        QJsonObject object;
+        while (readNext() == Name) {
+            const QString key = name();
+            readNext();
+            const QJsonValue member = value();
+            if (hasError()) {
+                return QJsonValue(QJsonValue::Undefined);
+            }
+            object.insert(key, member);
+        }
+        if (m_token != EndObject) {
+            return QJsonValue(QJsonValue::Undefined);
+        }
+        return object;
+    }
+    case StartArray: {
+        QJsonArray array;
+        while (readNext() != EndArray) {
+            const QJsonValue element = value();
+            if (hasError()) {
+                return QJsonValue(QJsonValue::Undefined);
+            }
+            array.append(element);
+        }
+        return array;
+    }
+    case String:
+        return stringValue();
+    case Number:
+        return m_number;
+    case Bool:
+        return m_bool;
+    case Null:
+        return QJsonValue();
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+void JsonStreamReader::skipValue()
+{
+    if (m_token != StartObject && m_token != StartArray) {
+        return;
+    }
+    int depth = 1;
+    while (depth > 0) {
+        switch (readNext()) {
+        case StartObject:
+        case StartArray:
+            ++depth;
+            break;
+        case EndObject:
+        case EndArray:
+            --depth;
+            break;
+        case Invalid:
+            return;
+        default:
+            break;
+        }
+    }
+}
+
+JsonStreamReader::Position JsonStreamReader::position() const
+{
+    Position position;
+    position.offset = m_device->pos() - (m_buffer.size() - m_position);
+    position.line = m_line;
+    position.token = m_token;
+    position.expectation = m_expectation;
+    position.containers = m_containers;
+    return position;
+}
+
+bool JsonStreamReader::seek(const Position &position)
+{
+    if (m_device->isSequential() || !m_device->seek(position.offset)) {
+        return false;
+    }
+    m_buffer.clear();
+    m_position = 0;
+    m_line = position.line;
+    m_token = position.token;
+    m_expectation = position.expectation;
+    m_containers = position.containers;
+    m_error.clear();
+    return true;
+}
+
+bool JsonStreamReader::hasError() const
+{
+    return m_token == Invalid;
+}
+
+QString JsonStreamReader::errorString() const
+{
+    return m_error;
+}
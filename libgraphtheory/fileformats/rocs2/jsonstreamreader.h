@@ -0,0 +1,186 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JSONSTREAMREADER_H
+#define JSONSTREAMREADER_H
+
+#include <QByteArray>
+#include <QJsonValue>
+#include <QString>
+#include <QVector>
+
+class QIODevice;
+
+namespace GraphTheory
+{
+
+/**
+ * \class JsonStreamReader
+ * Pull parser for JSON documents that reads its device in chunks. Opposed to QJsonDocument,
+ * only the values explicitly requested by value() are materialized, such that documents with
+ * large arrays can be processed in bounded memory.
+ *
+ * Usage is similar to QXmlStreamReader: readNext() advances to the next token, whose content
+ * is available by name(), stringValue(), numberValue(), and boolValue().
+ */
+class JsonStreamReader
+{
+public:
+    enum TokenType {
+        NoToken,
+        Invalid,
+        StartObject,
+        EndObject,
+        StartArray,
+        EndArray,
+        Name,
+        String,
+        Number,
+        Bool,
+        Null,
+        EndDocument
+    };
+
+private:
+    enum Expectation {
+        ExpectValue,
+        ExpectValueOrEnd,
+        ExpectName,
+        ExpectNameOrEnd,
+        ExpectSeparatorOrEnd,
+        ExpectEndOfDocument
+    };
+
+public:
+    /**
+     * State of the reader after a token, see position() and seek().
+     */
+    struct Position {
+        qint64 offset;
+        int line;
+        TokenType token;
+        Expectation expectation;
+        QVector<char> containers;
+    };
+
+    /**
+     * Create reader for @p device, which must be open for reading.
+     */
+    explicit JsonStreamReader(QIODevice *device);
+
+    /**
+     * Read next token. The separators of names and values are consumed implicitly.
+     * @return type of the token
+     */
+    TokenType readNext();
+
+    /**
+     * @return type of the current token
+     */
+    TokenType tokenType() const;
+
+    /**
+     * @return key of the current Name token
+     */
+    QString name() const;
+
+    /**
+     * @return content of the current String token
+     */
+    QString stringValue() const;
+
+    /**
+     * @return content of the current Number token
+     */
+    double numberValue() const;
+
+    /**
+     * @return content of the current Bool token
+     */
+    bool boolValue() const;
+
+    /**
+     * Convert the current value token into a JSON value. For StartObject and StartArray tokens,
+     * the complete object or array is read and the reader is positioned at its end token.
+     * @return value or an undefined value if the current token is not the start of a value
+     */
+    QJsonValue value();
+
+    /**
+     * Skip the current value. For StartObject and StartArray tokens, the reader is positioned
+     * at the corresponding end token.
+     */
+    void skipValue();
+
+    /**
+     * @return state of the reader after the current token
+     */
+    Position position() const;
+
+    /**
+     * Continue reading after the token at which @p position was taken, e.g., to read an array
+     * again after it was skipped. The device must support random access.
+     * @return false if the device could not be positioned
+     */
+    bool seek(const Position &position);
+
+    /**
+     * @return true if a syntax error occurred
+     */
+    bool hasError() const;
+
+    /**
+     * @return description of the syntax error, including its line
+     */
+    QString errorString() const;
+
+private:
+    /** refill buffer, @return false at end of device **/
+    bool fill();
+    /** @return next character or -1 at end of device **/
+    inline int getChar();
+    /** @return next character that is not white space or -1 at end of device **/
+    int getNonSpaceChar();
+    TokenType setError(const QString &message);
+    TokenType readValue(int c);
+    bool readString();
+    /** read the four hex digits of a unicode escape sequence **/
+    bool readHex(uint &code);
+    bool readNumber(int c);
+    bool readLiteral(const char *literal);
+    void appendUtf8(uint code);
+    /** set expectation after a complete value **/
+    void finishValue();
+
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    int m_position;
+    int m_line;
+    TokenType m_token;
+    Expectation m_expectation;
+    QVector<char> m_containers; // '{' or '[' for each open container
+    QByteArray m_text; // UTF-8 content of the current name, string, or number
+    double m_number;
+    bool m_bool;
+    QString m_error;
+};
+}
+
+#endif
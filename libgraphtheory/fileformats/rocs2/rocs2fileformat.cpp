@@ -19,6 +19,7 @@
  */
 
 #include "rocs2fileformat.h"
+#include "jsonstreamreader.h"
 #include "fileformats/fileformatinterface.h"
 #include "modifiers/topology.h"
 #include "graphdocument.h"
@@ -33,6 +34,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QFile>
+#include <QHash>
 #include <QUrl>
 
 using namespace GraphTheory;
@@ -63,10 +65,9 @@ void Rocs2FileFormat::readFile()
         setError(CouldNotOpenFile, i18n("Could not open file \"%1\" in read mode: %2", file().toLocalFile(), fileHandle.errorString()));
         return;
     }
-    const QByteArray fileContent = fileHandle.readAll();
 
     // gracefully handle empty documents: return a new one with default types
-    if (fileContent.isEmpty()) {
+    if (fileHandle.size() == 0) {
         setGraphDocument(GraphDocument::create());
         setError(None);
         return;
@@ -77,19 +78,11 @@ void Rocs2FileFormat::readFile()
     document->remove(document->nodeTypes().first());
     document->remove(document->edgeTypes().first());
 
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(fileContent);
-    QJsonObject jsonObj = jsonDoc.object();
+    // lookup tables for the type IDs
+    QHash<int, NodeTypePtr> nodeTypes;
+    QHash<int, EdgeTypePtr> edgeTypes;
 
-    // check format
-    int formatVersion = jsonObj["FormatVersion"].toInt();
-    if (formatVersion > 1) {
-        qCCritical(GRAPHTHEORY_FILEFORMAT) << "File format has version" << formatVersion << "which is higher than the latest supported version.";
-    }
-
-    // import node types
-    QJsonArray nodeTypesJson = jsonObj["NodeTypes"].toArray();
-    for (int index = 0; index < nodeTypesJson.count(); ++index) {
-        QJsonObject typeJson = nodeTypesJson.at(index).toObject();
+    auto importNodeType = [&](const QJsonObject &typeJson) {
         NodeTypePtr type = NodeType::create(document);
         type->setId(typeJson["Id"].toInt());
         type->setName(typeJson["Name"].toString());
@@ -101,12 +94,12 @@ void Rocs2FileFormat::readFile()
         for (int pIndex = 0; pIndex < propertiesJson.count(); ++pIndex) {
             type->addDynamicProperty(propertiesJson.at(pIndex).toString());
         }
-    }
+        if (!nodeTypes.contains(type->id())) {
+            nodeTypes.insert(type->id(), type);
+        }
+    };
 
-    // import edge types
-    QJsonArray edgeTypesJson = jsonObj["EdgeTypes"].toArray();
-    for (int index = 0; index < edgeTypesJson.count(); ++index) {
-        QJsonObject typeJson = edgeTypesJson.at(index).toObject();
+    auto importEdgeType = [&](const QJsonObject &typeJson) {
         EdgeTypePtr type = EdgeType::create(document);
         type->setId(typeJson["Id"].toInt());
         type->setName(typeJson["Name"].toString());
@@ -119,27 +112,22 @@ void Rocs2FileFormat::readFile()
         for (int pIndex = 0; pIndex < propertiesJson.count(); ++pIndex) {
             type->addDynamicProperty(propertiesJson.at(pIndex).toString());
         }
-    }
-
-    // import nodes
-    QJsonArray nodesJson = jsonObj["Nodes"].toArray();
-    for (int index = 0; index < nodesJson.count(); ++index) {
-        QJsonObject nodeJson = nodesJson.at(index).toObject();
-        NodePtr node = Node::create(document);
+        if (!edgeTypes.contains(type->id())) {
+            edgeTypes.insert(type->id(), type);
+        }
+    };
 
+    auto importNode = [&](const QJsonObject &nodeJson) {
         // set type
-        NodeTypePtr typeToSet;
-        //TODO this is not very efficient for big files: use table instead to cache IDs
-        foreach (NodeTypePtr type, document->nodeTypes()) {
-            if (type->id() == nodeJson["Type"].toInt()) {
-                typeToSet = type;
-                break;
-            }
-        }
+        NodeTypePtr typeToSet = nodeTypes.value(nodeJson["Type"].toInt());
         if (!typeToSet) {
             qCCritical(GRAPHTHEORY_FILEFORMAT) << "No type found with this ID, defaulting to first found type";
+            if (document->nodeTypes().isEmpty()) {
+                NodeType::create(document);
+            }
             typeToSet = document->nodeTypes().first();
         }
+        NodePtr node = Node::create(document);
         node->setType(typeToSet);
 
         // further properties
@@ -153,44 +141,28 @@ void Rocs2FileFormat::readFile()
             QJsonObject propertyJson = propertiesJson.at(pIndex).toObject();
             node->setDynamicProperty(propertyJson["Name"].toString(), propertyJson["Value"].toString());
         }
-    }
-
-    // import edges
-    QJsonArray edgesJson = jsonObj["Edges"].toArray();
-    for (int index = 0; index < edgesJson.count(); ++index) {
-        QJsonObject edgeJson = edgesJson.at(index).toObject();
+    };
 
+    auto importEdge = [&](const QJsonObject &edgeJson) {
         // find nodes to connect to
-        NodePtr fromNode, toNode;
-        //TODO this is not very efficient for big files: use table instead to cache IDs
-        foreach (NodePtr node, document->nodes()) {
-            if (node->id() == edgeJson["From"].toInt()) {
-                fromNode = node;
-            }
-            if (node->id() == edgeJson["To"].toInt()) {
-                toNode = node;
-            }
-        }
+        NodePtr fromNode = document->node(edgeJson["From"].toInt());
+        NodePtr toNode = document->node(edgeJson["To"].toInt());
         if (!fromNode || !toNode) {
-            qCCritical(GRAPHTHEORY_FILEFORMAT) << "No type found with this ID, aborting edge from"
+            qCCritical(GRAPHTHEORY_FILEFORMAT) << "No node found with this ID, aborting edge from"
                 << edgeJson["From"].toInt() << "to" << edgeJson["To"].toInt();
-            continue;
+            return;
         }
-        EdgePtr edge = Edge::create(fromNode, toNode);
 
         // set type
-        EdgeTypePtr typeToSet;
-        //TODO this is not very efficient for big files: use table instead to cache IDs
-        foreach (EdgeTypePtr type, document->edgeTypes()) {
-            if (type->id() == edgeJson["Type"].toInt()) {
-                typeToSet = type;
-                break;
-            }
-        }
+        EdgeTypePtr typeToSet = edgeTypes.value(edgeJson["Type"].toInt());
         if (!typeToSet) {
             qCCritical(GRAPHTHEORY_FILEFORMAT) << "No type found with this ID, defaulting to first found type";
+            if (document->edgeTypes().isEmpty()) {
+                EdgeType::create(document);
+            }
             typeToSet = document->edgeTypes().first();
         }
+        EdgePtr edge = Edge::create(fromNode, toNode);
         edge->setType(typeToSet);
 
         // set dynamic properties
@@ -199,7 +171,73 @@ void Rocs2FileFormat::readFile()
             QJsonObject propertyJson = propertiesJson.at(pIndex).toObject();
             edge->setDynamicProperty(propertyJson["Name"].toString(), propertyJson["Value"].toString());
         }
+    };
+
+    // elements are created while the file is read, such that only the currently read element
+    // is kept in memory; files of older versions list the edges before the nodes, their edge
+    // array is skipped and read again after all nodes are imported
+    JsonStreamReader reader(&fileHandle);
+    auto importArray = [&](const QString &key) {
+        while (reader.readNext() != JsonStreamReader::EndArray && !reader.hasError()) {
+            const QJsonObject elementJson = reader.value().toObject();
+            if (reader.hasError()) {
+                break;
+            }
+            if (key == QLatin1String("NodeTypes")) {
+                importNodeType(elementJson);
+            } else if (key == QLatin1String("EdgeTypes")) {
+                importEdgeType(elementJson);
+            } else if (key == QLatin1String("Nodes")) {
+                importNode(elementJson);
+            } else if (key == QLatin1String("Edges")) {
+                importEdge(elementJson);
+            }
+        }
+    };
+
+    JsonStreamReader::Position pendingEdges;
+    bool hasPendingEdges = false;
+    bool nodesImported = false;
+    BulkUpdateGuard bulkUpdate(document);
+    if (reader.readNext() == JsonStreamReader::StartObject) {
+        while (reader.readNext() == JsonStreamReader::Name) {
+            const QString key = reader.name();
+            reader.readNext();
+            if (key == QLatin1String("FormatVersion")) {
+                // check format
+                int formatVersion = reader.value().toInt();
+                if (formatVersion > 1) {
+                    qCCritical(GRAPHTHEORY_FILEFORMAT) << "File format has version" << formatVersion << "which is higher than the latest supported version.";
+                }
+                continue;
+            }
+            if (reader.tokenType() != JsonStreamReader::StartArray) {
+                reader.skipValue();
+                continue;
+            }
+            if (key == QLatin1String("Edges") && !nodesImported) {
+                pendingEdges = reader.position();
+                hasPendingEdges = true;
+                reader.skipValue();
+                continue;
+            }
+            importArray(key);
+            if (key == QLatin1String("Nodes")) {
+                nodesImported = true;
+            }
+        }
     }
+    if (hasPendingEdges && !reader.hasError()) {
+        if (reader.seek(pendingEdges)) {
+            importArray(QStringLiteral("Edges"));
+        } else {
+            qCCritical(GRAPHTHEORY_FILEFORMAT) << "Could not return to the edges, skipping their import";
+        }
+    }
+    if (reader.hasError()) {
+        qCCritical(GRAPHTHEORY_FILEFORMAT) << "Stopped import at syntax error," << reader.errorString();
+    }
+    bulkUpdate.release();
 
     setGraphDocument(document);
     setError(None);
@@ -213,11 +251,25 @@ void Rocs2FileFormat::writeFile(GraphDocumentPtr document)
         return;
     }
 
-    QJsonObject output; // this JSON object fill eventually be serialized
-    output.insert("FormatVersion", 1);
+    // elements are serialized one by one, ordered such that types precede nodes and nodes
+    // precede edges, which allows the reader to create all elements as they are read
+    bool firstElement = true;
+    auto writeElement = [&](const QJsonObject &elementJson) {
+        fileHandle.write(firstElement ? "\n" : ",\n");
+        fileHandle.write(QJsonDocument(elementJson).toJson(QJsonDocument::Compact));
+        firstElement = false;
+    };
+    auto beginArray = [&](const char *name) {
+        fileHandle.write("\"");
+        fileHandle.write(name);
+        fileHandle.write("\": [");
+        firstElement = true;
+    };
+
+    fileHandle.write("{\n\"FormatVersion\": 1,\n");
 
     // serialize node types
-    QJsonArray nodeTypes;
+    beginArray("NodeTypes");
     foreach (const auto &type, document->nodeTypes()) {
         QJsonObject typeJson;
         typeJson.insert("Id", type->id());
@@ -233,12 +285,12 @@ void Rocs2FileFormat::writeFile(GraphDocumentPtr document)
             propertiesJson.append(property);
         }
         typeJson.insert("Properties", propertiesJson);
-        nodeTypes.append(typeJson);
+        writeElement(typeJson);
     }
-    output.insert("NodeTypes", nodeTypes);
+    fileHandle.write("\n],\n");
 
     // serialize edge types
-    QJsonArray edgeTypes;
+    beginArray("EdgeTypes");
     foreach (EdgeTypePtr type, document->edgeTypes()) {
         QJsonObject typeJson;
         typeJson.insert("Id", type->id());
@@ -255,12 +307,12 @@ void Rocs2FileFormat::writeFile(GraphDocumentPtr document)
             propertiesJson.append(property);
         }
         typeJson.insert("Properties", propertiesJson);
-        edgeTypes.append(typeJson);
+        writeElement(typeJson);
     }
-    output.insert("EdgeTypes", edgeTypes);
+    fileHandle.write("\n],\n");
 
     // serialize nodes
-    QJsonArray nodes;
+    beginArray("Nodes");
     foreach (const auto &node, document->nodes()) {
         QJsonObject nodeJson;
         nodeJson.insert("Id", node->id());
@@ -276,12 +328,12 @@ void Rocs2FileFormat::writeFile(GraphDocumentPtr document)
             propertiesJson.append(propertyJson);
         }
         nodeJson.insert("Properties", propertiesJson);
-        nodes.append(nodeJson);
+        writeElement(nodeJson);
     }
-    output.insert("Nodes", nodes);
+    fileHandle.write("\n],\n");
 
     // serialize edges
-    QJsonArray edges;
+    beginArray("Edges");
     foreach (const auto &edge, document->edges()) {
         QJsonObject edgeJson;
         edgeJson.insert("Type", edge->type()->id());
@@ -295,20 +347,15 @@ void Rocs2FileFormat::writeFile(GraphDocumentPtr document)
             propertiesJson.append(propertyJson);
         }
         edgeJson.insert("Properties", propertiesJson);
-        edges.append(edgeJson);
+        writeElement(edgeJson);
     }
-    output.insert("Edges", edges);
+    fileHandle.write("\n]\n}\n");
 
-    // serialize to file
-    QJsonDocument outputDocument(output);
-    if (fileHandle.write(outputDocument.toJson()) == -1) {
+    if (!fileHandle.flush() || fileHandle.error() != QFile::NoError) {
         setError(Unknown, i18n("Error on serializing file format to file."));
         return;
     }
 
-    // debug serialization
-    // qCDebug(GRAPHTHEORY_FILEFORMAT) << outputDocument.toJson();
-
     setError(None);
 }
 
@@ -0,0 +1,332 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEXTREADER_P_H
+#define TEXTREADER_P_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+namespace GraphTheory
+{
+
+/**
+ * \class TextFile
+ *
+ * Content of a file that is opened for reading. The file is mapped into memory if possible,
+ * otherwise it is read at once.
+ */
+class TextFile
+{
+public:
+    explicit TextFile(QFile *file)
+        : m_begin(reinterpret_cast<const char *>(file->map(0, file->size())))
+        , m_end(m_begin)
+    {
+        if (m_begin) {
+            m_end += file->size();
+        } else {
+            m_content = file->readAll();
+            m_begin = m_content.constData();
+            m_end = m_begin + m_content.size();
+        }
+    }
+
+    const char * begin() const
+    {
+        return m_begin;
+    }
+
+    const char * end() const
+    {
+        return m_end;
+    }
+
+private:
+    Q_DISABLE_COPY(TextFile)
+    QByteArray m_content;
+    const char *m_begin;
+    const char *m_end;
+};
+
+/**
+ * \class TextChunk
+ *
+ * Range of complete lines of a text that is held in memory, e.g., a file mapped with
+ * QFile::map(). Large texts are split into chunks that are parsed in parallel, the results are
+ * merged in text order afterwards. Lines are located with memchr(), which the C library
+ * implements with vector instructions, and are never copied.
+ */
+class TextChunk
+{
+public:
+    TextChunk()
+        : m_begin(0)
+        , m_position(0)
+        , m_end(0)
+    {
+    }
+
+    TextChunk(const char *begin, const char *end)
+        : m_begin(begin)
+        , m_position(begin)
+        , m_end(end)
+    {
+    }
+
+    /**
+     * @return begin of the first line of the chunk
+     */
+    const char * begin() const
+    {
+        return m_begin;
+    }
+
+    /**
+     * @return end of the last line of the chunk
+     */
+    const char * end() const
+    {
+        return m_end;
+    }
+
+    /**
+     * @return begin of the next line that is read by readLine()
+     */
+    const char * position() const
+    {
+        return m_position;
+    }
+
+    /**
+     * Read the next line of the chunk. The line range [@p lineBegin, @p lineEnd) does not contain
+     * the line terminator "\n" or "\r\n".
+     *
+     * @return @c false if all lines of the chunk were read, otherwise @c true
+     */
+    bool readLine(const char *&lineBegin, const char *&lineEnd)
+    {
+        if (m_position >= m_end) {
+            return false;
+        }
+        lineBegin = m_position;
+        const char *newline = static_cast<const char *>(std::memchr(m_position, '\n', size_t(m_end - m_position)));
+        lineEnd = newline ? newline : m_end;
+        m_position = newline ? newline + 1 : m_end;
+        if (lineEnd > lineBegin && *(lineEnd - 1) == '\r') {
+            --lineEnd;
+        }
+        return true;
+    }
+
+    /**
+     * Split the text [@p begin, @p end) at line boundaries into chunks of about equal size, at
+     * most one chunk per available processor core. Texts smaller than @p minimumSize are not
+     * split.
+     */
+    static QVector<TextChunk> split(const char *begin, const char *end, qint64 minimumSize = 1 << 20)
+    {
+        const qint64 size = end - begin;
+        const int count = int(qBound<qint64>(1, size / qMax<qint64>(1, minimumSize), qMax(1, QThread::idealThreadCount())));
+        QVector<TextChunk> chunks;
+        chunks.reserve(count);
+        const char *chunkBegin = begin;
+        for (int i = 1; i < count; ++i) {
+            const char *chunkEnd = std::max(chunkBegin, begin + size * i / count);
+            const char *newline = static_cast<const char *>(std::memchr(chunkEnd, '\n', size_t(end - chunkEnd)));
+            chunkEnd = newline ? newline + 1 : end;
+            chunks.append(TextChunk(chunkBegin, chunkEnd));
+            chunkBegin = chunkEnd;
+        }
+        chunks.append(TextChunk(chunkBegin, end));
+        return chunks;
+    }
+
+    /**
+     * Call @p function for all chunk indices from 0 to @p count-1 on a thread pool and return
+     * when all calls are finished.
+     */
+    static void parallelFor(int count, const std::function<void(int)> &function)
+    {
+        if (count == 1) {
+            function(0);
+            return;
+        }
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+        for (int i = 0; i < count; ++i) {
+            pool.start(new Task([&function, i]() {
+                function(i);
+            }));
+        }
+        pool.waitForDone();
+    }
+
+    /**
+     * @return number of the line at @p position of the text beginning at @p begin, starting at 1
+     */
+    static int lineNumber(const char *begin, const char *position)
+    {
+        return 1 + int(std::count(begin, position, '\n'));
+    }
+
+    /**
+     * @return first position in [@p position, @p end) that is neither space nor tab
+     */
+    static const char * skipBlanks(const char *position, const char *end)
+    {
+        while (position != end && (*position == ' ' || *position == '\t')) {
+            ++position;
+        }
+        return position;
+    }
+
+    /**
+     * Parse the decimal integer at @p position and advance @p position behind it.
+     *
+     * @return @c false if there is no integer at @p position or the integer does not fit into
+     *         a 64 bit integer, otherwise @c true
+     */
+    static bool parseInteger(const char *&position, const char *end, qint64 &value)
+    {
+        const char *current = position;
+        const bool negative = current != end && *current == '-';
+        if (current != end && (*current == '-' || *current == '+')) {
+            ++current;
+        }
+        const char *digits = current;
+        quint64 magnitude = 0;
+        for (; current != end && *current >= '0' && *current <= '9'; ++current) {
+            if (magnitude > quint64(std::numeric_limits<qint64>::max() / 10)) {
+                return false;
+            }
+            magnitude = 10 * magnitude + quint64(*current - '0');
+        }
+        if (current == digits || magnitude > quint64(std::numeric_limits<qint64>::max())) {
+            return false;
+        }
+        value = negative ? -qint64(magnitude) : qint64(magnitude);
+        position = current;
+        return true;
+    }
+
+    /**
+     * Parse the decimal floating point number at @p position and advance @p position behind it.
+     * The decimal point is '.' regardless of the locale.
+     *
+     * @return @c false if there is no number at @p position, otherwise @c true
+     */
+    static bool parseReal(const char *&position, const char *end, qreal &value)
+    {
+        // powers of ten that are exactly representable as double
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        const char *current = position;
+        const bool negative = current != end && *current == '-';
+        if (current != end && (*current == '-' || *current == '+')) {
+            ++current;
+        }
+        quint64 mantissa = 0;
+        int significantDigits = 0;
+        int exponent = 0;
+        bool hasDigits = false;
+        for (; current != end && *current >= '0' && *current <= '9'; ++current) {
+            hasDigits = true;
+            if (significantDigits < 19) {
+                mantissa = 10 * mantissa + quint64(*current - '0');
+                significantDigits += mantissa > 0 ? 1 : 0;
+            } else {
+                ++exponent;
+            }
+        }
+        if (current != end && *current == '.') {
+            for (++current; current != end && *current >= '0' && *current <= '9'; ++current) {
+                hasDigits = true;
+                if (significantDigits < 19) {
+                    mantissa = 10 * mantissa + quint64(*current - '0');
+                    significantDigits += mantissa > 0 ? 1 : 0;
+                    --exponent;
+                }
+            }
+        }
+        if (!hasDigits) {
+            return false;
+        }
+        if (current != end && (*current == 'e' || *current == 'E')) {
+            const char *exponentBegin = current + 1;
+            qint64 exponentValue;
+            if (parseInteger(exponentBegin, end, exponentValue)) {
+                exponent = int(qBound<qint64>(-100000, exponent + exponentValue, 100000));
+                current = exponentBegin;
+            }
+        }
+
+        // mantissa and power of ten are exact, thus the result is correctly rounded;
+        // otherwise use the slower conversion of Qt
+        if (mantissa <= (quint64(1) << 53) && exponent >= -22 && exponent <= 22) {
+            value = exponent < 0 ? double(mantissa) / powers[-exponent] : double(mantissa) * powers[exponent];
+            value = negative ? -value : value;
+        } else {
+            bool ok;
+            value = QByteArray(position, int(current - position)).toDouble(&ok);
+            if (!ok) {
+                return false;
+            }
+        }
+        position = current;
+        return true;
+    }
+
+private:
+    class Task : public QRunnable
+    {
+    public:
+        explicit Task(const std::function<void()> &function)
+            : m_function(function)
+        {
+        }
+
+        void run() Q_DECL_OVERRIDE
+        {
+            m_function();
+        }
+
+    private:
+        std::function<void()> m_function;
+    };
+
+    const char *m_begin;
+    const char *m_position;
+    const char *m_end;
+};
+}
+
+#endif
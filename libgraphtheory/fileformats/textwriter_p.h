@@ -0,0 +1,288 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEXTWRITER_P_H
+#define TEXTWRITER_P_H
+
+#include "propertykey.h"
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <cstdio>
+#include <cstring>
+
+namespace GraphTheory
+{
+
+/**
+ * \class TextWriter
+ *
+ * Buffered writer for text based file formats. Output is encoded as UTF-8 into a buffer that is
+ * allocated once and handed to the device whenever it is full, such that serializing elements
+ * neither creates temporary strings nor calls into the device for every token. Numbers are
+ * formatted locale independent.
+ */
+class TextWriter
+{
+public:
+    explicit TextWriter(QIODevice *device, int capacity = 256 * 1024)
+        : m_device(device)
+        , m_buffer(capacity, Qt::Uninitialized)
+        , m_size(0)
+        , m_written(0)
+        , m_error(false)
+    {
+    }
+
+    ~TextWriter()
+    {
+        flush();
+    }
+
+    /**
+     * Hand all buffered output to the device.
+     *
+     * @return @c false if the device reported an error, otherwise @c true
+     */
+    bool flush()
+    {
+        if (m_size > 0 && !m_error) {
+            m_error = m_device->write(m_buffer.constData(), m_size) != m_size;
+            m_written += m_size;
+        }
+        m_size = 0;
+        return !m_error;
+    }
+
+    /**
+     * @return @c true if writing to the device failed
+     */
+    bool hasError() const
+    {
+        return m_error;
+    }
+
+    /**
+     * @return number of bytes written, including bytes that are still buffered
+     */
+    qint64 bytesWritten() const
+    {
+        return m_written + m_size;
+    }
+
+    TextWriter & operator<<(char c)
+    {
+        reserve(1);
+        m_buffer.data()[m_size++] = c;
+        return *this;
+    }
+
+    TextWriter & operator<<(const char *str)
+    {
+        append(str, int(std::strlen(str)));
+        return *this;
+    }
+
+    TextWriter & operator<<(const QByteArray &data)
+    {
+        append(data.constData(), data.size());
+        return *this;
+    }
+
+    TextWriter & operator<<(const QString &str)
+    {
+        const int length = str.size();
+        if (3 * length > m_buffer.size()) {
+            return *this << str.toUtf8();
+        }
+        reserve(3 * length);
+        char *out = m_buffer.data() + m_size;
+        const ushort *in = str.utf16();
+        for (int i = 0; i < length; ++i) {
+            uint c = in[i];
+            if (c < 0x80) {
+                *out++ = char(c);
+                continue;
+            }
+            if (c < 0x800) {
+                *out++ = char(0xc0 | (c >> 6));
+                *out++ = char(0x80 | (c & 0x3f));
+                continue;
+            }
+            if (QChar::isHighSurrogate(c) && i + 1 < length && QChar::isLowSurrogate(in[i + 1])) {
+                c = QChar::surrogateToUcs4(ushort(c), in[++i]);
+                *out++ = char(0xf0 | (c >> 18));
+                *out++ = char(0x80 | ((c >> 12) & 0x3f));
+            } else if (QChar::isSurrogate(c)) {
+                *out++ = '?';
+                continue;
+            } else {
+                *out++ = char(0xe0 | (c >> 12));
+            }
+            *out++ = char(0x80 | ((c >> 6) & 0x3f));
+            *out++ = char(0x80 | (c & 0x3f));
+        }
+        m_size = int(out - m_buffer.constData());
+        return *this;
+    }
+
+    TextWriter & operator<<(qint64 value)
+    {
+        char digits[24];
+        char *end = digits + sizeof(digits);
+        char *begin = end;
+        quint64 magnitude = value < 0 ? 0 - quint64(value) : quint64(value);
+        do {
+            *--begin = char('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (value < 0) {
+            *--begin = '-';
+        }
+        append(begin, int(end - begin));
+        return *this;
+    }
+
+    TextWriter & operator<<(int value)
+    {
+        return *this << qint64(value);
+    }
+
+    /**
+     * Write @p value in the format of QString::number(value), i.e., with six significant
+     * digits and '.' as decimal point regardless of the current C locale.
+     */
+    TextWriter & operator<<(qreal value)
+    {
+        char digits[32];
+        int length = std::snprintf(digits, sizeof(digits), "%g", value);
+        if (length < 0 || length >= int(sizeof(digits))) {
+            return *this << QByteArray::number(value);
+        }
+        for (int i = 0; i < length; ++i) {
+            if (digits[i] == ',') {
+                digits[i] = '.';
+            }
+        }
+        append(digits, length);
+        return *this;
+    }
+
+    /**
+     * Write the string representation of @p value. Strings and integers are written without
+     * creating an intermediate string, all other types are converted with QVariant::toString().
+     */
+    TextWriter & operator<<(const QVariant &value)
+    {
+        switch (value.type()) {
+        case QVariant::Invalid:
+            return *this;
+        case QVariant::String:
+            return *this << *reinterpret_cast<const QString *>(value.constData());
+        case QVariant::Int:
+            return *this << value.toInt();
+        case QVariant::LongLong:
+            return *this << value.toLongLong();
+        case QVariant::Bool:
+            return *this << (value.toBool() ? "true" : "false");
+        default:
+            return *this << value.toString();
+        }
+    }
+
+private:
+    void reserve(int length)
+    {
+        if (m_size + length > m_buffer.size()) {
+            flush();
+        }
+    }
+
+    void append(const char *data, int length)
+    {
+        if (length > m_buffer.size()) {
+            flush();
+            if (!m_error) {
+                m_error = m_device->write(data, length) != length;
+                m_written += length;
+            }
+            return;
+        }
+        reserve(length);
+        std::memcpy(m_buffer.data() + m_size, data, size_t(length));
+        m_size += length;
+    }
+
+    Q_DISABLE_COPY(TextWriter)
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    int m_size;
+    qint64 m_written;
+    bool m_error;
+};
+
+/**
+ * \class PropertyList
+ *
+ * Dynamic properties of a node or edge type, resolved once per type for serialization. Holds
+ * the property keys for value lookup and the UTF-8 encoded property names.
+ */
+class PropertyList
+{
+public:
+    PropertyList()
+    {
+    }
+
+    explicit PropertyList(const QStringList &properties)
+    {
+        m_keys.reserve(properties.size());
+        m_names.reserve(properties.size());
+        foreach (const QString &property, properties) {
+            m_keys.append(PropertyKey(property));
+            m_names.append(property.toUtf8());
+        }
+    }
+
+    int size() const
+    {
+        return m_keys.size();
+    }
+
+    const PropertyKey & key(int index) const
+    {
+        return m_keys.at(index);
+    }
+
+    const QByteArray & name(int index) const
+    {
+        return m_names.at(index);
+    }
+
+private:
+    QVector<PropertyKey> m_keys;
+    QVector<QByteArray> m_names;
+};
+}
+
+#endif
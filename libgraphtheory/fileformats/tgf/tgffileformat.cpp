@@ -70,6 +70,8 @@ void TgfFileFormat::readFile()
     }
 
     ReadMode mode = Nodes;
+    const PropertyKey labelKey("label");
+    BulkUpdateGuard bulkUpdate(document);
     while (!fileHandle.atEnd()) {
         QString line = QString(fileHandle.readLine()).trimmed();
 
@@ -82,7 +84,7 @@ void TgfFileFormat::readFile()
             int identifier = line.section(' ', 0, 0).toInt();
             QString label = line.section(' ', 1);  // get label, this is everything after first space
             NodePtr node = Node::create(document);
-            node->setDynamicProperty("label", label.simplified());
+            node->setDynamicProperty(labelKey, label.simplified());
             node->setId(identifier);
 
             if (nodeMap.contains(identifier)) {
@@ -102,9 +104,10 @@ void TgfFileFormat::readFile()
                 return;
             }
             EdgePtr edge = Edge::create(nodeMap[from], nodeMap[to]);
-            edge->setDynamicProperty("label", value.simplified());
+            edge->setDynamicProperty(labelKey, value.simplified());
         }
     }
+    bulkUpdate.release();
 
     Topology layouter;
     layouter.directedGraphDefaultTopology(document);
@@ -121,18 +124,19 @@ void TgfFileFormat::writeFile(GraphDocumentPtr document)
     }
 
     QTextStream out(&fileHandle);
+    const PropertyKey labelKey("label");
     // export data elements
     //FIXME only default data type considered
     foreach(NodePtr node, document->nodes()) {
         out << node->id();
         out << " ";
-        out << node->dynamicProperty("label").toString(); //TODO change to selectable property
+        out << node->dynamicProperty(labelKey).toString(); //TODO change to selectable property
         out << '\n';
     }
     out << "#\n";
     // export pointers
     for (auto const edge : document->edges()) {
-        out << edge->from()->id() << " " << edge->to()->id() << " " << edge->dynamicProperty("label").toString() <<'\n';
+        out << edge->from()->id() << " " << edge->to()->id() << " " << edge->dynamicProperty(labelKey).toString() <<'\n';
     }
     setError(None);
 }
@@ -0,0 +1,726 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "graphdiff.h"
+#include "graphdocument.h"
+#include "nodetype.h"
+#include "nodetypestyle.h"
+#include "edgetype.h"
+#include "edgetypestyle.h"
+#include "node.h"
+#include "edge.h"
+#include "propertytable_p.h"
+
+#include <QColor>
+#include <QHash>
+#include <QStringList>
+
+using namespace GraphTheory;
+
+namespace
+{
+// state of a type of the working copy at the baseline
+template<typename TypePtr>
+struct TypeBaseline {
+    TypePtr origin;             // type of the document
+    TypePtr copy;               // type of the working copy
+    QString name;
+    QStringList properties;
+    PropertyTable values;       // implicitly shared copy of the property table
+    QColor color;
+    bool visible;
+    bool propertyNamesVisible;
+    int direction;              // only used for edge types
+};
+
+// state of a node of the working copy at the baseline
+struct NodeBaseline {
+    qreal x;
+    qreal y;
+    QColor color;
+    const NodeType *type;
+    int row;                    // row in the property table of the type
+};
+
+// state of an edge of the working copy at the baseline
+struct EdgeBaseline {
+    const EdgeType *type;
+    int row;
+};
+
+// identifies an edge of two independent documents by the identifiers of its end points and type
+struct EdgeKey {
+    int from;
+    int to;
+    int type;
+};
+
+bool operator==(const EdgeKey &a, const EdgeKey &b)
+{
+    return a.from == b.from && a.to == b.to && a.type == b.type;
+}
+
+uint qHash(const EdgeKey &key, uint seed = 0)
+{
+    return ::qHash(key.from, seed) ^ ::qHash(key.to, seed + 1) ^ ::qHash(key.type, seed + 2);
+}
+
+EdgeKey edgeKey(const EdgePtr &edge)
+{
+    EdgeKey key = { edge->from()->id(), edge->to()->id(), edge->type()->id() };
+    return key;
+}
+
+template<typename ElementPtr>
+bool equalDynamicProperties(const ElementPtr &a, const ElementPtr &b)
+{
+    const QStringList properties = a->dynamicProperties();
+    if (properties != b->dynamicProperties()) {
+        return false;
+    }
+    foreach (const QString &property, properties) {
+        if (a->dynamicProperty(property) != b->dynamicProperty(property)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// edge created in the working copy, end points are positions in the baseline or, if negative,
+// -1 - position in the list of inserted nodes
+struct InsertedEdge {
+    EdgePtr copy;
+    int from;
+    int to;
+};
+
+template<typename TypePtr>
+const TypeBaseline<TypePtr> * findBaseline(const QVector<TypeBaseline<TypePtr> > &baselines, const QObject *copy)
+{
+    for (int i = 0; i < baselines.length(); ++i) {
+        if (baselines.at(i).copy.data() == copy) {
+            return &baselines.at(i);
+        }
+    }
+    return nullptr;
+}
+}
+
+class GraphTheory::GraphDiffPrivate
+{
+public:
+    GraphDiffPrivate()
+        : m_ownsWorkingCopy(false)
+        , m_typesChanged(false)
+    {
+    }
+
+    ~GraphDiffPrivate()
+    {
+        if (m_ownsWorkingCopy) {
+            m_workingCopy->destroy();
+        }
+    }
+
+    template<typename TypePtr>
+    static TypeBaseline<TypePtr> createBaseline(const TypePtr &origin, const TypePtr &copy)
+    {
+        TypeBaseline<TypePtr> baseline;
+        baseline.origin = origin;
+        baseline.copy = copy;
+        baseline.name = copy->name();
+        baseline.properties = copy->dynamicProperties();
+        baseline.values = *copy->propertyTable();
+        baseline.color = copy->style()->color();
+        baseline.visible = copy->style()->isVisible();
+        baseline.propertyNamesVisible = copy->style()->isPropertyNamesVisible();
+        baseline.direction = 0;
+        return baseline;
+    }
+
+    /**
+     * Find dynamic properties of @p copy with values that differ from the baseline @p type of
+     * its type, or all properties with values if the type is unknown at the baseline.
+     *
+     * @return @e true if a value changed; all changed columns are appended to @p columns if
+     * given, otherwise the search stops at the first change
+     */
+    template<typename ElementPtr, typename TypePtr>
+    static bool changedProperties(const ElementPtr &copy, const TypeBaseline<TypePtr> *type, QVector<int> *columns = nullptr)
+    {
+        const QStringList properties = copy->type()->dynamicProperties();
+        const PropertyTable *table = copy->type()->propertyTable();
+        const int row = copy->propertyRow();
+        bool changed = false;
+        for (int column = 0; column < properties.length(); ++column) {
+            QVariant previous;
+            if (type) {
+                const int previousColumn = type->properties.indexOf(properties.at(column));
+                if (previousColumn >= 0) {
+                    previous = type->values.value(previousColumn, row);
+                }
+            }
+            if (table->value(column, row) == previous) {
+                continue;
+            }
+            changed = true;
+            if (!columns) {
+                break;
+            }
+            columns->append(column);
+        }
+        return changed;
+    }
+
+    /**
+     * Set the dynamic properties in @p columns of @p copy at @p target, if registered at the
+     * type of @p target.
+     */
+    template<typename ElementPtr>
+    static void copyProperties(const ElementPtr &copy, const ElementPtr &target, const QVector<int> &columns)
+    {
+        const QStringList properties = copy->type()->dynamicProperties();
+        const QStringList targetProperties = target->type()->dynamicProperties();
+        foreach (int column, columns) {
+            if (targetProperties.contains(properties.at(column))) {
+                target->setDynamicProperty(properties.at(column),
+                    copy->type()->propertyTable()->value(column, copy->propertyRow()));
+            }
+        }
+    }
+
+    /**
+     * @return @e true if the type of @p baseline was changed in the working copy
+     */
+    template<typename TypePtr>
+    static bool typeChanged(const TypeBaseline<TypePtr> &baseline)
+    {
+        const TypePtr &copy = baseline.copy;
+        return !copy->isValid()
+            || copy->name() != baseline.name
+            || copy->dynamicProperties() != baseline.properties
+            || copy->style()->color() != baseline.color
+            || copy->style()->isVisible() != baseline.visible
+            || copy->style()->isPropertyNamesVisible() != baseline.propertyNamesVisible;
+    }
+
+    /**
+     * Apply the changes of the type of @p baseline to its type in the document. Properties
+     * are removed if they were removed in the working copy and added if they were added.
+     */
+    template<typename TypePtr>
+    static void applyType(const TypeBaseline<TypePtr> &baseline)
+    {
+        const TypePtr &copy = baseline.copy;
+        const TypePtr &origin = baseline.origin;
+        if (copy->name() != baseline.name) {
+            origin->setName(copy->name());
+        }
+        if (copy->style()->color() != baseline.color) {
+            origin->style()->setColor(copy->style()->color());
+        }
+        if (copy->style()->isVisible() != baseline.visible) {
+            origin->style()->setVisible(copy->style()->isVisible());
+        }
+        if (copy->style()->isPropertyNamesVisible() != baseline.propertyNamesVisible) {
+            origin->style()->setPropertyNamesVisible(copy->style()->isPropertyNamesVisible());
+        }
+        // renamed properties are removed and added, their values are copied as changes
+        const QStringList properties = copy->dynamicProperties();
+        foreach (const QString &property, baseline.properties) {
+            if (!properties.contains(property)) {
+                origin->removeDynamicProperty(property);
+            }
+        }
+        foreach (const QString &property, properties) {
+            if (!baseline.properties.contains(property)
+                && !origin->dynamicProperties().contains(property))
+            {
+                origin->addDynamicProperty(property);
+            }
+        }
+    }
+
+    /**
+     * Create a type in @p document equal to type @p copy of the working copy.
+     */
+    template<typename TypePtr, typename Type>
+    static TypePtr createType(GraphDocumentPtr document, const TypePtr &copy, const QList<TypePtr> &types)
+    {
+        TypePtr type = Type::create(document);
+        bool idUsed = false;
+        foreach (const TypePtr &other, types) {
+            idUsed = idUsed || other->id() == copy->id();
+        }
+        if (!idUsed) {
+            type->setId(copy->id());
+        }
+        type->setName(copy->name());
+        type->style()->setColor(copy->style()->color());
+        type->style()->setVisible(copy->style()->isVisible());
+        type->style()->setPropertyNamesVisible(copy->style()->isPropertyNamesVisible());
+        foreach (const QString &property, copy->dynamicProperties()) {
+            type->addDynamicProperty(property);
+        }
+        return type;
+    }
+
+    void clear();
+    void update();
+    void compare();
+    void apply() const;
+
+    GraphDocumentPtr m_document;
+    GraphDocumentPtr m_workingCopy; // clone of the document or, if not owned, a compared document
+    bool m_ownsWorkingCopy;
+
+    // baseline, elements of the document and their copies are stored at the same positions
+    QVector<TypeBaseline<NodeTypePtr> > m_nodeTypes;
+    QVector<TypeBaseline<EdgeTypePtr> > m_edgeTypes;
+    NodeList m_nodeOrigins;
+    NodeList m_nodeCopies;
+    QVector<NodeBaseline> m_nodes;
+    EdgeList m_edgeOrigins;
+    EdgeList m_edgeCopies;
+    QVector<EdgeBaseline> m_edges;
+
+    // changes found by update(), elements of the baseline are given by position
+    bool m_typesChanged;
+    QVector<int> m_removedNodes;
+    QVector<int> m_changedNodes;
+    NodeList m_insertedNodes;
+    QVector<int> m_removedEdges;
+    QVector<int> m_changedEdges;
+    QVector<InsertedEdge> m_insertedEdges;
+};
+
+void GraphDiffPrivate::clear()
+{
+    m_typesChanged = false;
+    m_removedNodes.clear();
+    m_changedNodes.clear();
+    m_insertedNodes.clear();
+    m_removedEdges.clear();
+    m_changedEdges.clear();
+    m_insertedEdges.clear();
+}
+
+void GraphDiffPrivate::update()
+{
+    if (!m_ownsWorkingCopy) {
+        compare();
+        return;
+    }
+    clear();
+
+    // types
+    m_typesChanged = m_workingCopy->nodeTypes().length() != m_nodeTypes.length()
+        || m_workingCopy->edgeTypes().length() != m_edgeTypes.length();
+    foreach (const TypeBaseline<NodeTypePtr> &baseline, m_nodeTypes) {
+        m_typesChanged = m_typesChanged || typeChanged(baseline);
+    }
+    foreach (const TypeBaseline<EdgeTypePtr> &baseline, m_edgeTypes) {
+        m_typesChanged = m_typesChanged || typeChanged(baseline)
+            || baseline.copy->direction() != baseline.direction;
+    }
+
+    // nodes
+    QHash<const Node*, int> nodePositions;
+    nodePositions.reserve(m_nodeCopies.length());
+    for (int i = 0; i < m_nodeCopies.length(); ++i) {
+        const NodePtr &copy = m_nodeCopies.at(i);
+        nodePositions.insert(copy.data(), i);
+        if (!copy->isValid()) {
+            m_removedNodes.append(i);
+            continue;
+        }
+        const NodeBaseline &baseline = m_nodes.at(i);
+        if (copy->type().data() != baseline.type
+            || copy->propertyRow() != baseline.row
+            || copy->x() != baseline.x
+            || copy->y() != baseline.y
+            || copy->color() != baseline.color
+            || changedProperties(copy, findBaseline(m_nodeTypes, baseline.type)))
+        {
+            m_changedNodes.append(i);
+        }
+    }
+    QHash<const Node*, int> insertedPositions;
+    foreach (const NodePtr &node, m_workingCopy->nodes()) {
+        if (!nodePositions.contains(node.data())) {
+            insertedPositions.insert(node.data(), m_insertedNodes.length());
+            m_insertedNodes.append(node);
+        }
+    }
+    auto nodeReference = [&](const NodePtr &node) {
+        const int position = nodePositions.value(node.data(), -1);
+        return position >= 0 ? position : -1 - insertedPositions.value(node.data());
+    };
+
+    // edges
+    QHash<const Edge*, int> edgePositions;
+    edgePositions.reserve(m_edgeCopies.length());
+    for (int i = 0; i < m_edgeCopies.length(); ++i) {
+        const EdgePtr &copy = m_edgeCopies.at(i);
+        edgePositions.insert(copy.data(), i);
+        if (!copy->isValid()) {
+            m_removedEdges.append(i);
+            continue;
+        }
+        const EdgeBaseline &baseline = m_edges.at(i);
+        if (copy->type().data() != baseline.type
+            || copy->propertyRow() != baseline.row
+            || changedProperties(copy, findBaseline(m_edgeTypes, baseline.type)))
+        {
+            m_changedEdges.append(i);
+        }
+    }
+    foreach (const EdgePtr &edge, m_workingCopy->edges()) {
+        if (!edgePositions.contains(edge.data())) {
+            InsertedEdge inserted = { edge, nodeReference(edge->from()), nodeReference(edge->to()) };
+            m_insertedEdges.append(inserted);
+        }
+    }
+}
+
+void GraphDiffPrivate::compare()
+{
+    clear();
+
+    // the matched element of the compared document is stored at the position of the element
+    // in the document, removed elements have none
+    m_nodeOrigins = m_document->nodes();
+    m_nodeCopies = NodeList(m_nodeOrigins.length());
+    foreach (const NodePtr &node, m_workingCopy->nodes()) {
+        const NodePtr previous = m_document->node(node->id());
+        if (!previous || m_nodeCopies.at(previous->documentIndex())) {
+            m_insertedNodes.append(node);
+            continue;
+        }
+        const int i = previous->documentIndex();
+        m_nodeCopies[i] = node;
+        if (previous->type()->id() != node->type()->id()
+            || previous->x() != node->x()
+            || previous->y() != node->y()
+            || previous->color() != node->color()
+            || !equalDynamicProperties(previous, node))
+        {
+            m_changedNodes.append(i);
+        }
+    }
+    for (int i = 0; i < m_nodeCopies.length(); ++i) {
+        if (!m_nodeCopies.at(i)) {
+            m_removedNodes.append(i);
+        }
+    }
+
+    // parallel edges are matched in the order of the edge lists
+    m_edgeOrigins = m_document->edges();
+    m_edgeCopies = EdgeList(m_edgeOrigins.length());
+    QHash<EdgeKey, QList<int> > previousEdges;
+    for (int i = 0; i < m_edgeOrigins.length(); ++i) {
+        previousEdges[edgeKey(m_edgeOrigins.at(i))].append(i);
+    }
+    foreach (const EdgePtr &edge, m_workingCopy->edges()) {
+        auto candidates = previousEdges.find(edgeKey(edge));
+        if (candidates == previousEdges.end() || candidates->isEmpty()) {
+            InsertedEdge inserted = { edge, 0, 0 };
+            m_insertedEdges.append(inserted);
+            continue;
+        }
+        const int i = candidates->takeFirst();
+        m_edgeCopies[i] = edge;
+        if (!equalDynamicProperties(m_edgeOrigins.at(i), edge)) {
+            m_changedEdges.append(i);
+        }
+    }
+    for (int i = 0; i < m_edgeCopies.length(); ++i) {
+        if (!m_edgeCopies.at(i)) {
+            m_removedEdges.append(i);
+        }
+    }
+}
+
+void GraphDiffPrivate::apply() const
+{
+    Q_ASSERT(m_ownsWorkingCopy);
+    if (!m_ownsWorkingCopy) {
+        return;
+    }
+    BulkUpdateGuard bulkUpdate(m_document);
+
+    // types, mapped from the working copy to the document
+    QHash<const NodeType*, NodeTypePtr> nodeTypes;
+    foreach (const TypeBaseline<NodeTypePtr> &baseline, m_nodeTypes) {
+        if (!baseline.origin->isValid()) {
+            continue;
+        }
+        if (!baseline.copy->isValid()) {
+            m_document->remove(baseline.origin);
+            continue;
+        }
+        applyType(baseline);
+        nodeTypes.insert(baseline.copy.data(), baseline.origin);
+    }
+    foreach (const NodeTypePtr &type, m_workingCopy->nodeTypes()) {
+        if (!findBaseline(m_nodeTypes, type.data())) {
+            nodeTypes.insert(type.data(), createType<NodeTypePtr, NodeType>(m_document, type, m_document->nodeTypes()));
+        }
+    }
+    QHash<const EdgeType*, EdgeTypePtr> edgeTypes;
+    foreach (const TypeBaseline<EdgeTypePtr> &baseline, m_edgeTypes) {
+        if (!baseline.origin->isValid()) {
+            continue;
+        }
+        if (!baseline.copy->isValid()) {
+            m_document->remove(baseline.origin);
+            continue;
+        }
+        applyType(baseline);
+        if (baseline.copy->direction() != baseline.direction) {
+            baseline.origin->setDirection(baseline.copy->direction());
+        }
+        edgeTypes.insert(baseline.copy.data(), baseline.origin);
+    }
+    foreach (const EdgeTypePtr &type, m_workingCopy->edgeTypes()) {
+        if (!findBaseline(m_edgeTypes, type.data())) {
+            EdgeTypePtr created = createType<EdgeTypePtr, EdgeType>(m_document, type, m_document->edgeTypes());
+            created->setDirection(type->direction());
+            edgeTypes.insert(type.data(), created);
+        }
+    }
+
+    // removed elements, unless already removed from the document
+    foreach (int i, m_removedEdges) {
+        if (m_edgeOrigins.at(i)->isValid()) {
+            m_document->remove(m_edgeOrigins.at(i));
+        }
+    }
+    foreach (int i, m_removedNodes) {
+        if (m_nodeOrigins.at(i)->isValid()) {
+            m_document->remove(m_nodeOrigins.at(i));
+        }
+    }
+
+    // nodes
+    foreach (int i, m_changedNodes) {
+        const NodePtr &origin = m_nodeOrigins.at(i);
+        const NodePtr &copy = m_nodeCopies.at(i);
+        const NodeBaseline &baseline = m_nodes.at(i);
+        if (!origin->isValid()) {
+            continue;
+        }
+        // after a change of the type, all values are new
+        const bool typeKept = copy->type().data() == baseline.type && copy->propertyRow() == baseline.row;
+        if (copy->type().data() != baseline.type && nodeTypes.contains(copy->type().data())) {
+            origin->setType(nodeTypes.value(copy->type().data()));
+        }
+        if (copy->x() != baseline.x) {
+            origin->setX(copy->x());
+        }
+        if (copy->y() != baseline.y) {
+            origin->setY(copy->y());
+        }
+        if (copy->color() != baseline.color) {
+            origin->setColor(copy->color());
+        }
+        QVector<int> columns;
+        changedProperties(copy, typeKept ? findBaseline(m_nodeTypes, baseline.type) : nullptr, &columns);
+        copyProperties(copy, origin, columns);
+    }
+    NodeList insertedNodes;
+    insertedNodes.reserve(m_insertedNodes.length());
+    foreach (const NodePtr &copy, m_insertedNodes) {
+        NodePtr node = Node::create(m_document);
+        if (!m_document->node(copy->id())) {
+            node->setId(copy->id());
+        }
+        if (nodeTypes.contains(copy->type().data())) {
+            node->setType(nodeTypes.value(copy->type().data()));
+        }
+        node->setX(copy->x());
+        node->setY(copy->y());
+        node->setColor(copy->color());
+        QVector<int> columns;
+        changedProperties<NodePtr, NodeTypePtr>(copy, nullptr, &columns);
+        copyProperties(copy, node, columns);
+        insertedNodes.append(node);
+    }
+
+    // edges
+    foreach (int i, m_changedEdges) {
+        const EdgePtr &origin = m_edgeOrigins.at(i);
+        const EdgePtr &copy = m_edgeCopies.at(i);
+        if (!origin->isValid()) {
+            continue;
+        }
+        const EdgeBaseline &baseline = m_edges.at(i);
+        const bool typeKept = copy->type().data() == baseline.type && copy->propertyRow() == baseline.row;
+        if (copy->type().data() != baseline.type && edgeTypes.contains(copy->type().data())) {
+            origin->setType(edgeTypes.value(copy->type().data()));
+        }
+        QVector<int> columns;
+        changedProperties(copy, typeKept ? findBaseline(m_edgeTypes, baseline.type) : nullptr, &columns);
+        copyProperties(copy, origin, columns);
+    }
+    foreach (const InsertedEdge &inserted, m_insertedEdges) {
+        const NodePtr from = inserted.from >= 0 ? m_nodeOrigins.at(inserted.from) : insertedNodes.at(-1 - inserted.from);
+        const NodePtr to = inserted.to >= 0 ? m_nodeOrigins.at(inserted.to) : insertedNodes.at(-1 - inserted.to);
+        if (!from->isValid() || !to->isValid()) {
+            continue;
+        }
+        EdgePtr edge = Edge::create(from, to);
+        if (edgeTypes.contains(inserted.copy->type().data())) {
+            edge->setType(edgeTypes.value(inserted.copy->type().data()));
+        }
+        QVector<int> columns;
+        changedProperties<EdgePtr, EdgeTypePtr>(inserted.copy, nullptr, &columns);
+        copyProperties(inserted.copy, edge, columns);
+    }
+}
+
+GraphDiff::GraphDiff(GraphDocumentPtr document)
+    : d(new GraphDiffPrivate)
+{
+    Q_ASSERT(document);
+    d->m_document = document;
+    d->m_workingCopy = document->clone();
+    d->m_ownsWorkingCopy = true;
+
+    // the clone creates types and elements in the order of the document
+    const QList<NodeTypePtr> nodeTypes = document->nodeTypes();
+    const QList<NodeTypePtr> nodeTypeCopies = d->m_workingCopy->nodeTypes();
+    for (int i = 0; i < nodeTypes.length(); ++i) {
+        d->m_nodeTypes.append(GraphDiffPrivate::createBaseline(nodeTypes.at(i), nodeTypeCopies.at(i)));
+    }
+    const QList<EdgeTypePtr> edgeTypes = document->edgeTypes();
+    const QList<EdgeTypePtr> edgeTypeCopies = d->m_workingCopy->edgeTypes();
+    for (int i = 0; i < edgeTypes.length(); ++i) {
+        d->m_edgeTypes.append(GraphDiffPrivate::createBaseline(edgeTypes.at(i), edgeTypeCopies.at(i)));
+        d->m_edgeTypes.last().direction = edgeTypeCopies.at(i)->direction();
+    }
+
+    d->m_nodeOrigins = document->nodes();
+    d->m_nodeCopies = d->m_workingCopy->nodes();
+    d->m_nodes.reserve(d->m_nodeCopies.length());
+    foreach (const NodePtr &copy, d->m_nodeCopies) {
+        const NodeBaseline baseline = { copy->x(), copy->y(), copy->color(), copy->type().data(), copy->propertyRow() };
+        d->m_nodes.append(baseline);
+    }
+    d->m_edgeOrigins = document->edges();
+    d->m_edgeCopies = d->m_workingCopy->edges();
+    d->m_edges.reserve(d->m_edgeCopies.length());
+    foreach (const EdgePtr &copy, d->m_edgeCopies) {
+        const EdgeBaseline baseline = { copy->type().data(), copy->propertyRow() };
+        d->m_edges.append(baseline);
+    }
+}
+
+GraphDiff::GraphDiff(GraphDocumentPtr from, GraphDocumentPtr to)
+    : d(new GraphDiffPrivate)
+{
+    Q_ASSERT(from);
+    Q_ASSERT(to);
+    d->m_document = from;
+    d->m_workingCopy = to;
+    d->compare();
+}
+
+GraphDiff::~GraphDiff()
+{
+}
+
+GraphDocumentPtr GraphDiff::document() const
+{
+    return d->m_document;
+}
+
+GraphDocumentPtr GraphDiff::workingCopy() const
+{
+    return d->m_workingCopy;
+}
+
+void GraphDiff::update()
+{
+    d->update();
+}
+
+void GraphDiff::apply() const
+{
+    d->apply();
+}
+
+bool GraphDiff::isEmpty() const
+{
+    return !d->m_typesChanged
+        && d->m_insertedNodes.isEmpty() && d->m_removedNodes.isEmpty()
+        && d->m_changedNodes.isEmpty() && d->m_insertedEdges.isEmpty()
+        && d->m_removedEdges.isEmpty() && d->m_changedEdges.isEmpty();
+}
+
+NodeList GraphDiff::insertedNodes() const
+{
+    return d->m_insertedNodes;
+}
+
+NodeList GraphDiff::removedNodes() const
+{
+    NodeList nodes;
+    foreach (int i, d->m_removedNodes) {
+        nodes.append(d->m_nodeOrigins.at(i));
+    }
+    return nodes;
+}
+
+NodeList GraphDiff::changedNodes() const
+{
+    NodeList nodes;
+    foreach (int i, d->m_changedNodes) {
+        nodes.append(d->m_nodeCopies.at(i));
+    }
+    return nodes;
+}
+
+EdgeList GraphDiff::insertedEdges() const
+{
+    EdgeList edges;
+    foreach (const InsertedEdge &inserted, d->m_insertedEdges) {
+        edges.append(inserted.copy);
+    }
+    return edges;
+}
+
+EdgeList GraphDiff::removedEdges() const
+{
+    EdgeList edges;
+    foreach (int i, d->m_removedEdges) {
+        edges.append(d->m_edgeOrigins.at(i));
+    }
+    return edges;
+}
+
+EdgeList GraphDiff::changedEdges() const
+{
+    EdgeList edges;
+    foreach (int i, d->m_changedEdges) {
+        edges.append(d->m_edgeCopies.at(i));
+    }
+    return edges;
+}
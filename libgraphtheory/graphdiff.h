@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRAPHDIFF_H
+#define GRAPHDIFF_H
+
+#include "graphtheory_export.h"
+#include "typenames.h"
+
+#include <QScopedPointer>
+
+namespace GraphTheory
+{
+class GraphDiffPrivate;
+
+/**
+ * \class GraphDiff
+ *
+ * Working copy of a graph document together with its changes. The working copy is created as
+ * clone of the document and can be modified independently of it, e.g. on another thread. Each
+ * element of the working copy that existed at creation is associated with the element of the
+ * document it was copied from, thus changes are identified by element identity and do neither
+ * depend on identifiers nor on the order of parallel edges.
+ *
+ * The state of the working copy at creation is the baseline: only values that differ from the
+ * baseline are changes, such that modifications of the document in the meantime are preserved
+ * unless the same value was changed in the working copy.
+ *
+ * The working copy clones every type, node and edge of the document, which are QObjects, thus
+ * creating and destroying it takes time linear in the size of the document, as does update().
+ * apply() only touches the changed elements. See bench_graphdiff for measurements.
+ *
+ * Alternatively, two independent documents can be compared, e.g., a document and a version
+ * of it loaded from a file. Then nodes are matched by their identifiers and edges by the
+ * identifiers of their end points and their edge type; parallel edges are matched in the
+ * order of GraphDocument::edges(). A matched element is changed if its type, its dynamic
+ * property values or, for nodes, its position or color differ. Types are not compared.
+ */
+class GRAPHTHEORY_EXPORT GraphDiff
+{
+public:
+    /**
+     * Create working copy of @p document. Must be called in the thread that modifies
+     * @p document.
+     */
+    explicit GraphDiff(GraphDocumentPtr document);
+
+    /**
+     * Compute the changes from document @p from to document @p to. Here, document() is
+     * @p from and workingCopy() is @p to, which is not owned by the diff. apply() is not
+     * supported for compared documents.
+     */
+    GraphDiff(GraphDocumentPtr from, GraphDocumentPtr to);
+
+    /**
+     * Destroys the working copy, unless it was given for comparison.
+     */
+    ~GraphDiff();
+
+    /**
+     * @return the document from which the working copy was created
+     */
+    GraphDocumentPtr document() const;
+
+    /**
+     * @return the working copy
+     */
+    GraphDocumentPtr workingCopy() const;
+
+    /**
+     * Compute the changes of the working copy relative to the baseline. The working copy must
+     * not be modified concurrently; the document is not accessed. For compared documents, the
+     * comparison is repeated.
+     */
+    void update();
+
+    /**
+     * @return @e true if the last update() found no inserted, removed or changed element and
+     * no changed type, otherwise @e false
+     */
+    bool isEmpty() const;
+
+    /**
+     * @return nodes of the working copy that were created after the baseline
+     */
+    NodeList insertedNodes() const;
+
+    /**
+     * @return nodes of the document whose copy was removed from the working copy
+     */
+    NodeList removedNodes() const;
+
+    /**
+     * @return nodes of the working copy whose type, position, color or dynamic property values
+     * differ from the baseline
+     */
+    NodeList changedNodes() const;
+
+    /**
+     * @return edges of the working copy that were created after the baseline
+     */
+    EdgeList insertedEdges() const;
+
+    /**
+     * @return edges of the document whose copy was removed from the working copy
+     */
+    EdgeList removedEdges() const;
+
+    /**
+     * @return edges of the working copy whose type or dynamic property values differ from
+     * the baseline
+     */
+    EdgeList changedEdges() const;
+
+    /**
+     * Apply the changes found by the last update() of a working copy to the document in one
+     * bulk update:
+     *  - types that were created, removed or changed in the working copy are created, removed
+     *    or changed, including added, removed and renamed dynamic properties,
+     *  - removed elements are removed, unless they are already gone,
+     *  - changed elements get the values that differ from the baseline,
+     *  - inserted elements are created; inserted nodes keep their identifier if it is still
+     *    unused in the document, otherwise they get a new one.
+     */
+    void apply() const;
+
+private:
+    Q_DISABLE_COPY(GraphDiff)
+    const QScopedPointer<GraphDiffPrivate> d;
+};
+}
+
+#endif
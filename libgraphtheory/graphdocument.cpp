@@ -23,11 +23,18 @@
 #include "edgetype.h"
 #include "nodetype.h"
 #include "edge.h"
+#include "nodetypestyle.h"
+#include "edgetypestyle.h"
+#include "propertytable_p.h"
+#include "elementpool_p.h"
 #include "fileformats/fileformatmanager.h"
 #include "logging_p.h"
 #include <KLocalizedString>
+#include <QFileInfo>
 #include <QSurfaceFormat>
 #include <QString>
+#include <QHash>
+#include <QMultiHash>
 
 using namespace GraphTheory;
 
@@ -43,6 +50,11 @@ public:
         , m_name(QString())
         , m_lastGeneratedId(0)
         , m_modified(false)
+        , m_bulkUpdateDepth(0)
+        , m_bulkFirstNode(0)
+        , m_bulkFirstEdge(0)
+        , m_bulkNodesRemoved(false)
+        , m_bulkEdgesRemoved(false)
     {
     }
 
@@ -57,11 +69,19 @@ public:
     QList<NodeTypePtr> m_nodeTypes;
     NodeList m_nodes;
     EdgeList m_edges;
+    QMultiHash<int, NodePtr> m_nodeIds; // index of node identifiers
 
     QUrl m_documentUrl;
     QString m_name;
     uint m_lastGeneratedId;
     bool m_modified;
+
+    // state of current bulk update
+    int m_bulkUpdateDepth;
+    int m_bulkFirstNode;
+    int m_bulkFirstEdge;
+    bool m_bulkNodesRemoved;
+    bool m_bulkEdgesRemoved;
 };
 
 GraphDocumentPtr GraphDocument::self() const
@@ -80,6 +100,7 @@ void GraphDocument::destroy()
         node->destroy();
     }
     d->m_nodes.clear();
+    d->m_nodeIds.clear();
     foreach (NodeTypePtr type, d->m_nodeTypes) {
         type->destroy();
     }
@@ -102,7 +123,8 @@ GraphDocument::GraphDocument()
 
 GraphDocument::~GraphDocument()
 {
-
+    // elements keep their document alive, thus all of them are deleted by now
+    ElementPool::releaseAllUnusedSlabs();
     --GraphDocument::objectCounter;
 }
 
@@ -135,6 +157,61 @@ GraphDocumentPtr GraphDocument::create()
     return pi;
 }
 
+GraphDocumentPtr GraphDocument::clone() const
+{
+    GraphDocumentPtr pi(new GraphDocument);
+    pi->setQpointer(pi);
+    pi->d->m_name = d->m_name;
+
+    // copy types, property tables are implicitly shared until one of the copies is modified
+    QHash<NodeTypePtr, NodeTypePtr> nodeTypes;
+    foreach (const NodeTypePtr &type, d->m_nodeTypes) {
+        NodeTypePtr typeCopy = NodeType::create(pi);
+        typeCopy->setId(type->id());
+        typeCopy->setName(type->name());
+        typeCopy->style()->setColor(type->style()->color());
+        typeCopy->style()->setVisible(type->style()->isVisible());
+        typeCopy->style()->setPropertyNamesVisible(type->style()->isPropertyNamesVisible());
+        foreach (const QString &property, type->dynamicProperties()) {
+            typeCopy->addDynamicProperty(property);
+        }
+        *typeCopy->propertyTable() = *type->propertyTable();
+        nodeTypes.insert(type, typeCopy);
+    }
+    QHash<EdgeTypePtr, EdgeTypePtr> edgeTypes;
+    foreach (const EdgeTypePtr &type, d->m_edgeTypes) {
+        EdgeTypePtr typeCopy = EdgeType::create(pi);
+        typeCopy->setId(type->id());
+        typeCopy->setName(type->name());
+        typeCopy->setDirection(type->direction());
+        typeCopy->style()->setColor(type->style()->color());
+        typeCopy->style()->setVisible(type->style()->isVisible());
+        typeCopy->style()->setPropertyNamesVisible(type->style()->isPropertyNamesVisible());
+        foreach (const QString &property, type->dynamicProperties()) {
+            typeCopy->addDynamicProperty(property);
+        }
+        *typeCopy->propertyTable() = *type->propertyTable();
+        edgeTypes.insert(type, typeCopy);
+    }
+
+    // copies are inserted in the same order, thus document indices of end points are kept
+    pi->d->m_nodes.reserve(d->m_nodes.length());
+    pi->d->m_edges.reserve(d->m_edges.length());
+    foreach (const NodePtr &node, d->m_nodes) {
+        node->clone(pi, nodeTypes.value(node->type()));
+    }
+    foreach (const EdgePtr &edge, d->m_edges) {
+        edge->clone(pi->d->m_nodes.at(edge->from()->documentIndex()),
+            pi->d->m_nodes.at(edge->to()->documentIndex()),
+            edgeTypes.value(edge->type()));
+    }
+
+    pi->d->m_lastGeneratedId = d->m_lastGeneratedId;
+    pi->d->m_valid = true;
+    pi->d->m_modified = false;
+    return pi;
+}
+
 NodeList GraphDocument::nodes(NodeTypePtr type) const
 {
     if (!type) {
@@ -165,20 +242,33 @@ EdgeList GraphDocument::edges(EdgeTypePtr type) const
     return edges;
 }
 
+NodePtr GraphDocument::node(int id) const
+{
+    return d->m_nodeIds.value(id);
+}
+
 void GraphDocument::insert(NodePtr node)
 {
     Q_ASSERT(node);
     Q_ASSERT(node->document() == d->q);
 
-    if (!node || d->m_nodes.contains(node)) {
+    if (!node || node->documentIndex() >= 0) {
         return;
     }
     if (0 <= node->id() && (uint)node->id() < d->m_lastGeneratedId) {
         d->m_lastGeneratedId = node->id();
     }
 
+    if (d->m_bulkUpdateDepth > 0) {
+        node->setDocumentIndex(d->m_nodes.length());
+        d->m_nodes.append(node);
+        d->m_nodeIds.insert(node->id(), node);
+        return;
+    }
     emit nodeAboutToBeAdded(node, d->m_nodes.length());
+    node->setDocumentIndex(d->m_nodes.length());
     d->m_nodes.append(node);
+    d->m_nodeIds.insert(node->id(), node);
     emit nodeAdded();
     setModified(true);
 }
@@ -189,11 +279,17 @@ void GraphDocument::insert(EdgePtr edge)
     Q_ASSERT(edge->from()->document() == d->q);
     Q_ASSERT(edge->to()->document() == d->q);
 
-    if (!edge || d->m_edges.contains(edge)) {
+    if (!edge || edge->documentIndex() >= 0) {
         return;
     }
 
+    if (d->m_bulkUpdateDepth > 0) {
+        edge->setDocumentIndex(d->m_edges.length());
+        d->m_edges.append(edge);
+        return;
+    }
     emit edgeAboutToBeAdded(edge, d->m_edges.length());
+    edge->setDocumentIndex(d->m_edges.length());
     d->m_edges.append(edge);
     emit edgeAdded();
     setModified(true);
@@ -234,11 +330,31 @@ void GraphDocument::remove(NodePtr node)
     if (node->isValid()) {
         node->destroy();
     }
-    int index = d->m_nodes.indexOf(node);
-    if (index >= 0) {
-        emit nodesAboutToBeRemoved(index,index);
-        d->m_nodes.removeAt(index);
-        emit nodesRemoved();
+    const int index = node->documentIndex();
+    if (index < 0) {
+        return;
+    }
+    d->m_nodeIds.remove(node->id(), node);
+    const bool bulkUpdate = d->m_bulkUpdateDepth > 0;
+    const int last = d->m_nodes.length() - 1;
+    if (!bulkUpdate) {
+        emit nodesAboutToBeRemoved(last, last);
+    }
+    // efficient way to remove node without having to preserve order:
+    // the last node takes the slot of the removed one, thus the last row vanishes
+    NodePtr lastNode = d->m_nodes.at(last);
+    d->m_nodes[index] = lastNode;
+    lastNode->setDocumentIndex(index);
+    d->m_nodes.removeLast();
+    node->setDocumentIndex(-1);
+    emit nodeRemoved(node);
+    if (bulkUpdate) {
+        d->m_bulkNodesRemoved = true;
+        return;
+    }
+    emit nodesRemoved();
+    if (index != last) {
+        emit nodeReplaced(index);
     }
     setModified(true);
 }
@@ -248,15 +364,42 @@ void GraphDocument::remove(EdgePtr edge)
     if (edge->isValid()) {
         edge->destroy();
     }
-    int index = d->m_edges.indexOf(edge);
-    if (index >= 0) {
-        emit edgesAboutToBeRemoved(index,index);
-        d->m_edges.removeAt(index);
-        emit edgesRemoved();
+    const int index = edge->documentIndex();
+    if (index < 0) {
+        return;
+    }
+    const bool bulkUpdate = d->m_bulkUpdateDepth > 0;
+    const int last = d->m_edges.length() - 1;
+    if (!bulkUpdate) {
+        emit edgesAboutToBeRemoved(last, last);
+    }
+    // efficient way to remove edge without having to preserve order:
+    // the last edge takes the slot of the removed one, thus the last row vanishes
+    EdgePtr lastEdge = d->m_edges.at(last);
+    d->m_edges[index] = lastEdge;
+    lastEdge->setDocumentIndex(index);
+    d->m_edges.removeLast();
+    edge->setDocumentIndex(-1);
+    emit edgeRemoved(edge);
+    if (bulkUpdate) {
+        d->m_bulkEdgesRemoved = true;
+        return;
+    }
+    emit edgesRemoved();
+    if (index != last) {
+        emit edgeReplaced(index);
     }
     setModified(true);
 }
 
+void GraphDocument::remove(const EdgeList &edges)
+{
+    BulkUpdateGuard bulkUpdate(d->q);
+    foreach (EdgePtr edge, edges) {
+        remove(edge);
+    }
+}
+
 void GraphDocument::remove(NodeTypePtr type)
 {
     foreach (NodePtr node, d->m_nodes) {
@@ -289,6 +432,64 @@ void GraphDocument::remove(EdgeTypePtr type)
     setModified(true);
 }
 
+void GraphDocument::beginBulkUpdate()
+{
+    if (d->m_bulkUpdateDepth++ > 0) {
+        return;
+    }
+    d->m_bulkFirstNode = d->m_nodes.length();
+    d->m_bulkFirstEdge = d->m_edges.length();
+    d->m_bulkNodesRemoved = false;
+    d->m_bulkEdgesRemoved = false;
+}
+
+void GraphDocument::endBulkUpdate()
+{
+    Q_ASSERT(d->m_bulkUpdateDepth > 0);
+    if (d->m_bulkUpdateDepth <= 0 || --d->m_bulkUpdateDepth > 0) {
+        return;
+    }
+    bool modified = false;
+    if (d->m_bulkNodesRemoved) {
+        emit nodesReset();
+        modified = true;
+    } else if (d->m_nodes.length() > d->m_bulkFirstNode) {
+        emit nodesAdded(d->m_bulkFirstNode, d->m_nodes.length() - 1);
+        modified = true;
+    }
+    if (d->m_bulkEdgesRemoved) {
+        emit edgesReset();
+        modified = true;
+    } else if (d->m_edges.length() > d->m_bulkFirstEdge) {
+        emit edgesAdded(d->m_bulkFirstEdge, d->m_edges.length() - 1);
+        modified = true;
+    }
+    if (modified) {
+        setModified(true);
+    }
+}
+
+BulkUpdateGuard::BulkUpdateGuard(GraphDocumentPtr document)
+    : m_document(document)
+{
+    Q_ASSERT(m_document);
+    m_document->beginBulkUpdate();
+}
+
+BulkUpdateGuard::~BulkUpdateGuard()
+{
+    release();
+}
+
+void BulkUpdateGuard::release()
+{
+    if (!m_document) {
+        return;
+    }
+    m_document->endBulkUpdate();
+    m_document.reset();
+}
+
 QList< EdgeTypePtr > GraphDocument::edgeTypes() const
 {
     return d->m_edgeTypes;
@@ -309,6 +510,20 @@ void GraphDocument::setQpointer(GraphDocumentPtr q)
     d->q = q;
 }
 
+void GraphDocument::updateNodeId(NodePtr node, int oldId)
+{
+    // only nodes that are registered at the document are indexed
+    if (d->m_nodeIds.remove(oldId, node) == 0) {
+        return;
+    }
+    d->m_nodeIds.insert(node->id(), node);
+
+    // generated identifiers must not collide with explicitly set ones
+    if (node->id() > 0 && uint(node->id()) > d->m_lastGeneratedId) {
+        d->m_lastGeneratedId = node->id();
+    }
+}
+
 //BEGIN file stuff
 QString GraphDocument::documentName() const
 {
@@ -351,8 +566,16 @@ bool GraphDocument::documentSaveAs(const QUrl &documentUrl)
         return false;
     }
 
+    // documents are always saved in a lossless format: the default format, or the previous
+    // default format for documents of older projects; other formats are only written by exports
     FileFormatManager fileFormatManager;
-    FileFormatInterface *serializer = fileFormatManager.defaultBackend();
+    FileFormatInterface *serializer = nullptr;
+    if (QFileInfo(documentUrl.toLocalFile()).suffix().compare(QLatin1String("graph2"), Qt::CaseInsensitive) == 0) {
+        serializer = fileFormatManager.backendByExtension(QStringLiteral("graph2"));
+    }
+    if (!serializer) {
+        serializer = fileFormatManager.defaultBackend();
+    }
     serializer->setFile(documentUrl);
     serializer->writeFile(d->q);
     if (serializer->hasError()) {
@@ -52,6 +52,17 @@ public:
      */
     static GraphDocumentPtr create();
 
+    /**
+     * Creates a copy of this document with equal types, nodes and edges, including their
+     * identifiers and dynamic property values. Nodes and edges are copied in the order of
+     * nodes() and edges(). Dynamic property values are shared with this document until one
+     * of the documents modifies them, such that cloning large documents is cheap. The copy
+     * has no document URL and no view.
+     *
+     * @return the new GraphDocument object
+     */
+    GraphDocumentPtr clone() const;
+
     /** Destroys the document */
     virtual ~GraphDocument();
 
@@ -77,6 +88,16 @@ public:
      */
     EdgeList edges(EdgeTypePtr type = EdgeTypePtr()) const;
 
+    /**
+     * Look up the node with identifier @p id. Nodes are indexed by their identifiers when
+     * they are inserted and whenever Node::setId() is called, such that the lookup takes
+     * constant time on average. If several nodes share the identifier @p id, one of them is
+     * returned.
+     *
+     * @return the node with identifier @p id or a null pointer if no such node exists
+     */
+    NodePtr node(int id) const;
+
     /**
      * Add @p node to this document. The node must be correctly setup before, i.e.,
      * its type and document values have to be set. When inserting a node already in the list,
@@ -111,7 +132,9 @@ public:
 
     /**
      * Remove @p node from this document. If the node is valid, Node::destroy() will be called,
-     * otherwise it will only be removed.
+     * otherwise it will only be removed. Removal takes constant time and does not preserve
+     * the order of nodes: the last node of the list takes the position of the removed node,
+     * which is announced by signal nodeReplaced().
      *
      * @param node  the node to be removed from the document
      */
@@ -119,12 +142,21 @@ public:
 
     /**
      * Remove @p edge from this document. If the edge is valid, Edge::destroy() will be called,
-     * otherwise it will only be removed.
+     * otherwise it will only be removed. Removal takes constant time and does not preserve
+     * the order of edges: the last edge of the list takes the position of the removed edge,
+     * which is announced by signal edgeReplaced().
      *
      * @param edge  the edge to be removed from the document
      */
     void remove(EdgePtr edge);
 
+    /**
+     * Remove all @p edges from this document within one bulk update.
+     *
+     * @param edges  the edges to be removed from the document
+     */
+    void remove(const EdgeList &edges);
+
     /**
      * Remove @p type and all associated nodes from this document. If the type is valid,
      * NodeType::destroy() will be called.
@@ -141,6 +173,25 @@ public:
      */
     void remove(EdgeTypePtr type);
 
+    /**
+     * Start a bulk update of the document. Until the matching endBulkUpdate() call, inserting
+     * or removing nodes and edges does not emit the per-element signals nodeAboutToBeAdded(),
+     * nodeAdded(), nodesAboutToBeRemoved() and nodesRemoved() (and their edge counterparts).
+     * Instead, endBulkUpdate() notifies listeners once about all changes. Bulk updates can
+     * be nested; only the outermost endBulkUpdate() call emits signals.
+     *
+     * While a bulk update is in progress, listeners must not access the document by row.
+     * Use BulkUpdateGuard to ensure that every bulk update is finished.
+     */
+    void beginBulkUpdate();
+
+    /**
+     * Finish a bulk update started by beginBulkUpdate(). If only nodes were appended, signal
+     * nodesAdded(first, last) is emitted for the range of appended nodes; if nodes were
+     * removed, nodesReset() is emitted. The same holds for edges.
+     */
+    void endBulkUpdate();
+
     /**
      * List of registered edge types. The list is never empty and the first element is the
      * default EdgeType.
@@ -179,14 +230,30 @@ Q_SIGNALS:
     void nodeAdded();
     void nodesAboutToBeRemoved(int,int);
     void nodesRemoved();
+    /** node at index @p index was replaced by the former last node of the list **/
+    void nodeReplaced(int index);
+    /** @p node was removed from the document, also emitted during bulk updates **/
+    void nodeRemoved(NodePtr node);
     void edgeAboutToBeAdded(EdgePtr,int);
     void edgeAdded();
     void edgesAboutToBeRemoved(int,int);
     void edgesRemoved();
+    /** edge at index @p index was replaced by the former last edge of the list **/
+    void edgeReplaced(int index);
+    /** @p edge was removed from the document, also emitted during bulk updates **/
+    void edgeRemoved(EdgePtr edge);
     void nodeTypeAboutToBeAdded(NodeTypePtr,int);
     void nodeTypeAdded();
     void nodeTypesAboutToBeRemoved(int,int);
     void nodeTypesRemoved();
+    /** nodes from index @p first to @p last were appended by a bulk update **/
+    void nodesAdded(int first, int last);
+    /** nodes were inserted and removed by a bulk update, all node indices are invalidated **/
+    void nodesReset();
+    /** edges from index @p first to @p last were appended by a bulk update **/
+    void edgesAdded(int first, int last);
+    /** edges were inserted and removed by a bulk update, all edge indices are invalidated **/
+    void edgesReset();
     void edgeTypeAboutToBeAdded(EdgeTypePtr,int);
     void edgeTypeAdded();
     void edgeTypesAboutToBeRemoved(int,int);
@@ -232,6 +299,9 @@ public:
     /**
      * Save document to path @p url, this does not change the documentUrl value.
      * To also change the document value, use setDocumentUrl(...).
+     * The document is written in the default format of FileFormatManager, which is the binary
+     * graph format; only files with extension "graph2" keep the previous default format. Other
+     * formats may lose information and are only written by exporting the document.
      * @return @e true on success, i.e. the save has been done, otherwise
      *         @e false
      */
@@ -270,8 +340,40 @@ private:
     Q_DISABLE_COPY(GraphDocument)
     const QScopedPointer<GraphDocumentPrivate> d;
     void setQpointer(GraphDocumentPtr q);
+    /** update identifier index after ID of @p node changed from @p oldId **/
+    void updateNodeId(NodePtr node, int oldId);
+    friend class Node;
     static uint objectCounter;
 };
+
+/**
+ * \class BulkUpdateGuard
+ *
+ * Starts a bulk update of a document at construction and finishes it at destruction, such
+ * that early returns and exceptions do not leave the document in bulk update mode.
+ */
+class GRAPHTHEORY_EXPORT BulkUpdateGuard
+{
+public:
+    /**
+     * Calls GraphDocument::beginBulkUpdate() on @p document.
+     */
+    explicit BulkUpdateGuard(GraphDocumentPtr document);
+
+    /**
+     * Calls GraphDocument::endBulkUpdate() on the document, unless release() was called before.
+     */
+    ~BulkUpdateGuard();
+
+    /**
+     * Finish the bulk update before the guard is destroyed.
+     */
+    void release();
+
+private:
+    Q_DISABLE_COPY(BulkUpdateGuard)
+    GraphDocumentPtr m_document;
+};
 }
 
 #endif
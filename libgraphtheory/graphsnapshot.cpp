@@ -0,0 +1,269 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "graphsnapshot.h"
+#include "graphdocument.h"
+#include "edgetype.h"
+#include "node.h"
+#include "edge.h"
+#include "propertykey.h"
+
+#include <QHash>
+#include <QSharedData>
+#include <QtNumeric>
+
+using namespace GraphTheory;
+
+namespace
+{
+// one CSR adjacency structure
+struct Adjacency {
+    QVector<int> offsets;
+    QVector<int> targets;
+    QVector<int> edges;
+};
+}
+
+class GraphTheory::GraphSnapshotPrivate : public QSharedData
+{
+public:
+    GraphSnapshotPrivate()
+    {
+        m_all.offsets.fill(0, 1);
+    }
+
+    /**
+     * Fill @p adjacency with all edges for which @p accept returns true.
+     */
+    template<typename Predicate>
+    void buildAdjacency(Adjacency &adjacency, Predicate accept)
+    {
+        const int n = m_nodes.length();
+        QVector<int> degree(n + 1, 0);
+        for (int e = 0; e < m_edges.length(); ++e) {
+            if (!accept(e)) {
+                continue;
+            }
+            ++degree[m_sources.at(e) + 1];
+            if (m_bidirectional.at(e) && m_sources.at(e) != m_targets.at(e)) {
+                ++degree[m_targets.at(e) + 1];
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            degree[i + 1] += degree[i];
+        }
+        adjacency.offsets = degree;
+        adjacency.targets.resize(degree.last());
+        adjacency.edges.resize(degree.last());
+
+        // reuse degree as insert position of every node
+        for (int e = 0; e < m_edges.length(); ++e) {
+            if (!accept(e)) {
+                continue;
+            }
+            const int from = m_sources.at(e);
+            const int to = m_targets.at(e);
+            adjacency.targets[degree[from]] = to;
+            adjacency.edges[degree[from]++] = e;
+            if (m_bidirectional.at(e) && from != to) {
+                adjacency.targets[degree[to]] = from;
+                adjacency.edges[degree[to]++] = e;
+            }
+        }
+    }
+
+    NodeList m_nodes;
+    EdgeList m_edges;
+    QList<EdgeTypePtr> m_edgeTypes;
+    QHash<const Node*, int> m_nodeIndices;
+    QVector<int> m_nodeIds;
+    QVector<int> m_sources;
+    QVector<int> m_targets;
+    QVector<int> m_types;
+    QVector<bool> m_bidirectional;
+    Adjacency m_all;
+    QVector<Adjacency> m_typeAdjacencies;
+    QStringList m_weightProperties;
+    QVector< QVector<qreal> > m_weights;
+};
+
+GraphSnapshot::GraphSnapshot()
+    : d(new GraphSnapshotPrivate)
+{
+}
+
+GraphSnapshot::GraphSnapshot(GraphDocumentPtr document, const QStringList &weightProperties)
+    : d(new GraphSnapshotPrivate)
+{
+    Q_ASSERT(document);
+    d->m_nodes = document->nodes();
+    d->m_edges = document->edges();
+    d->m_edgeTypes = document->edgeTypes();
+    d->m_weightProperties = weightProperties;
+
+    const int n = d->m_nodes.length();
+    const int m = d->m_edges.length();
+
+    d->m_nodeIndices.reserve(n);
+    d->m_nodeIds.resize(n);
+    for (int i = 0; i < n; ++i) {
+        d->m_nodeIndices.insert(d->m_nodes.at(i).data(), i);
+        d->m_nodeIds[i] = d->m_nodes.at(i)->id();
+    }
+
+    QHash<const EdgeType*, int> typeIndices;
+    for (int t = 0; t < d->m_edgeTypes.length(); ++t) {
+        typeIndices.insert(d->m_edgeTypes.at(t).data(), t);
+    }
+
+    QVector<PropertyKey> keys;
+    foreach (const QString &property, weightProperties) {
+        keys.append(PropertyKey(property));
+    }
+    d->m_weights.fill(QVector<qreal>(m), keys.length());
+
+    d->m_sources.resize(m);
+    d->m_targets.resize(m);
+    d->m_types.resize(m);
+    d->m_bidirectional.resize(m);
+    for (int e = 0; e < m; ++e) {
+        const EdgePtr &edge = d->m_edges.at(e);
+        d->m_sources[e] = d->m_nodeIndices.value(edge->from().data());
+        d->m_targets[e] = d->m_nodeIndices.value(edge->to().data());
+        d->m_types[e] = typeIndices.value(edge->type().data());
+        d->m_bidirectional[e] = edge->type()->direction() == EdgeType::Bidirectional;
+        for (int w = 0; w < keys.length(); ++w) {
+            bool ok = false;
+            const qreal weight = edge->dynamicProperty(keys.at(w)).toReal(&ok);
+            d->m_weights[w][e] = ok ? weight : qQNaN();
+        }
+    }
+
+    d->buildAdjacency(d->m_all, [](int) { return true; });
+    d->m_typeAdjacencies.resize(d->m_edgeTypes.length());
+    for (int t = 0; t < d->m_edgeTypes.length(); ++t) {
+        const QVector<int> &types = d->m_types;
+        d->buildAdjacency(d->m_typeAdjacencies[t], [&types, t](int e) { return types.at(e) == t; });
+    }
+}
+
+GraphSnapshot::GraphSnapshot(const GraphSnapshot &other)
+    : d(other.d)
+{
+}
+
+GraphSnapshot & GraphSnapshot::operator=(const GraphSnapshot &other)
+{
+    d = other.d;
+    return *this;
+}
+
+GraphSnapshot::~GraphSnapshot()
+{
+}
+
+int GraphSnapshot::nodeCount() const
+{
+    return d->m_nodes.length();
+}
+
+int GraphSnapshot::edgeCount() const
+{
+    return d->m_edges.length();
+}
+
+NodePtr GraphSnapshot::node(int index) const
+{
+    return d->m_nodes.at(index);
+}
+
+int GraphSnapshot::nodeIndex(const NodePtr &node) const
+{
+    return d->m_nodeIndices.value(node.data(), -1);
+}
+
+const QVector<int> & GraphSnapshot::nodeIds() const
+{
+    return d->m_nodeIds;
+}
+
+EdgePtr GraphSnapshot::edge(int index) const
+{
+    return d->m_edges.at(index);
+}
+
+const QVector<int> & GraphSnapshot::edgeSources() const
+{
+    return d->m_sources;
+}
+
+const QVector<int> & GraphSnapshot::edgeTargets() const
+{
+    return d->m_targets;
+}
+
+int GraphSnapshot::edgeTypeCount() const
+{
+    return d->m_edgeTypes.length();
+}
+
+int GraphSnapshot::edgeTypeIndex(const EdgeTypePtr &type) const
+{
+    return d->m_edgeTypes.indexOf(type);
+}
+
+const QVector<int> & GraphSnapshot::offsets(int type) const
+{
+    if (type == AllEdgeTypes) {
+        return d->m_all.offsets;
+    }
+    return d->m_typeAdjacencies.at(type).offsets;
+}
+
+const QVector<int> & GraphSnapshot::targets(int type) const
+{
+    if (type == AllEdgeTypes) {
+        return d->m_all.targets;
+    }
+    return d->m_typeAdjacencies.at(type).targets;
+}
+
+const QVector<int> & GraphSnapshot::edges(int type) const
+{
+    if (type == AllEdgeTypes) {
+        return d->m_all.edges;
+    }
+    return d->m_typeAdjacencies.at(type).edges;
+}
+
+int GraphSnapshot::weightCount() const
+{
+    return d->m_weights.length();
+}
+
+int GraphSnapshot::weightIndex(const QString &property) const
+{
+    return d->m_weightProperties.indexOf(property);
+}
+
+const QVector<qreal> & GraphSnapshot::weights(int column) const
+{
+    return d->m_weights.at(column);
+}
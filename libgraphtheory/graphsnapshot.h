@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+
+#include "graphtheory_export.h"
+#include "typenames.h"
+
+#include <QSharedDataPointer>
+#include <QStringList>
+#include <QVector>
+
+namespace GraphTheory
+{
+class GraphSnapshotPrivate;
+
+/**
+ * \class GraphSnapshot
+ *
+ * Immutable copy of the structure of a GraphDocument, stored as compressed sparse rows (CSR).
+ * Nodes are identified by contiguous indices, which are the positions of the nodes in
+ * GraphDocument::nodes() at the time the snapshot was created. For every edge type as well as
+ * for all edge types together, the snapshot provides
+ *
+ * - offsets: for node index i the adjacent entries are at positions offsets[i] to
+ *   offsets[i+1]-1,
+ * - targets: node index of the target of each entry,
+ * - edges: index of the edge of each entry in edges(),
+ *
+ * where unidirectional edges are only contained at their start node and bidirectional edges
+ * at both end nodes. Optionally, numeric weight columns are taken from dynamic edge properties;
+ * values that are not set or not numeric are stored as NaN.
+ *
+ * A snapshot does not follow changes of the document. Since it is never modified after
+ * construction, it can be copied cheaply and read from several threads concurrently.
+ */
+class GRAPHTHEORY_EXPORT GraphSnapshot
+{
+public:
+    /**
+     * Index of the adjacency over all edge types.
+     */
+    static const int AllEdgeTypes = -1;
+
+    /**
+     * Creates an empty snapshot.
+     */
+    GraphSnapshot();
+
+    /**
+     * Creates a snapshot of @p document. For each property name in @p weightProperties a
+     * weight column is created, in the same order.
+     *
+     * @param document  the document to copy
+     * @param weightProperties  names of dynamic edge properties with numeric values
+     */
+    explicit GraphSnapshot(GraphDocumentPtr document, const QStringList &weightProperties = QStringList());
+
+    GraphSnapshot(const GraphSnapshot &other);
+    GraphSnapshot & operator=(const GraphSnapshot &other);
+    ~GraphSnapshot();
+
+    /**
+     * @return number of nodes
+     */
+    int nodeCount() const;
+
+    /**
+     * @return number of edges
+     */
+    int edgeCount() const;
+
+    /**
+     * @return node at index @p index
+     */
+    NodePtr node(int index) const;
+
+    /**
+     * @return index of @p node or -1 if the node is not contained in the snapshot
+     */
+    int nodeIndex(const NodePtr &node) const;
+
+    /**
+     * @return identifiers of all nodes by node index
+     */
+    const QVector<int> & nodeIds() const;
+
+    /**
+     * @return edge at index @p index
+     */
+    EdgePtr edge(int index) const;
+
+    /**
+     * @return node indices of the start nodes of all edges by edge index
+     */
+    const QVector<int> & edgeSources() const;
+
+    /**
+     * @return node indices of the end nodes of all edges by edge index
+     */
+    const QVector<int> & edgeTargets() const;
+
+    /**
+     * @return number of edge types
+     */
+    int edgeTypeCount() const;
+
+    /**
+     * @return index of edge type @p type, as used for the adjacency accessors, or -1
+     */
+    int edgeTypeIndex(const EdgeTypePtr &type) const;
+
+    /**
+     * @return adjacency offsets of edge type @p type with nodeCount()+1 entries
+     */
+    const QVector<int> & offsets(int type = AllEdgeTypes) const;
+
+    /**
+     * @return target node indices of all adjacency entries of edge type @p type
+     */
+    const QVector<int> & targets(int type = AllEdgeTypes) const;
+
+    /**
+     * @return edge indices of all adjacency entries of edge type @p type
+     */
+    const QVector<int> & edges(int type = AllEdgeTypes) const;
+
+    /**
+     * @return number of weight columns
+     */
+    int weightCount() const;
+
+    /**
+     * @return index of weight column for property @p property or -1 if not created
+     */
+    int weightIndex(const QString &property) const;
+
+    /**
+     * @return weights of column @p column by edge index
+     */
+    const QVector<qreal> & weights(int column) const;
+
+private:
+    QSharedDataPointer<GraphSnapshotPrivate> d;
+};
+}
+
+#endif
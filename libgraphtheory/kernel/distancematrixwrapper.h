@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DISTANCEMATRIXWRAPPER_H
+#define DISTANCEMATRIXWRAPPER_H
+
+#include "kernel.h"
+#include "distancematrix_p.h"
+
+#include <QObject>
+
+namespace GraphTheory
+{
+
+/**
+ * \class DistanceMatrixWrapper
+ * Wraps a DistanceMatrix to be accessible via QtScript. Distances are read from the matrix on
+ * demand, such that scripts do not pay for converting all n*n entries into script values.
+ */
+class DistanceMatrixWrapper : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int size READ size)
+
+public:
+    explicit DistanceMatrixWrapper(const DistanceMatrix &matrix);
+    virtual ~DistanceMatrixWrapper();
+
+    /**
+     * \return number of nodes, which is the number of rows and columns
+     */
+    int size() const;
+
+    /**
+     * \return distance from the node at index \p from to the node at index \p to, where
+     * indices are positions in Document.nodes(), Infinity if not reachable
+     */
+    Q_INVOKABLE qreal distance(int from, int to) const;
+
+Q_SIGNALS:
+    void message(const QString &messageString, Kernel::MessageType type) const;
+
+private:
+    Q_DISABLE_COPY(DistanceMatrixWrapper)
+    const DistanceMatrix m_matrix; // implicitly shares the distances with the cached matrix
+};
+}
+
+#endif
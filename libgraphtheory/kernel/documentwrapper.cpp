@@ -21,27 +21,29 @@
 #include "documentwrapper.h"
 #include "nodewrapper.h"
 #include "edgewrapper.h"
+#include "distancematrixwrapper.h"
 #include "graphdocument.h"
 #include "nodetype.h"
 #include "edge.h"
+#include "graphsnapshot.h"
+#include "propertykey.h"
 #include <KLocalizedString>
 #include <QDebug>
+#include <QtNumeric>
 
 using namespace GraphTheory;
 
+namespace
+{
+// number of distance matrices kept per document, each one takes n*n values
+const int maxCachedDistanceMatrices = 2;
+}
+
 DocumentWrapper::DocumentWrapper(GraphDocumentPtr document, QScriptEngine *engine)
-    : m_document(document)
+    : m_document(document.data())
     , m_engine(engine)
 {
-    foreach (NodePtr node, document->nodes()) {
-        registerWrapper(node);
-    }
-    foreach (EdgePtr edge, document->edges()) {
-        registerWrapper(edge);
-    }
-
-    connect(document.data(), &GraphDocument::nodeAboutToBeAdded, this, static_cast<void (DocumentWrapper::*)(NodePtr)>(&DocumentWrapper::registerWrapper));
-    connect(document.data(), &GraphDocument::edgeAboutToBeAdded, this, static_cast<void (DocumentWrapper::*)(EdgePtr)>(&DocumentWrapper::registerWrapper));
+    connectDocument();
 }
 
 DocumentWrapper::~DocumentWrapper()
@@ -55,50 +57,224 @@ QScriptEngine* DocumentWrapper::engine() const
     return m_engine;
 }
 
-void DocumentWrapper::registerWrapper(NodePtr node)
+void DocumentWrapper::setEngine(QScriptEngine *engine)
 {
-    if (m_nodeMap.contains(node)) {
-        return;
-    }
-    NodeWrapper *wrapper = new NodeWrapper(node, this);
-    m_nodeMap.insert(node, wrapper);
-    connect(wrapper, &NodeWrapper::message, this, &DocumentWrapper::message);
-    return;
+    m_engine = engine;
 }
 
-void DocumentWrapper::registerWrapper(EdgePtr edge)
+GraphDocumentPtr DocumentWrapper::document() const
 {
-    if (m_edgeMap.contains(edge)) {
-        return;
+    if (!m_document) {
+        return GraphDocumentPtr();
     }
-    EdgeWrapper *wrapper = new EdgeWrapper(edge, this);
-    m_edgeMap.insert(edge, wrapper);
-    connect(wrapper, &EdgeWrapper::message, this, &DocumentWrapper::message);
-    return;
+    return m_document->self();
 }
 
 NodeWrapper * DocumentWrapper::nodeWrapper(NodePtr node) const
 {
-    Q_ASSERT(m_nodeMap.contains(node));
-    return m_nodeMap.value(node);
+    NodeWrapper *wrapper = m_nodeMap.value(node.data());
+    if (!wrapper) {
+        wrapper = new NodeWrapper(node, const_cast<DocumentWrapper*>(this));
+        m_nodeMap.insert(node.data(), wrapper);
+        connect(wrapper, &NodeWrapper::message, this, &DocumentWrapper::message);
+    }
+    return wrapper;
 }
 
 EdgeWrapper * DocumentWrapper::edgeWrapper(EdgePtr edge) const
 {
-    Q_ASSERT(m_edgeMap.contains(edge));
-    return m_edgeMap.value(edge);
+    EdgeWrapper *wrapper = m_edgeMap.value(edge.data());
+    if (!wrapper) {
+        wrapper = new EdgeWrapper(edge, const_cast<DocumentWrapper*>(this));
+        m_edgeMap.insert(edge.data(), wrapper);
+        connect(wrapper, &EdgeWrapper::message, this, &DocumentWrapper::message);
+    }
+    return wrapper;
 }
 
-QScriptValue DocumentWrapper::node(int id) const
+void DocumentWrapper::releaseInvalidWrappers()
+{
+    for (auto iter = m_edgeMap.begin(); iter != m_edgeMap.end();) {
+        if (iter.value()->edge()->isValid()) {
+            ++iter;
+            continue;
+        }
+        delete iter.value();
+        iter = m_edgeMap.erase(iter);
+    }
+    for (auto iter = m_nodeMap.begin(); iter != m_nodeMap.end();) {
+        if (iter.value()->node()->isValid()) {
+            ++iter;
+            continue;
+        }
+        delete iter.value();
+        iter = m_nodeMap.erase(iter);
+    }
+}
+
+void DocumentWrapper::releaseWrapper(NodePtr node)
+{
+    // the wrapper holds the last reference to the removed node
+    delete m_nodeMap.take(node.data());
+}
+
+void DocumentWrapper::releaseWrapper(EdgePtr edge)
+{
+    delete m_edgeMap.take(edge.data());
+}
+
+void DocumentWrapper::attachWorkingCopy(GraphDocumentPtr workingCopy)
+{
+    Q_ASSERT(!m_origin);
+    m_origin = document();
+    disconnectDocument();
+
+    // the clone contains the copies of all elements at the positions of the originals
+    if (!m_nodeMap.isEmpty()) {
+        const NodeList nodes = m_origin->nodes();
+        const NodeList copies = workingCopy->nodes();
+        QHash<const Node*, NodeWrapper*> nodeMap;
+        nodeMap.reserve(m_nodeMap.size());
+        for (int i = 0; i < nodes.length(); ++i) {
+            NodeWrapper *wrapper = m_nodeMap.value(nodes.at(i).data());
+            if (wrapper) {
+                wrapper->setNode(copies.at(i));
+                nodeMap.insert(copies.at(i).data(), wrapper);
+                m_nodeOrigins.insert(copies.at(i).data(), nodes.at(i));
+            }
+        }
+        m_nodeMap = nodeMap;
+    }
+    if (!m_edgeMap.isEmpty()) {
+        const EdgeList edges = m_origin->edges();
+        const EdgeList copies = workingCopy->edges();
+        QHash<const Edge*, EdgeWrapper*> edgeMap;
+        edgeMap.reserve(m_edgeMap.size());
+        for (int i = 0; i < edges.length(); ++i) {
+            EdgeWrapper *wrapper = m_edgeMap.value(edges.at(i).data());
+            if (wrapper) {
+                wrapper->setEdge(copies.at(i));
+                edgeMap.insert(copies.at(i).data(), wrapper);
+                m_edgeOrigins.insert(copies.at(i).data(), edges.at(i));
+            }
+        }
+        m_edgeMap = edgeMap;
+    }
+
+    m_document = workingCopy.data();
+    connectDocument();
+}
+
+void DocumentWrapper::detachWorkingCopy()
+{
+    Q_ASSERT(m_origin);
+    disconnectDocument();
+
+    QHash<const Node*, NodeWrapper*> nodeMap;
+    for (auto iter = m_nodeMap.constBegin(); iter != m_nodeMap.constEnd(); ++iter) {
+        const NodePtr origin = m_nodeOrigins.value(iter.key());
+        if (origin && origin->isValid()) {
+            iter.value()->setNode(origin);
+            nodeMap.insert(origin.data(), iter.value());
+        } else {
+            delete iter.value();
+        }
+    }
+    m_nodeMap = nodeMap;
+    QHash<const Edge*, EdgeWrapper*> edgeMap;
+    for (auto iter = m_edgeMap.constBegin(); iter != m_edgeMap.constEnd(); ++iter) {
+        const EdgePtr origin = m_edgeOrigins.value(iter.key());
+        if (origin && origin->isValid()) {
+            iter.value()->setEdge(origin);
+            edgeMap.insert(origin.data(), iter.value());
+        } else {
+            delete iter.value();
+        }
+    }
+    m_edgeMap = edgeMap;
+    m_nodeOrigins.clear();
+    m_edgeOrigins.clear();
+
+    m_document = m_origin.data();
+    m_origin.reset();
+    connectDocument();
+}
+
+void DocumentWrapper::connectDocument()
+{
+    // the types notify once for all their elements, wrappers do not observe them individually
+    foreach (NodeTypePtr type, m_document->nodeTypes()) {
+        connectType(type);
+    }
+    foreach (EdgeTypePtr type, m_document->edgeTypes()) {
+        connectType(type);
+    }
+    connect(m_document.data(), &GraphDocument::nodeTypeAdded, this, [=] () {
+        connectType(m_document->nodeTypes().last());
+    });
+    connect(m_document.data(), &GraphDocument::edgeTypeAdded, this, [=] () {
+        connectType(m_document->edgeTypes().last());
+    });
+    // removed elements are released directly, also when a worker thread modifies a working copy;
+    // after bulk updates the indices are invalidated, thus all wrappers are checked
+    connect(m_document.data(), &GraphDocument::nodeRemoved, this, [=] (NodePtr node) {
+        releaseWrapper(node);
+    }, Qt::DirectConnection);
+    connect(m_document.data(), &GraphDocument::edgeRemoved, this, [=] (EdgePtr edge) {
+        releaseWrapper(edge);
+    }, Qt::DirectConnection);
+    connect(m_document.data(), &GraphDocument::nodesReset, this, &DocumentWrapper::releaseInvalidWrappers);
+    connect(m_document.data(), &GraphDocument::edgesReset, this, &DocumentWrapper::releaseInvalidWrappers);
+}
+
+void DocumentWrapper::disconnectDocument()
 {
-    //TODO average access time is linear, which might drastically be improved by
-    //     using proper caching mechanisms at Document objects
-    for (auto const &node : m_document->nodes()) {
-        if (node->id() == id) {
-            return m_engine->newQObject(nodeWrapper(node),
-                                        QScriptEngine::QtOwnership,
-                                        QScriptEngine::AutoCreateDynamicProperties);
+    m_document->disconnect(this);
+    foreach (NodeTypePtr type, m_document->nodeTypes()) {
+        type->disconnect(this);
+    }
+    foreach (EdgeTypePtr type, m_document->edgeTypes()) {
+        type->disconnect(this);
+    }
+}
+
+void DocumentWrapper::connectType(NodeTypePtr type)
+{
+    const NodeType *key = type.data();
+    auto update = [=] () {
+        foreach (NodeWrapper *wrapper, m_nodeMap) {
+            if (wrapper->node()->type().data() == key) {
+                wrapper->updateDynamicProperties();
+            }
+        }
+    };
+    connect(type.data(), &NodeType::dynamicPropertyAdded, this, update);
+    connect(type.data(), &NodeType::dynamicPropertyRemoved, this, update);
+    connect(type.data(), &NodeType::dynamicPropertyRenamed, this, update);
+}
+
+void DocumentWrapper::connectType(EdgeTypePtr type)
+{
+    const EdgeType *key = type.data();
+    auto update = [=] () {
+        foreach (EdgeWrapper *wrapper, m_edgeMap) {
+            if (wrapper->edge()->type().data() == key) {
+                wrapper->updateDynamicProperties();
+            }
         }
+    };
+    connect(type.data(), &EdgeType::dynamicPropertyAdded, this, update);
+    connect(type.data(), &EdgeType::dynamicPropertyRemoved, this, update);
+    connect(type.data(), &EdgeType::dynamicPropertyRenamed, this, update);
+}
+
+QScriptValue DocumentWrapper::node(int id) const
+{
+    NodePtr node = m_document->node(id);
+    if (node) {
+        return m_engine->newQObject(nodeWrapper(node),
+                                    QScriptEngine::QtOwnership,
+                                    QScriptEngine::AutoCreateDynamicProperties);
     }
     QString command = QString("Document.node(%1)").arg(id);
     emit message(i18nc("@info:shell", "%1: no node with ID %2 registered", command, id), Kernel::ErrorMessage);
@@ -183,7 +359,12 @@ QScriptValue DocumentWrapper::edges(int type) const
 
 QScriptValue DocumentWrapper::createNode(int x, int y)
 {
-    NodePtr node = Node::create(m_document);
+    if (!m_document) {
+        QString command = QString("Document.createNode(x, y)");
+        emit message(i18nc("@info:shell", "%1: the document was closed", command), Kernel::ErrorMessage);
+        return QScriptValue();
+    }
+    NodePtr node = Node::create(m_document->self());
     node->setX(x);
     node->setY(y);
     return m_engine->newQObject(nodeWrapper(node),
@@ -216,11 +397,11 @@ void DocumentWrapper::remove(NodeWrapper *node)
         emit message(i18nc("@info:shell", "%1: \"node\" is not a valid node object", command), Kernel::ErrorMessage);
         return;
     }
-    // note: The NodeWrapper object explicitly is not removed from m_nodeMap and by this the node object is not removed.
-    // This has the benefit to not taking care validity of Node, NodeWrapper and its QScriptObject, but on the downside
-    // leads to much used memory, that is only freed after run.
-    // TODO: we need a mechanism that carefully implements on-the-fly object deletions
-    node->node()->destroy();
+    // wrappers of the node and its edges are deleted right away by the removal signals; script
+    // objects that still refer to them only hold guarded pointers and raise an error when
+    // being accessed
+    const NodePtr element = node->node();
+    element->destroy();
 }
 
 void DocumentWrapper::remove(EdgeWrapper *edge)
@@ -230,9 +411,145 @@ void DocumentWrapper::remove(EdgeWrapper *edge)
         emit message(i18nc("@info:shell", "%1: \"edge\" is not a valid edge object", command), Kernel::ErrorMessage);
         return;
     }
-    // note: The EdgeWrapper object explicitly is not removed from m_edgeMap and by this the edge object is not removed.
-    // This has the benefit to not taking care validity of Edge, EdgeWrapper and its QScriptObject, but on the downside
-    // leads to much used memory, that is only freed after run.
-    // TODO: we need a mechanism that carefully implements on-the-fly object deletions
-    edge->edge()->destroy();
+    const EdgePtr element = edge->edge();
+    element->destroy();
+}
+
+QScriptValue DocumentWrapper::distanceMatrix(const QString &lengthProperty)
+{
+    // the matrix needs memory quadratic in the number of nodes
+    if (m_document->nodes().count() > DistanceMatrix::maximumSize) {
+        QString command = QString("Document.distanceMatrix(%1)").arg(lengthProperty);
+        emit message(i18nc("@info:shell", "%1: graph has more than %2 nodes, which is not supported", command, DistanceMatrix::maximumSize), Kernel::ErrorMessage);
+        return QScriptValue();
+    }
+
+    const GraphSnapshot graph(document(), QStringList() << lengthProperty);
+
+    // edges without length have length 0
+    QVector<qreal> lengths = graph.weights(0);
+    for (int e = 0; e < lengths.size(); ++e) {
+        if (qIsNaN(lengths.at(e))) {
+            lengths[e] = 0;
+        }
+    }
+
+    // validating the cached matrix against the snapshot is linear in the size of the graph
+    DistanceMatrix matrix;
+    for (int i = 0; i < m_distanceMatrices.length(); ++i) {
+        if (m_distanceMatrices.at(i).first == lengthProperty) {
+            matrix = m_distanceMatrices.takeAt(i).second;
+            break;
+        }
+    }
+    if (!matrix.isValidFor(graph, lengths)) {
+        matrix = DistanceMatrix(graph, lengths);
+    }
+    m_distanceMatrices.prepend(qMakePair(lengthProperty, matrix));
+    while (m_distanceMatrices.length() > maxCachedDistanceMatrices) {
+        m_distanceMatrices.removeLast();
+    }
+    if (matrix.hasNegativeCycle()) {
+        QString command = QString("Document.distanceMatrix(%1)").arg(lengthProperty);
+        emit message(i18nc("@info:shell", "%1: graph contains a cycle of negative length", command), Kernel::ErrorMessage);
+        return QScriptValue();
+    }
+
+    // the wrapper shares the distances with the cache and is deleted by the engine
+    DistanceMatrixWrapper *wrapper = new DistanceMatrixWrapper(matrix);
+    connect(wrapper, &DistanceMatrixWrapper::message, this, &DocumentWrapper::message);
+    return m_engine->newQObject(wrapper, QScriptEngine::ScriptOwnership);
+}
+
+bool DocumentWrapper::checkLength(const QScriptValue &array, int length, const QString &command) const
+{
+    if (!array.isArray() || array.property("length").toInt32() != length) {
+        emit message(i18nc("@info:shell", "%1: expected an array of length %2", command, length), Kernel::ErrorMessage);
+        return false;
+    }
+    return true;
+}
+
+QScriptValue DocumentWrapper::nodePositions() const
+{
+    const NodeList nodes = m_document->nodes();
+    QScriptValue array = m_engine->newArray(2 * nodes.length());
+    for (int i = 0; i < nodes.length(); ++i) {
+        array.setProperty(2 * i, nodes.at(i)->x());
+        array.setProperty(2 * i + 1, nodes.at(i)->y());
+    }
+    return array;
+}
+
+void DocumentWrapper::setNodePositions(const QScriptValue &positions)
+{
+    const NodeList nodes = m_document->nodes();
+    if (!checkLength(positions, 2 * nodes.length(), QString("Document.setNodePositions(positions)"))) {
+        return;
+    }
+    for (int i = 0; i < nodes.length(); ++i) {
+        nodes.at(i)->setX(positions.property(2 * i).toNumber());
+        nodes.at(i)->setY(positions.property(2 * i + 1).toNumber());
+    }
+}
+
+QScriptValue DocumentWrapper::nodeProperty(const QString &name) const
+{
+    const NodeList nodes = m_document->nodes();
+    const PropertyKey key(name);
+    QScriptValue array = m_engine->newArray(nodes.length());
+    for (int i = 0; i < nodes.length(); ++i) {
+        bool ok = false;
+        const qreal value = nodes.at(i)->dynamicProperty(key).toReal(&ok);
+        array.setProperty(i, ok ? value : qQNaN());
+    }
+    return array;
+}
+
+void DocumentWrapper::setNodeProperty(const QString &name, const QScriptValue &values)
+{
+    const NodeList nodes = m_document->nodes();
+    QString command = QString("Document.setNodeProperty(%1, values)").arg(name);
+    if (!checkLength(values, nodes.length(), command)) {
+        return;
+    }
+    // dynamic properties are declared by the node types, which is not up to scripts
+    QHash<const NodeType*, bool> declared;
+    foreach (NodeTypePtr type, m_document->nodeTypes()) {
+        declared.insert(type.data(), type->dynamicProperties().contains(name));
+    }
+    foreach (const NodePtr &node, nodes) {
+        if (!declared.value(node->type().data())) {
+            emit message(i18nc("@info:shell", "%1: node type ID %2 has no property \"%3\"", command, node->type()->id(), name), Kernel::ErrorMessage);
+            return;
+        }
+    }
+    const PropertyKey key(name);
+    for (int i = 0; i < nodes.length(); ++i) {
+        nodes.at(i)->setDynamicProperty(key, values.property(i).toVariant());
+    }
+}
+
+QScriptValue DocumentWrapper::edgeEndpoints() const
+{
+    const EdgeList edges = m_document->edges();
+    QScriptValue array = m_engine->newArray(2 * edges.length());
+    for (int i = 0; i < edges.length(); ++i) {
+        array.setProperty(2 * i, edges.at(i)->from()->documentIndex());
+        array.setProperty(2 * i + 1, edges.at(i)->to()->documentIndex());
+    }
+    return array;
+}
+
+QScriptValue DocumentWrapper::edgeProperty(const QString &name) const
+{
+    const EdgeList edges = m_document->edges();
+    const PropertyKey key(name);
+    QScriptValue array = m_engine->newArray(edges.length());
+    for (int i = 0; i < edges.length(); ++i) {
+        bool ok = false;
+        const qreal value = edges.at(i)->dynamicProperty(key).toReal(&ok);
+        array.setProperty(i, ok ? value : qQNaN());
+    }
+    return array;
 }
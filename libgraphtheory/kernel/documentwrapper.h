@@ -27,10 +27,15 @@
 #include "node.h"
 #include "edge.h"
 #include "graphdocument.h"
+#include "distancematrix_p.h"
 
 #include <QScriptEngine>
 #include <QObject>
 #include <QColor>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QPointer>
 
 namespace GraphTheory
 {
@@ -53,15 +58,39 @@ public:
     QScriptEngine * engine() const;
 
     /**
-     * \return wrapper for \p node
+     * Set \p engine that evaluates the scripts using this wrapper.
+     */
+    void setEngine(QScriptEngine *engine);
+
+    /**
+     * \return wrapper for \p node, which is created on first access
      */
     NodeWrapper * nodeWrapper(NodePtr node) const;
 
     /**
-     * \return wrapper for \p edge
+     * \return wrapper for \p edge, which is created on first access
      */
     EdgeWrapper * edgeWrapper(EdgePtr edge) const;
 
+    /**
+     * \return the wrapped document
+     */
+    GraphDocumentPtr document() const;
+
+    /**
+     * Wrap \p workingCopy instead of the document until detachWorkingCopy() is called. The
+     * working copy must be an unmodified clone of the document; existing wrappers are kept
+     * and wrap the corresponding elements of the working copy.
+     */
+    void attachWorkingCopy(GraphDocumentPtr workingCopy);
+
+    /**
+     * Wrap the document again, after the changes of the working copy were applied or
+     * discarded. Wrappers of elements that were created in the working copy or whose element
+     * was removed from the document are deleted.
+     */
+    void detachWorkingCopy();
+
     Q_INVOKABLE QScriptValue node(int id) const;
     Q_INVOKABLE QScriptValue nodes() const;
     Q_INVOKABLE QScriptValue nodes(int type) const;
@@ -72,19 +101,89 @@ public:
     Q_INVOKABLE void remove(GraphTheory::NodeWrapper *node);
     Q_INVOKABLE void remove(GraphTheory::EdgeWrapper *edge);
 
+    /**
+     * \return flat array with coordinates x0, y0, x1, y1, ... of all nodes, ordered as nodes()
+     */
+    Q_INVOKABLE QScriptValue nodePositions() const;
+
+    /**
+     * Set the positions of all nodes from a flat array \p positions as returned by nodePositions().
+     */
+    Q_INVOKABLE void setNodePositions(const QScriptValue &positions);
+
+    /**
+     * \return array with the numeric values of dynamic property \p name of all nodes, ordered as
+     * nodes(), with NaN for missing or non-numeric values
+     */
+    Q_INVOKABLE QScriptValue nodeProperty(const QString &name) const;
+
+    /**
+     * Set dynamic property \p name of all nodes from array \p values, ordered as nodes(). If
+     * the type of any node lacks the property, an error is reported and no value is set.
+     */
+    Q_INVOKABLE void setNodeProperty(const QString &name, const QScriptValue &values);
+
+    /**
+     * \return flat array with the node indices from0, to0, from1, to1, ... of all edges, ordered
+     * as edges(), where node indices are positions in nodes()
+     */
+    Q_INVOKABLE QScriptValue edgeEndpoints() const;
+
+    /**
+     * \return array with the numeric values of dynamic property \p name of all edges, ordered as
+     * edges(), with NaN for missing or non-numeric values
+     */
+    Q_INVOKABLE QScriptValue edgeProperty(const QString &name) const;
+
+    /**
+     * Compute the distances between all pairs of nodes, where edges without value for
+     * \p lengthProperty have length 0. The matrices of the most recently used length
+     * properties are cached until the structure of the graph or the edge lengths change.
+     * \return DistanceMatrixWrapper with distance(from, to) for node indices as in nodes(),
+     * Infinity for unreachable nodes; graphs with more than DistanceMatrix::maximumSize nodes
+     * are rejected with an error
+     */
+    Q_INVOKABLE QScriptValue distanceMatrix(const QString &lengthProperty);
+
 Q_SIGNALS:
     void message(const QString &messageString, Kernel::MessageType type) const;
 
 private Q_SLOTS:
-    void registerWrapper(NodePtr node);
-    void registerWrapper(EdgePtr edge);
+    /**
+     * Delete wrappers of nodes and edges that were removed from the document by a bulk update.
+     * Wrappers keep their elements alive, thus they are released as soon as the elements are
+     * removed; single removals release the wrapper of the removed element directly.
+     */
+    void releaseInvalidWrappers();
 
 private:
     Q_DISABLE_COPY(DocumentWrapper)
-    const GraphDocumentPtr m_document;
+    /**
+     * Subscribe to the changes of the wrapped document that concern the wrappers.
+     */
+    void connectDocument();
+    void disconnectDocument();
+    /**
+     * Delete the wrapper of the removed \p node or \p edge, if one exists.
+     */
+    void releaseWrapper(NodePtr node);
+    void releaseWrapper(EdgePtr edge);
+    /**
+     * Subscribe to property list changes of @p type, which are passed to the existing wrappers
+     * of its elements.
+     */
+    void connectType(NodeTypePtr type);
+    void connectType(EdgeTypePtr type);
+
+    bool checkLength(const QScriptValue &array, int length, const QString &command) const;
+    QPointer<GraphDocument> m_document; // not owned, wrappers are kept between runs
+    GraphDocumentPtr m_origin; // document while a working copy is wrapped
+    QHash<const Node*, NodePtr> m_nodeOrigins; // wrapped nodes of the working copy to originals
+    QHash<const Edge*, EdgePtr> m_edgeOrigins;
     QScriptEngine *m_engine;
-    QMap<NodePtr, NodeWrapper*> m_nodeMap;
-    QMap<EdgePtr, EdgeWrapper*> m_edgeMap;
+    mutable QHash<const Node*, NodeWrapper*> m_nodeMap;
+    mutable QHash<const Edge*, EdgeWrapper*> m_edgeMap;
+    QList<QPair<QString, DistanceMatrix> > m_distanceMatrices; // most recently used first
 };
 }
 
@@ -23,7 +23,6 @@
 #include "graphdocument.h"
 #include "edgetype.h"
 #include "edge.h"
-#include "edgetypestyle.h"
 #include <KLocalizedString>
 #include <QColor>
 #include <QDebug>
@@ -32,15 +31,10 @@
 using namespace GraphTheory;
 
 EdgeWrapper::EdgeWrapper(EdgePtr edge, DocumentWrapper *documentWrapper)
-    : m_edge(edge)
+    : QObject(documentWrapper)
     , m_documentWrapper(documentWrapper)
 {
-    connect(m_edge.data(), &Edge::styleChanged, this, [=] () {
-        emit colorChanged(m_edge->type()->style()->color());
-    } );
-    connect(m_edge.data(), &Edge::dynamicPropertiesChanged, this, &EdgeWrapper::updateDynamicProperties);
-    connect(m_edge.data(), &Edge::typeChanged, this, &EdgeWrapper::typeChanged);
-    updateDynamicProperties();
+    setEdge(edge);
 }
 
 EdgeWrapper::~EdgeWrapper()
@@ -53,6 +47,17 @@ EdgePtr EdgeWrapper::edge() const
     return m_edge;
 }
 
+void EdgeWrapper::setEdge(EdgePtr edge)
+{
+    if (m_edge) {
+        m_edge->disconnect(this);
+    }
+    m_edge = edge;
+    connect(m_edge.data(), &Edge::dynamicPropertyChanged, this, &EdgeWrapper::updateDynamicProperty);
+    connect(m_edge.data(), &Edge::typeChanged, this, &EdgeWrapper::typeChanged);
+    updateDynamicProperties();
+}
+
 int EdgeWrapper::type() const
 {
     return m_edge->type()->id();
@@ -124,3 +129,17 @@ void EdgeWrapper::updateDynamicProperties()
         }
     }
 }
+
+void EdgeWrapper::updateDynamicProperty(int index)
+{
+    // wrappers persist between script runs, thus values changed outside of scripts must be updated
+    const QStringList properties = m_edge->dynamicProperties();
+    if (index < 0 || index >= properties.length()) {
+        return;
+    }
+    const QByteArray name = properties.at(index).toUtf8();
+    const QVariant value = m_edge->dynamicProperty(properties.at(index));
+    if (value.isValid() && property(name) != value) {
+        setProperty(name, value);
+    }
+}
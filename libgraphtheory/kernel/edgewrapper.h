@@ -55,6 +55,12 @@ public:
 
     EdgePtr edge() const;
 
+    /**
+     * Wrap @p edge instead of the current edge. Used by DocumentWrapper to keep the wrapper
+     * when a script is executed on a working copy of the document.
+     */
+    void setEdge(EdgePtr edge);
+
     /**
      * @return EdgeType::id of corresponding node
      */
@@ -75,15 +81,15 @@ public:
 
 public Q_SLOTS:
     void updateDynamicProperties();
+    void updateDynamicProperty(int index);
 
 Q_SIGNALS:
     void message(const QString &messageString, Kernel::MessageType type) const;
-    void colorChanged(const QColor &color);
     void typeChanged();
 
 private:
     Q_DISABLE_COPY(EdgeWrapper)
-    const EdgePtr m_edge;
+    EdgePtr m_edge;
     const DocumentWrapper *m_documentWrapper;
 };
 }
@@ -19,33 +19,74 @@
  */
 
 #include "kernel.h"
+#include "kernelexecution.h"
 #include "graphdocument.h"
 #include "documentwrapper.h"
 #include "nodewrapper.h"
 #include "edgewrapper.h"
+#include "profileragent_p.h"
 #include "logging_p.h"
+#include "kernel/modules/algorithms/algorithmsmodule.h"
 #include "kernel/modules/console/consolemodule.h"
 
 #include <KLocalizedString>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
 #include <QScriptEngine>
+#include <QScriptProgram>
+#include <QTimer>
 
 using namespace GraphTheory;
 
+namespace {
+// minimal time between two batches of messages
+const int messageBatchInterval = 100;
+}
+
 class GraphTheory::KernelPrivate {
 public:
     KernelPrivate()
         : m_engine(nullptr)
+        , m_profilerAgent(nullptr)
+        , m_profilingEnabled(false)
+        , m_libraryRevision(0)
+        , m_engineRevision(0)
     {
     }
 
     ~KernelPrivate()
     {
+        qDeleteAll(m_documentWrappers);
+        qDeleteAll(m_idleEngines);
     }
 
     QScriptValue registerGlobalObject(QObject *qobject, const QString &name);
+    /** drop the idle engines unless the libraries were only @p extended by a new one **/
+    void libraryChanged(bool extended);
+    /**
+     * Take the wrapper of @p document out of the cache; it is created if the document has
+     * none or if its wrapper is used by a running execution.
+     */
+    DocumentWrapper * takeDocumentWrapper(GraphDocumentPtr document);
+    /** keep @p wrapper for later executions on its document **/
+    void storeDocumentWrapper(DocumentWrapper *wrapper);
 
+    Kernel *q;
     QScriptEngine *m_engine;
+    QHash<const GraphDocument*, DocumentWrapper*> m_documentWrappers; // kept between runs
     ConsoleModule m_consoleModule;
+    AlgorithmsModule m_algorithmsModule;
+    ProfilerAgent *m_profilerAgent; // owned by engine
+    bool m_profilingEnabled;
+    KernelProfile m_profile;
+    Kernel::MessageList m_messageBuffer;
+    QTimer m_messageTimer;
+    QMap<QString, QScriptProgram> m_libraries;
+    int m_libraryRevision; // incremented with every change of the libraries
+    int m_engineRevision; // revision of the libraries evaluated by m_engine
+    QList<QScriptEngine*> m_idleEngines; // engines of finished asynchronous executions
+    QList<QMap<QString, QScriptProgram> > m_idlePrograms; // libraries evaluated by the idle engines
 };
 
 QScriptValue KernelPrivate::registerGlobalObject(QObject *qobject, const QString &name)
@@ -60,11 +101,54 @@ QScriptValue KernelPrivate::registerGlobalObject(QObject *qobject, const QString
     return globalObject;
 }
 
+DocumentWrapper * KernelPrivate::takeDocumentWrapper(GraphDocumentPtr document)
+{
+    DocumentWrapper *wrapper = m_documentWrappers.take(document.data());
+    if (!wrapper) {
+        wrapper = new DocumentWrapper(document, m_engine);
+        // wrappers keep nodes and edges alive, thus they must not outlive the document
+        const GraphDocument *key = document.data();
+        QObject::connect(document.data(), &QObject::destroyed, q, [this, key]() {
+            delete m_documentWrappers.take(key);
+        });
+    }
+    return wrapper;
+}
+
+void KernelPrivate::storeDocumentWrapper(DocumentWrapper *wrapper)
+{
+    const GraphDocumentPtr document = wrapper->document();
+    if (!document || m_documentWrappers.contains(document.data())) {
+        delete wrapper;
+        return;
+    }
+    m_documentWrappers.insert(document.data(), wrapper);
+}
+
+void KernelPrivate::libraryChanged(bool extended)
+{
+    ++m_libraryRevision;
+    // idle engines evaluate added libraries when they are reused, but keep the global objects
+    // of removed or replaced ones
+    if (!extended) {
+        qDeleteAll(m_idleEngines);
+        m_idleEngines.clear();
+        m_idlePrograms.clear();
+    }
+}
+
 ///BEGIN: Kernel
 Kernel::Kernel()
     : d(new KernelPrivate)
 {
+    d->q = this;
     connect(&d->m_consoleModule, &ConsoleModule::message, this, &Kernel::processMessage);
+    connect(&d->m_algorithmsModule, &AlgorithmsModule::message, this, &Kernel::processMessage);
+
+    // the timer also fires during synchronous executions, since the engine processes events
+    d->m_messageTimer.setSingleShot(true);
+    d->m_messageTimer.setInterval(messageBatchInterval);
+    connect(&d->m_messageTimer, &QTimer::timeout, this, &Kernel::flushMessages);
 }
 
 Kernel::~Kernel()
@@ -74,8 +158,23 @@ Kernel::~Kernel()
 
 QScriptValue Kernel::execute(GraphDocumentPtr document, const QString &script)
 {
+    if (d->m_engine && d->m_engineRevision != d->m_libraryRevision && !d->m_engine->isEvaluating()) {
+        // start with a fresh global object, since libraries may have been removed
+        delete d->m_engine;
+        d->m_engine = nullptr;
+        d->m_profilerAgent = nullptr;
+    }
     if (!d->m_engine) {
         d->m_engine = new QScriptEngine(this);
+        d->m_engineRevision = d->m_libraryRevision;
+        foreach (const QScriptProgram &library, d->m_libraries) {
+            d->m_engine->evaluate(library);
+            if (d->m_engine->hasUncaughtException()) {
+                processMessage(i18nc("@info:shell", "%1: %2", library.fileName(),
+                    d->m_engine->uncaughtException().toString()), WarningMessage);
+                d->m_engine->clearExceptions();
+            }
+        }
     }
 
     // register meta types
@@ -87,48 +186,188 @@ QScriptValue Kernel::execute(GraphDocumentPtr document, const QString &script)
     if (d->m_engine->isEvaluating()) {
         d->m_engine->abortEvaluation();
     }
+    if (d->m_profilingEnabled) {
+        d->m_profile = KernelProfile();
+        if (!d->m_profilerAgent) {
+            d->m_profilerAgent = new ProfilerAgent(d->m_engine);
+        }
+    }
+    QElapsedTimer timer;
+    timer.start();
     d->m_engine->collectGarbage();
+    if (d->m_profilingEnabled) {
+        d->m_profile.addGarbageCollectionTime(timer.nsecsElapsed());
+    }
     d->m_engine->pushContext();
 
-    // add document
-    DocumentWrapper documentWrapper(document, d->m_engine);
-    d->m_engine->globalObject().setProperty("Document", d->m_engine->newQObject(&documentWrapper));
-    connect(&documentWrapper, &DocumentWrapper::message,
+    // add document, wrappers of its elements are reused from previous runs
+    DocumentWrapper *documentWrapper = d->takeDocumentWrapper(document);
+    documentWrapper->setEngine(d->m_engine);
+    d->m_engine->globalObject().setProperty("Document", d->m_engine->newQObject(documentWrapper));
+    connect(documentWrapper, &DocumentWrapper::message,
         this, &Kernel::processMessage);
 
     // set modules
     d->m_engine->globalObject().setProperty("Console", d->m_engine->newQObject(&d->m_consoleModule));
+    d->m_algorithmsModule.setDocumentWrapper(documentWrapper);
+    d->m_engine->globalObject().setProperty("Algorithms", d->m_engine->newQObject(&d->m_algorithmsModule));
 
     // set evaluation
     d->m_engine->setProcessEventsInterval(100); //! TODO: Make that changeable.
 
+    if (d->m_profilingEnabled) {
+        d->m_profilerAgent->start(&d->m_profile);
+        d->m_engine->setAgent(d->m_profilerAgent);
+    }
+    timer.restart();
     QScriptValue result = d->m_engine->evaluate(script).toString();
+    if (d->m_profilingEnabled) {
+        d->m_profile.setTotalTime(timer.nsecsElapsed());
+        d->m_engine->setAgent(nullptr);
+        d->m_profilerAgent->start(nullptr);
+    }
     if (d->m_engine && d->m_engine->hasUncaughtException()) {
-        emit message(result.toString(), WarningMessage);
-        emit message(d->m_engine->uncaughtExceptionBacktrace().join("\n"), InfoMessage);
+        processMessage(result.toString(), WarningMessage);
+        processMessage(d->m_engine->uncaughtExceptionBacktrace().join("\n"), InfoMessage);
     }
     if (d->m_engine) {
-        emit message(i18nc("@info status message after successful script execution", "<i>Execution Finished</i>"), InfoMessage);
-        emit message(result.toString(), InfoMessage);
+        processMessage(i18nc("@info status message after successful script execution", "Execution Finished"), InfoMessage);
+        processMessage(result.toString(), InfoMessage);
         d->m_engine->popContext();
     }
+    if (d->m_engine && d->m_profilingEnabled) {
+        // also measure the collection of the garbage the script left behind
+        timer.restart();
+        d->m_engine->collectGarbage();
+        d->m_profile.addGarbageCollectionTime(timer.nsecsElapsed());
+        processMessage(d->m_profile.summary(), InfoMessage);
+    }
     // end processing messages
-    disconnect(&documentWrapper, &DocumentWrapper::message, this, &Kernel::processMessage);
+    disconnect(documentWrapper, &DocumentWrapper::message, this, &Kernel::processMessage);
+    flushMessages();
 
     emit executionFinished();
     d->m_engine->globalObject().setProperty("Document", QScriptValue());
+    d->m_algorithmsModule.setDocumentWrapper(nullptr);
+    d->storeDocumentWrapper(documentWrapper);
 
     return result;
 }
 
+KernelExecution * Kernel::executeAsync(GraphDocumentPtr document, const QString &script)
+{
+    // reuse the engine of a finished execution, which already evaluated the libraries
+    QScriptEngine *engine = nullptr;
+    QMap<QString, QScriptProgram> programs;
+    if (!d->m_idleEngines.isEmpty()) {
+        engine = d->m_idleEngines.takeLast();
+        programs = d->m_idlePrograms.takeLast();
+    }
+    QMap<QString, QString> librarySources;
+    for (auto it = d->m_libraries.constBegin(); it != d->m_libraries.constEnd(); ++it) {
+        librarySources.insert(it.key(), it.value().sourceCode());
+    }
+    KernelExecution *execution = new KernelExecution(document, script, engine, programs,
+        d->takeDocumentWrapper(document), librarySources, d->m_profilingEnabled, this);
+    connect(execution, &KernelExecution::finished, this, [this, execution]() {
+        QMap<QString, QScriptProgram> programs;
+        QScriptEngine *engine = execution->takeEngine(&programs);
+        if (engine) {
+            // libraries changed meanwhile are handled when the engine is reused
+            d->m_idleEngines.append(engine);
+            d->m_idlePrograms.append(programs);
+        }
+        d->storeDocumentWrapper(execution->takeDocumentWrapper());
+        if (execution->isProfiled()) {
+            d->m_profile = execution->profile();
+        }
+    });
+    connect(execution, &KernelExecution::messagesBatched,
+        this, &Kernel::processMessages);
+    connect(execution, &KernelExecution::finished,
+        this, &Kernel::flushMessages);
+    connect(execution, &KernelExecution::finished,
+        this, &Kernel::executionFinished);
+    execution->start();
+    return execution;
+}
+
 void Kernel::stop()
 {
-    d->m_engine->abortEvaluation();
+    if (d->m_engine) {
+        d->m_engine->abortEvaluation();
+    }
+    foreach (KernelExecution *execution, findChildren<KernelExecution*>()) {
+        execution->cancel();
+    }
+}
+
+void Kernel::setProfilingEnabled(bool enabled)
+{
+    d->m_profilingEnabled = enabled;
+}
+
+bool Kernel::isProfilingEnabled() const
+{
+    return d->m_profilingEnabled;
+}
+
+KernelProfile Kernel::profile() const
+{
+    return d->m_profile;
+}
+
+bool Kernel::addLibrary(const QString &name, const QString &source)
+{
+    const QScriptSyntaxCheckResult check = QScriptEngine::checkSyntax(source);
+    if (check.state() != QScriptSyntaxCheckResult::Valid) {
+        processMessage(i18nc("@info:shell", "%1: line %2: %3", name, check.errorLineNumber(),
+            check.errorMessage()), ErrorMessage);
+        return false;
+    }
+    const bool extended = !d->m_libraries.contains(name);
+    d->m_libraries.insert(name, QScriptProgram(source, name));
+    d->libraryChanged(extended);
+    return true;
+}
+
+void Kernel::removeLibrary(const QString &name)
+{
+    if (d->m_libraries.remove(name) > 0) {
+        d->libraryChanged(false);
+    }
+}
+
+QStringList Kernel::libraries() const
+{
+    return d->m_libraries.keys();
 }
 
 void Kernel::processMessage(const QString &messageString, Kernel::MessageType type)
 {
-    emit message(messageString, type);
+    d->m_messageBuffer.append(qMakePair(type, messageString));
+    if (!d->m_messageTimer.isActive()) {
+        d->m_messageTimer.start();
+    }
+}
+
+void Kernel::processMessages(const MessageList &messages)
+{
+    d->m_messageBuffer.append(messages);
+    if (!d->m_messageTimer.isActive()) {
+        d->m_messageTimer.start();
+    }
+}
+
+void Kernel::flushMessages()
+{
+    d->m_messageTimer.stop();
+    if (d->m_messageBuffer.isEmpty()) {
+        return;
+    }
+    const MessageList messages = d->m_messageBuffer;
+    d->m_messageBuffer.clear();
+    emit messagesBatched(messages);
 }
 
 //END: Kernel
@@ -25,13 +25,18 @@
 #include "typenames.h"
 #include "node.h"
 #include "graphdocument.h"
+#include "kernelprofile.h"
 
 #include <QScriptEngine>
 #include <QObject>
+#include <QList>
+#include <QPair>
+#include <QStringList>
 
 namespace GraphTheory
 {
 class KernelPrivate;
+class KernelExecution;
 
 /**
  * \class Kernel
@@ -46,6 +51,7 @@ public:
         WarningMessage,
         ErrorMessage
     };
+    typedef QList< QPair<MessageType, QString> > MessageList;
 
     Kernel();
 
@@ -55,15 +61,74 @@ public:
      * execute javascript @p script on @p document and @return result as reported by engine
      */
     QScriptValue execute(GraphTheory::GraphDocumentPtr document, const QString &script);
+
+    /**
+     * Start execution of javascript @p script on a worker thread. The script operates on a copy
+     * of @p document; its changes are applied to @p document after it terminated. Messages of
+     * the execution are emitted by messagesBatched() and executionFinished() is emitted when the
+     * changes are applied.
+     *
+     * @return handle of the execution, owned by the kernel
+     */
+    KernelExecution * executeAsync(GraphTheory::GraphDocumentPtr document, const QString &script);
+
+    /**
+     * Abort the synchronous and cancel all asynchronous executions.
+     */
     void stop();
 
+    /**
+     * Enable or disable profiling of executions started afterwards. If enabled, a summary of
+     * each execution is sent as message and available by profile() once it finished.
+     */
+    void setProfilingEnabled(bool enabled);
+
+    /**
+     * @return true if profiling is enabled
+     */
+    bool isProfilingEnabled() const;
+
+    /**
+     * @return profile of the last finished execution while profiling was enabled
+     */
+    KernelProfile profile() const;
+
+    /**
+     * Register the library script @p source under @p name, replacing a library of the same name.
+     * Libraries are compiled once and evaluated into the global object of each script engine
+     * before its first execution; engines are kept between executions, such that later
+     * executions only evaluate their own script. Since the global object is shared, state that
+     * a library keeps in global variables persists between executions as well.
+     *
+     * @return @e false if @p source has syntax errors, which are reported as message
+     */
+    bool addLibrary(const QString &name, const QString &source);
+
+    /**
+     * Remove the library script registered as @p name.
+     */
+    void removeLibrary(const QString &name);
+
+    /**
+     * @return names of all registered library scripts
+     */
+    QStringList libraries() const;
 
 private Q_SLOTS:
-    /** process all incoming messages and resend them afterwards**/
+    /** buffer incoming message until the next batch is emitted **/
     void processMessage(const QString &message, GraphTheory::Kernel::MessageType type);
+    /** buffer batch of incoming messages until the next batch is emitted **/
+    void processMessages(const GraphTheory::Kernel::MessageList &messages);
+    /** emit all buffered messages by messagesBatched() **/
+    void flushMessages();
 
 Q_SIGNALS:
-    void message(const QString &message, GraphTheory::Kernel::MessageType type);
+    /**
+     * All messages since the last batch, emitted at most every 100 ms and at the end of each
+     * execution. Messages are only delivered in batches, since updating displays once per
+     * message can dominate the runtime of scripts that print a lot.
+     */
+    void messagesBatched(const GraphTheory::Kernel::MessageList &messages);
     void executionFinished();
 
 private:
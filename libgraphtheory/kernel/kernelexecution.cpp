@@ -0,0 +1,415 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kernelexecution.h"
+#include "graphdocument.h"
+#include "graphdiff.h"
+#include "documentwrapper.h"
+#include "nodewrapper.h"
+#include "edgewrapper.h"
+#include "profileragent_p.h"
+#include "kernel/modules/algorithms/algorithmsmodule.h"
+#include "kernel/modules/console/consolemodule.h"
+
+#include <KLocalizedString>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScriptEngine>
+#include <QScriptProgram>
+#include <QThread>
+#include <QTimer>
+
+using namespace GraphTheory;
+
+namespace
+{
+// interval in milliseconds at which the engine checks for cancellation
+const int cancelCheckInterval = 100;
+
+class ScriptThread : public QThread
+{
+public:
+    explicit ScriptThread(KernelExecutionPrivate *execution)
+        : m_execution(execution)
+    {
+    }
+
+protected:
+    void run() Q_DECL_OVERRIDE;
+
+private:
+    KernelExecutionPrivate *m_execution;
+};
+}
+
+class GraphTheory::KernelExecutionPrivate {
+public:
+    KernelExecutionPrivate(KernelExecution *q)
+        : q(q)
+        , m_thread(this)
+        , m_engine(nullptr)
+        , m_documentWrapper(nullptr)
+        , m_diff(nullptr)
+        , m_profiling(false)
+        , m_progress(0)
+        , m_error(false)
+        , m_finished(false)
+    {
+    }
+
+    ~KernelExecutionPrivate()
+    {
+        delete m_engine;
+        delete m_documentWrapper;
+        delete m_diff;
+    }
+
+    /** executed on the worker thread **/
+    void run();
+
+    /** buffer message of the worker thread until the next batch is delivered **/
+    void addMessage(const QString &message, Kernel::MessageType type)
+    {
+        QMutexLocker locker(&m_messagesMutex);
+        m_messages.append(qMakePair(type, message));
+    }
+
+    /** request delivery of the buffered messages by the thread of the handle **/
+    void postMessages()
+    {
+        QMutexLocker locker(&m_messagesMutex);
+        if (!m_messages.isEmpty()) {
+            QMetaObject::invokeMethod(q, "flushMessages", Qt::QueuedConnection);
+        }
+    }
+
+    /** take all buffered messages **/
+    Kernel::MessageList takeMessages()
+    {
+        QMutexLocker locker(&m_messagesMutex);
+        Kernel::MessageList messages;
+        messages.swap(m_messages);
+        return messages;
+    }
+
+    KernelExecution *q;
+    ScriptThread m_thread;
+    GraphDocumentPtr m_document;
+    QString m_script;
+    QScriptEngine *m_engine; // lives in the worker thread while the script runs
+    QMap<QString, QScriptProgram> m_programs; // libraries evaluated by m_engine, compiled for it
+    QMap<QString, QString> m_librarySources; // current libraries of the kernel
+    DocumentWrapper *m_documentWrapper; // wraps the working copy while the script runs
+    GraphDiff *m_diff; // working copy of the document, only modified by the worker
+    QAtomicInt m_canceled;
+    bool m_profiling;
+    KernelProfile m_profile; // written by the worker, read after it finished
+    QMutex m_messagesMutex;
+    Kernel::MessageList m_messages; // not yet delivered messages, guarded by the mutex
+    int m_progress;
+    QString m_result;
+    QStringList m_backtrace;
+    bool m_error;
+    bool m_finished;
+};
+
+void ScriptThread::run()
+{
+    m_execution->run();
+}
+
+void KernelExecutionPrivate::run()
+{
+    // an engine keeps the global objects of its libraries, thus it is replaced if a library
+    // was removed or changed since it evaluated them
+    if (m_engine) {
+        for (auto it = m_programs.constBegin(); it != m_programs.constEnd(); ++it) {
+            if (!m_librarySources.contains(it.key())
+                || m_librarySources.value(it.key()) != it.value().sourceCode())
+            {
+                delete m_engine;
+                m_engine = nullptr;
+                m_programs.clear();
+                break;
+            }
+        }
+    }
+    if (!m_engine) {
+        m_engine = new QScriptEngine;
+        qScriptRegisterSequenceMetaType<QList<GraphTheory::NodeWrapper*> >(m_engine);
+        qScriptRegisterSequenceMetaType<QList<GraphTheory::EdgeWrapper*> >(m_engine);
+    }
+    // the programs of the kernel are compiled for the engine of the kernel, thus every worker
+    // engine gets programs of its own; they are created here and kept with the engine, such
+    // that every library is compiled once per engine, also when libraries are added later
+    for (auto it = m_librarySources.constBegin(); it != m_librarySources.constEnd(); ++it) {
+        if (m_programs.contains(it.key())) {
+            continue;
+        }
+        const QScriptProgram library(it.value(), it.key());
+        m_programs.insert(it.key(), library);
+        m_engine->evaluate(library);
+        if (m_engine->hasUncaughtException()) {
+            addMessage(i18nc("@info:shell", "%1: %2", library.fileName(),
+                m_engine->uncaughtException().toString()), Kernel::WarningMessage);
+            m_engine->clearExceptions();
+        }
+    }
+    QScriptEngine &engine = *m_engine;
+
+    // messages are buffered and delivered in batches, progress by queued connections
+    auto bufferMessage = [this](const QString &message, Kernel::MessageType type) {
+        addMessage(message, type);
+    };
+    ConsoleModule consoleModule;
+    QObject::connect(&consoleModule, &ConsoleModule::message, bufferMessage);
+    QObject::connect(&consoleModule, &ConsoleModule::progressChanged, q, &KernelExecution::setProgress);
+    AlgorithmsModule algorithmsModule;
+    QObject::connect(&algorithmsModule, &AlgorithmsModule::message, bufferMessage);
+
+    {
+        m_documentWrapper->setEngine(&engine);
+        const QMetaObject::Connection wrapperMessages =
+            QObject::connect(m_documentWrapper, &DocumentWrapper::message, bufferMessage);
+        engine.globalObject().setProperty("Document", engine.newQObject(m_documentWrapper));
+        engine.globalObject().setProperty("Console", engine.newQObject(&consoleModule));
+        algorithmsModule.setDocumentWrapper(m_documentWrapper);
+        engine.globalObject().setProperty("Algorithms", engine.newQObject(&algorithmsModule));
+
+        // the engine processes events of this thread regularly, which triggers the check and
+        // the delivery of the messages since the last check
+        QTimer cancelTimer;
+        QObject::connect(&cancelTimer, &QTimer::timeout, [&engine, this]() {
+            if (m_canceled.load()) {
+                engine.abortEvaluation();
+            }
+            postMessages();
+        });
+        cancelTimer.start(cancelCheckInterval);
+        engine.setProcessEventsInterval(cancelCheckInterval);
+
+        ProfilerAgent *profilerAgent = nullptr;
+        QElapsedTimer timer;
+        if (m_profiling) {
+            timer.start();
+            engine.collectGarbage();
+            m_profile.addGarbageCollectionTime(timer.nsecsElapsed());
+            profilerAgent = new ProfilerAgent(&engine);
+            profilerAgent->start(&m_profile);
+            engine.setAgent(profilerAgent);
+        }
+
+        // variables of the script must not leak into later executions by the same engine
+        timer.start();
+        engine.pushContext();
+        m_result = engine.evaluate(m_script).toString();
+        m_error = engine.hasUncaughtException();
+        if (m_error) {
+            m_backtrace = engine.uncaughtExceptionBacktrace();
+            engine.clearExceptions();
+        }
+        engine.popContext();
+        if (profilerAgent) {
+            m_profile.setTotalTime(timer.nsecsElapsed());
+            engine.setAgent(nullptr);
+            delete profilerAgent;
+        }
+        engine.globalObject().setProperty("Document", QScriptValue());
+        engine.globalObject().setProperty("Console", QScriptValue());
+        engine.globalObject().setProperty("Algorithms", QScriptValue());
+        engine.setProcessEventsInterval(-1);
+        // also measure the collection of the garbage the script left behind
+        timer.start();
+        engine.collectGarbage();
+        if (m_profiling) {
+            m_profile.addGarbageCollectionTime(timer.nsecsElapsed());
+        }
+        QObject::disconnect(wrapperMessages);
+    }
+    // hand the engine and the wrappers back, such that they can be reused after the execution
+    m_engine->moveToThread(q->thread());
+    m_documentWrapper->moveToThread(q->thread());
+
+    if (!m_canceled.load()) {
+        m_diff->update();
+    }
+}
+
+KernelExecution::KernelExecution(GraphDocumentPtr document, const QString &script, QScriptEngine *engine,
+                                 const QMap<QString, QScriptProgram> &programs, DocumentWrapper *documentWrapper,
+                                 const QMap<QString, QString> &librarySources, bool profiling, QObject *parent)
+    : QObject(parent)
+    , d(new KernelExecutionPrivate(this))
+{
+    Q_ASSERT(document);
+    d->m_document = document;
+    d->m_diff = new GraphDiff(document);
+    d->m_documentWrapper = documentWrapper ? documentWrapper : new DocumentWrapper(document, nullptr);
+    d->m_documentWrapper->attachWorkingCopy(d->m_diff->workingCopy());
+    d->m_script = script;
+    d->m_profiling = profiling;
+    d->m_engine = engine;
+    d->m_programs = programs;
+    d->m_librarySources = librarySources;
+    connect(&d->m_thread, &QThread::finished, this, &KernelExecution::finish);
+}
+
+KernelExecution::~KernelExecution()
+{
+    cancel();
+    d->m_thread.wait();
+}
+
+void KernelExecution::start()
+{
+    if (d->m_engine) {
+        d->m_engine->moveToThread(&d->m_thread);
+    }
+    d->m_documentWrapper->moveToThread(&d->m_thread);
+    d->m_thread.start();
+}
+
+QScriptEngine * KernelExecution::takeEngine(QMap<QString, QScriptProgram> *programs)
+{
+    if (!d->m_finished) {
+        return nullptr;
+    }
+    programs->swap(d->m_programs);
+    // the script ran in its own context, thus neither an error nor a cancellation affects
+    // later executions by the engine
+    QScriptEngine *engine = d->m_engine;
+    d->m_engine = nullptr;
+    return engine;
+}
+
+DocumentWrapper * KernelExecution::takeDocumentWrapper()
+{
+    if (!d->m_finished) {
+        return nullptr;
+    }
+    DocumentWrapper *documentWrapper = d->m_documentWrapper;
+    d->m_documentWrapper = nullptr;
+    return documentWrapper;
+}
+
+bool KernelExecution::isFinished() const
+{
+    return d->m_finished;
+}
+
+bool KernelExecution::isCanceled() const
+{
+    return d->m_canceled.load();
+}
+
+bool KernelExecution::hasError() const
+{
+    return d->m_error;
+}
+
+int KernelExecution::progress() const
+{
+    return d->m_progress;
+}
+
+bool KernelExecution::isProfiled() const
+{
+    return d->m_profiling;
+}
+
+KernelProfile KernelExecution::profile() const
+{
+    if (!d->m_finished) {
+        return KernelProfile();
+    }
+    return d->m_profile;
+}
+
+QString KernelExecution::result() const
+{
+    if (!d->m_finished) {
+        return QString();
+    }
+    return d->m_result;
+}
+
+void KernelExecution::cancel()
+{
+    d->m_canceled.store(1);
+}
+
+void KernelExecution::waitForFinished()
+{
+    d->m_thread.wait();
+    finish();
+}
+
+void KernelExecution::setProgress(int progress)
+{
+    if (d->m_progress == progress) {
+        return;
+    }
+    d->m_progress = progress;
+    emit progressChanged(progress);
+}
+
+void KernelExecution::finish()
+{
+    if (d->m_finished || d->m_thread.isRunning()) {
+        return;
+    }
+    d->m_finished = true;
+
+    // messages of the worker precede the status messages
+    Kernel::MessageList messages = d->takeMessages();
+    if (d->m_error) {
+        messages.append(qMakePair(Kernel::WarningMessage, d->m_result));
+        messages.append(qMakePair(Kernel::InfoMessage, d->m_backtrace.join("\n")));
+    }
+    if (!isCanceled()) {
+        d->m_diff->apply();
+    }
+    d->m_documentWrapper->detachWorkingCopy();
+    delete d->m_diff;
+    d->m_diff = nullptr;
+    if (isCanceled()) {
+        messages.append(qMakePair(Kernel::InfoMessage,
+            i18nc("@info status message after canceled script execution", "Execution Canceled")));
+    } else {
+        messages.append(qMakePair(Kernel::InfoMessage,
+            i18nc("@info status message after successful script execution", "Execution Finished")));
+        messages.append(qMakePair(Kernel::InfoMessage, d->m_result));
+    }
+    if (d->m_profiling) {
+        messages.append(qMakePair(Kernel::InfoMessage, d->m_profile.summary()));
+    }
+    emit messagesBatched(messages);
+    emit finished();
+}
+
+void KernelExecution::flushMessages()
+{
+    const Kernel::MessageList messages = d->takeMessages();
+    if (!messages.isEmpty()) {
+        emit messagesBatched(messages);
+    }
+}
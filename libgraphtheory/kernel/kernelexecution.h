@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KERNELEXECUTION_H
+#define KERNELEXECUTION_H
+
+#include "graphtheory_export.h"
+#include "typenames.h"
+#include "kernel.h"
+
+#include <QObject>
+#include <QMap>
+#include <QString>
+#include <QScriptProgram>
+
+class QScriptEngine;
+
+namespace GraphTheory
+{
+class DocumentWrapper;
+class KernelExecutionPrivate;
+
+/**
+ * \class KernelExecution
+ * Handle of an asynchronous script execution as started by Kernel::executeAsync().
+ *
+ * The script is executed on a worker thread on a copy of the document, such that neither the
+ * editor nor the views are involved while the script runs. After the script finished, all
+ * changes are applied to the document at once in the thread of the handle. When the execution
+ * is canceled, the changes are discarded.
+ *
+ * The copy is a GraphDiff working copy. For every execution, including scripts that change
+ * nothing, it is cloned from the document when the handle is created and destroyed after the
+ * changes are applied, both in the thread of the handle and in time linear in the number of
+ * nodes and edges. Finding the changes is linear as well but runs on the worker thread; applying
+ * them only touches the changed elements.
+ *
+ * The handle is owned by the kernel. It may be deleted after finished() was emitted.
+ */
+class GRAPHTHEORY_EXPORT KernelExecution : public QObject
+{
+    Q_OBJECT
+
+public:
+    virtual ~KernelExecution();
+
+    /**
+     * @return @e true if the execution finished and changes are applied, otherwise @e false
+     */
+    bool isFinished() const;
+
+    /**
+     * @return @e true if the execution was canceled, otherwise @e false
+     */
+    bool isCanceled() const;
+
+    /**
+     * @return @e true if the script terminated with an uncaught exception, otherwise @e false
+     */
+    bool hasError() const;
+
+    /**
+     * Progress as last reported by the script via Console.progress().
+     *
+     * @return progress in percent
+     */
+    int progress() const;
+
+    /**
+     * @return @e true if the execution is profiled, otherwise @e false
+     */
+    bool isProfiled() const;
+
+    /**
+     * @return timing of the profiled execution, empty before finished or if not profiled
+     */
+    KernelProfile profile() const;
+
+    /**
+     * @return string representation of the script result, empty before finished
+     */
+    QString result() const;
+
+    /**
+     * Abort the script and discard all changes it performed. The execution is aborted at the
+     * next point at which the engine processes events.
+     */
+    void cancel();
+
+    /**
+     * Block until the script terminated and apply its changes.
+     */
+    void waitForFinished();
+
+Q_SIGNALS:
+    /**
+     * Messages of the execution, delivered in batches of all messages of the script since the
+     * last batch. The last batch is emitted right before finished() and contains the status
+     * messages of the execution.
+     */
+    void messagesBatched(const GraphTheory::Kernel::MessageList &messages);
+    void progressChanged(int progress);
+    void finished();
+
+private Q_SLOTS:
+    void setProgress(int progress);
+    /** emit the messages buffered by the worker thread **/
+    void flushMessages();
+    /** apply changes of the terminated script to the document **/
+    void finish();
+
+private:
+    /**
+     * Create execution of @p script on @p document. The script is evaluated by @p engine if
+     * given, otherwise by a new engine. @p programs are the libraries already evaluated by
+     * @p engine; the libraries of @p librarySources (name and source code) it lacks are
+     * evaluated first. An engine whose programs differ from @p librarySources is replaced.
+     * The wrappers of @p documentWrapper are reused if given, otherwise a new one is created.
+     * If @p profiling is true, the calls of API methods are measured.
+     */
+    KernelExecution(GraphDocumentPtr document, const QString &script, QScriptEngine *engine,
+                    const QMap<QString, QScriptProgram> &programs, DocumentWrapper *documentWrapper,
+                    const QMap<QString, QString> &librarySources, bool profiling, QObject *parent);
+    Q_DISABLE_COPY(KernelExecution)
+    void start();
+    /**
+     * Take ownership of the engine after the execution finished, also after errors and
+     * cancellation. The programs of the libraries evaluated by the engine are stored to
+     * @p programs; they are compiled for this engine and are passed along when it is reused.
+     */
+    QScriptEngine * takeEngine(QMap<QString, QScriptProgram> *programs);
+    /**
+     * Take ownership of the document wrapper after the execution finished. It wraps the
+     * document again and can be used by later executions on it.
+     */
+    DocumentWrapper * takeDocumentWrapper();
+    const QScopedPointer<KernelExecutionPrivate> d;
+    friend class Kernel;
+    friend class KernelExecutionPrivate;
+};
+}
+
+#endif
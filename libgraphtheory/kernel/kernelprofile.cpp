@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kernelprofile.h"
+#include <KLocalizedString>
+#include <QStringList>
+#include <algorithm>
+
+using namespace GraphTheory;
+
+namespace {
+QString milliseconds(qint64 nanoseconds)
+{
+    return QString::number(nanoseconds / 1.0e6, 'f', 2);
+}
+}
+
+KernelProfile::KernelProfile()
+    : m_totalTime(0)
+    , m_nativeTime(0)
+    , m_garbageCollectionTime(0)
+{
+}
+
+qint64 KernelProfile::totalTime() const
+{
+    return m_totalTime;
+}
+
+qint64 KernelProfile::nativeTime() const
+{
+    return m_nativeTime;
+}
+
+qint64 KernelProfile::scriptTime() const
+{
+    return qMax<qint64>(0, m_totalTime - m_nativeTime);
+}
+
+qint64 KernelProfile::garbageCollectionTime() const
+{
+    return m_garbageCollectionTime;
+}
+
+QList<KernelProfile::Entry> KernelProfile::entries() const
+{
+    QList<Entry> entries = m_entries.values();
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.time > b.time;
+    });
+    return entries;
+}
+
+QString KernelProfile::summary(int maxEntries) const
+{
+    QStringList lines;
+    lines << i18nc("@info:shell", "Profile: total %1 ms, script %2 ms, API calls %3 ms, garbage collection %4 ms",
+                   milliseconds(m_totalTime), milliseconds(scriptTime()),
+                   milliseconds(m_nativeTime), milliseconds(m_garbageCollectionTime));
+    const QList<Entry> sortedEntries = entries();
+    for (int i = 0; i < sortedEntries.length() && i < maxEntries; ++i) {
+        const Entry &entry = sortedEntries.at(i);
+        lines << i18nc("@info:shell", "%1: %2 calls, %3 ms", entry.function, entry.calls, milliseconds(entry.time));
+    }
+    return lines.join("\n");
+}
+
+void KernelProfile::addCall(const QString &function, qint64 time, bool nested)
+{
+    Entry &entry = m_entries[function];
+    if (entry.function.isEmpty()) {
+        entry.function = function;
+        entry.calls = 0;
+        entry.time = 0;
+    }
+    ++entry.calls;
+    entry.time += time;
+    if (!nested) {
+        m_nativeTime += time;
+    }
+}
+
+void KernelProfile::setTotalTime(qint64 time)
+{
+    m_totalTime = time;
+}
+
+void KernelProfile::addGarbageCollectionTime(qint64 time)
+{
+    m_garbageCollectionTime += time;
+}
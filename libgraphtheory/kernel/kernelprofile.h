@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KERNELPROFILE_H
+#define KERNELPROFILE_H
+
+#include "graphtheory_export.h"
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+namespace GraphTheory
+{
+
+/**
+ * \class KernelProfile
+ *
+ * Timing information of one script execution, as collected by the kernel if profiling is
+ * enabled. Calls of invokable methods of the script API objects (e.g. Document, nodes, edges,
+ * Console) are counted per method together with their inclusive time. All times are given in
+ * nanoseconds.
+ */
+class GRAPHTHEORY_EXPORT KernelProfile
+{
+public:
+    struct Entry {
+        QString function;
+        int calls;
+        qint64 time;
+    };
+
+    KernelProfile();
+
+    /**
+     * @return time of the whole script evaluation
+     */
+    qint64 totalTime() const;
+
+    /**
+     * @return time spent in calls of API methods, excluding nested calls
+     */
+    qint64 nativeTime() const;
+
+    /**
+     * @return time of the evaluation that is not spent in API methods, i.e., in the script
+     * interpreter
+     */
+    qint64 scriptTime() const;
+
+    /**
+     * @return time of the garbage collections triggered by the kernel
+     */
+    qint64 garbageCollectionTime() const;
+
+    /**
+     * @return one entry per called API method, ordered by decreasing time
+     */
+    QList<Entry> entries() const;
+
+    /**
+     * @return human readable summary with at most @p maxEntries methods
+     */
+    QString summary(int maxEntries = 10) const;
+
+    /**
+     * Record a call of @p function taking @p time.
+     * If @p nested is true, the call is not added to nativeTime().
+     */
+    void addCall(const QString &function, qint64 time, bool nested);
+    void setTotalTime(qint64 time);
+    void addGarbageCollectionTime(qint64 time);
+
+private:
+    qint64 m_totalTime;
+    qint64 m_nativeTime;
+    qint64 m_garbageCollectionTime;
+    QHash<QString, Entry> m_entries;
+};
+}
+
+#endif
@@ -0,0 +1,979 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "algorithmsmodule.h"
+#include "kernel/documentwrapper.h"
+#include "kernel/edgewrapper.h"
+#include "graphdocument.h"
+#include "graphsnapshot.h"
+#include "shortestpaths_p.h"
+#include "node.h"
+#include "edge.h"
+#include <KLocalizedString>
+#include <QHash>
+#include <QtMath>
+#include <QtNumeric>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace GraphTheory;
+
+namespace {
+const qreal infinity = std::numeric_limits<qreal>::infinity();
+
+// residual capacities below this value are considered as zero
+const qreal epsilon = 1e-9;
+
+typedef std::pair<qreal, int> QueueEntry;
+typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > MinQueue;
+
+/**
+ * Adjacency of a snapshot that contains each edge at both of its end nodes, with self-loops
+ * contained only once.
+ */
+struct UndirectedAdjacency
+{
+    explicit UndirectedAdjacency(const GraphSnapshot &graph)
+        : offsets(graph.nodeCount() + 1, 0)
+    {
+        const QVector<int> &sources = graph.edgeSources();
+        const QVector<int> &targets = graph.edgeTargets();
+        for (int edge = 0; edge < graph.edgeCount(); ++edge) {
+            ++offsets[sources.at(edge) + 1];
+            if (sources.at(edge) != targets.at(edge)) {
+                ++offsets[targets.at(edge) + 1];
+            }
+        }
+        for (int node = 0; node < graph.nodeCount(); ++node) {
+            offsets[node + 1] += offsets.at(node);
+        }
+        neighbors.resize(offsets.last());
+        edges.resize(offsets.last());
+        QVector<int> position = offsets;
+        for (int edge = 0; edge < graph.edgeCount(); ++edge) {
+            const int from = sources.at(edge);
+            const int to = targets.at(edge);
+            neighbors[position.at(from)] = to;
+            edges[position[from]++] = edge;
+            if (from != to) {
+                neighbors[position.at(to)] = from;
+                edges[position[to]++] = edge;
+            }
+        }
+    }
+
+    QVector<int> offsets;
+    QVector<int> neighbors;
+    QVector<int> edges;
+};
+
+class DisjointSets
+{
+public:
+    explicit DisjointSets(int size)
+        : m_parent(size)
+        , m_rank(size, 0)
+    {
+        for (int i = 0; i < size; ++i) {
+            m_parent[i] = i;
+        }
+    }
+
+    int find(int element)
+    {
+        while (m_parent.at(element) != element) {
+            m_parent[element] = m_parent.at(m_parent.at(element));
+            element = m_parent.at(element);
+        }
+        return element;
+    }
+
+    bool unite(int a, int b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (m_rank.at(a) < m_rank.at(b)) {
+            std::swap(a, b);
+        }
+        m_parent[b] = a;
+        if (m_rank.at(a) == m_rank.at(b)) {
+            ++m_rank[a];
+        }
+        return true;
+    }
+
+private:
+    QVector<int> m_parent;
+    QVector<int> m_rank;
+};
+
+/**
+ * Residual network for Dinic's maximum flow algorithm. Arcs are created pairwise, such that the
+ * reverse arc of arc a is a^1.
+ */
+class FlowNetwork
+{
+public:
+    explicit FlowNetwork(int nodeCount)
+        : m_first(nodeCount, -1)
+    {
+    }
+
+    int addArc(int from, int to, qreal capacity)
+    {
+        const int arc = m_to.size();
+        appendArc(from, to, capacity);
+        appendArc(to, from, 0);
+        return arc;
+    }
+
+    qreal flow(int arc) const
+    {
+        return m_capacity.at(arc ^ 1);
+    }
+
+    int from(int arc) const
+    {
+        return m_to.at(arc ^ 1);
+    }
+
+    int to(int arc) const
+    {
+        return m_to.at(arc);
+    }
+
+    qreal maxFlow(int source, int sink)
+    {
+        qreal total = 0;
+        if (source == sink) {
+            return total;
+        }
+        QVector<int> level(m_first.size());
+        QVector<int> path;
+        while (buildLevels(source, sink, level)) {
+            // find blocking flow by iterative depth-first search on the level graph
+            QVector<int> current = m_first;
+            int node = source;
+            path.clear();
+            while (true) {
+                if (node == sink) {
+                    qreal bottleneck = infinity;
+                    foreach (int arc, path) {
+                        bottleneck = qMin(bottleneck, m_capacity.at(arc));
+                    }
+                    int retreat = -1;
+                    for (int i = 0; i < path.size(); ++i) {
+                        const int arc = path.at(i);
+                        m_capacity[arc] -= bottleneck;
+                        m_capacity[arc ^ 1] += bottleneck;
+                        if (retreat < 0 && m_capacity.at(arc) <= epsilon) {
+                            retreat = i;
+                        }
+                    }
+                    total += bottleneck;
+                    // continue from the start node of the first saturated arc
+                    node = from(path.at(retreat));
+                    path.resize(retreat);
+                    continue;
+                }
+                int arc = current.at(node);
+                while (arc != -1 && (m_capacity.at(arc) <= epsilon || level.at(m_to.at(arc)) != level.at(node) + 1)) {
+                    arc = m_next.at(arc);
+                }
+                current[node] = arc;
+                if (arc != -1) {
+                    path.append(arc);
+                    node = m_to.at(arc);
+                    continue;
+                }
+                // dead end, the node cannot be part of another augmenting path in this phase
+                level[node] = -1;
+                if (path.isEmpty()) {
+                    break;
+                }
+                node = from(path.last());
+                path.removeLast();
+                current[node] = m_next.at(current.at(node));
+            }
+        }
+        return total;
+    }
+
+    /**
+     * \return for every node whether it is reachable from @p source in the residual network
+     */
+    QVector<bool> sourceSide(int source) const
+    {
+        QVector<bool> reached(m_first.size(), false);
+        QVector<int> queue;
+        reached[source] = true;
+        queue.append(source);
+        for (int head = 0; head < queue.size(); ++head) {
+            for (int arc = m_first.at(queue.at(head)); arc != -1; arc = m_next.at(arc)) {
+                if (m_capacity.at(arc) > epsilon && !reached.at(m_to.at(arc))) {
+                    reached[m_to.at(arc)] = true;
+                    queue.append(m_to.at(arc));
+                }
+            }
+        }
+        return reached;
+    }
+
+private:
+    void appendArc(int from, int to, qreal capacity)
+    {
+        m_to.append(to);
+        m_capacity.append(capacity);
+        m_next.append(m_first.at(from));
+        m_first[from] = m_to.size() - 1;
+    }
+
+    bool buildLevels(int source, int sink, QVector<int> &level) const
+    {
+        level.fill(-1);
+        level[source] = 0;
+        QVector<int> queue;
+        queue.append(source);
+        for (int head = 0; head < queue.size(); ++head) {
+            const int node = queue.at(head);
+            for (int arc = m_first.at(node); arc != -1; arc = m_next.at(arc)) {
+                if (m_capacity.at(arc) > epsilon && level.at(m_to.at(arc)) < 0) {
+                    level[m_to.at(arc)] = level.at(node) + 1;
+                    queue.append(m_to.at(arc));
+                }
+            }
+        }
+        return level.at(sink) >= 0;
+    }
+
+    QVector<int> m_first;
+    QVector<int> m_to;
+    QVector<int> m_next;
+    QVector<qreal> m_capacity;
+};
+
+/**
+ * \return weights of all edges by edge index, 1 without @p property and 0 for edges without
+ * value, as for node.distance() and Document.distanceMatrix()
+ */
+QVector<qreal> edgeWeights(const GraphSnapshot &graph, const QString &property)
+{
+    if (property.isEmpty()) {
+        return QVector<qreal>(graph.edgeCount(), 1);
+    }
+    QVector<qreal> weights = graph.weights(graph.weightIndex(property));
+    for (int i = 0; i < weights.size(); ++i) {
+        if (qIsNaN(weights.at(i))) {
+            weights[i] = 0;
+        }
+    }
+    return weights;
+}
+
+/**
+ * \return identifiers of the nodes with indices @p nodes
+ */
+QVariantList nodeIds(const GraphSnapshot &graph, const QVector<int> &nodes)
+{
+    QVariantList result;
+    foreach (int node, nodes) {
+        result.append(graph.nodeIds().at(node));
+    }
+    return result;
+}
+
+/**
+ * Compute articulation points and bridges by Tarjan's low-link values, ignoring edge directions.
+ */
+void lowLink(const GraphSnapshot &graph, QVector<bool> &articulation, QVector<int> &bridges)
+{
+    const int count = graph.nodeCount();
+    const UndirectedAdjacency adjacency(graph);
+    QVector<int> discovery(count, -1);
+    QVector<int> low(count, 0);
+    articulation.fill(false, count);
+    bridges.clear();
+
+    // explicit call stack of the depth-first search, to support large graphs
+    QVector<int> callNode;
+    QVector<int> callEdge;
+    QVector<int> callPosition;
+    int counter = 0;
+    for (int root = 0; root < count; ++root) {
+        if (discovery.at(root) >= 0) {
+            continue;
+        }
+        int rootChildren = 0;
+        discovery[root] = low[root] = counter++;
+        callNode.append(root);
+        callEdge.append(-1);
+        callPosition.append(adjacency.offsets.at(root));
+        while (!callNode.isEmpty()) {
+            const int node = callNode.last();
+            const int position = callPosition.last();
+            if (position < adjacency.offsets.at(node + 1)) {
+                ++callPosition.last();
+                const int neighbor = adjacency.neighbors.at(position);
+                const int edge = adjacency.edges.at(position);
+                if (edge == callEdge.last()) {
+                    continue;
+                }
+                if (discovery.at(neighbor) < 0) {
+                    if (node == root) {
+                        ++rootChildren;
+                    }
+                    discovery[neighbor] = low[neighbor] = counter++;
+                    callNode.append(neighbor);
+                    callEdge.append(edge);
+                    callPosition.append(adjacency.offsets.at(neighbor));
+                } else {
+                    low[node] = qMin(low.at(node), discovery.at(neighbor));
+                }
+                continue;
+            }
+            const int edge = callEdge.last();
+            callNode.removeLast();
+            callEdge.removeLast();
+            callPosition.removeLast();
+            if (callNode.isEmpty()) {
+                break;
+            }
+            const int parent = callNode.last();
+            low[parent] = qMin(low.at(parent), low.at(node));
+            if (low.at(node) > discovery.at(parent)) {
+                bridges.append(edge);
+            }
+            if (parent != root && low.at(node) >= discovery.at(parent)) {
+                articulation[parent] = true;
+            }
+        }
+        if (rootChildren > 1) {
+            articulation[root] = true;
+        }
+    }
+}
+}
+
+AlgorithmsModule::AlgorithmsModule(QObject *parent)
+    : QObject(parent)
+    , m_documentWrapper(nullptr)
+{
+}
+
+AlgorithmsModule::~AlgorithmsModule()
+{
+}
+
+void AlgorithmsModule::setDocumentWrapper(DocumentWrapper *documentWrapper)
+{
+    m_documentWrapper = documentWrapper;
+}
+
+bool AlgorithmsModule::snapshot(GraphSnapshot &graph, const QString &weightProperty)
+{
+    if (!m_documentWrapper || !m_documentWrapper->document()) {
+        emit message(i18nc("@info:shell", "Algorithms: no document available"), Kernel::ErrorMessage);
+        return false;
+    }
+    QStringList weightProperties;
+    if (!weightProperty.isEmpty()) {
+        weightProperties.append(weightProperty);
+    }
+    graph = GraphSnapshot(m_documentWrapper->document(), weightProperties);
+    return true;
+}
+
+int AlgorithmsModule::nodeIndex(const GraphSnapshot &graph, int id, const QString &command)
+{
+    const NodePtr node = m_documentWrapper->document()->node(id);
+    const int index = node ? graph.nodeIndex(node) : -1;
+    if (index < 0) {
+        emit message(i18nc("@info:shell", "%1: no node with ID %2 registered", command, id), Kernel::ErrorMessage);
+    }
+    return index;
+}
+
+QList<EdgeWrapper*> AlgorithmsModule::edgeWrappers(const GraphSnapshot &graph, const QVector<int> &edges) const
+{
+    QList<EdgeWrapper*> wrappers;
+    wrappers.reserve(edges.size());
+    foreach (int edge, edges) {
+        wrappers.append(m_documentWrapper->edgeWrapper(graph.edge(edge)));
+    }
+    return wrappers;
+}
+
+QVariantList AlgorithmsModule::bfs(int start)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph)) {
+        return QVariantList();
+    }
+    const int source = nodeIndex(graph, start, QStringLiteral("bfs"));
+    if (source < 0) {
+        return QVariantList();
+    }
+    const QVector<int> &offsets = graph.offsets();
+    const QVector<int> &targets = graph.targets();
+    QVector<bool> visited(graph.nodeCount(), false);
+    QVector<int> queue;
+    visited[source] = true;
+    queue.append(source);
+    for (int head = 0; head < queue.size(); ++head) {
+        const int node = queue.at(head);
+        for (int i = offsets.at(node); i < offsets.at(node + 1); ++i) {
+            if (!visited.at(targets.at(i))) {
+                visited[targets.at(i)] = true;
+                queue.append(targets.at(i));
+            }
+        }
+    }
+
+    return nodeIds(graph, queue);
+}
+
+QVariantList AlgorithmsModule::dfs(int start)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph)) {
+        return QVariantList();
+    }
+    const int source = nodeIndex(graph, start, QStringLiteral("dfs"));
+    if (source < 0) {
+        return QVariantList();
+    }
+    const QVector<int> &offsets = graph.offsets();
+    const QVector<int> &targets = graph.targets();
+    QVector<bool> visited(graph.nodeCount(), false);
+    QVector<int> callNode;
+    QVector<int> callPosition;
+    QVariantList result;
+
+    visited[source] = true;
+    result.append(graph.nodeIds().at(source));
+    callNode.append(source);
+    callPosition.append(offsets.at(source));
+    while (!callNode.isEmpty()) {
+        const int node = callNode.last();
+        const int position = callPosition.last();
+        if (position == offsets.at(node + 1)) {
+            callNode.removeLast();
+            callPosition.removeLast();
+            continue;
+        }
+        ++callPosition.last();
+        const int next = targets.at(position);
+        if (!visited.at(next)) {
+            visited[next] = true;
+            result.append(graph.nodeIds().at(next));
+            callNode.append(next);
+            callPosition.append(offsets.at(next));
+        }
+    }
+    return result;
+}
+
+QVariantList AlgorithmsModule::dijkstra(int from, int to, const QString &weightProperty)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph, weightProperty)) {
+        return QVariantList();
+    }
+    const int source = nodeIndex(graph, from, QStringLiteral("dijkstra"));
+    const int target = nodeIndex(graph, to, QStringLiteral("dijkstra"));
+    if (source < 0 || target < 0) {
+        return QVariantList();
+    }
+    const QVector<qreal> weights = edgeWeights(graph, weightProperty);
+    if (ShortestPaths::hasNegativeWeight(weights)) {
+        emit message(i18nc("@info:shell", "%1: negative edge weights are not supported", QStringLiteral("dijkstra")), Kernel::ErrorMessage);
+        return QVariantList();
+    }
+    return nodeIds(graph, ShortestPaths(graph, weights, source, target).path(target));
+}
+
+QVariantList AlgorithmsModule::bellmanFord(int from, int to, const QString &weightProperty)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph, weightProperty)) {
+        return QVariantList();
+    }
+    const int source = nodeIndex(graph, from, QStringLiteral("bellmanFord"));
+    const int target = nodeIndex(graph, to, QStringLiteral("bellmanFord"));
+    if (source < 0 || target < 0) {
+        return QVariantList();
+    }
+    const ShortestPaths paths(graph, edgeWeights(graph, weightProperty), source, target);
+    if (paths.hasNegativeCycle()) {
+        emit message(i18nc("@info:shell", "%1: graph contains a cycle of negative weight", QStringLiteral("bellmanFord")), Kernel::ErrorMessage);
+        return QVariantList();
+    }
+    return nodeIds(graph, paths.path(target));
+}
+
+QVariantList AlgorithmsModule::aStar(int from, int to, const QString &weightProperty)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph, weightProperty)) {
+        return QVariantList();
+    }
+    const int source = nodeIndex(graph, from, QStringLiteral("aStar"));
+    const int target = nodeIndex(graph, to, QStringLiteral("aStar"));
+    if (source < 0 || target < 0) {
+        return QVariantList();
+    }
+    const int count = graph.nodeCount();
+    QVector<qreal> x(count);
+    QVector<qreal> y(count);
+    for (int node = 0; node < count; ++node) {
+        x[node] = graph.node(node)->x();
+        y[node] = graph.node(node)->y();
+    }
+    auto euclidean = [&x, &y](int a, int b) {
+        return qSqrt((x.at(a) - x.at(b)) * (x.at(a) - x.at(b)) + (y.at(a) - y.at(b)) * (y.at(a) - y.at(b)));
+    };
+
+    // the heuristic is scaled by the minimal ratio of weight and edge length, which keeps it
+    // consistent for arbitrary non-negative weights
+    QVector<qreal> weights(graph.edgeCount());
+    qreal scale = 1;
+    if (weightProperty.isEmpty()) {
+        for (int edge = 0; edge < graph.edgeCount(); ++edge) {
+            weights[edge] = euclidean(graph.edgeSources().at(edge), graph.edgeTargets().at(edge));
+        }
+    } else {
+        weights = edgeWeights(graph, weightProperty);
+        if (ShortestPaths::hasNegativeWeight(weights)) {
+            emit message(i18nc("@info:shell", "%1: negative edge weights are not supported", QStringLiteral("aStar")), Kernel::ErrorMessage);
+            return QVariantList();
+        }
+        scale = infinity;
+        for (int edge = 0; edge < graph.edgeCount(); ++edge) {
+            const qreal length = euclidean(graph.edgeSources().at(edge), graph.edgeTargets().at(edge));
+            if (length > 0) {
+                scale = qMin(scale, weights.at(edge) / length);
+            }
+        }
+        if (scale == infinity) {
+            scale = 0;
+        }
+    }
+
+    const QVector<int> &offsets = graph.offsets();
+    const QVector<int> &targets = graph.targets();
+    const QVector<int> &edges = graph.edges();
+    QVector<qreal> distance(count, infinity);
+    QVector<int> predecessor(count, -1);
+    QVector<bool> closed(count, false);
+    MinQueue queue;
+    distance[source] = 0;
+    queue.push(QueueEntry(scale * euclidean(source, target), source));
+    while (!queue.empty()) {
+        const int node = queue.top().second;
+        queue.pop();
+        if (closed.at(node)) {
+            continue;
+        }
+        closed[node] = true;
+        if (node == target) {
+            break;
+        }
+        for (int i = offsets.at(node); i < offsets.at(node + 1); ++i) {
+            const int next = targets.at(i);
+            const qreal length = distance.at(node) + weights.at(edges.at(i));
+            if (!closed.at(next) && length < distance.at(next)) {
+                distance[next] = length;
+                predecessor[next] = node;
+                queue.push(QueueEntry(length + scale * euclidean(next, target), next));
+            }
+        }
+    }
+    if (distance.at(target) == infinity) {
+        return QVariantList();
+    }
+    QVector<int> path;
+    for (int node = target; node != source; node = predecessor.at(node)) {
+        path.prepend(node);
+    }
+    path.prepend(source);
+    return nodeIds(graph, path);
+}
+
+QVariantList AlgorithmsModule::connectedComponents()
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph)) {
+        return QVariantList();
+    }
+    DisjointSets sets(graph.nodeCount());
+    for (int edge = 0; edge < graph.edgeCount(); ++edge) {
+        sets.unite(graph.edgeSources().at(edge), graph.edgeTargets().at(edge));
+    }
+    QHash<int, int> componentIndex;
+    QVector<QVariantList> components;
+    for (int node = 0; node < graph.nodeCount(); ++node) {
+        const int root = sets.find(node);
+        if (!componentIndex.contains(root)) {
+            componentIndex.insert(root, components.size());
+            components.append(QVariantList());
+        }
+        components[componentIndex.value(root)].append(graph.nodeIds().at(node));
+    }
+
+    QVariantList result;
+    foreach (const QVariantList &component, components) {
+        result.append(QVariant(component));
+    }
+    return result;
+}
+
+QVariantList AlgorithmsModule::stronglyConnectedComponents()
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph)) {
+        return QVariantList();
+    }
+    const QVector<int> &offsets = graph.offsets();
+    const QVector<int> &targets = graph.targets();
+    const int count = graph.nodeCount();
+    QVector<int> index(count, -1);
+    QVector<int> low(count, 0);
+    QVector<bool> onStack(count, false);
+    QVector<int> stack;
+    QVector<int> callNode;
+    QVector<int> callPosition;
+    QVariantList result;
+    int counter = 0;
+
+    // Tarjan's algorithm with an explicit call stack
+    for (int root = 0; root < count; ++root) {
+        if (index.at(root) >= 0) {
+            continue;
+        }
+        index[root] = low[root] = counter++;
+        stack.append(root);
+        onStack[root] = true;
+        callNode.append(root);
+        callPosition.append(offsets.at(root));
+        while (!callNode.isEmpty()) {
+            const int node = callNode.last();
+            const int position = callPosition.last();
+            if (position < offsets.at(node + 1)) {
+                ++callPosition.last();
+                const int next = targets.at(position);
+                if (index.at(next) < 0) {
+                    index[next] = low[next] = counter++;
+                    stack.append(next);
+                    onStack[next] = true;
+                    callNode.append(next);
+                    callPosition.append(offsets.at(next));
+                } else if (onStack.at(next)) {
+                    low[node] = qMin(low.at(node), index.at(next));
+                }
+                continue;
+            }
+            callNode.removeLast();
+            callPosition.removeLast();
+            if (!callNode.isEmpty()) {
+                low[callNode.last()] = qMin(low.at(callNode.last()), low.at(node));
+            }
+            if (low.at(node) == index.at(node)) {
+                QVariantList component;
+                int member;
+                do {
+                    member = stack.takeLast();
+                    onStack[member] = false;
+                    component.prepend(graph.nodeIds().at(member));
+                } while (member != node);
+                result.append(QVariant(component));
+            }
+        }
+    }
+    return result;
+}
+
+QVariantList AlgorithmsModule::topologicalSort()
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph)) {
+        return QVariantList();
+    }
+    const QVector<int> &offsets = graph.offsets();
+    const QVector<int> &targets = graph.targets();
+    const int count = graph.nodeCount();
+    QVector<int> indegree(count, 0);
+    foreach (int target, targets) {
+        ++indegree[target];
+    }
+    QVector<int> order;
+    order.reserve(count);
+    for (int node = 0; node < count; ++node) {
+        if (indegree.at(node) == 0) {
+            order.append(node);
+        }
+    }
+    for (int head = 0; head < order.size(); ++head) {
+        const int node = order.at(head);
+        for (int i = offsets.at(node); i < offsets.at(node + 1); ++i) {
+            if (--indegree[targets.at(i)] == 0) {
+                order.append(targets.at(i));
+            }
+        }
+    }
+    if (order.size() < count) {
+        emit message(i18nc("@info:shell", "%1: graph contains a cycle", QStringLiteral("topologicalSort")), Kernel::ErrorMessage);
+        return QVariantList();
+    }
+
+    return nodeIds(graph, order);
+}
+
+QList<EdgeWrapper*> AlgorithmsModule::kruskal(const QString &weightProperty)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph, weightProperty)) {
+        return QList<EdgeWrapper*>();
+    }
+    const QVector<qreal> weights = edgeWeights(graph, weightProperty);
+    QVector<int> order(graph.edgeCount());
+    for (int edge = 0; edge < order.size(); ++edge) {
+        order[edge] = edge;
+    }
+    std::stable_sort(order.begin(), order.end(), [&weights](int a, int b) {
+        return weights.at(a) < weights.at(b);
+    });
+
+    DisjointSets sets(graph.nodeCount());
+    QVector<int> tree;
+    foreach (int edge, order) {
+        if (sets.unite(graph.edgeSources().at(edge), graph.edgeTargets().at(edge))) {
+            tree.append(edge);
+        }
+    }
+    return edgeWrappers(graph, tree);
+}
+
+QList<EdgeWrapper*> AlgorithmsModule::prim(int start, const QString &weightProperty)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph, weightProperty)) {
+        return QList<EdgeWrapper*>();
+    }
+    const int root = nodeIndex(graph, start, QStringLiteral("prim"));
+    if (root < 0) {
+        return QList<EdgeWrapper*>();
+    }
+    const QVector<qreal> weights = edgeWeights(graph, weightProperty);
+    const UndirectedAdjacency adjacency(graph);
+    QVector<bool> inTree(graph.nodeCount(), false);
+    QVector<int> tree;
+
+    // queue entries are positions in the adjacency, leading to nodes not yet in the tree
+    MinQueue queue;
+    inTree[root] = true;
+    for (int i = adjacency.offsets.at(root); i < adjacency.offsets.at(root + 1); ++i) {
+        queue.push(QueueEntry(weights.at(adjacency.edges.at(i)), i));
+    }
+    while (!queue.empty()) {
+        const int position = queue.top().second;
+        queue.pop();
+        const int node = adjacency.neighbors.at(position);
+        if (inTree.at(node)) {
+            continue;
+        }
+        inTree[node] = true;
+        tree.append(adjacency.edges.at(position));
+        for (int i = adjacency.offsets.at(node); i < adjacency.offsets.at(node + 1); ++i) {
+            if (!inTree.at(adjacency.neighbors.at(i))) {
+                queue.push(QueueEntry(weights.at(adjacency.edges.at(i)), i));
+            }
+        }
+    }
+    return edgeWrappers(graph, tree);
+}
+
+qreal AlgorithmsModule::maxFlow(int source, int sink, const QString &capacityProperty)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph, capacityProperty)) {
+        return 0;
+    }
+    const int sourceIndex = nodeIndex(graph, source, QStringLiteral("maxFlow"));
+    const int sinkIndex = nodeIndex(graph, sink, QStringLiteral("maxFlow"));
+    if (sourceIndex < 0 || sinkIndex < 0) {
+        return 0;
+    }
+    const QVector<qreal> capacities = edgeWeights(graph, capacityProperty);
+    if (ShortestPaths::hasNegativeWeight(capacities)) {
+        emit message(i18nc("@info:shell", "%1: negative capacities are not supported", QStringLiteral("maxFlow")), Kernel::ErrorMessage);
+        return 0;
+    }
+    FlowNetwork network(graph.nodeCount());
+    for (int node = 0; node < graph.nodeCount(); ++node) {
+        for (int i = graph.offsets().at(node); i < graph.offsets().at(node + 1); ++i) {
+            network.addArc(node, graph.targets().at(i), capacities.at(graph.edges().at(i)));
+        }
+    }
+    return network.maxFlow(sourceIndex, sinkIndex);
+}
+
+QList<EdgeWrapper*> AlgorithmsModule::minCut(int source, int sink, const QString &capacityProperty)
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph, capacityProperty)) {
+        return QList<EdgeWrapper*>();
+    }
+    const int sourceIndex = nodeIndex(graph, source, QStringLiteral("minCut"));
+    const int sinkIndex = nodeIndex(graph, sink, QStringLiteral("minCut"));
+    if (sourceIndex < 0 || sinkIndex < 0) {
+        return QList<EdgeWrapper*>();
+    }
+    const QVector<qreal> capacities = edgeWeights(graph, capacityProperty);
+    if (ShortestPaths::hasNegativeWeight(capacities)) {
+        emit message(i18nc("@info:shell", "%1: negative capacities are not supported", QStringLiteral("minCut")), Kernel::ErrorMessage);
+        return QList<EdgeWrapper*>();
+    }
+    FlowNetwork network(graph.nodeCount());
+    QVector<int> arcs;
+    QVector<int> arcEdges;
+    for (int node = 0; node < graph.nodeCount(); ++node) {
+        for (int i = graph.offsets().at(node); i < graph.offsets().at(node + 1); ++i) {
+            arcs.append(network.addArc(node, graph.targets().at(i), capacities.at(graph.edges().at(i))));
+            arcEdges.append(graph.edges().at(i));
+        }
+    }
+    network.maxFlow(sourceIndex, sinkIndex);
+
+    // the cut consists of all edges leaving the nodes reachable in the residual network
+    const QVector<bool> sourceSide = network.sourceSide(sourceIndex);
+    QVector<bool> inCut(graph.edgeCount(), false);
+    QVector<int> cut;
+    for (int i = 0; i < arcs.size(); ++i) {
+        const int edge = arcEdges.at(i);
+        if (!inCut.at(edge) && sourceSide.at(network.from(arcs.at(i))) && !sourceSide.at(network.to(arcs.at(i)))) {
+            inCut[edge] = true;
+            cut.append(edge);
+        }
+    }
+    return edgeWrappers(graph, cut);
+}
+
+QList<EdgeWrapper*> AlgorithmsModule::bipartiteMatching()
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph)) {
+        return QList<EdgeWrapper*>();
+    }
+    const int count = graph.nodeCount();
+    const UndirectedAdjacency adjacency(graph);
+
+    // two-coloring by breadth-first search
+    QVector<int> color(count, -1);
+    QVector<int> queue;
+    for (int root = 0; root < count; ++root) {
+        if (color.at(root) >= 0) {
+            continue;
+        }
+        color[root] = 0;
+        queue.clear();
+        queue.append(root);
+        for (int head = 0; head < queue.size(); ++head) {
+            const int node = queue.at(head);
+            for (int i = adjacency.offsets.at(node); i < adjacency.offsets.at(node + 1); ++i) {
+                const int neighbor = adjacency.neighbors.at(i);
+                if (color.at(neighbor) < 0) {
+                    color[neighbor] = 1 - color.at(node);
+                    queue.append(neighbor);
+                } else if (color.at(neighbor) == color.at(node)) {
+                    emit message(i18nc("@info:shell", "%1: graph is not bipartite", QStringLiteral("bipartiteMatching")), Kernel::ErrorMessage);
+                    return QList<EdgeWrapper*>();
+                }
+            }
+        }
+    }
+
+    // maximum matching as unit capacity flow, for which Dinic's algorithm is Hopcroft-Karp
+    const int source = count;
+    const int sink = count + 1;
+    FlowNetwork network(count + 2);
+    for (int node = 0; node < count; ++node) {
+        if (color.at(node) == 0) {
+            network.addArc(source, node, 1);
+        } else {
+            network.addArc(node, sink, 1);
+        }
+    }
+    QVector<int> arcs(graph.edgeCount());
+    for (int edge = 0; edge < graph.edgeCount(); ++edge) {
+        int left = graph.edgeSources().at(edge);
+        int right = graph.edgeTargets().at(edge);
+        if (color.at(left) != 0) {
+            std::swap(left, right);
+        }
+        arcs[edge] = network.addArc(left, right, 1);
+    }
+    network.maxFlow(source, sink);
+
+    QVector<int> matching;
+    for (int edge = 0; edge < graph.edgeCount(); ++edge) {
+        if (network.flow(arcs.at(edge)) > 0.5) {
+            matching.append(edge);
+        }
+    }
+    return edgeWrappers(graph, matching);
+}
+
+QVariantList AlgorithmsModule::articulationPoints()
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph)) {
+        return QVariantList();
+    }
+    QVector<bool> articulation;
+    QVector<int> bridges;
+    lowLink(graph, articulation, bridges);
+
+    QVariantList result;
+    for (int node = 0; node < graph.nodeCount(); ++node) {
+        if (articulation.at(node)) {
+            result.append(graph.nodeIds().at(node));
+        }
+    }
+    return result;
+}
+
+QList<EdgeWrapper*> AlgorithmsModule::bridges()
+{
+    GraphSnapshot graph;
+    if (!snapshot(graph)) {
+        return QList<EdgeWrapper*>();
+    }
+    QVector<bool> articulation;
+    QVector<int> bridges;
+    lowLink(graph, articulation, bridges);
+    return edgeWrappers(graph, bridges);
+}
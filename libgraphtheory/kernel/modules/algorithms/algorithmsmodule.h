@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHMSMODULE_H
+#define ALGORITHMSMODULE_H
+
+#include "graphtheory_export.h"
+#include "kernel/kernel.h"
+#include <QObject>
+#include <QList>
+#include <QVariantList>
+#include <QVector>
+
+namespace GraphTheory
+{
+class DocumentWrapper;
+class EdgeWrapper;
+class GraphSnapshot;
+
+/**
+ * \class AlgorithmsModule
+ * This class provides native implementations of common graph algorithms to the scripting
+ * engine. Every call works on a snapshot of the current document. Nodes are passed and returned
+ * by their identifiers, edges are returned as script wrappers.
+ *
+ * Edge weights are read from dynamic edge properties whose name is passed to the respective
+ * method; if no property is given or the value of an edge is not numeric, the weight is 1.
+ */
+class GRAPHTHEORY_EXPORT AlgorithmsModule : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AlgorithmsModule(QObject *parent = 0);
+    ~AlgorithmsModule();
+
+    /**
+     * Set the document on which the algorithms operate to the one of @p documentWrapper.
+     */
+    void setDocumentWrapper(DocumentWrapper *documentWrapper);
+
+    /**
+     * \return identifiers of all nodes reachable from node @p start in breadth-first order
+     */
+    Q_INVOKABLE QVariantList bfs(int start);
+
+    /**
+     * \return identifiers of all nodes reachable from node @p start in depth-first order
+     */
+    Q_INVOKABLE QVariantList dfs(int start);
+
+    /**
+     * Compute a shortest path from node @p from to node @p to by Dijkstra's algorithm. Weights
+     * must not be negative.
+     * \return identifiers of the nodes of the path, empty if @p to is not reachable
+     */
+    Q_INVOKABLE QVariantList dijkstra(int from, int to, const QString &weightProperty = QString());
+
+    /**
+     * Compute a shortest path from node @p from to node @p to by the Bellman-Ford algorithm,
+     * which also admits negative weights. Without negative weights, Dijkstra's algorithm is used.
+     * \return identifiers of the nodes of the path, empty if @p to is not reachable or a
+     * negative cycle is reachable from @p from
+     */
+    Q_INVOKABLE QVariantList bellmanFord(int from, int to, const QString &weightProperty = QString());
+
+    /**
+     * Compute a shortest path from node @p from to node @p to by A* search. The heuristic is
+     * the Euclidean distance of the node positions. Without weight property, the length of an
+     * edge is its Euclidean length, otherwise the distance is scaled such that it never
+     * overestimates.
+     * \return identifiers of the nodes of the path, empty if @p to is not reachable
+     */
+    Q_INVOKABLE QVariantList aStar(int from, int to, const QString &weightProperty = QString());
+
+    /**
+     * \return connected components of the graph, ignoring edge directions, as lists of node
+     * identifiers
+     */
+    Q_INVOKABLE QVariantList connectedComponents();
+
+    /**
+     * \return strongly connected components of the graph as lists of node identifiers
+     */
+    Q_INVOKABLE QVariantList stronglyConnectedComponents();
+
+    /**
+     * \return node identifiers in topological order, empty if the graph contains a cycle
+     */
+    Q_INVOKABLE QVariantList topologicalSort();
+
+    /**
+     * Compute a minimum spanning forest by Kruskal's algorithm, ignoring edge directions.
+     * \return the edges of the forest
+     */
+    Q_INVOKABLE QList<GraphTheory::EdgeWrapper*> kruskal(const QString &weightProperty = QString());
+
+    /**
+     * Compute a minimum spanning tree of the component of node @p start by Prim's algorithm,
+     * ignoring edge directions.
+     * \return the edges of the tree
+     */
+    Q_INVOKABLE QList<GraphTheory::EdgeWrapper*> prim(int start, const QString &weightProperty = QString());
+
+    /**
+     * \return value of a maximum flow from node @p source to node @p sink, capacities are
+     * taken from @p capacityProperty
+     */
+    Q_INVOKABLE qreal maxFlow(int source, int sink, const QString &capacityProperty = QString());
+
+    /**
+     * \return edges of a minimum cut separating node @p source from node @p sink
+     */
+    Q_INVOKABLE QList<GraphTheory::EdgeWrapper*> minCut(int source, int sink, const QString &capacityProperty = QString());
+
+    /**
+     * Compute a maximum matching of a bipartite graph, ignoring edge directions.
+     * \return the edges of the matching, empty if the graph is not bipartite
+     */
+    Q_INVOKABLE QList<GraphTheory::EdgeWrapper*> bipartiteMatching();
+
+    /**
+     * \return identifiers of all nodes whose removal disconnects their component, ignoring
+     * edge directions
+     */
+    Q_INVOKABLE QVariantList articulationPoints();
+
+    /**
+     * \return all edges whose removal disconnects their component, ignoring edge directions
+     */
+    Q_INVOKABLE QList<GraphTheory::EdgeWrapper*> bridges();
+
+Q_SIGNALS:
+    void message(const QString &message, GraphTheory::Kernel::MessageType type);
+
+private:
+    Q_DISABLE_COPY(AlgorithmsModule)
+    bool snapshot(GraphSnapshot &graph, const QString &weightProperty = QString());
+    int nodeIndex(const GraphSnapshot &graph, int id, const QString &command);
+    QList<GraphTheory::EdgeWrapper*> edgeWrappers(const GraphSnapshot &graph, const QVector<int> &edges) const;
+    DocumentWrapper *m_documentWrapper;
+};
+}
+
+#endif
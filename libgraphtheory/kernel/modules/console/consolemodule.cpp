@@ -58,3 +58,8 @@ void ConsoleModule::error(const QString& messageString)
     m_backlog.append(qMakePair<Kernel::MessageType, QString>(Kernel::ErrorMessage, messageString));
     emit(message(messageString, Kernel::ErrorMessage));
 }
+
+void ConsoleModule::progress(int percent)
+{
+    emit progressChanged(qBound(0, percent, 100));
+}
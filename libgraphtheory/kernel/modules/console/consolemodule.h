@@ -70,8 +70,14 @@ public Q_SLOTS:
      */
     Q_INVOKABLE void error(const QString &message);
 
+    /**
+     * Report progress \p percent of the script execution.
+     */
+    Q_INVOKABLE void progress(int percent);
+
 Q_SIGNALS:
     void message(const QString &message, GraphTheory::Kernel::MessageType type);
+    void progressChanged(int percent);
 
 private:
     Q_DISABLE_COPY(ConsoleModule)
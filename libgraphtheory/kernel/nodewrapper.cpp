@@ -23,27 +23,25 @@
 #include "graphdocument.h"
 #include "nodetype.h"
 #include "edge.h"
+#include "graphsnapshot.h"
+#include "shortestpaths_p.h"
 #include "typenames.h"
 #include <KLocalizedString>
 #include <QPointF>
+#include <QScriptContext>
 #include <QColor>
 #include <QDebug>
 #include <QEvent>
+#include <QtNumeric>
+#include <limits>
 
 using namespace GraphTheory;
 
 NodeWrapper::NodeWrapper(NodePtr node, DocumentWrapper *documentWrapper)
-    : QObject(node.data())
-    , m_node(node)
+    : QObject(documentWrapper)
     , m_documentWrapper(documentWrapper)
 {
-    connect(m_node.data(), &Node::idChanged, this, &NodeWrapper::idChanged);
-    connect(m_node.data(), &Node::colorChanged, this, &NodeWrapper::colorChanged);
-    connect(m_node.data(), &Node::positionChanged, this, &NodeWrapper::positionChanged);
-    connect(m_node.data(), &Node::dynamicPropertiesChanged, this, &NodeWrapper::updateDynamicProperties);
-    connect(m_node.data(), &Node::typeChanged, this, &NodeWrapper::typeChanged);
-
-    updateDynamicProperties();
+    setNode(node);
 }
 
 NodeWrapper::~NodeWrapper()
@@ -56,6 +54,21 @@ NodePtr NodeWrapper::node() const
     return m_node;
 }
 
+void NodeWrapper::setNode(NodePtr node)
+{
+    if (m_node) {
+        m_node->disconnect(this);
+    }
+    m_node = node;
+    connect(m_node.data(), &Node::idChanged, this, &NodeWrapper::idChanged);
+    connect(m_node.data(), &Node::colorChanged, this, &NodeWrapper::colorChanged);
+    connect(m_node.data(), &Node::positionChanged, this, &NodeWrapper::positionChanged);
+    connect(m_node.data(), &Node::dynamicPropertyChanged, this, &NodeWrapper::updateDynamicProperty);
+    connect(m_node.data(), &Node::typeChanged, this, &NodeWrapper::typeChanged);
+
+    updateDynamicProperties();
+}
+
 int NodeWrapper::id() const
 {
     return m_node->id();
@@ -154,7 +167,7 @@ QList<GraphTheory::EdgeWrapper*> NodeWrapper::edges(int type) const
         return QList<EdgeWrapper*>();
     }
     QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->edges(typePtr)) {
+    for (const auto &edge : m_node->edgesView(typePtr)) {
         edges.append(m_documentWrapper->edgeWrapper(edge));
     }
     return edges;
@@ -184,7 +197,7 @@ QList<GraphTheory::EdgeWrapper*> NodeWrapper::inEdges(int type) const
         return QList<EdgeWrapper*>();
     }
     QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->inEdges(typePtr)) {
+    for (const auto &edge : m_node->inEdgesView(typePtr)) {
         edges.append(m_documentWrapper->edgeWrapper(edge));
     }
     return edges;
@@ -214,7 +227,7 @@ QList<GraphTheory::EdgeWrapper*> NodeWrapper::outEdges(int type) const
         return QList<EdgeWrapper*>();
     }
     QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->outEdges(typePtr)) {
+    for (const auto &edge : m_node->outEdgesView(typePtr)) {
         edges.append(m_documentWrapper->edgeWrapper(edge));
     }
     return edges;
@@ -248,7 +261,7 @@ QList<NodeWrapper*> NodeWrapper::neighbors(int type) const
         return QList<NodeWrapper*>();
     }
     QSet<NodeWrapper*> neighbors;
-    for (const auto &edge : m_node->edges(typePtr)) {
+    for (const auto &edge : m_node->edgesView(typePtr)) {
         if (m_node == edge->from()) {
             neighbors.insert(m_documentWrapper->nodeWrapper(edge->to()));
         } else {
@@ -291,7 +304,7 @@ QList<NodeWrapper*> NodeWrapper::predecessors(int type) const
         return QList<NodeWrapper*>();
     }
     QSet<NodeWrapper*> precessors;
-    for (const auto &edge : m_node->inEdges(typePtr)) {
+    for (const auto &edge : m_node->inEdgesView(typePtr)) {
         if (edge->type()->direction() == EdgeType::Unidirectional) {
             precessors.insert(m_documentWrapper->nodeWrapper(edge->from()));
             continue;
@@ -339,7 +352,7 @@ QList<NodeWrapper*> NodeWrapper::successors(int type) const
         return QList<NodeWrapper*>();
     }
     QSet<NodeWrapper*> successors;
-    for (const auto &edge : m_node->outEdges(typePtr)) {
+    for (const auto &edge : m_node->outEdgesView(typePtr)) {
         if (edge->type()->direction() == EdgeType::Unidirectional) {
             successors.insert(m_documentWrapper->nodeWrapper(edge->to()));
             continue;
@@ -356,72 +369,61 @@ QList<NodeWrapper*> NodeWrapper::successors(int type) const
 
 QScriptValue NodeWrapper::distance(const QString &lengthProperty, QList< NodeWrapper* > targets)
 {
-    //TODO at a later point in time:
-    //     factor this algorithm out into a self-contained graph algorithm class
-
-    // Implementation of Floyd-Warshall Algorithm:
-    // asymptotic runtime: O(n^3), n = number of nodes
-    //
-    // 1 let D be a |V| × |V| matrix of minimum distances initialized to ∞ (infinity)
-    // 2 foreach(vertex v)
-    // 3    D[v][v] ← 0
-    // 4 foreach (edge (u,v))
-    // 5    D[u][v] := w(u,v)  // the weight of the edge (u,v)
-    // 6 for (k from 1 to |V|)
-    // 7    for (i from 1 to |V|)
-    // 8       for (j from 1 to |V|)
-    // 9          if (D[i][j] > D[i][k] + D[k][j])
-    // 10             D[i][j] := D[i][k] + D[k][j]
-    // 11         end if
-
-    const NodeList nodes = m_node->document()->nodes();
-    const EdgeList edges = m_node->document()->edges();
-    const int n = nodes.length();
-
-    // create fast access mapping of node IDs to positions
-    QMap<int, int> map;
-    for (int i = 0; i < n; ++i) {
-        map.insert(nodes.at(i)->id(), i);
-    }
-
-    // initialize distance matrix D
-    QVector< QVector<qreal> > D(n, QVector<qreal>(n));
-    for (int i = 0; i < n; ++i) {
-    for (int j = 0; j < n; ++j) {
-        if (i == j) {
-            D[i][j] = 0;
-        }
-        else {
-            D[i][j] = std::numeric_limits<qreal>::max();
-        }
-    }
-    }
+    return distance(lengthProperty, targets, false);
+}
 
-    // set edges lengths to D
-    for (const auto &edge : edges) {
-        D[map[edge->from()->id()]][map[edge->to()->id()]] = edge->dynamicProperty(lengthProperty).toDouble();
-        if (edge->type()->direction() == EdgeType::Bidirectional) {
-            D[map[edge->to()->id()]][map[edge->from()->id()]] = edge->dynamicProperty(lengthProperty).toDouble();
+QScriptValue NodeWrapper::distance(const QString &lengthProperty, QList< NodeWrapper* > targets, bool includePaths)
+{
+    // elements that are no node objects or whose nodes were removed are converted to null
+    QScriptEngine *engine = m_documentWrapper->engine();
+    for (int i = 0; i < targets.length(); ++i) {
+        if (!targets.at(i)) {
+            QString command = QString("node.distance(%1, targets)").arg(lengthProperty);
+            return engine->currentContext()->throwError(QScriptContext::TypeError,
+                i18nc("@info:shell", "%1: target %2 is not a valid node object", command, i));
         }
     }
 
-    // computation
-    for (int k = 0; k < n; ++k) {
-    for (int i = 0; i < n; ++i) {
-    for (int j = 0; j < n; ++j) {
-        if (D[i][j] > D[i][k] + D[k][j]) {
-            D[i][j] = D[i][k] + D[k][j];
+    const GraphSnapshot graph(m_node->document(), QStringList() << lengthProperty);
+
+    // edges without length have length 0
+    QVector<qreal> lengths = graph.weights(0);
+    for (int e = 0; e < lengths.size(); ++e) {
+        if (qIsNaN(lengths.at(e))) {
+            lengths[e] = 0;
         }
     }
-    }
+
+    // single-source shortest paths, by Dijkstra's algorithm or by Bellman-Ford for negative lengths
+    const ShortestPaths paths(graph, lengths, graph.nodeIndex(m_node));
+    if (paths.hasNegativeCycle()) {
+        QString command = QString("node.distance(%1, targets)").arg(lengthProperty);
+        emit message(i18nc("@info:shell", "%1: graph contains a cycle of negative length", command), Kernel::ErrorMessage);
+        return engine->newArray();
     }
 
-    // compute return statement
-    QScriptValue array = m_documentWrapper->engine()->newArray(targets.length());
-    const int from = map[m_node->id()];
+    // compute return statement, unreachable nodes have maximal distance
+    QScriptValue array = engine->newArray(targets.length());
     for (int i = 0; i < targets.length(); ++i) {
-        const qreal distance = D[from][map[targets.at(i)->id()]];
-        array.setProperty(i, distance);
+        const int target = graph.nodeIndex(targets.at(i)->node());
+        qreal distance = std::numeric_limits<qreal>::max();
+        if (target >= 0 && !qIsInf(paths.distance(target))) {
+            distance = paths.distance(target);
+        }
+        if (!includePaths) {
+            array.setProperty(i, distance);
+            continue;
+        }
+        QList<NodeWrapper*> path;
+        if (target >= 0) {
+            foreach (int node, paths.path(target)) {
+                path.append(m_documentWrapper->nodeWrapper(graph.node(node)));
+            }
+        }
+        QScriptValue entry = engine->newObject();
+        entry.setProperty("distance", distance);
+        entry.setProperty("path", engine->toScriptValue(path));
+        array.setProperty(i, entry);
     }
     return array;
 }
@@ -453,3 +455,17 @@ void NodeWrapper::updateDynamicProperties()
         }
     }
 }
+
+void NodeWrapper::updateDynamicProperty(int index)
+{
+    // wrappers persist between script runs, thus values changed outside of scripts must be updated
+    const QStringList properties = m_node->dynamicProperties();
+    if (index < 0 || index >= properties.length()) {
+        return;
+    }
+    const QByteArray name = properties.at(index).toUtf8();
+    const QVariant value = m_node->dynamicProperty(properties.at(index));
+    if (value.isValid() && property(name) != value) {
+        setProperty(name, value);
+    }
+}
@@ -58,6 +58,12 @@ public:
 
     NodePtr node() const;
 
+    /**
+     * Wrap @p node instead of the current node. Used by DocumentWrapper to keep the wrapper
+     * when a script is executed on a working copy of the document.
+     */
+    void setNode(NodePtr node);
+
     /**
      * If the id value is invalid, -1 is returned.
      *
@@ -182,11 +188,19 @@ public:
      */
     Q_INVOKABLE QScriptValue distance(const QString &lengthProperty, QList<GraphTheory::NodeWrapper*> targets);
 
+    /**
+     * @param includePaths if true, each entry is an object with properties "distance" and "path",
+     * where path is the list of nodes of a shortest path to the target
+     * @return array of distances to given set of nodes
+     */
+    Q_INVOKABLE QScriptValue distance(const QString &lengthProperty, QList<GraphTheory::NodeWrapper*> targets, bool includePaths);
+
     /** reimplemented from QObject **/
     virtual bool event(QEvent *e) Q_DECL_OVERRIDE;
 
 public Q_SLOTS:
     void updateDynamicProperties();
+    void updateDynamicProperty(int index);
 
 Q_SIGNALS:
     void message(const QString &messageString, Kernel::MessageType type) const;
@@ -197,7 +211,7 @@ Q_SIGNALS:
 
 private:
     Q_DISABLE_COPY(NodeWrapper)
-    const NodePtr m_node;
+    NodePtr m_node;
     const DocumentWrapper *m_documentWrapper;
 };
 }
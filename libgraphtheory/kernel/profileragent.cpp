@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "profileragent_p.h"
+#include "kernelprofile.h"
+
+#include <QMetaObject>
+#include <QScriptContext>
+#include <QScriptContextInfo>
+#include <QScriptEngine>
+
+using namespace GraphTheory;
+
+ProfilerAgent::ProfilerAgent(QScriptEngine *engine)
+    : QScriptEngineAgent(engine)
+    , m_profile(nullptr)
+    , m_depth(0)
+{
+}
+
+void ProfilerAgent::start(KernelProfile *profile)
+{
+    m_profile = profile;
+    m_calls.clear();
+    m_depth = 0;
+    m_timer.start();
+}
+
+void ProfilerAgent::functionEntry(qint64 scriptId)
+{
+    if (scriptId != -1) {
+        return;
+    }
+    // every native entry is recorded, such that entries and exits stay balanced
+    Call call;
+    const QScriptContextInfo info(engine()->currentContext());
+    QObject *object = engine()->currentContext()->thisObject().toQObject();
+    if (object && info.functionType() == QScriptContextInfo::QtFunction) {
+        const QString className = QString::fromLatin1(object->metaObject()->className());
+        call.function = className.section("::", -1) + '.' + info.functionName();
+        ++m_depth;
+    }
+    call.start = m_timer.nsecsElapsed();
+    m_calls.append(call);
+}
+
+void ProfilerAgent::functionExit(qint64 scriptId, const QScriptValue &returnValue)
+{
+    Q_UNUSED(returnValue);
+    if (scriptId != -1 || m_calls.isEmpty()) {
+        return;
+    }
+    const Call call = m_calls.takeLast();
+    if (call.function.isEmpty()) {
+        return;
+    }
+    --m_depth;
+    if (m_profile) {
+        m_profile->addCall(call.function, m_timer.nsecsElapsed() - call.start, m_depth > 0);
+    }
+}
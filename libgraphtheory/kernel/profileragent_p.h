@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILERAGENT_P_H
+#define PROFILERAGENT_P_H
+
+#include <QElapsedTimer>
+#include <QScriptEngineAgent>
+#include <QString>
+#include <QVector>
+
+namespace GraphTheory
+{
+class KernelProfile;
+
+/**
+ * \class ProfilerAgent
+ *
+ * Engine agent that measures all calls of invokable methods of QObjects. The engine reports
+ * entry and exit of every native function, those of QObjects are identified by their context.
+ */
+class ProfilerAgent : public QScriptEngineAgent
+{
+public:
+    explicit ProfilerAgent(QScriptEngine *engine);
+
+    /**
+     * Record all following calls into @p profile, or stop recording if @p profile is null.
+     */
+    void start(KernelProfile *profile);
+
+    void functionEntry(qint64 scriptId) Q_DECL_OVERRIDE;
+    void functionExit(qint64 scriptId, const QScriptValue &returnValue) Q_DECL_OVERRIDE;
+
+private:
+    struct Call {
+        QString function;
+        qint64 start;
+    };
+    KernelProfile *m_profile;
+    QVector<Call> m_calls;
+    int m_depth;
+    QElapsedTimer m_timer;
+};
+}
+
+#endif
@@ -21,6 +21,9 @@
 #include "edgemodel.h"
 #include "edge.h"
 #include "graphdocument.h"
+#include "edgetypestyle.h"
+#include "nodetype.h"
+#include "nodetypestyle.h"
 
 #include <KLocalizedString>
 #include <QSignalMapper>
@@ -32,6 +35,8 @@ class GraphTheory::EdgeModelPrivate {
 public:
     EdgeModelPrivate()
         : m_signalMapper(new QSignalMapper)
+        , m_rowCount(0)
+        , m_removedFirst(0)
     {
     }
 
@@ -40,16 +45,39 @@ public:
         m_signalMapper->deleteLater();
     }
 
-    void updateMappings()
+    /** map change signals of all edges from row @p first on to their rows **/
+    void updateMappings(int first)
     {
-        int edges = m_document->edges().count();
-        for (int i = 0; i < edges; i++) {
-            m_signalMapper->setMapping(m_document->edges().at(i).data(), i);
+        const EdgeList edges = m_document->edges();
+        for (int i = first; i < edges.count(); i++) {
+            updateMapping(edges.at(i).data(), i);
+        }
+    }
+
+    /** map change signals of @p edge to @p row **/
+    void updateMapping(Edge *edge, int row)
+    {
+        m_signalMapper->setMapping(edge, row);
+        QObject::connect(edge, &Edge::typeChanged, m_signalMapper,
+            static_cast<void (QSignalMapper::*)()>(&QSignalMapper::map), Qt::UniqueConnection);
+        QObject::connect(edge, &Edge::dynamicPropertyChanged, m_signalMapper,
+            static_cast<void (QSignalMapper::*)()>(&QSignalMapper::map), Qt::UniqueConnection);
+    }
+
+    /** stop mapping change signals of the edges in rows @p first to @p last **/
+    void removeMappings(int first, int last)
+    {
+        const EdgeList edges = m_document->edges();
+        for (int i = first; i <= last; i++) {
+            edges.at(i)->disconnect(m_signalMapper);
+            m_signalMapper->removeMappings(edges.at(i).data());
         }
     }
 
     GraphDocumentPtr m_document;
     QSignalMapper *m_signalMapper;
+    int m_rowCount; // rows announced to views, lags behind the document during bulk updates
+    int m_removedFirst; // first row of the ongoing removal
 };
 
 EdgeModel::EdgeModel(QObject *parent)
@@ -70,6 +98,10 @@ QHash< int, QByteArray > EdgeModel::roleNames() const
     QHash<int, QByteArray> roles;
     roles[IdRole] = "id";
     roles[DataRole] = "dataRole";
+    roles[TypeColorRole] = "typeColor";
+    roles[TypeVisibleRole] = "typeVisible";
+    roles[DirectionRole] = "direction";
+    roles[PropertiesRole] = "properties";
 
     return roles;
 }
@@ -83,8 +115,20 @@ void EdgeModel::setDocument(GraphDocumentPtr document)
     beginResetModel();
     if (d->m_document) {
         d->m_document.data()->disconnect(this);
+        foreach (EdgeTypePtr type, d->m_document->edgeTypes()) {
+            type->disconnect(this);
+            type->style()->disconnect(this);
+        }
+        foreach (NodeTypePtr type, d->m_document->nodeTypes()) {
+            type->style()->disconnect(this);
+        }
+        foreach (EdgePtr edge, d->m_document->edges()) {
+            edge->disconnect(d->m_signalMapper);
+            d->m_signalMapper->removeMappings(edge.data());
+        }
     }
     d->m_document = document;
+    d->m_rowCount = document ? document->edges().count() : 0;
     if (d->m_document) {
         connect(d->m_document.data(), &GraphDocument::edgeAboutToBeAdded,
             this, &EdgeModel::onEdgeAboutToBeAdded);
@@ -94,6 +138,23 @@ void EdgeModel::setDocument(GraphDocumentPtr document)
             this, &EdgeModel::onEdgesAboutToBeRemoved);
         connect(d->m_document.data(), &GraphDocument::edgesRemoved,
             this, &EdgeModel::onEdgesRemoved);
+        connect(d->m_document.data(), &GraphDocument::edgesAdded,
+            this, &EdgeModel::onEdgesAdded);
+        connect(d->m_document.data(), &GraphDocument::edgesReset,
+            this, &EdgeModel::onEdgesReset);
+        connect(d->m_document.data(), &GraphDocument::edgeReplaced,
+            this, &EdgeModel::onEdgeReplaced);
+        connect(d->m_document.data(), &GraphDocument::edgeTypeAdded,
+            this, &EdgeModel::onEdgeTypeAdded);
+        connect(d->m_document.data(), &GraphDocument::nodeTypeAdded,
+            this, &EdgeModel::onNodeTypeAdded);
+        foreach (EdgeTypePtr type, d->m_document->edgeTypes()) {
+            connectType(type);
+        }
+        foreach (NodeTypePtr type, d->m_document->nodeTypes()) {
+            connectType(type);
+        }
+        d->updateMappings(0);
     }
     endResetModel();
 }
@@ -116,6 +177,26 @@ QVariant EdgeModel::data(const QModelIndex &index, int role) const
     {
     case DataRole:
         return QVariant::fromValue<QObject*>(edge.data());
+    case TypeColorRole:
+        return edge->type()->style()->color();
+    case TypeVisibleRole:
+        return edge->type()->style()->isVisible()
+            && edge->from()->type()->style()->isVisible()
+            && edge->to()->type()->style()->isVisible();
+    case DirectionRole:
+        return edge->type()->direction();
+    case PropertiesRole: {
+        QVariantList properties;
+        const bool visibility = edge->type()->style()->isPropertyNamesVisible();
+        foreach (const QString &name, edge->dynamicProperties()) {
+            QVariantMap property;
+            property.insert(QStringLiteral("name"), name);
+            property.insert(QStringLiteral("value"), edge->dynamicProperty(name));
+            property.insert(QStringLiteral("visibility"), visibility);
+            properties.append(property);
+        }
+        return properties;
+    }
     default:
         return QVariant();
     }
@@ -131,7 +212,7 @@ int EdgeModel::rowCount(const QModelIndex &parent) const
         return 0;
     }
 
-    return d->m_document->edges().count();
+    return d->m_rowCount;
 }
 
 void EdgeModel::onEdgeAboutToBeAdded(EdgePtr edge, int index)
@@ -142,26 +223,124 @@ void EdgeModel::onEdgeAboutToBeAdded(EdgePtr edge, int index)
 
 void EdgeModel::onEdgeAdded()
 {
-    d->updateMappings();
+    d->updateMappings(d->m_rowCount);
+    d->m_rowCount = d->m_document->edges().count();
     endInsertRows();
 }
 
 void EdgeModel::onEdgesAboutToBeRemoved(int first, int last)
 {
     beginRemoveRows(QModelIndex(), first, last);
+    d->removeMappings(first, last);
+    d->m_removedFirst = first;
 }
 
 void EdgeModel::onEdgesRemoved()
 {
+    d->m_rowCount = d->m_document->edges().count();
+    d->updateMappings(d->m_removedFirst);
     endRemoveRows();
 }
 
+void EdgeModel::onEdgesAdded(int first, int last)
+{
+    // the edges were appended by a bulk update, the model announces them now; its row count
+    // has not been updated since the bulk update started, thus it equals @p first
+    Q_UNUSED(first);
+    if (last < d->m_rowCount) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), d->m_rowCount, last);
+    d->updateMappings(d->m_rowCount);
+    d->m_rowCount = last + 1;
+    endInsertRows();
+}
+
+void EdgeModel::onEdgesReset()
+{
+    beginResetModel();
+    d->m_rowCount = d->m_document->edges().count();
+    d->updateMappings(0);
+    endResetModel();
+}
+
+void EdgeModel::onEdgeReplaced(int index)
+{
+    // only the moved edge changed its row, remapping all following rows would make removals linear
+    d->updateMapping(d->m_document->edges().at(index).data(), index);
+    emitEdgeChanged(index);
+}
+
 void EdgeModel::emitEdgeChanged(int row)
 {
+    if (row >= d->m_rowCount) {
+        return; // not yet announced during a bulk update
+    }
     emit edgeChanged(row);
     emit dataChanged(index(row, 0), index(row, 0));
 }
 
+void EdgeModel::onEdgeTypeAdded()
+{
+    connectType(d->m_document->edgeTypes().last());
+}
+
+void EdgeModel::onNodeTypeAdded()
+{
+    connectType(d->m_document->nodeTypes().last());
+}
+
+void EdgeModel::connectType(EdgeTypePtr type)
+{
+    const QObject *key = type.data();
+    connect(type->style(), &EdgeTypeStyle::changed, this, [=] () {
+        emitTypeChanged(key, {TypeColorRole, TypeVisibleRole, PropertiesRole});
+    });
+    connect(type.data(), &EdgeType::directionChanged, this, [=] () {
+        emitTypeChanged(key, {DirectionRole});
+    });
+    connect(type.data(), &EdgeType::dynamicPropertyAdded, this, [=] () {
+        emitTypeChanged(key, {PropertiesRole});
+    });
+    connect(type.data(), &EdgeType::dynamicPropertyRemoved, this, [=] () {
+        emitTypeChanged(key, {PropertiesRole});
+    });
+    connect(type.data(), &EdgeType::dynamicPropertyRenamed, this, [=] () {
+        emitTypeChanged(key, {PropertiesRole});
+    });
+}
+
+void EdgeModel::connectType(NodeTypePtr type)
+{
+    const QObject *key = type.data();
+    connect(type->style(), &NodeTypeStyle::visibilityChanged, this, [=] () {
+        emitTypeChanged(key, {TypeVisibleRole});
+    });
+}
+
+void EdgeModel::emitTypeChanged(const QObject *type, const QVector<int> &roles)
+{
+    const EdgeList edges = d->m_document->edges();
+    // during bulk updates the row count lags behind the document, which may have fewer elements
+    const int rowCount = qMin(d->m_rowCount, edges.count());
+    int first = -1;
+    for (int row = 0; row <= rowCount; ++row) {
+        bool affected = false;
+        if (row < rowCount) {
+            const EdgePtr edge = edges.at(row);
+            affected = edge->type().data() == type
+                || edge->from()->type().data() == type
+                || edge->to()->type().data() == type;
+        }
+        if (affected && first < 0) {
+            first = row;
+        } else if (!affected && first >= 0) {
+            emit dataChanged(index(first, 0), index(row - 1, 0), roles);
+            first = -1;
+        }
+    }
+}
+
 QVariant EdgeModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
     if (role != Qt::DisplayRole) {
@@ -40,7 +40,11 @@ class GRAPHTHEORY_EXPORT EdgeModel : public QAbstractListModel
 public:
     enum EdgeRoles {
         IdRole = Qt::UserRole + 1,      //!< unique identifier of node
-        DataRole                        //!< access to Edge object
+        DataRole,                       //!< access to Edge object
+        TypeColorRole,                  //!< color of the edge type style
+        TypeVisibleRole,                //!< visibility of the edge type style and of both end points
+        DirectionRole,                  //!< direction of the edge type
+        PropertiesRole                  //!< list of name, value and visibility of all dynamic properties
     };
 
     explicit EdgeModel(QObject *parent = 0);
@@ -62,10 +66,28 @@ private Q_SLOTS:
     void onEdgeAdded();
     void onEdgesAboutToBeRemoved(int first, int last);
     void onEdgesRemoved();
+    void onEdgesAdded(int first, int last);
+    void onEdgesReset();
+    void onEdgeReplaced(int index);
     void emitEdgeChanged(int row);
+    void onEdgeTypeAdded();
+    void onNodeTypeAdded();
 
 private:
     Q_DISABLE_COPY(EdgeModel)
+    /**
+     * Subscribe to the changes of @p type that affect all of its edges.
+     */
+    void connectType(EdgeTypePtr type);
+    /**
+     * Subscribe to the changes of @p type that affect all edges at nodes of this type.
+     */
+    void connectType(NodeTypePtr type);
+    /**
+     * Emit dataChanged() for @p roles of all rows whose edge or one of its end points is of
+     * type @p type, with one signal per consecutive range of rows.
+     */
+    void emitTypeChanged(const QObject *type, const QVector<int> &roles);
     const QScopedPointer<EdgeModelPrivate> d;
 };
 }
@@ -20,6 +20,7 @@
 
 #include "edgepropertymodel.h"
 #include "edge.h"
+#include "edgetype.h"
 #include "edgetypestyle.h"
 #include <KLocalizedString>
 #include <QDebug>
@@ -38,7 +39,7 @@ public:
     }
 
     EdgePtr m_edge;
-
+    EdgeTypePtr m_type; // type whose signals are connected
 };
 
 EdgePropertyModel::EdgePropertyModel(QObject *parent)
@@ -73,23 +74,19 @@ void EdgePropertyModel::setEdge(Edge *edge)
     if (d->m_edge) {
         d->m_edge.data()->disconnect(this);
     }
+    if (d->m_type) {
+        d->m_type->disconnect(this);
+        d->m_type->style()->disconnect(this);
+        d->m_type.reset();
+    }
     d->m_edge = edge->self();
     if (d->m_edge) {
-        connect(d->m_edge.data(), &Edge::dynamicPropertyAboutToBeAdded,
-            this, &EdgePropertyModel::onDynamicPropertyAboutToBeAdded);
-        connect(d->m_edge.data(), &Edge::dynamicPropertyAdded,
-            this, &EdgePropertyModel::onDynamicPropertyAdded);
-        connect(d->m_edge.data(), &Edge::dynamicPropertiesAboutToBeRemoved,
-            this, &EdgePropertyModel::onDynamicPropertiesAboutToBeRemoved);
-        connect(d->m_edge.data(), &Edge::dynamicPropertyRemoved,
-            this, &EdgePropertyModel::onDynamicPropertyRemoved);
         connect(d->m_edge.data(), &Edge::dynamicPropertyChanged,
             this, &EdgePropertyModel::onDynamicPropertyChanged);
-        connect(d->m_edge.data(), &Edge::styleChanged,[=]() {
-            QVector<int> changedRoles;
-            changedRoles.append(VisibilityRole);
-            emit dataChanged(index(0), index(d->m_edge->dynamicProperties().count() - 1), changedRoles);
-        } );
+        connect(d->m_edge.data(), &Edge::typeChanged,
+            this, &EdgePropertyModel::onTypeChanged);
+        d->m_type = d->m_edge->type();
+        connectType();
     }
     endResetModel();
     emit edgeChanged();
@@ -166,6 +163,36 @@ void EdgePropertyModel::onDynamicPropertyChanged(int row)
     emit dataChanged(index(row, 0), index(row, 0));
 }
 
+void EdgePropertyModel::onTypeChanged(EdgeTypePtr type)
+{
+    beginResetModel();
+    d->m_type->disconnect(this);
+    d->m_type->style()->disconnect(this);
+    d->m_type = type;
+    connectType();
+    endResetModel();
+}
+
+void EdgePropertyModel::connectType()
+{
+    // the type notifies about changes of the property list, which apply to all its edges
+    connect(d->m_type.data(), &EdgeType::dynamicPropertyAboutToBeAdded,
+        this, &EdgePropertyModel::onDynamicPropertyAboutToBeAdded);
+    connect(d->m_type.data(), &EdgeType::dynamicPropertyAdded,
+        this, &EdgePropertyModel::onDynamicPropertyAdded);
+    connect(d->m_type.data(), &EdgeType::dynamicPropertiesAboutToBeRemoved,
+        this, &EdgePropertyModel::onDynamicPropertiesAboutToBeRemoved);
+    connect(d->m_type.data(), &EdgeType::dynamicPropertyRemoved,
+        this, &EdgePropertyModel::onDynamicPropertyRemoved);
+    connect(d->m_type.data(), &EdgeType::dynamicPropertyChanged,
+        this, &EdgePropertyModel::onDynamicPropertyChanged);
+    connect(d->m_type->style(), &EdgeTypeStyle::changed, this, [=] () {
+        QVector<int> changedRoles;
+        changedRoles.append(VisibilityRole);
+        emit dataChanged(index(0), index(d->m_edge->dynamicProperties().count() - 1), changedRoles);
+    });
+}
+
 QVariant EdgePropertyModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
     if (role != Qt::DisplayRole) {
@@ -66,9 +66,14 @@ private Q_SLOTS:
     void onDynamicPropertiesAboutToBeRemoved(int first, int last);
     void onDynamicPropertyRemoved();
     void onDynamicPropertyChanged(int row);
+    void onTypeChanged(EdgeTypePtr type);
 
 private:
     Q_DISABLE_COPY(EdgePropertyModel)
+    /**
+     * Subscribe to the property list and style changes of the type of the edge.
+     */
+    void connectType();
     const QScopedPointer<EdgePropertyModelPrivate> d;
 };
 }
@@ -20,6 +20,8 @@
 
 #include "nodemodel.h"
 #include "graphdocument.h"
+#include "nodetype.h"
+#include "nodetypestyle.h"
 
 #include <KLocalizedString>
 #include <QSignalMapper>
@@ -30,6 +32,8 @@ class GraphTheory::NodeModelPrivate {
 public:
     NodeModelPrivate()
         : m_signalMapper(new QSignalMapper)
+        , m_rowCount(0)
+        , m_removedFirst(0)
     {
     }
 
@@ -38,16 +42,39 @@ public:
         m_signalMapper->deleteLater();
     }
 
-    void updateMappings()
+    /** map change signals of all nodes from row @p first on to their rows **/
+    void updateMappings(int first)
     {
-        int nodes = m_document->nodes().count();
-        for (int i = 0; i < nodes; i++) {
-            m_signalMapper->setMapping(m_document->nodes().at(i).data(), i);
+        const NodeList nodes = m_document->nodes();
+        for (int i = first; i < nodes.count(); i++) {
+            updateMapping(nodes.at(i).data(), i);
+        }
+    }
+
+    /** map change signals of @p node to @p row **/
+    void updateMapping(Node *node, int row)
+    {
+        m_signalMapper->setMapping(node, row);
+        QObject::connect(node, &Node::typeChanged, m_signalMapper,
+            static_cast<void (QSignalMapper::*)()>(&QSignalMapper::map), Qt::UniqueConnection);
+        QObject::connect(node, &Node::dynamicPropertyChanged, m_signalMapper,
+            static_cast<void (QSignalMapper::*)()>(&QSignalMapper::map), Qt::UniqueConnection);
+    }
+
+    /** stop mapping change signals of the nodes in rows @p first to @p last **/
+    void removeMappings(int first, int last)
+    {
+        const NodeList nodes = m_document->nodes();
+        for (int i = first; i <= last; i++) {
+            nodes.at(i)->disconnect(m_signalMapper);
+            m_signalMapper->removeMappings(nodes.at(i).data());
         }
     }
 
     GraphDocumentPtr m_document;
     QSignalMapper *m_signalMapper;
+    int m_rowCount; // rows announced to views, lags behind the document during bulk updates
+    int m_removedFirst; // first row of the ongoing removal
 };
 
 NodeModel::NodeModel(QObject *parent)
@@ -67,6 +94,9 @@ QHash< int, QByteArray > NodeModel::roleNames() const
     QHash<int, QByteArray> roles;
     roles[IdRole] = "id";
     roles[DataRole] = "dataRole";
+    roles[TypeColorRole] = "typeColor";
+    roles[TypeVisibleRole] = "typeVisible";
+    roles[PropertiesRole] = "properties";
 
     return roles;
 }
@@ -80,13 +110,30 @@ void NodeModel::setDocument(GraphDocumentPtr document)
     beginResetModel();
     if (d->m_document) {
         d->m_document.data()->disconnect(this);
+        foreach (NodeTypePtr type, d->m_document->nodeTypes()) {
+            type->disconnect(this);
+            type->style()->disconnect(this);
+        }
+        foreach (NodePtr node, d->m_document->nodes()) {
+            node->disconnect(d->m_signalMapper);
+            d->m_signalMapper->removeMappings(node.data());
+        }
     }
     d->m_document = document;
+    d->m_rowCount = document ? document->nodes().count() : 0;
     if (d->m_document) {
         connect(d->m_document.data(), &GraphDocument::nodeAboutToBeAdded, this, &NodeModel::onNodeAboutToBeAdded);
         connect(d->m_document.data(), &GraphDocument::nodeAdded, this, &NodeModel::onNodeAdded);
         connect(d->m_document.data(), &GraphDocument::nodesAboutToBeRemoved, this, &NodeModel::onNodesAboutToBeRemoved);
         connect(d->m_document.data(), &GraphDocument::nodesRemoved, this, &NodeModel::onNodesRemoved);
+        connect(d->m_document.data(), &GraphDocument::nodesAdded, this, &NodeModel::onNodesAdded);
+        connect(d->m_document.data(), &GraphDocument::nodesReset, this, &NodeModel::onNodesReset);
+        connect(d->m_document.data(), &GraphDocument::nodeReplaced, this, &NodeModel::onNodeReplaced);
+        connect(d->m_document.data(), &GraphDocument::nodeTypeAdded, this, &NodeModel::onNodeTypeAdded);
+        foreach (NodeTypePtr type, d->m_document->nodeTypes()) {
+            connectType(type);
+        }
+        d->updateMappings(0);
     }
     endResetModel();
 }
@@ -111,6 +158,22 @@ QVariant NodeModel::data(const QModelIndex &index, int role) const
         return node->id();
     case DataRole:
         return QVariant::fromValue<QObject*>(node.data());
+    case TypeColorRole:
+        return node->type()->style()->color();
+    case TypeVisibleRole:
+        return node->type()->style()->isVisible();
+    case PropertiesRole: {
+        QVariantList properties;
+        const bool visibility = node->type()->style()->isPropertyNamesVisible();
+        foreach (const QString &name, node->dynamicProperties()) {
+            QVariantMap property;
+            property.insert(QStringLiteral("name"), name);
+            property.insert(QStringLiteral("value"), node->dynamicProperty(name));
+            property.insert(QStringLiteral("visibility"), visibility);
+            properties.append(property);
+        }
+        return properties;
+    }
     default:
         return QVariant();
     }
@@ -126,7 +189,7 @@ int NodeModel::rowCount(const QModelIndex &parent) const
         return 0;
     }
 
-    return d->m_document->nodes().count();
+    return d->m_rowCount;
 }
 
 void NodeModel::onNodeAboutToBeAdded(NodePtr node, int index)
@@ -137,26 +200,102 @@ void NodeModel::onNodeAboutToBeAdded(NodePtr node, int index)
 
 void NodeModel::onNodeAdded()
 {
-    d->updateMappings();
+    d->updateMappings(d->m_rowCount);
+    d->m_rowCount = d->m_document->nodes().count();
     endInsertRows();
 }
 
 void NodeModel::onNodesAboutToBeRemoved(int first, int last)
 {
     beginRemoveRows(QModelIndex(), first, last);
+    d->removeMappings(first, last);
+    d->m_removedFirst = first;
 }
 
 void NodeModel::onNodesRemoved()
 {
+    d->m_rowCount = d->m_document->nodes().count();
+    d->updateMappings(d->m_removedFirst);
     endRemoveRows();
 }
 
+void NodeModel::onNodesAdded(int first, int last)
+{
+    // the nodes were appended by a bulk update, the model announces them now; its row count
+    // has not been updated since the bulk update started, thus it equals @p first
+    Q_UNUSED(first);
+    if (last < d->m_rowCount) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), d->m_rowCount, last);
+    d->updateMappings(d->m_rowCount);
+    d->m_rowCount = last + 1;
+    endInsertRows();
+}
+
+void NodeModel::onNodesReset()
+{
+    beginResetModel();
+    d->m_rowCount = d->m_document->nodes().count();
+    d->updateMappings(0);
+    endResetModel();
+}
+
+void NodeModel::onNodeReplaced(int index)
+{
+    // only the moved node changed its row, remapping all following rows would make removals linear
+    d->updateMapping(d->m_document->nodes().at(index).data(), index);
+    emitNodeChanged(index);
+}
+
 void NodeModel::emitNodeChanged(int row)
 {
+    if (row >= d->m_rowCount) {
+        return; // not yet announced during a bulk update
+    }
     emit nodeChanged(row);
     emit dataChanged(index(row, 0), index(row, 0));
 }
 
+void NodeModel::onNodeTypeAdded()
+{
+    connectType(d->m_document->nodeTypes().last());
+}
+
+void NodeModel::connectType(NodeTypePtr type)
+{
+    const NodeType *key = type.data();
+    connect(type->style(), &NodeTypeStyle::changed, this, [=] () {
+        emitTypeChanged(key, {TypeColorRole, TypeVisibleRole, PropertiesRole});
+    });
+    connect(type.data(), &NodeType::dynamicPropertyAdded, this, [=] () {
+        emitTypeChanged(key, {PropertiesRole});
+    });
+    connect(type.data(), &NodeType::dynamicPropertyRemoved, this, [=] () {
+        emitTypeChanged(key, {PropertiesRole});
+    });
+    connect(type.data(), &NodeType::dynamicPropertyRenamed, this, [=] () {
+        emitTypeChanged(key, {PropertiesRole});
+    });
+}
+
+void NodeModel::emitTypeChanged(const NodeType *type, const QVector<int> &roles)
+{
+    const NodeList nodes = d->m_document->nodes();
+    // during bulk updates the row count lags behind the document, which may have fewer elements
+    const int rowCount = qMin(d->m_rowCount, nodes.count());
+    int first = -1;
+    for (int row = 0; row <= rowCount; ++row) {
+        const bool affected = row < rowCount && nodes.at(row)->type().data() == type;
+        if (affected && first < 0) {
+            first = row;
+        } else if (!affected && first >= 0) {
+            emit dataChanged(index(first, 0), index(row - 1, 0), roles);
+            first = -1;
+        }
+    }
+}
+
 QVariant NodeModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
     if (role != Qt::DisplayRole) {
@@ -41,7 +41,10 @@ class GRAPHTHEORY_EXPORT NodeModel : public QAbstractListModel
 public:
     enum NodeRoles {
         IdRole = Qt::UserRole + 1,      //!< unique identifier of node
-        DataRole                        //!< access to Node object
+        DataRole,                       //!< access to Node object
+        TypeColorRole,                  //!< color of the node type style
+        TypeVisibleRole,                //!< visibility of the node type style
+        PropertiesRole                  //!< list of name, value and visibility of all dynamic properties
     };
 
     explicit NodeModel(QObject *parent = 0);
@@ -63,10 +66,23 @@ private Q_SLOTS:
     void onNodeAdded();
     void onNodesAboutToBeRemoved(int first, int last);
     void onNodesRemoved();
+    void onNodesAdded(int first, int last);
+    void onNodesReset();
+    void onNodeReplaced(int index);
     void emitNodeChanged(int row);
+    void onNodeTypeAdded();
 
 private:
     Q_DISABLE_COPY(NodeModel)
+    /**
+     * Subscribe to the changes of @p type that affect all of its nodes.
+     */
+    void connectType(NodeTypePtr type);
+    /**
+     * Emit dataChanged() for @p roles of all rows whose node is of type @p type, with one
+     * signal per consecutive range of rows.
+     */
+    void emitTypeChanged(const NodeType *type, const QVector<int> &roles);
     const QScopedPointer<NodeModelPrivate> d;
 };
 }
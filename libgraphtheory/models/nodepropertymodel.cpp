@@ -20,6 +20,7 @@
 
 #include "nodepropertymodel.h"
 #include "node.h"
+#include "nodetype.h"
 #include "nodetypestyle.h"
 #include <KLocalizedString>
 #include <QDebug>
@@ -38,7 +39,7 @@ public:
     }
 
     NodePtr m_node;
-
+    NodeTypePtr m_type; // type whose signals are connected
 };
 
 NodePropertyModel::NodePropertyModel(QObject *parent)
@@ -73,23 +74,19 @@ void NodePropertyModel::setNode(Node* node)
     if (d->m_node) {
         d->m_node.data()->disconnect(this);
     }
+    if (d->m_type) {
+        d->m_type->disconnect(this);
+        d->m_type->style()->disconnect(this);
+        d->m_type.reset();
+    }
     d->m_node = node->self();
     if (d->m_node) {
-        connect(d->m_node.data(), &Node::dynamicPropertyAboutToBeAdded,
-            this, &NodePropertyModel::onDynamicPropertyAboutToBeAdded);
-        connect(d->m_node.data(), &Node::dynamicPropertyAdded,
-            this, &NodePropertyModel::onDynamicPropertyAdded);
-        connect(d->m_node.data(), &Node::dynamicPropertiesAboutToBeRemoved,
-            this, &NodePropertyModel::onDynamicPropertiesAboutToBeRemoved);
-        connect(d->m_node.data(), &Node::dynamicPropertyRemoved,
-            this, &NodePropertyModel::onDynamicPropertyRemoved);
         connect(d->m_node.data(), &Node::dynamicPropertyChanged,
             this, &NodePropertyModel::onDynamicPropertyChanged);
-        connect(d->m_node.data(), &Node::styleChanged,[=]() {
-            QVector<int> changedRoles;
-            changedRoles.append(VisibilityRole);
-            emit dataChanged(index(0), index(d->m_node->dynamicProperties().count() - 1), changedRoles);
-        } );
+        connect(d->m_node.data(), &Node::typeChanged,
+            this, &NodePropertyModel::onTypeChanged);
+        d->m_type = d->m_node->type();
+        connectType();
     }
     endResetModel();
     emit nodeChanged();
@@ -166,6 +163,36 @@ void NodePropertyModel::onDynamicPropertyChanged(int row)
     emit dataChanged(index(row, 0), index(row, 0));
 }
 
+void NodePropertyModel::onTypeChanged(NodeTypePtr type)
+{
+    beginResetModel();
+    d->m_type->disconnect(this);
+    d->m_type->style()->disconnect(this);
+    d->m_type = type;
+    connectType();
+    endResetModel();
+}
+
+void NodePropertyModel::connectType()
+{
+    // the type notifies about changes of the property list, which apply to all its nodes
+    connect(d->m_type.data(), &NodeType::dynamicPropertyAboutToBeAdded,
+        this, &NodePropertyModel::onDynamicPropertyAboutToBeAdded);
+    connect(d->m_type.data(), &NodeType::dynamicPropertyAdded,
+        this, &NodePropertyModel::onDynamicPropertyAdded);
+    connect(d->m_type.data(), &NodeType::dynamicPropertiesAboutToBeRemoved,
+        this, &NodePropertyModel::onDynamicPropertiesAboutToBeRemoved);
+    connect(d->m_type.data(), &NodeType::dynamicPropertyRemoved,
+        this, &NodePropertyModel::onDynamicPropertyRemoved);
+    connect(d->m_type.data(), &NodeType::dynamicPropertyChanged,
+        this, &NodePropertyModel::onDynamicPropertyChanged);
+    connect(d->m_type->style(), &NodeTypeStyle::changed, this, [=] () {
+        QVector<int> changedRoles;
+        changedRoles.append(VisibilityRole);
+        emit dataChanged(index(0), index(d->m_node->dynamicProperties().count() - 1), changedRoles);
+    });
+}
+
 QVariant NodePropertyModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
     if (role != Qt::DisplayRole) {
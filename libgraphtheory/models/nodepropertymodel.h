@@ -66,9 +66,14 @@ private Q_SLOTS:
     void onDynamicPropertiesAboutToBeRemoved(int first, int last);
     void onDynamicPropertyRemoved();
     void onDynamicPropertyChanged(int row);
+    void onTypeChanged(NodeTypePtr type);
 
 private:
     Q_DISABLE_COPY(NodePropertyModel)
+    /**
+     * Subscribe to the property list and style changes of the type of the node.
+     */
+    void connectType();
     const QScopedPointer<NodePropertyModelPrivate> d;
 };
 }
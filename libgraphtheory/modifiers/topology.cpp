@@ -21,6 +21,7 @@
 #include "topology.h"
 #include "graphdocument.h"
 #include "edge.h"
+#include "graphsnapshot.h"
 #include "logging_p.h"
 
 #include <QList>
@@ -56,6 +57,34 @@ namespace boost {
     }
 }
 
+namespace
+{
+// edges between @p nodes as pairs of positions in @p nodes, edges to other nodes are skipped
+QVector<BoostEdge> boostEdges(const NodeList &nodes)
+{
+    const GraphSnapshot snapshot(nodes.first()->document());
+    QVector<int> positions(snapshot.nodeCount(), -1);
+    for (int i = 0; i < nodes.count(); ++i) {
+        const int index = snapshot.nodeIndex(nodes.at(i));
+        if (index >= 0) {
+            positions[index] = i;
+        }
+    }
+    const QVector<int> &sources = snapshot.edgeSources();
+    const QVector<int> &targets = snapshot.edgeTargets();
+    QVector<BoostEdge> edges;
+    edges.reserve(snapshot.edgeCount());
+    for (int e = 0; e < snapshot.edgeCount(); ++e) {
+        const int from = positions.at(sources.at(e));
+        const int to = positions.at(targets.at(e));
+        if (from >= 0 && to >= 0) {
+            edges.append(BoostEdge(from, to));
+        }
+    }
+    return edges;
+}
+}
+
 Topology::Topology()
 {
 
@@ -94,20 +123,8 @@ void Topology::applyMinCutTreeAlignment(NodeList nodes)
 
     topology_type topology(xList.first(), yList.first(), xList.last(), yList.last());
 
-    // create IDs for all nodes
-    QMap<NodePtr, int> node_mapping;
-    QMap<QPair<int, int>, EdgePtr > edge_mapping; // to map all edges back afterwards
-    int counter = 0;
-    foreach(NodePtr node, nodes) {
-        node_mapping[node] = counter++;
-    }
-
-    QVector<BoostEdge> edges(nodes.first()->document()->edges().count());
-
-    counter = 0;
-    foreach(EdgePtr edge, nodes.first()->document()->edges()) {
-        edges[counter++] = BoostEdge(node_mapping[edge->from()], node_mapping[edge->to()]);
-    }
+    // nodes are identified by their positions in the list
+    const QVector<BoostEdge> edges = boostEdges(nodes);
 
     // setup the graph
     Graph graph(
@@ -117,7 +134,7 @@ void Topology::applyMinCutTreeAlignment(NodeList nodes)
     );
 
     PositionMap positionMap(position_vec.begin(), get(boost::vertex_index, graph));
-    counter = 0;
+    int counter = 0;
     foreach(NodePtr node, nodes) {
         positionMap[counter][0] = node->x();
         positionMap[counter][1] = node->y();
@@ -133,10 +150,10 @@ void Topology::applyMinCutTreeAlignment(NodeList nodes)
     );
 
     // put nodes at whiteboard as generated
-    foreach(NodePtr node, nodes) {
-        Vertex v = boost::vertex(node_mapping[node], graph);
-        node->setX(positionMap[v][0]);
-        node->setY(positionMap[v][1]);
+    for (int i = 0; i < nodes.count(); ++i) {
+        Vertex v = boost::vertex(i, graph);
+        nodes.at(i)->setX(positionMap[v][0]);
+        nodes.at(i)->setY(positionMap[v][1]);
     }
 }
 
@@ -162,20 +179,8 @@ void Topology::applyCircleAlignment(NodeList nodes, qreal radius)
         radius = fmax(fabs(xList.first() - xList.last()), fabs(yList.first() - yList.last())) / 2;
     }
 
-    // create IDs for all nodes
-    QMap<NodePtr, int> node_mapping;
-    QMap<QPair<int, int>, EdgePtr > edge_mapping; // to map all edges back afterwards
-    int counter = 0;
-    foreach(NodePtr node, nodes) {
-        node_mapping[node] = counter++;
-    }
-
-    QVector<BoostEdge> edges(nodes.first()->document()->edges().count());
-
-    counter = 0;
-    foreach(EdgePtr edge, nodes.first()->document()->edges()) {
-        edges[counter++] = BoostEdge(node_mapping[edge->from()], node_mapping[edge->to()]);
-    }
+    // nodes are identified by their positions in the list
+    const QVector<BoostEdge> edges = boostEdges(nodes);
 
     // setup the graph
     Graph graph(
@@ -185,7 +190,7 @@ void Topology::applyCircleAlignment(NodeList nodes, qreal radius)
     );
 
     PositionMap positionMap(position_vec.begin(), get(boost::vertex_index, graph));
-    counter = 0;
+    int counter = 0;
     foreach(NodePtr node, nodes) {
         positionMap[counter][0] = node->x();
         positionMap[counter][1] = node->y();
@@ -198,10 +203,10 @@ void Topology::applyCircleAlignment(NodeList nodes, qreal radius)
                                                     radius);
 
     // put nodes at whiteboard as generated
-    foreach(NodePtr node, nodes) {
-        Vertex v = boost::vertex(node_mapping[node], graph);
-        node->setX(positionMap[v][0]);
-        node->setY(positionMap[v][1]);
+    for (int i = 0; i < nodes.count(); ++i) {
+        Vertex v = boost::vertex(i, graph);
+        nodes.at(i)->setX(positionMap[v][0]);
+        nodes.at(i)->setY(positionMap[v][1]);
     }
 }
 
@@ -21,6 +21,7 @@
 #include "valueassign.h"
 #include "node.h"
 #include "edge.h"
+#include "propertykey.h"
 #include <limits.h>
 #include <QString>
 #include <QVariant>
@@ -40,11 +41,12 @@ ValueAssign::ValueAssign()
 template<typename T>
 void ValueAssign::enumerate(const QVector<T> &list, const QString &property, int start, const QString &baseString, bool overrideValues)
 {
+    const PropertyKey key(property);
     for (int i = 0; i < list.size(); i++) {
-        if (!overrideValues && !list[i]->dynamicProperty(property).isNull()) {
+        if (!overrideValues && !list[i]->dynamicProperty(key).isNull()) {
             return;
         }
-        list[i]->setDynamicProperty(property, baseString + QString::number(start++));
+        list[i]->setDynamicProperty(key, baseString + QString::number(start++));
     }
 }
 template GRAPHTHEORY_EXPORT void ValueAssign::enumerate<NodePtr>(const QVector<NodePtr> &list, const QString &property, int start, const QString &baseString, bool overrideValues);
@@ -62,11 +64,12 @@ void ValueAssign::enumerateAlpha(const QVector< T >& list, const QString &proper
         }
     }
 
+    const PropertyKey key(property);
     for (int i = 0; i < list.size(); i++) {
-        if (!overrideValues && !list[i]->dynamicProperty(property).isNull()) {
+        if (!overrideValues && !list[i]->dynamicProperty(key).isNull()) {
             return;
         }
-        list[i]->setDynamicProperty(property, identifier);
+        list[i]->setDynamicProperty(key, identifier);
 
         // compute new identifier by lexicographical increasing
         for (int i = identifier.length()-1; i >= 0; --i) {
@@ -100,11 +103,12 @@ void ValueAssign::assignRandomIntegers(const QVector<T> &list, const QString &pr
     boost::uniform_int<> distribution(lowerLimit, upperLimit);
     boost::variate_generator<boost::mt19937&, boost::uniform_int<> > die(gen, distribution);
 
+    const PropertyKey key(property);
     for (int i = 0; i < list.size(); i++) {
-        if (!overrideValues && !list[i]->dynamicProperty(property).isNull()) {
+        if (!overrideValues && !list[i]->dynamicProperty(key).isNull()) {
             return;
         }
-        list[i]->setDynamicProperty(property, QString::number(die()));
+        list[i]->setDynamicProperty(key, QString::number(die()));
     }
 }
 template GRAPHTHEORY_EXPORT void ValueAssign::assignRandomIntegers<NodePtr>(const QVector<NodePtr> &list, const QString &property, int lowerLimit, int upperLimit, int seed, bool overrideValues);
@@ -124,11 +128,12 @@ void ValueAssign::assignRandomReals(const QVector<T> &list, const QString &prope
     boost::uniform_real<> distribution(lowerLimit, upperLimit);
     boost::variate_generator<boost::mt19937&, boost::uniform_real<> > die(gen, distribution);
 
+    const PropertyKey key(property);
     for (int i = 0; i < list.size(); i++) {
-        if (!overrideValues && !list[i]->dynamicProperty(property).isNull()) {
+        if (!overrideValues && !list[i]->dynamicProperty(key).isNull()) {
             return;
         }
-        list[i]->setDynamicProperty(property, QString::number(die()));
+        list[i]->setDynamicProperty(key, QString::number(die()));
     }
 }
 template GRAPHTHEORY_EXPORT void ValueAssign::assignRandomReals<NodePtr>(const QVector<NodePtr> &list, const QString &property, qreal lowerLimit, qreal upperLimit, int seed, bool overrideValues);
@@ -137,11 +142,12 @@ template GRAPHTHEORY_EXPORT void ValueAssign::assignRandomReals<EdgePtr>(const Q
 template<typename T>
 void ValueAssign::assignConstantValue(const QVector<T> &list, const QString &property, const QString &constant, bool overrideValues)
 {
+    const PropertyKey key(property);
     for (int i = 0; i < list.size(); i++) {
-        if (!overrideValues && !list[i]->dynamicProperty(property).isNull()) {
+        if (!overrideValues && !list[i]->dynamicProperty(key).isNull()) {
             return;
         }
-        list[i]->setDynamicProperty(property, constant);
+        list[i]->setDynamicProperty(key, constant);
     }
 }
 template GRAPHTHEORY_EXPORT void ValueAssign::assignConstantValue<NodePtr>(const QVector<NodePtr> &list, const QString &property, const QString &constant, bool overrideValues);
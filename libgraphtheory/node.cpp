@@ -23,8 +23,11 @@
 #include "nodetype.h"
 #include "edge.h"
 #include "nodetypestyle.h"
+#include "propertytable_p.h"
+#include "elementpool_p.h"
 #include "logging_p.h"
 
+#include <QHash>
 #include <QPointF>
 #include <QColor>
 
@@ -33,6 +36,9 @@ using namespace GraphTheory;
 // initialize number of edge objects
 uint Node::objectCounter = 0;
 
+// memory pool for node objects
+Q_GLOBAL_STATIC_WITH_ARGS(ElementPool, nodePool, (sizeof(Node)))
+
 class GraphTheory::NodePrivate {
 public:
     NodePrivate()
@@ -41,6 +47,8 @@ public:
         , m_y(0)
         , m_color(Qt::white)
         , m_id(-1)
+        , m_documentIndex(-1)
+        , m_propertyRow(-1)
     {
     }
 
@@ -48,34 +56,119 @@ public:
     {
     }
 
+    static void * operator new(std::size_t size);
+    static void operator delete(void *pointer, std::size_t size);
+
+    /**
+     * Incident edges of one edge type, grouped by the role of this node.
+     */
+    struct EdgeBucket {
+        EdgeList edges;     // all edges of the type
+        EdgeList outEdges;  // edges with this node as start point
+        EdgeList inEdges;   // edges with this node as end point
+    };
+
+    static void removeEdge(EdgeList &list, const EdgePtr &edge)
+    {
+        // efficient way to remove edge without having to preserve order
+        for (int i = 0; i < list.length(); ++i) {
+            if (list.at(i) == edge) {
+                list[i] = list.last();
+                list.removeLast();
+                return;
+            }
+        }
+    }
+
+    void insertIntoBucket(const EdgePtr &edge, const EdgeTypePtr &type)
+    {
+        EdgeBucket &bucket = m_buckets[type];
+        bucket.edges.append(edge);
+        if (edge->from() == q) {
+            bucket.outEdges.append(edge);
+        }
+        if (edge->to() == q) {
+            bucket.inEdges.append(edge);
+        }
+    }
+
+    void removeFromBucket(const EdgePtr &edge, const EdgeTypePtr &type)
+    {
+        auto bucket = m_buckets.find(type);
+        if (bucket == m_buckets.end()) {
+            return;
+        }
+        removeEdge(bucket->edges, edge);
+        removeEdge(bucket->outEdges, edge);
+        removeEdge(bucket->inEdges, edge);
+        if (bucket->edges.isEmpty()) {
+            m_buckets.erase(bucket);
+        }
+    }
+
     NodePtr q;
     GraphDocumentPtr m_document;
     NodeTypePtr m_type;
     EdgeList m_edges;
+    QHash<EdgeTypePtr, EdgeBucket> m_buckets; // incident edges by edge type
     bool m_valid;
     qreal m_x;
     qreal m_y;
     QColor m_color;
     int m_id;
+    int m_documentIndex;
+    int m_propertyRow; // row of the values in the property table of the type
 };
 
+Q_GLOBAL_STATIC_WITH_ARGS(ElementPool, nodePrivatePool, (sizeof(NodePrivate)))
+
+void * NodePrivate::operator new(std::size_t size)
+{
+    if (nodePrivatePool.isDestroyed()) {
+        return ::operator new(size);
+    }
+    return nodePrivatePool->allocate(size);
+}
+
+void NodePrivate::operator delete(void *pointer, std::size_t size)
+{
+    // after the pool is destroyed at shutdown, its memory is released by the system
+    if (!nodePrivatePool.isDestroyed()) {
+        nodePrivatePool->deallocate(pointer, size);
+    }
+}
+
 Node::Node()
     : QObject()
     , d(new NodePrivate)
 {
-    connect(this, &Node::dynamicPropertyAdded,
-        this, &Node::dynamicPropertiesChanged);
-    connect(this, &Node::dynamicPropertyRemoved,
-        this, &Node::dynamicPropertiesChanged);
-
     ++Node::objectCounter;
 }
 
 Node::~Node()
 {
+    if (d->m_type) {
+        d->m_type->propertyTable()->removeRow(d->m_propertyRow);
+    }
     --Node::objectCounter;
 }
 
+void * Node::operator new(std::size_t size)
+{
+    if (nodePool.isDestroyed()) {
+        return ::operator new(size);
+    }
+    return nodePool->allocate(size);
+}
+
+void Node::operator delete(void *pointer, std::size_t size)
+{
+    // after the pool is destroyed at shutdown, its memory is released by the system
+    if (!nodePool.isDestroyed()) {
+        nodePool->deallocate(pointer, size);
+    }
+}
+
 NodePtr Node::create(GraphDocumentPtr document)
 {
     NodePtr pi(new Node);
@@ -91,6 +184,24 @@ NodePtr Node::create(GraphDocumentPtr document)
     return pi;
 }
 
+NodePtr Node::clone(GraphDocumentPtr document, NodeTypePtr type) const
+{
+    NodePtr pi(new Node);
+    pi->setQpointer(pi);
+    pi->d->m_document = document;
+    pi->d->m_id = d->m_id;
+    pi->d->m_x = d->m_x;
+    pi->d->m_y = d->m_y;
+    pi->d->m_color = d->m_color;
+    // values are located at the same row of the copied property table
+    pi->d->m_type = type;
+    pi->d->m_propertyRow = d->m_propertyRow;
+    pi->d->m_valid = true;
+
+    document->insert(pi->d->q);
+    return pi;
+}
+
 NodePtr Node::self() const
 {
     return d->q;
@@ -130,27 +241,26 @@ void Node::setType(NodeTypePtr type)
     if (d->m_type == type) {
         return;
     }
-    if (d->m_type) {
-        d->m_type->disconnect(this);
-        d->m_type->style()->disconnect(this);
-    }
+    NodeTypePtr previousType = d->m_type;
     d->m_type = type;
-    connect(type.data(), &NodeType::dynamicPropertyAboutToBeAdded,
-        this, &Node::dynamicPropertyAboutToBeAdded);
-    connect(type.data(), &NodeType::dynamicPropertyAdded,
-        this, &Node::dynamicPropertyAdded);
-    connect(type.data(), &NodeType::dynamicPropertiesAboutToBeRemoved,
-        this, &Node::dynamicPropertiesAboutToBeRemoved);
-    connect(type.data(), &NodeType::dynamicPropertyRemoved,
-        this, &Node::dynamicPropertyRemoved);
-    connect(type.data(), &NodeType::dynamicPropertyRemoved,
-        this, &Node::updateDynamicProperty);
-    connect(type.data(), &NodeType::dynamicPropertyRenamed,
-        this, &Node::renameDynamicProperty);
-    connect(type->style(), &NodeTypeStyle::changed,
-        this, &Node::styleChanged);
+
+    // allocate row in property table of the new type and keep values of properties that are
+    // registered at both types
+    const int previousRow = d->m_propertyRow;
+    d->m_propertyRow = type->propertyTable()->insertRow();
+    if (previousType) {
+        const QStringList previousProperties = previousType->dynamicProperties();
+        const QStringList properties = type->dynamicProperties();
+        for (int i = 0; i < previousProperties.length(); ++i) {
+            const int column = properties.indexOf(previousProperties.at(i));
+            if (column >= 0) {
+                type->propertyTable()->setValue(column, d->m_propertyRow,
+                    previousType->propertyTable()->value(i, previousRow));
+            }
+        }
+        previousType->propertyTable()->removeRow(previousRow);
+    }
     emit typeChanged(type);
-    emit styleChanged();
 }
 
 void Node::insert(EdgePtr edge)
@@ -158,10 +268,11 @@ void Node::insert(EdgePtr edge)
     if (edge->from() != d->q && edge->to() != d->q) {
         return;
     }
-    if (d->m_edges.contains(edge)) {
+    if (edgesView(edge->type()).contains(edge)) {
         return;
     }
     d->m_edges.append(edge);
+    d->insertIntoBucket(edge, edge->type());
     emit edgeAdded(edge);
 }
 
@@ -170,70 +281,98 @@ void Node::remove(EdgePtr edge)
     if (edge && edge->isValid()) {
         edge->destroy();
     }
-    // efficient way to remove edge without having to preserve order
-    for (int i = 0; i < d->m_edges.length(); ++i) {
-        if (d->m_edges.at(i) == edge) {
-            d->m_edges[i] = d->m_edges.last();
-            d->m_edges.removeLast();
-            return;
-        }
+    const int edgeCount = d->m_edges.length();
+    NodePrivate::removeEdge(d->m_edges, edge);
+    if (d->m_edges.length() < edgeCount) {
+        d->removeFromBucket(edge, edge->type());
     }
 }
 
-EdgeList Node::edges(EdgeTypePtr type) const
+void Node::updateEdgeType(EdgePtr edge, EdgeTypePtr previousType)
 {
-    if (!type) {
-        return d->m_edges;
-    }
-    EdgeList edges;
-    foreach (EdgePtr edge, d->m_edges) {
-        if (edge->type() == type) {
-            edges.append(edge);
-        }
+    if (!d->m_buckets.contains(previousType) || !d->m_buckets[previousType].edges.contains(edge)) {
+        return;
     }
-    return edges;
+    d->removeFromBucket(edge, previousType);
+    d->insertIntoBucket(edge, edge->type());
+}
+
+EdgeList Node::edges(EdgeTypePtr type) const
+{
+    return edgesView(type);
 }
 
 EdgeList Node::inEdges(EdgeTypePtr type) const
 {
+    if (type) {
+        return inEdgesView(type);
+    }
+    if (d->m_buckets.size() == 1) {
+        return inEdgesView(d->m_buckets.constBegin().key());
+    }
     EdgeList inEdges;
-    foreach (EdgePtr edge, d->m_edges) {
-        if (type && edge->type() != type) {
-            continue;
-        }
-        if (edge->type()->direction() == EdgeType::Bidirectional) {
-            inEdges.append(edge);
-            continue;
-        }
-        if (edge->type()->direction() == EdgeType::Unidirectional
-            && edge->to() == self()
-        ) {
-            inEdges.append(edge);
-        }
+    for (auto bucket = d->m_buckets.constBegin(); bucket != d->m_buckets.constEnd(); ++bucket) {
+        inEdges.append(inEdgesView(bucket.key()));
     }
     return inEdges;
 }
 
 EdgeList Node::outEdges(EdgeTypePtr type) const
 {
+    if (type) {
+        return outEdgesView(type);
+    }
+    if (d->m_buckets.size() == 1) {
+        return outEdgesView(d->m_buckets.constBegin().key());
+    }
     EdgeList outEdges;
-    foreach (EdgePtr edge, d->m_edges) {
-        if (type && edge->type() != type) {
-            continue;
-        }
-        if (edge->type()->direction() == EdgeType::Bidirectional) {
-            outEdges.append(edge);
-            continue;
-        }
-        if (edge->type()->direction() == EdgeType::Unidirectional
-            && edge->from() == self()
-        ) {
-            outEdges.append(edge);
-        }
+    for (auto bucket = d->m_buckets.constBegin(); bucket != d->m_buckets.constEnd(); ++bucket) {
+        outEdges.append(outEdgesView(bucket.key()));
     }
     return outEdges;
 }
 
+const EdgeList & Node::edgesView(EdgeTypePtr type) const
+{
+    static const EdgeList noEdges;
+    if (!type) {
+        return d->m_edges;
+    }
+    auto bucket = d->m_buckets.constFind(type);
+    if (bucket == d->m_buckets.constEnd()) {
+        return noEdges;
+    }
+    return bucket->edges;
+}
+
+const EdgeList & Node::inEdgesView(EdgeTypePtr type) const
+{
+    static const EdgeList noEdges;
+    Q_ASSERT(type);
+    auto bucket = d->m_buckets.constFind(type);
+    if (bucket == d->m_buckets.constEnd()) {
+        return noEdges;
+    }
+    if (type->direction() == EdgeType::Bidirectional) {
+        return bucket->edges;
+    }
+    return bucket->inEdges;
+}
+
+const EdgeList & Node::outEdgesView(EdgeTypePtr type) const
+{
+    static const EdgeList noEdges;
+    Q_ASSERT(type);
+    auto bucket = d->m_buckets.constFind(type);
+    if (bucket == d->m_buckets.constEnd()) {
+        return noEdges;
+    }
+    if (type->direction() == EdgeType::Bidirectional) {
+        return bucket->edges;
+    }
+    return bucket->outEdges;
+}
+
 int Node::id() const
 {
     return d->m_id;
@@ -244,7 +383,11 @@ void Node::setId(int id)
     if (id == d->m_id) {
         return;
     }
+    const int oldId = d->m_id;
     d->m_id = id;
+    if (d->m_valid) {
+        d->m_document->updateNodeId(d->q, oldId);
+    }
     emit idChanged(id);
 }
 
@@ -292,7 +435,26 @@ void Node::setColor(const QColor &color)
 
 QVariant Node::dynamicProperty(const QString &property) const
 {
-    return Node::property(("_graph_" + property).toLatin1());
+    if (!d->m_type) {
+        return QVariant();
+    }
+    const int column = d->m_type->dynamicProperties().indexOf(property);
+    if (column < 0) {
+        return QVariant();
+    }
+    return d->m_type->propertyTable()->value(column, d->m_propertyRow);
+}
+
+QVariant Node::dynamicProperty(const PropertyKey &key) const
+{
+    if (!d->m_type) {
+        return QVariant();
+    }
+    const int column = d->m_type->dynamicPropertyIndex(key);
+    if (column < 0) {
+        return QVariant();
+    }
+    return d->m_type->propertyTable()->value(column, d->m_propertyRow);
 }
 
 QStringList Node::dynamicProperties() const
@@ -307,27 +469,43 @@ void Node::setDynamicProperty(const QString &property, const QVariant &value)
 {
     if (!d->m_type) {
         qCWarning(GRAPHTHEORY_GENERAL) << "No type registered, aborting to set property.";
+        return;
     }
-    if (value.isValid() && !d->m_type->dynamicProperties().contains(property)) {
-        qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+    const int column = d->m_type->dynamicProperties().indexOf(property);
+    if (column < 0) {
+        if (value.isValid()) {
+            qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+        }
+        return;
     }
-    setProperty(("_graph_" + property).toLatin1(), value);
-    emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(property));
+    d->m_type->propertyTable()->setValue(column, d->m_propertyRow, value);
+    emit dynamicPropertyChanged(column);
 }
 
-void Node::updateDynamicProperty(const QString &property)
+void Node::setDynamicProperty(const PropertyKey &key, const QVariant &value)
 {
-    // remove property if not registered at type
-    if (!d->m_type->dynamicProperties().contains(property)) {
-        setDynamicProperty(property, QVariant::Invalid);
+    if (!d->m_type) {
+        qCWarning(GRAPHTHEORY_GENERAL) << "No type registered, aborting to set property.";
+        return;
     }
-    emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(property));
+    const int column = d->m_type->dynamicPropertyIndex(key);
+    if (column < 0) {
+        if (value.isValid()) {
+            qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+        }
+        return;
+    }
+    d->m_type->propertyTable()->setValue(column, d->m_propertyRow, value);
+    emit dynamicPropertyChanged(column);
 }
 
 void Node::renameDynamicProperty(const QString &oldProperty, const QString &newProperty)
 {
-    setDynamicProperty(newProperty, dynamicProperty(oldProperty));
-    setDynamicProperty(oldProperty, QVariant::Invalid);
+    // the renamed property keeps its column in the property table, thus the value is preserved
+    Q_UNUSED(oldProperty);
+    if (!d->m_type) {
+        return;
+    }
     emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(newProperty));
 }
 
@@ -335,3 +513,18 @@ void Node::setQpointer(NodePtr q)
 {
     d->q = q;
 }
+
+int Node::documentIndex() const
+{
+    return d->m_documentIndex;
+}
+
+void Node::setDocumentIndex(int index)
+{
+    d->m_documentIndex = index;
+}
+
+int Node::propertyRow() const
+{
+    return d->m_propertyRow;
+}
@@ -23,9 +23,11 @@
 
 #include "graphtheory_export.h"
 #include "typenames.h"
+#include "propertykey.h"
 #include "graphdocument.h"
 
 #include <QObject>
+#include <cstddef>
 #include <QColor>
 
 class QPointF;
@@ -44,7 +46,7 @@ class GRAPHTHEORY_EXPORT Node : public QObject
     Q_PROPERTY(qreal x READ x WRITE setX NOTIFY positionChanged)
     Q_PROPERTY(qreal y READ y WRITE setY NOTIFY positionChanged)
     Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
-    Q_PROPERTY(QStringList dynamicProperties READ dynamicProperties NOTIFY dynamicPropertiesChanged)
+    Q_PROPERTY(QStringList dynamicProperties READ dynamicProperties)
 
 public:
     /**
@@ -58,6 +60,13 @@ public:
     /** Destroys the node */
     virtual ~Node();
 
+    /**
+     * Nodes are allocated from a shared pool, such that large numbers of nodes are stored
+     * contiguously and without per-object allocation overhead.
+     */
+    static void * operator new(std::size_t size);
+    static void operator delete(void *pointer, std::size_t size);
+
     /**
      * @return shared pointer to object
      */
@@ -129,6 +138,31 @@ public:
      */
     EdgeList outEdges(EdgeTypePtr type = EdgeTypePtr()) const;
 
+    /**
+     * Non-allocating variant of edges(). Incident edges are kept grouped by their edge type,
+     * hence no filtering is performed. The returned list must not be used after edges of this
+     * node were inserted, removed, or changed their type.
+     *
+     * @return edges adjacent to this node, if optional @p type is set, only edges of this type
+     */
+    const EdgeList & edgesView(EdgeTypePtr type = EdgeTypePtr()) const;
+
+    /**
+     * Non-allocating variant of inEdges() for the valid edge type @p type. The same restrictions
+     * as for edgesView() apply.
+     *
+     * @return incoming edges of type @p type
+     */
+    const EdgeList & inEdgesView(EdgeTypePtr type) const;
+
+    /**
+     * Non-allocating variant of outEdges() for the valid edge type @p type. The same restrictions
+     * as for edgesView() apply.
+     *
+     * @return outgoing edges of type @p type
+     */
+    const EdgeList & outEdgesView(EdgeTypePtr type) const;
+
     /**
      * If the id value is invalid, -1 is returned.
      *
@@ -176,6 +210,13 @@ public:
      */
     QVariant dynamicProperty(const QString &property) const;
 
+    /**
+     * Fast variant of dynamicProperty() for properties identified by @p key.
+     *
+     * @return return value of dynamic property, value is QVariant::Invalid if it is not set
+     */
+    QVariant dynamicProperty(const PropertyKey &key) const;
+
     /**
      * @return list of dynamic properties registered at node type
      */
@@ -183,8 +224,8 @@ public:
 
     /**
      * Set dynamic property with identifier @c property. If @c value is
-     * QVariant::Invalid, the dynamic property is unset. Internally, this
-     * method use the QObject::setProperty mechanism but prefixes properties to avoid name clashes.
+     * QVariant::Invalid, the dynamic property is unset. The property must be registered at
+     * the node type; values are stored in the property table of the type.
      *
      * @param property is the identifier for the new property
      * @param value is the value of this property
@@ -192,7 +233,17 @@ public:
     void setDynamicProperty(const QString &property, const QVariant &value);
 
     /**
-     * Rename dynamic property from identifier @c oldProperty to @c newProperty.
+     * Fast variant of setDynamicProperty() for properties identified by @p key. The property
+     * must be registered at the node type.
+     *
+     * @param key is the key of the property
+     * @param value is the value of this property
+     */
+    void setDynamicProperty(const PropertyKey &key, const QVariant &value);
+
+    /**
+     * Rename dynamic property from identifier @c oldProperty to @c newProperty. The rename must
+     * already be performed at the node type, the value of the property is preserved.
      *
      * @param oldProperty the former value of the property
      * @param newProperty the new value of the property
@@ -216,20 +267,11 @@ Q_SIGNALS:
     void idChanged(int id);
     void colorChanged(const QColor &color);
     /**
-     * signal is emitted whenever a style property changed. Use typeChanged() to get informed
-     * about a change of the style object.
+     * signal is emitted whenever the value of the dynamic property in column @p index of the
+     * property table changed. Changes of the property list or the style are only signaled by
+     * the node type, which notifies its subscribers once for all of its nodes.
      **/
-    void styleChanged();
-    void dynamicPropertyAboutToBeAdded(const QString&, int);
-    void dynamicPropertyAdded();
-    void dynamicPropertiesAboutToBeRemoved(int, int);
-    void dynamicPropertyRemoved();
     void dynamicPropertyChanged(int index);
-    /** list of dynamic properties changed **/
-    void dynamicPropertiesChanged();
-
-private Q_SLOTS:
-    void updateDynamicProperty(const QString &property);
 
 protected:
     Node();
@@ -238,7 +280,30 @@ private:
     Q_DISABLE_COPY(Node)
     const QScopedPointer<NodePrivate> d;
     void setQpointer(NodePtr q);
+    /**
+     * Create copy of this node of type @p type in @p document and insert it into the document.
+     * The property table of @p type must be a copy of the table of the type of this node.
+     */
+    NodePtr clone(GraphDocumentPtr document, NodeTypePtr type) const;
+    /**
+     * Position of the node in the list of the document or -1 if the node is not
+     * contained in the document. Only maintained by GraphDocument.
+     */
+    int documentIndex() const;
+    void setDocumentIndex(int index);
+    /**
+     * @return row of the values of this node in the property table of its type
+     */
+    int propertyRow() const;
+    /**
+     * Move @p edge from the bucket of @p previousType to the bucket of its current type.
+     */
+    void updateEdgeType(EdgePtr edge, EdgeTypePtr previousType);
     static uint objectCounter;
+    friend class GraphDocument;
+    friend class GraphDiffPrivate;
+    friend class DocumentWrapper;
+    friend class Edge;
 };
 }
 
@@ -21,6 +21,7 @@
 #include "nodetype.h"
 #include "nodetypestyle.h"
 #include "graphdocument.h"
+#include "propertytable_p.h"
 #include <QDebug>
 
 using namespace GraphTheory;
@@ -44,11 +45,25 @@ public:
         m_style->deleteLater();
     }
 
+    void updatePropertyKeys()
+    {
+        m_propertyKeys.fill(-1);
+        for (int i = 0; i < m_dynamicProperties.length(); ++i) {
+            const int id = PropertyKey(m_dynamicProperties.at(i)).id();
+            while (m_propertyKeys.length() <= id) {
+                m_propertyKeys.append(-1);
+            }
+            m_propertyKeys[id] = i;
+        }
+    }
+
     NodeTypePtr q;
     int m_id;
     NodeTypeStyle *m_style;
     GraphDocumentPtr m_document;
     QStringList m_dynamicProperties;
+    PropertyTable m_propertyTable; // values of dynamic properties of all elements
+    QVector<int> m_propertyKeys; // index of dynamic property by property key identifier
     QString m_name;
     bool m_valid;
 };
@@ -143,13 +158,23 @@ QStringList NodeType::dynamicProperties() const
     return d->m_dynamicProperties;
 }
 
+int NodeType::dynamicPropertyIndex(const PropertyKey &key) const
+{
+    if (!key.isValid() || key.id() >= d->m_propertyKeys.length()) {
+        return -1;
+    }
+    return d->m_propertyKeys.at(key.id());
+}
+
 void NodeType::addDynamicProperty(const QString& property)
 {
     if (d->m_dynamicProperties.contains(property)) {
         return;
     }
     emit dynamicPropertyAboutToBeAdded(property, d->m_dynamicProperties.count());
+    d->m_propertyTable.insertColumn(d->m_dynamicProperties.count());
     d->m_dynamicProperties.append(property);
+    d->updatePropertyKeys();
     emit dynamicPropertyAdded();
 }
 
@@ -160,7 +185,9 @@ void NodeType::removeDynamicProperty(const QString& property)
     }
     int index = d->m_dynamicProperties.indexOf(property);
     emit dynamicPropertiesAboutToBeRemoved(index, index);
+    d->m_propertyTable.removeColumn(index);
     d->m_dynamicProperties.removeAt(index);
+    d->updatePropertyKeys();
     emit dynamicPropertyRemoved(property);
 }
 
@@ -174,6 +201,7 @@ void NodeType::renameDynamicProperty(const QString& oldProperty, const QString&
     }
     int index = d->m_dynamicProperties.indexOf(oldProperty);
     d->m_dynamicProperties[index] = newProperty;
+    d->updatePropertyKeys();
     emit dynamicPropertyRenamed(oldProperty, newProperty);
     emit dynamicPropertyChanged(index);
 }
@@ -182,3 +210,8 @@ void NodeType::setQpointer(NodeTypePtr q)
 {
     d->q = q;
 }
+
+PropertyTable * NodeType::propertyTable() const
+{
+    return &d->m_propertyTable;
+}
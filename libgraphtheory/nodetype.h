@@ -23,6 +23,7 @@
 
 #include "graphtheory_export.h"
 #include "typenames.h"
+#include "propertykey.h"
 
 #include <QObject>
 #include <QSharedPointer>
@@ -33,6 +34,7 @@ namespace GraphTheory
 
 class NodeTypePrivate;
 class NodeTypeStyle;
+class PropertyTable;
 
 /**
  * \class Node
@@ -109,6 +111,14 @@ public:
      */
     QStringList dynamicProperties() const;
 
+    /**
+     * Look up the position of the dynamic property with key @p key in dynamicProperties()
+     * without comparing strings.
+     *
+     * @return index of the property or -1 if the property is not registered at this type
+     */
+    int dynamicPropertyIndex(const PropertyKey &key) const;
+
     /**
      * Add dynamic property @c property to list of dynamic properties.
      * Signal dynamicPropertyAdded(@c property) is emitted afterwards
@@ -156,7 +166,14 @@ private:
     Q_DISABLE_COPY(NodeType)
     const QScopedPointer<NodeTypePrivate> d;
     void setQpointer(NodeTypePtr q);
+    /**
+     * @return storage of the dynamic property values of all nodes of this type
+     */
+    PropertyTable * propertyTable() const;
     static uint objectCounter;
+    friend class Node;
+    friend class GraphDocument;
+    friend class GraphDiffPrivate;
 };
 }
 
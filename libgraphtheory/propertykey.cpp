@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "propertykey.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+
+using namespace GraphTheory;
+
+namespace
+{
+// registry of interned property names, shared by all documents; names are never removed,
+// since their identifiers may still be used by keys and by the lookup tables of types
+struct PropertyKeyRegistry {
+    QMutex mutex;
+    QHash<QString, int> ids;
+    QStringList names;
+};
+Q_GLOBAL_STATIC(PropertyKeyRegistry, registry)
+}
+
+PropertyKey::PropertyKey()
+    : m_id(-1)
+{
+}
+
+PropertyKey::PropertyKey(const QString &name)
+{
+    PropertyKeyRegistry *keys = registry();
+    QMutexLocker locker(&keys->mutex);
+    auto iter = keys->ids.constFind(name);
+    if (iter != keys->ids.constEnd()) {
+        m_id = iter.value();
+        return;
+    }
+    m_id = keys->names.length();
+    keys->ids.insert(name, m_id);
+    keys->names.append(name);
+}
+
+QString PropertyKey::name() const
+{
+    if (m_id < 0) {
+        return QString();
+    }
+    PropertyKeyRegistry *keys = registry();
+    QMutexLocker locker(&keys->mutex);
+    return keys->names.at(m_id);
+}
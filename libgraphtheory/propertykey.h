@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROPERTYKEY_H
+#define PROPERTYKEY_H
+
+#include "graphtheory_export.h"
+
+#include <QHash>
+#include <QString>
+
+namespace GraphTheory
+{
+
+/**
+ * \class PropertyKey
+ *
+ * Handle for the name of a dynamic property. Property names are interned, i.e., all keys
+ * created for the same name share the same identifier. Resolve a key once and use it for
+ * all nodes or edges to avoid string comparisons when accessing dynamic properties:
+ *
+ * \code
+ * const PropertyKey weight("weight");
+ * foreach (EdgePtr edge, document->edges()) {
+ *     sum += edge->dynamicProperty(weight).toReal();
+ * }
+ * \endcode
+ *
+ * Keys do not depend on a NodeType or EdgeType and stay valid when properties are added,
+ * removed, or renamed.
+ *
+ * The registry of property names is shared by all documents and intentionally never shrinks:
+ * identifiers index the lookup tables of the types, thus they cannot be reused for other
+ * names while any key or type may still refer to them. Each distinct name is stored once, so
+ * the registry grows with the number of different property names used during the lifetime of
+ * the process, not with the number of documents, elements or keys.
+ */
+class GRAPHTHEORY_EXPORT PropertyKey
+{
+public:
+    /**
+     * Creates an invalid key.
+     */
+    PropertyKey();
+
+    /**
+     * Creates the key for the property name @p name.
+     */
+    explicit PropertyKey(const QString &name);
+
+    /**
+     * @return @c true if the key was created from a property name, otherwise @c false
+     */
+    bool isValid() const
+    {
+        return m_id >= 0;
+    }
+
+    /**
+     * @return unique identifier of the property name, -1 if the key is invalid
+     */
+    int id() const
+    {
+        return m_id;
+    }
+
+    /**
+     * @return the property name of the key
+     */
+    QString name() const;
+
+    bool operator==(const PropertyKey &other) const
+    {
+        return m_id == other.m_id;
+    }
+
+    bool operator!=(const PropertyKey &other) const
+    {
+        return m_id != other.m_id;
+    }
+
+private:
+    int m_id;
+};
+
+inline uint qHash(const PropertyKey &key, uint seed = 0)
+{
+    return ::qHash(key.id(), seed);
+}
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "propertytable_p.h"
+
+using namespace GraphTheory;
+
+PropertyTable::Column::Column()
+    : type(EmptyColumn)
+{
+}
+
+void PropertyTable::Column::resize(int rowCount)
+{
+    switch (type) {
+    case EmptyColumn:
+        break;
+    case RealColumn:
+        reals.resize(rowCount);
+        isSet.resize(rowCount);
+        break;
+    case StringColumn:
+        strings.resize(rowCount);
+        isSet.resize(rowCount);
+        break;
+    case VariantColumn:
+        variants.resize(rowCount);
+        break;
+    }
+}
+
+void PropertyTable::Column::convertToVariants()
+{
+    const int rowCount = isSet.size();
+    variants.resize(rowCount);
+    for (int row = 0; row < rowCount; ++row) {
+        if (!isSet.testBit(row)) {
+            continue;
+        }
+        if (type == RealColumn) {
+            variants[row] = reals.at(row);
+        } else {
+            variants[row] = strings.at(row);
+        }
+    }
+    reals.clear();
+    strings.clear();
+    isSet.clear();
+    type = VariantColumn;
+}
+
+PropertyTable::PropertyTable()
+    : m_rowCount(0)
+{
+}
+
+int PropertyTable::insertRow()
+{
+    if (!m_freeRows.isEmpty()) {
+        const int row = m_freeRows.last();
+        m_freeRows.removeLast();
+        return row;
+    }
+    ++m_rowCount;
+    for (int i = 0; i < m_columns.length(); ++i) {
+        m_columns[i].resize(m_rowCount);
+    }
+    return m_rowCount - 1;
+}
+
+void PropertyTable::removeRow(int row)
+{
+    Q_ASSERT(row >= 0 && row < m_rowCount);
+    for (int i = 0; i < m_columns.length(); ++i) {
+        setValue(i, row, QVariant());
+    }
+    m_freeRows.append(row);
+}
+
+void PropertyTable::insertColumn(int column)
+{
+    m_columns.insert(column, Column());
+}
+
+void PropertyTable::removeColumn(int column)
+{
+    m_columns.remove(column);
+}
+
+int PropertyTable::columnCount() const
+{
+    return m_columns.length();
+}
+
+QVariant PropertyTable::value(int column, int row) const
+{
+    Q_ASSERT(column >= 0 && column < m_columns.length());
+    Q_ASSERT(row >= 0 && row < m_rowCount);
+    const Column &values = m_columns.at(column);
+    switch (values.type) {
+    case EmptyColumn:
+        return QVariant();
+    case RealColumn:
+        return values.isSet.testBit(row) ? QVariant(values.reals.at(row)) : QVariant();
+    case StringColumn:
+        return values.isSet.testBit(row) ? QVariant(values.strings.at(row)) : QVariant();
+    case VariantColumn:
+        return values.variants.at(row);
+    }
+    return QVariant();
+}
+
+void PropertyTable::setValue(int column, int row, const QVariant &value)
+{
+    Q_ASSERT(column >= 0 && column < m_columns.length());
+    Q_ASSERT(row >= 0 && row < m_rowCount);
+    Column &values = m_columns[column];
+
+    // the first value decides the type of the column, other types switch it to variants
+    const int valueType = value.userType();
+    if (values.type == EmptyColumn) {
+        if (!value.isValid()) {
+            return;
+        }
+        if (valueType == QMetaType::Double) {
+            values.type = RealColumn;
+        } else if (valueType == QMetaType::QString) {
+            values.type = StringColumn;
+        } else {
+            values.type = VariantColumn;
+        }
+        values.resize(m_rowCount);
+    } else if ((values.type == RealColumn && value.isValid() && valueType != QMetaType::Double)
+        || (values.type == StringColumn && value.isValid() && valueType != QMetaType::QString))
+    {
+        values.convertToVariants();
+    }
+
+    switch (values.type) {
+    case EmptyColumn:
+        break;
+    case RealColumn:
+        values.isSet.setBit(row, value.isValid());
+        values.reals[row] = value.isValid() ? value.toDouble() : 0;
+        break;
+    case StringColumn:
+        values.isSet.setBit(row, value.isValid());
+        values.strings[row] = value.isValid() ? value.toString() : QString();
+        break;
+    case VariantColumn:
+        values.variants[row] = value;
+        break;
+    }
+}
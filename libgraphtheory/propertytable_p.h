@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROPERTYTABLE_P_H
+#define PROPERTYTABLE_P_H
+
+#include <QBitArray>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+namespace GraphTheory
+{
+
+/**
+ * \class PropertyTable
+ *
+ * Column storage for the dynamic property values of all elements of one node or edge type.
+ * Each dynamic property of the type is one column, with the same index as the property in the
+ * list of dynamic properties of the type. Each element owns one row slot, which is reused after
+ * the element releases it.
+ *
+ * Columns store their values unboxed as long as all values set in them are numbers of type
+ * double or all are strings; a column falls back to QVariant storage once it receives a value
+ * of another type. Values are returned with the type they were set with.
+ */
+class PropertyTable
+{
+public:
+    PropertyTable();
+
+    /**
+     * Allocate a row with all values unset.
+     *
+     * @return index of the row
+     */
+    int insertRow();
+
+    /**
+     * Unset all values of row @p row and release it for later reuse.
+     */
+    void removeRow(int row);
+
+    /**
+     * Insert column with all values unset at position @p column.
+     */
+    void insertColumn(int column);
+
+    /**
+     * Remove column at position @p column including all values.
+     */
+    void removeColumn(int column);
+
+    /**
+     * @return number of columns
+     */
+    int columnCount() const;
+
+    /**
+     * @return value at @p column and @p row, QVariant::Invalid if not set
+     */
+    QVariant value(int column, int row) const;
+
+    /**
+     * Set value at @p column and @p row to @p value.
+     */
+    void setValue(int column, int row, const QVariant &value);
+
+private:
+    enum ColumnType {
+        EmptyColumn,    // no value was set yet
+        RealColumn,     // values in reals
+        StringColumn,   // values in strings
+        VariantColumn   // values in variants
+    };
+    struct Column {
+        Column();
+        void resize(int rowCount);
+        /** move all values to variants **/
+        void convertToVariants();
+
+        ColumnType type;
+        QBitArray isSet; // rows with a value, for real and string columns
+        QVector<double> reals;
+        QVector<QString> strings;
+        QVector<QVariant> variants;
+    };
+
+    QVector<Column> m_columns;
+    QVector<int> m_freeRows;
+    int m_rowCount;
+};
+}
+
+#endif
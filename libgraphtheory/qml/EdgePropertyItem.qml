@@ -27,18 +27,18 @@ import org.kde.rocs.graphtheory 1.0
 Item {
     id: root
 
-    property Edge edge: undefined
+    property var properties: []
 
     Column {
         Repeater {
-            model: EdgePropertyModel { edge: root.edge }
+            model: root.properties
             Text {
                 id: propertyText
                 text: {
-                    if (model.visibility) {
-                        return model.name + ": " + model.value;
+                    if (modelData.visibility) {
+                        return modelData.name + ": " + modelData.value;
                     } else {
-                        return (model.value != undefined) ? model.value : "";
+                        return (modelData.value != undefined) ? modelData.value : "";
                     }
                 }
             }
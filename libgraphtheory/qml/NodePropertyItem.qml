@@ -27,17 +27,17 @@ import org.kde.rocs.graphtheory 1.0
 Item {
     id: root
 
-    property Node node: undefined
+    property var properties: []
 
     Column {
         Repeater {
-            model: NodePropertyModel { node: root.node }
+            model: root.properties
             Text {
                 text: {
-                    if (model.visibility) {
-                        return model.name + ": " + model.value;
+                    if (modelData.visibility) {
+                        return modelData.name + ": " + modelData.value;
                     } else {
-                        return (model.value != undefined) ? model.value : "";
+                        return (modelData.value != undefined) ? modelData.value : "";
                     }
                 }
             }
@@ -205,12 +205,15 @@ Item {
                 EdgeItem {
                     id: edgeItem
                     edge: model.dataRole
+                    typeColor: model.typeColor
+                    typeVisible: model.typeVisible
+                    direction: model.direction
                     origin: scene.origin
                     z: -1 // edges must be below nodes
 
                     EdgePropertyItem {
                         anchors.centerIn: parent
-                        edge: model.dataRole
+                        properties: model.properties
                     }
 
                     MouseArea {
@@ -234,6 +237,8 @@ Item {
                 NodeItem {
                     id: nodeItem
                     node: model.dataRole
+                    typeColor: model.typeColor
+                    typeVisible: model.typeVisible
                     origin: scene.origin
                     highlighted: addEdgeAction.from == node || addEdgeAction.to == node
                     property bool __modifyingPosition: false
@@ -339,7 +344,7 @@ Item {
                     }
                     NodePropertyItem {
                         anchors.centerIn: parent
-                        node: model.dataRole
+                        properties: model.properties
                     }
 
                     Drag.active: dragArea.drag.active
@@ -36,6 +36,8 @@ public:
         , m_pointFrom(0, 0)
         , m_pointTo(0, 0)
         , m_nodeWidth(32)
+        , m_typeColor(Qt::black)
+        , m_direction(EdgeType::Unidirectional)
         , m_colorDirty(false)
         , m_directionDirty(false)
         , m_visible(true)
@@ -49,6 +51,8 @@ public:
     QPointF m_origin;
     QPointF m_pointFrom, m_pointTo;
     const int m_nodeWidth;
+    QColor m_typeColor;
+    EdgeType::Direction m_direction;
     bool m_colorDirty;
     bool m_directionDirty;
     bool m_visible;
@@ -82,27 +86,20 @@ void EdgeItem::setEdge(Edge *edge)
         d->m_edge->disconnect(this);
     }
     d->m_edge = edge;
-    d->m_visible = edge->type()->style()->isVisible();
     connect(edge->from().data(), &Node::positionChanged,
         this, &EdgeItem::updatePosition);
     connect(edge->to().data(), &Node::positionChanged,
         this, &EdgeItem::updatePosition);
-    connect(edge, &Edge::typeChanged,
-        this, [&](EdgeTypePtr) { update(); });
-    connect(edge, &Edge::styleChanged,
-        this, &EdgeItem::updateColor);
-    connect(edge, &Edge::directionChanged,
-        this, &EdgeItem::updateDirection);
-
-    connect(edge, &Edge::styleChanged,
-        this, &EdgeItem::updateVisibility);
-    connect(edge->from().data(), &Node::styleChanged,
-        this, &EdgeItem::updateVisibility);
-    connect(edge->to().data(), &Node::styleChanged,
-        this, &EdgeItem::updateVisibility);
+
+    // type style changes are passed by the edge model to the typeColor, typeVisible and
+    // direction properties
+    setTypeColor(edge->type()->style()->color());
+    setTypeVisible(edge->type()->style()->isVisible()
+        && edge->from()->type()->style()->isVisible()
+        && edge->to()->type()->style()->isVisible());
+    setDirection(edge->type()->direction());
 
     updatePosition();
-    updateVisibility();
     emit edgeChanged();
 }
 
@@ -125,15 +122,15 @@ QSGNode * EdgeItem::updatePaintNode(QSGNode *node, QQuickItem::UpdatePaintNodeDa
     QSGLineNode *n = static_cast<QSGLineNode *>(node);
     if (!n) {
         n = new QSGLineNode();
-        n->setDirection(d->m_edge->type()->direction());
-        n->setColor(d->m_edge->type()->style()->color());
+        n->setDirection(d->m_direction);
+        n->setColor(d->m_typeColor);
     }
     if (d->m_colorDirty) {
-        n->setColor(d->m_edge->type()->style()->color());
+        n->setColor(d->m_typeColor);
         d->m_colorDirty = false;
     }
     if (d->m_directionDirty) {
-        n->setDirection(d->m_edge->type()->direction());
+        n->setDirection(d->m_direction);
         d->m_directionDirty = false;
     }
 
@@ -166,27 +163,53 @@ void EdgeItem::updatePosition()
     update();
 }
 
-void EdgeItem::updateColor()
+QColor EdgeItem::typeColor() const
 {
+    return d->m_typeColor;
+}
+
+void EdgeItem::setTypeColor(const QColor &color)
+{
+    if (d->m_typeColor == color) {
+        return;
+    }
+    d->m_typeColor = color;
     d->m_colorDirty = true;
+    emit typeColorChanged();
     update();
 }
 
-void EdgeItem::updateDirection()
+bool EdgeItem::isTypeVisible() const
 {
-    d->m_directionDirty = true;
-    update();
+    return d->m_visible;
 }
 
-void EdgeItem::updateVisibility()
+void EdgeItem::setTypeVisible(bool visible)
 {
-    bool visible = d->m_edge->type()->style()->isVisible() &&
-        d->m_edge->from()->type()->style()->isVisible() &&
-        d->m_edge->to()->type()->style()->isVisible();
+    if (d->m_visible == visible) {
+        return;
+    }
     d->m_visible = visible;
     if (d->m_visible) {
         setOpacity(1);
     } else {
         setOpacity(0);
     }
+    emit typeVisibleChanged();
+}
+
+int EdgeItem::direction() const
+{
+    return d->m_direction;
+}
+
+void EdgeItem::setDirection(int direction)
+{
+    if (d->m_direction == direction) {
+        return;
+    }
+    d->m_direction = static_cast<EdgeType::Direction>(direction);
+    d->m_directionDirty = true;
+    emit directionChanged();
+    update();
 }
@@ -36,6 +36,9 @@ class EdgeItem : public QQuickItem
     Q_OBJECT
     Q_PROPERTY(GraphTheory::Edge * edge READ edge WRITE setEdge NOTIFY edgeChanged)
     Q_PROPERTY(QPointF origin READ origin WRITE setOrigin)
+    Q_PROPERTY(QColor typeColor READ typeColor WRITE setTypeColor NOTIFY typeColorChanged)
+    Q_PROPERTY(bool typeVisible READ isTypeVisible WRITE setTypeVisible NOTIFY typeVisibleChanged)
+    Q_PROPERTY(int direction READ direction WRITE setDirection NOTIFY directionChanged)
 
 public:
     explicit EdgeItem(QQuickItem *parent = 0);
@@ -46,18 +49,27 @@ public:
     QPointF origin() const;
     /** set translation of global origin (0,0) into scene coordinates **/
     void setOrigin(const QPointF &origin);
+    /** color of the edge type style, bound to the edge model such that the type notifies all items at once **/
+    QColor typeColor() const;
+    void setTypeColor(const QColor &color);
+    /** visibility of the edge type style and the node type styles of both end points, bound to the edge model **/
+    bool isTypeVisible() const;
+    void setTypeVisible(bool visible);
+    /** EdgeType::Direction of the edge type, bound to the edge model **/
+    int direction() const;
+    void setDirection(int direction);
 
 protected:
     virtual QSGNode * updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) Q_DECL_OVERRIDE;
 
 Q_SIGNALS:
     void edgeChanged();
+    void typeColorChanged();
+    void typeVisibleChanged();
+    void directionChanged();
 
 private Q_SLOTS:
     void updatePosition();
-    void updateColor();
-    void updateDirection();
-    void updateVisibility();
 
 private:
     Q_DISABLE_COPY(EdgeItem)
@@ -31,6 +31,7 @@ public:
     NodeItemPrivate()
         : m_node(0)
         , m_origin(0,0)
+        , m_typeColor(Qt::black)
         , m_visible(true)
         , m_highlighted(false)
         , m_updating(false)
@@ -43,6 +44,7 @@ public:
 
     Node *m_node;
     QPointF m_origin;
+    QColor m_typeColor;
     bool m_visible;
     bool m_highlighted;
     bool m_updating; //!< while true do not react to any change requested
@@ -79,21 +81,18 @@ void NodeItem::setNode(Node *node)
     setGlobalPosition(QPointF(node->x(), node->y()));
     connect(node, &Node::positionChanged,
         this, &NodeItem::setGlobalPosition);
-    connect(node, &Node::styleChanged,
-        this, [&] () { update(); });
     connect(node, &Node::colorChanged,
         this, [&] (QColor) { update(); });
-    connect(node, &Node::typeChanged,
-        this, [&] (NodeTypePtr) { update(); });
-    connect(node, &Node::styleChanged,
-        this, &NodeItem::updateVisibility);
     connect(this, &NodeItem::xChanged,
         this, &NodeItem::updatePositionfromScene);
     connect(this, &NodeItem::yChanged,
         this, &NodeItem::updatePositionfromScene);
 
+    // type style changes are passed by the node model to the typeColor and typeVisible properties
+    setTypeColor(node->type()->style()->color());
+    setTypeVisible(node->type()->style()->isVisible());
+
     emit nodeChanged();
-    updateVisibility();
     update();
 }
 
@@ -128,6 +127,40 @@ void NodeItem::setHighlighted(bool highlight)
     update();
 }
 
+QColor NodeItem::typeColor() const
+{
+    return d->m_typeColor;
+}
+
+void NodeItem::setTypeColor(const QColor &color)
+{
+    if (d->m_typeColor == color) {
+        return;
+    }
+    d->m_typeColor = color;
+    emit typeColorChanged();
+    update();
+}
+
+bool NodeItem::isTypeVisible() const
+{
+    return d->m_visible;
+}
+
+void NodeItem::setTypeVisible(bool visible)
+{
+    if (d->m_visible == visible) {
+        return;
+    }
+    d->m_visible = visible;
+    if (d->m_visible) {
+        setOpacity(1);
+    } else {
+        setOpacity(0);
+    }
+    emit typeVisibleChanged();
+}
+
 void NodeItem::paint(QPainter *painter)
 {
     painter->setRenderHint(QPainter::Antialiasing);
@@ -137,7 +170,7 @@ void NodeItem::paint(QPainter *painter)
         painter->setBrush(QColor(246, 116, 0, 125)); // beware orange, half transparent
         painter->drawEllipse(QRectF(0, 0, width(), height()));
     }
-    painter->setPen(QPen(QColor(d->m_node->type()->style()->color()), 2, Qt::SolidLine));
+    painter->setPen(QPen(d->m_typeColor, 2, Qt::SolidLine));
     painter->setBrush(QBrush(d->m_node->color()));
     painter->drawEllipse(QRectF(4, 4, width() - 8, height() - 8));
 }
@@ -175,16 +208,3 @@ void NodeItem::setGlobalPosition(const QPointF &position)
     setY(position.y() - d->m_origin.y() - height()/2);
     update();
 }
-
-void NodeItem::updateVisibility()
-{
-    if (d->m_visible == d->m_node->type()->style()->isVisible()) {
-        return;
-    }
-    d->m_visible = d->m_node->type()->style()->isVisible();
-    if (d->m_visible) {
-        setOpacity(1);
-    } else {
-        setOpacity(0);
-    }
-}
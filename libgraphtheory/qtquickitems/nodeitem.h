@@ -35,6 +35,8 @@ class NodeItem : public QQuickPaintedItem
     Q_PROPERTY(GraphTheory::Node * node READ node WRITE setNode NOTIFY nodeChanged)
     Q_PROPERTY(QPointF origin READ origin WRITE setOrigin)
     Q_PROPERTY(bool highlighted READ isHighlighted WRITE setHighlighted NOTIFY highlightedChanged)
+    Q_PROPERTY(QColor typeColor READ typeColor WRITE setTypeColor NOTIFY typeColorChanged)
+    Q_PROPERTY(bool typeVisible READ isTypeVisible WRITE setTypeVisible NOTIFY typeVisibleChanged)
 
 public:
     explicit NodeItem(QQuickPaintedItem *parent = 0);
@@ -47,6 +49,12 @@ public:
     void setOrigin(const QPointF &origin);
     bool isHighlighted() const;
     void setHighlighted(bool highlight);
+    /** color of the node type style, bound to the node model such that the type notifies all items at once **/
+    QColor typeColor() const;
+    void setTypeColor(const QColor &color);
+    /** visibility of the node type style, bound to the node model **/
+    bool isTypeVisible() const;
+    void setTypeVisible(bool visible);
     /** reimplemented from QQuickPaintedItem **/
     void paint(QPainter *painter) Q_DECL_OVERRIDE;
     /** reimplemented from QQuickItem **/
@@ -55,11 +63,12 @@ public:
 Q_SIGNALS:
     void nodeChanged();
     void highlightedChanged();
+    void typeColorChanged();
+    void typeVisibleChanged();
 
 private Q_SLOTS:
     void updatePositionfromScene();
     void setGlobalPosition(const QPointF &globalPosition);
-    void updateVisibility();
 
 private:
     Q_DISABLE_COPY(NodeItem)
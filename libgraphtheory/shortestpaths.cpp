@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shortestpaths_p.h"
+#include "graphsnapshot.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace GraphTheory;
+
+namespace {
+const qreal infinity = std::numeric_limits<qreal>::infinity();
+}
+
+ShortestPaths::ShortestPaths(const GraphSnapshot &graph, const QVector<qreal> &weights, int source, int target)
+    : m_source(source)
+    , m_distance(graph.nodeCount(), infinity)
+    , m_predecessor(graph.nodeCount(), -1)
+    , m_negativeCycle(false)
+{
+    Q_ASSERT(weights.size() == graph.edgeCount());
+    Q_ASSERT(source >= 0 && source < graph.nodeCount());
+    m_distance[source] = 0;
+    if (hasNegativeWeight(weights)) {
+        bellmanFord(graph, weights);
+    } else {
+        dijkstra(graph, weights, target);
+    }
+}
+
+bool ShortestPaths::hasNegativeCycle() const
+{
+    return m_negativeCycle;
+}
+
+qreal ShortestPaths::distance(int node) const
+{
+    return m_distance.at(node);
+}
+
+int ShortestPaths::predecessor(int node) const
+{
+    return m_predecessor.at(node);
+}
+
+QVector<int> ShortestPaths::path(int node) const
+{
+    QVector<int> result;
+    if (m_negativeCycle || m_distance.at(node) == infinity) {
+        return result;
+    }
+    for (; node != m_source; node = m_predecessor.at(node)) {
+        result.append(node);
+    }
+    result.append(m_source);
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+bool ShortestPaths::hasNegativeWeight(const QVector<qreal> &weights)
+{
+    return std::any_of(weights.constBegin(), weights.constEnd(), [](qreal weight) {
+        return weight < 0;
+    });
+}
+
+void ShortestPaths::dijkstra(const GraphSnapshot &graph, const QVector<qreal> &weights, int target)
+{
+    typedef std::pair<qreal, int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+
+    const QVector<int> &offsets = graph.offsets();
+    const QVector<int> &targets = graph.targets();
+    const QVector<int> &edges = graph.edges();
+    queue.push(QueueEntry(0, m_source));
+    while (!queue.empty()) {
+        const QueueEntry entry = queue.top();
+        queue.pop();
+        const int node = entry.second;
+        if (entry.first > m_distance.at(node)) {
+            continue;
+        }
+        if (node == target) {
+            break;
+        }
+        for (int i = offsets.at(node); i < offsets.at(node + 1); ++i) {
+            const qreal length = entry.first + weights.at(edges.at(i));
+            if (length < m_distance.at(targets.at(i))) {
+                m_distance[targets.at(i)] = length;
+                m_predecessor[targets.at(i)] = node;
+                queue.push(QueueEntry(length, targets.at(i)));
+            }
+        }
+    }
+}
+
+void ShortestPaths::bellmanFord(const GraphSnapshot &graph, const QVector<qreal> &weights)
+{
+    const QVector<int> &offsets = graph.offsets();
+    const QVector<int> &targets = graph.targets();
+    const QVector<int> &edges = graph.edges();
+    const int count = graph.nodeCount();
+
+    // after count-1 rounds all distances are final, unless a negative cycle is reachable
+    for (int round = 0; round < count; ++round) {
+        bool changed = false;
+        for (int node = 0; node < count; ++node) {
+            if (m_distance.at(node) == infinity) {
+                continue;
+            }
+            for (int i = offsets.at(node); i < offsets.at(node + 1); ++i) {
+                const qreal length = m_distance.at(node) + weights.at(edges.at(i));
+                if (length < m_distance.at(targets.at(i))) {
+                    m_distance[targets.at(i)] = length;
+                    m_predecessor[targets.at(i)] = node;
+                    changed = true;
+                }
+            }
+        }
+        if (!changed) {
+            return;
+        }
+    }
+    m_negativeCycle = true;
+}
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHORTESTPATHS_P_H
+#define SHORTESTPATHS_P_H
+
+#include <QVector>
+
+namespace GraphTheory
+{
+class GraphSnapshot;
+
+/**
+ * \class ShortestPaths
+ *
+ * Single-source shortest paths on the adjacency of a GraphSnapshot. Edge weights are given by
+ * edge index. Without negative weights Dijkstra's algorithm is used, otherwise the
+ * Bellman-Ford algorithm.
+ */
+class ShortestPaths
+{
+public:
+    /**
+     * Compute shortest paths from node index @p source. If @p target is a node index, the
+     * computation may stop as soon as the distance to @p target is known.
+     */
+    ShortestPaths(const GraphSnapshot &graph, const QVector<qreal> &weights, int source, int target = -1);
+
+    /**
+     * @return true if a cycle of negative weight is reachable from the source, in which case
+     * distances and predecessors are meaningless
+     */
+    bool hasNegativeCycle() const;
+
+    /**
+     * @return distance of node index @p node, infinity if the node is not reachable
+     */
+    qreal distance(int node) const;
+
+    /**
+     * @return node index of the predecessor of @p node on a shortest path, -1 for the source
+     * and for nodes that are not reachable
+     */
+    int predecessor(int node) const;
+
+    /**
+     * @return node indices of a shortest path from the source to @p node, empty if @p node is
+     * not reachable
+     */
+    QVector<int> path(int node) const;
+
+    /**
+     * @return true if any of @p weights is negative
+     */
+    static bool hasNegativeWeight(const QVector<qreal> &weights);
+
+private:
+    void dijkstra(const GraphSnapshot &graph, const QVector<qreal> &weights, int target);
+    void bellmanFord(const GraphSnapshot &graph, const QVector<qreal> &weights);
+
+    const int m_source;
+    QVector<qreal> m_distance;
+    QVector<int> m_predecessor;
+    bool m_negativeCycle;
+};
+}
+
+#endif
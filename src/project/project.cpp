@@ -339,7 +339,7 @@ bool Project::addGraphDocument(GraphDocumentPtr document)
     }
     QString fileName;
     for (int i = 0; i <= d->m_graphDocuments.count(); ++i) {
-        fileName = "graphfile" + QString::number(i) + QString(".graph2");
+        fileName = "graphfile" + QString::number(i) + QString(".bgraph");
         if (!usedFileNames.contains(fileName)) {
             break;
         }
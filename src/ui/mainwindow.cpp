@@ -22,10 +22,12 @@
 #include "mainwindow.h"
 #include "rocsversion.h"
 #include "settings.h"
+#include "logging_p.h"
 
 #include "libgraphtheory/editor.h"
 #include "libgraphtheory/editorplugins/editorpluginmanager.h"
 #include "libgraphtheory/kernel/kernel.h"
+#include "libgraphtheory/kernel/kernelexecution.h"
 #include "libgraphtheory/view.h"
 
 #include <QApplication>
@@ -42,6 +44,7 @@
 #include <QInputDialog>
 #include <QActionGroup>
 #include <QFileDialog>
+#include <QFile>
 #include <QQuickWidget>
 #include <QPointer>
 
@@ -64,6 +67,7 @@
 #include "ui/sidedockwidget.h"
 #include "ui/fileformatdialog.h"
 #include "ui/journalwidget.h"
+#include "ui/scriptprofilewidget.h"
 #include "grapheditorwidget.h"
 #include "plugins/scriptapi/scriptapiwidget.h"
 #include "project/project.h"
@@ -88,7 +92,9 @@ MainWindow::MainWindow()
     setupToolsPluginsAction();
 
     // setup kernel
-    connect(m_kernel, &Kernel::message, m_outputWidget, &ScriptOutputWidget::processMessage);
+    connect(m_kernel, &Kernel::messagesBatched, m_outputWidget, &ScriptOutputWidget::processMessages);
+    m_outputWidget->setScrollbackLimit(Settings::scriptOutputScrollback());
+    loadLibraryScripts();
 
     // TODO: use welcome widget instead of creating default empty project
     createProject();
@@ -184,14 +190,20 @@ QWidget* MainWindow::setupScriptPanel()
     m_stopScript = new QAction(QIcon::fromTheme("process-stop"), i18nc("@action:intoolbar Script Execution", "Stop"), this);
     m_stopScript->setToolTip(i18nc("@info:tooltip", "Stop script execution."));
     m_stopScript->setEnabled(false);
+    m_profileScript = new QAction(QIcon::fromTheme("chronometer"), i18nc("@action:intoolbar Script Execution", "Profile"), this);
+    m_profileScript->setToolTip(i18nc("@info:tooltip", "Measure the calls of scripting API methods of the following script executions."));
+    m_profileScript->setCheckable(true);
     executeCommands->addAction(m_runScript);
     executeCommands->addAction(m_stopScript);
+    executeCommands->addAction(m_profileScript);
     // add actions to action collection to be able to set shortcuts on them in the ui
     actionCollection()->addAction("_runScript", m_runScript);
     actionCollection()->addAction("_stopScript", m_stopScript);
+    actionCollection()->addAction("_profileScript", m_profileScript);
 
     connect(m_runScript, &QAction::triggered, this, &MainWindow::executeScript);
     connect(m_stopScript, &QAction::triggered, this, &MainWindow::stopScript);
+    connect(m_profileScript, &QAction::toggled, m_kernel, &Kernel::setProfilingEnabled);
 
     m_hScriptSplitter->addWidget(m_codeEditorWidget);
     m_hScriptSplitter->addWidget(m_outputWidget);
@@ -228,6 +240,15 @@ QWidget* MainWindow::setupSidePanel()
     m_journalWidget = new JournalEditorWidget(panel);
     sideDock->addDock(m_journalWidget, i18nc("@title", "Journal"), QIcon::fromTheme("story-editor"));
 
+    // profile of the last profiled script execution
+    m_profileWidget = new ScriptProfileWidget(panel);
+    sideDock->addDock(m_profileWidget, i18nc("@title", "Script Profile"), QIcon::fromTheme("chronometer"));
+    connect(m_kernel, &Kernel::executionFinished, m_profileWidget, [=]() {
+        if (m_kernel->isProfilingEnabled()) {
+            m_profileWidget->setProfile(m_kernel->profile());
+        }
+    });
+
     // Rocs scripting API documentation
     ScriptApiWidget* apiDoc = new ScriptApiWidget(panel);
     sideDock->addDock(apiDoc, i18nc("@title", "Scripting API"), QIcon::fromTheme("documentation"));
@@ -563,6 +584,20 @@ void MainWindow::showEditorPluginDialog()
     }
 }
 
+void MainWindow::loadLibraryScripts()
+{
+    foreach (const QString &path, Settings::libraryScripts()) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            qCWarning(ROCS_GENERAL) << "Could not open library script" << path;
+            m_outputWidget->processMessage(i18nc("@info:shell", "Could not open library script %1", path),
+                Kernel::ErrorMessage);
+            continue;
+        }
+        m_kernel->addLibrary(path, QString::fromUtf8(file.readAll()));
+    }
+}
+
 void MainWindow::executeScript()
 {
     if (m_outputWidget->isOutputClearEnabled()) {
@@ -570,7 +605,11 @@ void MainWindow::executeScript()
     }
     QString script = m_codeEditorWidget->activeDocument()->text();
     enableStopAction();
-    m_kernel->execute(m_currentProject->activeGraphDocument(), script);
+
+    // run script in background, such that the editor stays responsive
+    KernelExecution *execution = m_kernel->executeAsync(m_currentProject->activeGraphDocument(), script);
+    connect(execution, &KernelExecution::finished, this, &MainWindow::disableStopAction);
+    connect(execution, &KernelExecution::finished, execution, &QObject::deleteLater);
 }
 
 void MainWindow::stopScript()
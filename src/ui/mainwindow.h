@@ -40,6 +40,7 @@ class GraphEditorWidget;
 class QCloseEvent;
 class ScriptOutputWidget;
 class JournalEditorWidget;
+class ScriptProfileWidget;
 
 class MainWindow : public KXmlGuiWindow
 {
@@ -59,6 +60,11 @@ private:
      */
     void setProject(Project *project);
 
+    /**
+     * Register the library scripts listed in the settings at the kernel.
+     */
+    void loadLibraryScripts();
+
     /**
      * Setup the information panel at the right side.
      *
@@ -151,10 +157,12 @@ private:
     GraphEditorWidget *m_graphEditorWidget;
     ScriptOutputWidget *m_outputWidget;
     JournalEditorWidget *m_journalWidget;
+    ScriptProfileWidget *m_profileWidget;
 
     // Other Bunch of stuff.
     QAction *m_runScript;
     QAction *m_stopScript;
+    QAction *m_profileScript;
 
     ///Store the recent files.
     KRecentFilesAction *m_recentProjects;
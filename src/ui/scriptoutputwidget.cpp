@@ -19,9 +19,15 @@
  */
  
 #include "scriptoutputwidget.h"
+#include <KLocalizedString>
 #include <QWidget>
 #include <QDebug>
+#include <QFileDialog>
 #include <QIcon>
+#include <QScrollBar>
+#include <QTextBrowser>
+#include <QTextCursor>
+#include <QTextStream>
 
 using namespace GraphTheory;
 
@@ -35,10 +41,12 @@ ScriptOutputWidget::ScriptOutputWidget(QWidget *parent)
     ui->buttonEnableDebugOutput->setIcon(QIcon::fromTheme("tools-report-bug"));
     ui->buttonDisableClear->setIcon(QIcon::fromTheme("document-decrypt"));
     ui->buttonClear->setIcon(QIcon::fromTheme("edit-clear-list"));
+    ui->buttonLogToFile->setIcon(QIcon::fromTheme("document-save"));
 
     connect(ui->buttonEnableDebugOutput, &QPushButton::clicked, this, &ScriptOutputWidget::showDebugOutput);
     connect(ui->buttonDisableClear, &QPushButton::clicked, this, &ScriptOutputWidget::updateFixOutputButton);
     connect(ui->buttonClear, &QPushButton::clicked, this, &ScriptOutputWidget::clear);
+    connect(ui->buttonLogToFile, &QPushButton::toggled, this, &ScriptOutputWidget::toggleLogFile);
 }
 
 void ScriptOutputWidget::updateFixOutputButton()
@@ -64,21 +72,99 @@ bool ScriptOutputWidget::isOutputClearEnabled() const
 
 void ScriptOutputWidget::processMessage(const QString& message, Kernel::MessageType type)
 {
-    switch(type)
-    {
-    case Kernel::MessageType::InfoMessage:
-        ui->txtOutput->append(message);
-        ui->dbgOutput->append("<i>" + message + "</i>");
-        break;
-    case Kernel::MessageType::WarningMessage:
-        ui->dbgOutput->append("<span style=\"color: green\">" + message + "</span>");
-        break;
-    case Kernel::MessageType::ErrorMessage:
-        ui->txtOutput->append("<b style=\"color: red\">" + message + "</b>");
-        ui->dbgOutput->append("<b style=\"color: red\">" + message + "</b>");
-        break;
-    default:
-        qWarning() << "Unknown message type, aborting printing.";
+    processMessages(Kernel::MessageList() << qMakePair(type, message));
+}
+
+void ScriptOutputWidget::processMessages(const Kernel::MessageList &messages)
+{
+    QStringList output;
+    QStringList debugOutput;
+    QTextStream log(&m_logFile);
+    for (const auto &message : messages) {
+        // messages are plain text, only the formatting added here is interpreted as HTML
+        const QString text = message.second.toHtmlEscaped().replace('\n', "<br/>");
+        switch(message.first)
+        {
+        case Kernel::MessageType::InfoMessage:
+            output.append(text);
+            debugOutput.append("<i>" + text + "</i>");
+            break;
+        case Kernel::MessageType::WarningMessage:
+            debugOutput.append("<span style=\"color: green\">" + text + "</span>");
+            break;
+        case Kernel::MessageType::ErrorMessage:
+            output.append("<b style=\"color: red\">" + text + "</b>");
+            debugOutput.append("<b style=\"color: red\">" + text + "</b>");
+            break;
+        default:
+            qWarning() << "Unknown message type, aborting printing.";
+            continue;
+        }
+        if (m_logFile.isOpen()) {
+            log << message.second << '\n';
+        }
+    }
+    append(ui->txtOutput, output);
+    append(ui->dbgOutput, debugOutput);
+}
+
+void ScriptOutputWidget::append(QTextBrowser *browser, const QStringList &lines)
+{
+    if (lines.isEmpty()) {
+        return;
+    }
+    // only follow the output if the user did not scroll up to read earlier lines
+    QScrollBar *scrollBar = browser->verticalScrollBar();
+    const bool atBottom = scrollBar->value() == scrollBar->maximum();
+
+    // each line becomes one block; lines that the scrollback limit would discard right away
+    // are not inserted at all
+    const int limit = browser->document()->maximumBlockCount();
+    const int first = limit > 0 ? qMax(0, lines.size() - limit) : 0;
+
+    // insert all lines within one edit block, such that the document is laid out only once
+    QTextCursor cursor(browser->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    for (int i = first; i < lines.size(); ++i) {
+        if (!cursor.atStart()) {
+            cursor.insertBlock();
+        }
+        cursor.insertHtml(lines.at(i));
+    }
+    cursor.endEditBlock();
+    if (atBottom) {
+        scrollBar->setValue(scrollBar->maximum());
+    }
+}
+
+void ScriptOutputWidget::setScrollbackLimit(int lines)
+{
+    ui->txtOutput->document()->setMaximumBlockCount(lines);
+    ui->dbgOutput->document()->setMaximumBlockCount(lines);
+}
+
+bool ScriptOutputWidget::setLogFile(const QString &path)
+{
+    if (m_logFile.isOpen()) {
+        m_logFile.close();
+    }
+    if (path.isEmpty()) {
+        return true;
+    }
+    m_logFile.setFileName(path);
+    return m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+}
+
+void ScriptOutputWidget::toggleLogFile(bool enabled)
+{
+    if (!enabled) {
+        setLogFile(QString());
+        return;
+    }
+    const QString path = QFileDialog::getSaveFileName(this, i18nc("@title:window", "Write Script Output to File"));
+    if (path.isEmpty() || !setLogFile(path)) {
+        ui->buttonLogToFile->setChecked(false);
     }
 }
 
@@ -23,8 +23,11 @@
 
 #include "ui_scriptoutputwidget.h"
 #include "libgraphtheory/kernel/kernel.h"
+#include <QFile>
 #include <QWidget>
 
+class QTextBrowser;
+
 /**
  * \class ScriptOutputWidget
  *
@@ -39,16 +42,33 @@ public:
     explicit ScriptOutputWidget(QWidget *parent = 0);
     bool isOutputClearEnabled() const;
 
+    /**
+     * Set the number of lines @p lines that are kept by the output views, older lines are
+     * dropped. A value of 0 keeps all lines.
+     */
+    void setScrollbackLimit(int lines);
+
+    /**
+     * Additionally write all messages to the file at @p path, which keeps the complete output
+     * independent of the scrollback limit. An empty path stops writing.
+     * \return true if the file could be opened
+     */
+    bool setLogFile(const QString &path);
+
 public Q_SLOTS:
     void processMessage(const QString &message, GraphTheory::Kernel::MessageType type);
+    void processMessages(const GraphTheory::Kernel::MessageList &messages);
     void showDebugOutput(bool show = true);
     void clear();
 
 private Q_SLOTS:
     void updateFixOutputButton();
+    void toggleLogFile(bool enabled);
 
 private:
+    void append(QTextBrowser *browser, const QStringList &lines);
     Ui::ScriptOutputWidget* ui;
+    QFile m_logFile;
 };
 
 #endif
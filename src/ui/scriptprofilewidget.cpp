@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 2 of
+ *  the License or (at your option) version 3 or any later version
+ *  accepted by the membership of KDE e.V. (or its successor approved
+ *  by the membership of KDE e.V.), which shall act as a proxy
+ *  defined in Section 14 of version 3 of the license.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "scriptprofilewidget.h"
+#include "libgraphtheory/kernel/kernelprofile.h"
+
+#include <KLocalizedString>
+#include <QHeaderView>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+using namespace GraphTheory;
+
+namespace {
+QString milliseconds(qint64 nanoseconds)
+{
+    return QString::number(nanoseconds / 1.0e6, 'f', 2);
+}
+}
+
+ScriptProfileWidget::ScriptProfileWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_summary(new QLabel(this))
+    , m_entries(new QTreeWidget(this))
+{
+    m_summary->setWordWrap(true);
+    m_summary->setText(i18nc("@info", "Enable profiling and run a script to measure its API calls."));
+    m_entries->setRootIsDecorated(false);
+    m_entries->setSortingEnabled(true);
+    m_entries->setHeaderLabels(QStringList()
+        << i18nc("@title:column", "Method")
+        << i18nc("@title:column", "Calls")
+        << i18nc("@title:column", "Time (ms)"));
+    m_entries->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(m_summary);
+    layout->addWidget(m_entries);
+}
+
+void ScriptProfileWidget::setProfile(const KernelProfile &profile)
+{
+    m_summary->setText(i18nc("@info", "Total %1 ms, script %2 ms, API calls %3 ms, garbage collection %4 ms",
+        milliseconds(profile.totalTime()), milliseconds(profile.scriptTime()),
+        milliseconds(profile.nativeTime()), milliseconds(profile.garbageCollectionTime())));
+
+    // sorting while inserting would reorder the rows after every value
+    m_entries->setSortingEnabled(false);
+    m_entries->clear();
+    foreach (const KernelProfile::Entry &entry, profile.entries()) {
+        QTreeWidgetItem *item = new QTreeWidgetItem(m_entries);
+        item->setText(0, entry.function);
+        item->setData(1, Qt::DisplayRole, entry.calls);
+        item->setData(2, Qt::DisplayRole, entry.time / 1.0e6);
+        item->setTextAlignment(1, Qt::AlignRight);
+        item->setTextAlignment(2, Qt::AlignRight);
+    }
+    m_entries->setSortingEnabled(true);
+    m_entries->sortByColumn(2, Qt::DescendingOrder);
+}
@@ -0,0 +1,55 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 2 of
+ *  the License or (at your option) version 3 or any later version
+ *  accepted by the membership of KDE e.V. (or its successor approved
+ *  by the membership of KDE e.V.), which shall act as a proxy
+ *  defined in Section 14 of version 3 of the license.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCRIPTPROFILEWIDGET_H
+#define SCRIPTPROFILEWIDGET_H
+
+#include <QWidget>
+
+namespace GraphTheory {
+    class KernelProfile;
+}
+class QLabel;
+class QTreeWidget;
+
+/**
+ * \class ScriptProfileWidget
+ *
+ * This class presents the profile of the last profiled script execution as a table with one
+ * row per called script API method.
+ */
+class ScriptProfileWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ScriptProfileWidget(QWidget *parent);
+
+    /**
+     * Replaces the displayed results by those of \p profile.
+     */
+    void setProfile(const GraphTheory::KernelProfile &profile);
+
+private:
+    QLabel *m_summary;
+    QTreeWidget *m_entries;
+};
+
+#endif